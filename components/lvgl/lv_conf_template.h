@@ -140,17 +140,30 @@
 /* If a widget has `style_opa < 255` (not `bg_opa`, `text_opa` etc) or not NORMAL blend mode
  * it is buffered into a "simple" layer before rendering. The widget can be buffered in smaller chunks.
  * "Transformed layers" (if `transform_angle/zoom` are set) use larger buffers
- * and can't be drawn in chunks. */
+ * and are drawn in chunks only if `LV_DRAW_LAYER_TRANSFORM_BUF_SIZE` is set. */
 
 /** The target buffer size for simple layer chunks. */
 #define LV_DRAW_LAYER_SIMPLE_BUF_SIZE    (24 * 1024)    /**< [bytes]*/
 
+/** The target buffer size for transformed layer chunks.
+ * The transformed widget is drawn in tiles of the screen whose (not transformed) source area fits into this size.
+ * Set it to 0 to draw the whole widget on one layer. */
+#define LV_DRAW_LAYER_TRANSFORM_BUF_SIZE 0  /**< [bytes]*/
+
 /* Limit the max allocated memory for simple and transformed layers.
  * It should be at least `LV_DRAW_LAYER_SIMPLE_BUF_SIZE` sized but if transformed layers are also used
- * it should be enough to store the largest widget too (width x height x 4 area).
+ * it should be enough to store the largest widget too (width x height x 4 area) or the largest
+ * `LV_DRAW_LAYER_TRANSFORM_BUF_SIZE` chunk.
+ * A layer which doesn't fit is drawn when an other one is freed. The limit is exceeded only if
+ * the layers using the memory might wait for this one (e.g. nested layers).
  * Set it to 0 to have no limit. */
 #define LV_DRAW_LAYER_MAX_MEMORY 0  /**< No limit by default [bytes]*/
 
+/** Keep this many freed layer buffers to reuse them for the next layers
+ * instead of freeing and allocating them again. They are counted in `LV_DRAW_LAYER_MAX_MEMORY`.
+ * Set it to 0 to free the layer buffers immediately. */
+#define LV_DRAW_LAYER_BUF_POOL_CNT 0
+
 /** Stack size of drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -218,6 +231,18 @@
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
     #endif
 
+    /** Size of the cache of the calculated gradient color maps and blurred shadow corners [bytes].
+     *  Unlike `LV_DRAW_SW_SHADOW_CACHE_SIZE` it keeps many items, shared by the draw units,
+     *  and can be saved to a file and preloaded at boot (see `lv_draw_sw_cache_save()`).
+     *  Items larger than half of the cache are not cached.
+     *  - 0: disables caching */
+    #define LV_DRAW_SW_CACHE_SIZE 0
+
+    /** Draw the images rotated by 90, 180 or 270 degrees at 1:1 scale by copying the pixels
+     *  instead of with the general (interpolating) transform.
+     *  - 0: use the general transform, e.g. as a reference in tests */
+    #define LV_DRAW_SW_RIGHT_ANGLE_ROTATION 1
+
     #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
 
     #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
@@ -460,6 +485,12 @@
  *  released immediately after use. */
 #define LV_CACHE_DEF_SIZE       0
 
+/** Evict the decoded images by cost instead of LRU order (Greedy-Dual-Size-Frequency).
+ *  Small images, images used often and images which took long to decode are kept longer,
+ *  large images which were quick to decode are evicted first.
+ *  Set a microsecond clock with `lv_image_cache_set_clock_cb()` to measure the decoding time. */
+#define LV_IMAGE_CACHE_USE_GDSF 0
+
 /** Default number of image header cache entries. The cache is used to store the headers of images
  *  The main logic is like `LV_CACHE_DEF_SIZE` but for image headers. */
 #define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
@@ -485,6 +516,15 @@
 /**  Enable support widget names*/
 #define LV_USE_OBJ_NAME         0
 
+/** Keep a rendered copy of widgets with `LV_OBJ_FLAG_CACHE_AS_BITMAP` and its children
+ *  and blend it instead of redrawing them until something in them is invalidated. */
+#define LV_USE_OBJ_BITMAP_CACHE 0
+#if LV_USE_OBJ_BITMAP_CACHE
+    /** Memory budget shared by all the cached widget bitmaps.
+     *  The least recently used bitmaps are freed when it's exceeded. */
+    #define LV_OBJ_BITMAP_CACHE_SIZE (64 * 1024)    /**< [bytes]*/
+#endif
+
 /** Automatically assign an ID when obj is created */
 #define LV_OBJ_ID_AUTO_ASSIGN   LV_USE_OBJ_ID
 
@@ -644,6 +684,11 @@
 /** Enables/disables support for compressed fonts. */
 #define LV_USE_FONT_COMPRESSED 0
 
+/** Size of the decoded glyph bitmap cache of the built-in fonts in bytes.
+ *  Glyphs are decoded to A8 once and reused until evicted in LRU order.
+ *  0: disable the cache and decode the glyphs on every draw. */
+#define LV_FONT_GLYPH_CACHE_SIZE 0
+
 /** Enable drawing placeholders when glyph dsc is not found. */
 #define LV_USE_FONT_PLACEHOLDER 1
 
@@ -925,6 +970,11 @@
 /** JPG + split JPG decoder library.
  *  Split JPG is a custom format optimized for embedded systems. */
 #define LV_USE_TJPGD 0
+#if LV_USE_TJPGD
+    /** Bytes of decoded MCU rows (full width strips, RGB888) kept between draws.
+     *  A 320x240 image needs 230400 bytes to stay fully decoded. 0: no cache */
+    #define LV_TJPGD_CACHE_SIZE 0
+#endif
 
 /** libjpeg-turbo decoder library.
  *  - Supports complete JPEG specifications and high-performance JPEG decoding. */
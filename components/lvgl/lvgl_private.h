@@ -43,6 +43,7 @@ extern "C" {
 #include "src/draw/lv_draw_mask_private.h"
 #include "src/draw/sw/lv_draw_sw_private.h"
 #include "src/draw/sw/lv_draw_sw_mask_private.h"
+#include "src/draw/sw/lv_draw_sw_cache_private.h"
 #include "src/draw/sw/blend/lv_draw_sw_blend_private.h"
 #include "src/drivers/libinput/lv_xkb_private.h"
 #include "src/drivers/libinput/lv_libinput_private.h"
@@ -54,6 +55,7 @@ extern "C" {
 #include "src/core/lv_obj_private.h"
 #include "src/core/lv_obj_scroll_private.h"
 #include "src/core/lv_obj_draw_private.h"
+#include "src/core/lv_obj_bitmap_cache_private.h"
 #include "src/core/lv_obj_class_private.h"
 #include "src/core/lv_group_private.h"
 #include "src/core/lv_obj_event_private.h"
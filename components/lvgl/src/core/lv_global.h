@@ -51,10 +51,13 @@ extern "C" {
 #include "../draw/lv_draw_private.h"
 #include "../draw/sw/lv_draw_sw_private.h"
 #include "../draw/sw/lv_draw_sw_mask_private.h"
+#include "../draw/sw/lv_draw_sw_cache_private.h"
 #include "../stdlib/builtin/lv_tlsf_private.h"
 #include "../others/sysmon/lv_sysmon_private.h"
 #include "../others/test/lv_test_private.h"
 #include "../layouts/lv_layout_private.h"
+#include "lv_obj_bitmap_cache_private.h"
+#include "../others/observer/lv_observer_private.h"
 
 /*********************
  *      DEFINES
@@ -73,6 +76,10 @@ struct _snippet_stack;
 struct _lv_freetype_context_t;
 #endif
 
+#if LV_USE_TJPGD
+struct _lv_tjpgd_context_t;
+#endif
+
 #if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
 struct _lv_profiler_builtin_ctx_t;
 #endif
@@ -87,6 +94,7 @@ typedef struct _lv_global_t {
 
     lv_ll_t disp_ll;
     lv_display_t * disp_refresh;
+    uint32_t inv_batch_cnt;
     lv_display_t * disp_default;
 
     lv_ll_t style_trans_ll;
@@ -125,6 +133,19 @@ typedef struct _lv_global_t {
 
     lv_cache_t * img_cache;
     lv_cache_t * img_header_cache;
+    lv_image_cache_stats_t image_cache_stats;
+    lv_image_cache_clock_cb_t image_cache_clock_cb;
+
+    lv_cache_t * font_glyph_cache;
+    lv_font_glyph_cache_stats_t font_glyph_cache_stats;
+
+#if LV_USE_OBSERVER
+    lv_subject_deferred_t subject_deferred;
+#endif
+
+#if LV_USE_OBJ_BITMAP_CACHE
+    lv_obj_bitmap_cache_state_t obj_bitmap_cache;
+#endif
 
     lv_draw_global_info_t draw_info;
     lv_ll_t draw_sw_blend_handler_ll;
@@ -134,6 +155,9 @@ typedef struct _lv_global_t {
 #if LV_DRAW_SW_COMPLEX
     lv_draw_sw_mask_radius_circle_dsc_arr_t sw_circle_cache;
 #endif
+#if LV_USE_DRAW_SW && LV_DRAW_SW_CACHE_SIZE > 0
+    lv_draw_sw_cache_state_t draw_sw_cache;
+#endif
 
 #if LV_USE_LOG
     lv_log_print_g_cb_t custom_log_print_cb;
@@ -195,6 +219,10 @@ typedef struct _lv_global_t {
     struct _lv_freetype_context_t * ft_context;
 #endif
 
+#if LV_USE_TJPGD
+    struct _lv_tjpgd_context_t * tjpgd_context;
+#endif
+
 #if LV_USE_FONT_COMPRESSED
     lv_font_fmt_rle_t font_fmt_rle;
 #endif
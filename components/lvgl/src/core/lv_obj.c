@@ -26,6 +26,7 @@
 #include "../tick/lv_tick.h"
 #include "../stdlib/lv_string.h"
 #include "lv_obj_draw_private.h"
+#include "lv_obj_bitmap_cache_private.h"
 
 /*********************
  *      DEFINES
@@ -65,6 +66,7 @@ static void screen_load_on_trigger_event_cb(lv_event_t * e);
 static void screen_create_on_trigger_event_cb(lv_event_t * e);
 static void free_user_data_on_delete_event_cb(lv_event_t * e);
 static void delete_on_screen_unloaded_event_cb(lv_event_t * e);
+static bool child_depends_on_parent_size(const lv_obj_t * child, bool w_changed, bool h_changed);
 
 #if LV_USE_OBJ_PROPERTY
     static lv_result_t lv_obj_set_any(lv_obj_t *, lv_prop_id_t, const lv_property_t *);
@@ -279,6 +281,10 @@ void lv_obj_add_flag(lv_obj_t * obj, lv_obj_flag_t f)
         lv_obj_invalidate_area(obj, &hor_area);
         lv_obj_invalidate_area(obj, &ver_area);
     }
+
+#if LV_USE_OBJ_BITMAP_CACHE
+    if(f & LV_OBJ_FLAG_CACHE_AS_BITMAP) lv_obj_bitmap_cache_add(obj);
+#endif
 }
 
 void lv_obj_remove_flag(lv_obj_t * obj, lv_obj_flag_t f)
@@ -307,6 +313,9 @@ void lv_obj_remove_flag(lv_obj_t * obj, lv_obj_flag_t f)
         lv_obj_mark_layout_as_dirty(lv_obj_get_parent(obj));
     }
 
+#if LV_USE_OBJ_BITMAP_CACHE
+    if(f & LV_OBJ_FLAG_CACHE_AS_BITMAP) lv_obj_bitmap_cache_remove(obj);
+#endif
 }
 
 void lv_obj_set_flag(lv_obj_t * obj, lv_obj_flag_t f, bool v)
@@ -584,6 +593,9 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
         }
 
         lv_event_remove_all(&obj->spec_attr->event_list);
+#if LV_USE_OBJ_BITMAP_CACHE
+        lv_obj_bitmap_cache_remove(obj);
+#endif
 #if LV_USE_OBJ_NAME
         if(obj->spec_attr->name && !obj->spec_attr->name_static) {
             lv_free((void *)obj->spec_attr->name);
@@ -908,11 +920,19 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e)
             lv_obj_mark_layout_as_dirty(obj);
         }
 
+        /*Only the children whose size or position is calculated from the parent's size
+         *need to be updated. The others keep their measured size.*/
+        const lv_area_t * ori = lv_event_get_param(e);
+        bool w_changed = ori == NULL || lv_area_get_width(ori) != lv_obj_get_width(obj);
+        bool h_changed = ori == NULL || lv_area_get_height(ori) != lv_obj_get_height(obj);
+
         uint32_t i;
         uint32_t child_cnt = lv_obj_get_child_count(obj);
         for(i = 0; i < child_cnt; i++) {
             lv_obj_t * child = obj->spec_attr->children[i];
-            lv_obj_mark_layout_as_dirty(child);
+            if(child_depends_on_parent_size(child, w_changed, h_changed)) {
+                lv_obj_mark_layout_as_dirty(child);
+            }
         }
     }
     else if(code == LV_EVENT_CHILD_CHANGED) {
@@ -1031,6 +1051,34 @@ static void update_obj_state(lv_obj_t * obj, lv_state_t new_state)
     }
 }
 
+static bool child_depends_on_parent_size(const lv_obj_t * child, bool w_changed, bool h_changed)
+{
+    lv_align_t align = lv_obj_get_style_align(child, LV_PART_MAIN);
+    if(align == LV_ALIGN_DEFAULT) {
+        /*RTL aligns to the right side of the parent*/
+        if(lv_obj_get_style_base_dir(lv_obj_get_parent(child), LV_PART_MAIN) != LV_BASE_DIR_LTR) return true;
+    }
+    else if(align != LV_ALIGN_TOP_LEFT) {
+        return true;
+    }
+
+    if(w_changed) {
+        if(LV_COORD_IS_PCT(lv_obj_get_style_width(child, LV_PART_MAIN))) return true;
+        if(LV_COORD_IS_PCT(lv_obj_get_style_min_width(child, LV_PART_MAIN))) return true;
+        if(LV_COORD_IS_PCT(lv_obj_get_style_max_width(child, LV_PART_MAIN))) return true;
+        if(LV_COORD_IS_PCT(lv_obj_get_style_x(child, LV_PART_MAIN))) return true;
+    }
+
+    if(h_changed) {
+        if(LV_COORD_IS_PCT(lv_obj_get_style_height(child, LV_PART_MAIN))) return true;
+        if(LV_COORD_IS_PCT(lv_obj_get_style_min_height(child, LV_PART_MAIN))) return true;
+        if(LV_COORD_IS_PCT(lv_obj_get_style_max_height(child, LV_PART_MAIN))) return true;
+        if(LV_COORD_IS_PCT(lv_obj_get_style_y(child, LV_PART_MAIN))) return true;
+    }
+
+    return false;
+}
+
 static bool obj_valid_child(const lv_obj_t * parent, const lv_obj_t * obj_to_find)
 {
     /*Check all children of `parent`*/
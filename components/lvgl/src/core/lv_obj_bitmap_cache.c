@@ -0,0 +1,362 @@
+/**
+ * @file lv_obj_bitmap_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj_bitmap_cache_private.h"
+
+#if LV_USE_OBJ_BITMAP_CACHE
+
+#include "lv_obj_private.h"
+#include "lv_obj_draw_private.h"
+#include "lv_obj_event_private.h"
+#include "lv_refr_private.h"
+#include "../display/lv_display_private.h"
+#include "../draw/lv_draw_private.h"
+#include "../draw/lv_draw_image.h"
+#include "../misc/lv_area_private.h"
+#include "../misc/cache/lv_cache.h"
+#include "../stdlib/lv_mem.h"
+#include "lv_global.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define cache_state (LV_GLOBAL_DEFAULT()->obj_bitmap_cache)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool get_render_area(lv_obj_t * obj, lv_display_t * disp, lv_area_t * area_out);
+static bool entry_is_usable(const lv_obj_bitmap_cache_entry_t * entry, const lv_area_t * area);
+static bool need_alpha(lv_obj_t * obj, const lv_area_t * area);
+static bool make_room(lv_obj_bitmap_cache_entry_t * entry, uint32_t size);
+static void free_draw_buf(lv_obj_bitmap_cache_entry_t * entry);
+static void render(lv_obj_bitmap_cache_entry_t * entry, lv_display_t * disp, const lv_area_t * area);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_obj_bitmap_cache_init(void)
+{
+    lv_ll_init(&cache_state.entry_ll, sizeof(lv_obj_bitmap_cache_entry_t));
+    cache_state.rendering = NULL;
+    lv_memzero(&cache_state.stats, sizeof(lv_obj_bitmap_cache_stats_t));
+    cache_state.stats.budget = LV_OBJ_BITMAP_CACHE_SIZE;
+}
+
+void lv_obj_bitmap_cache_deinit(void)
+{
+    lv_obj_bitmap_cache_entry_t * entry;
+    LV_LL_READ(&cache_state.entry_ll, entry) {
+        free_draw_buf(entry);
+        if(entry->obj->spec_attr) entry->obj->spec_attr->bitmap_cache = NULL;
+    }
+    lv_ll_clear(&cache_state.entry_ll);
+    cache_state.stats.entry_cnt = 0;
+}
+
+void lv_obj_bitmap_cache_set_budget(uint32_t budget)
+{
+    cache_state.stats.budget = budget;
+
+    lv_obj_bitmap_cache_entry_t * entry;
+    LV_LL_READ_BACK(&cache_state.entry_ll, entry) {
+        if(cache_state.stats.used <= budget) break;
+        if(entry->draw_buf == NULL) continue;
+        free_draw_buf(entry);
+        cache_state.stats.evictions++;
+    }
+}
+
+void lv_obj_bitmap_cache_get_stats(lv_obj_bitmap_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    *stats = cache_state.stats;
+}
+
+void lv_obj_bitmap_cache_reset_stats(void)
+{
+    cache_state.stats.hits = 0;
+    cache_state.stats.renders = 0;
+    cache_state.stats.fallbacks = 0;
+    cache_state.stats.evictions = 0;
+}
+
+void lv_obj_bitmap_cache_add(lv_obj_t * obj)
+{
+    lv_obj_allocate_spec_attr(obj);
+    if(obj->spec_attr->bitmap_cache) return;
+
+    lv_obj_bitmap_cache_entry_t * entry = lv_ll_ins_tail(&cache_state.entry_ll);
+    LV_ASSERT_MALLOC(entry);
+    if(entry == NULL) return;
+
+    lv_memzero(entry, sizeof(lv_obj_bitmap_cache_entry_t));
+    entry->obj = obj;
+    obj->spec_attr->bitmap_cache = entry;
+    cache_state.stats.entry_cnt++;
+}
+
+void lv_obj_bitmap_cache_remove(lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->bitmap_cache == NULL) return;
+
+    lv_obj_bitmap_cache_entry_t * entry = obj->spec_attr->bitmap_cache;
+    free_draw_buf(entry);
+    lv_ll_remove(&cache_state.entry_ll, entry);
+    lv_free(entry);
+    obj->spec_attr->bitmap_cache = NULL;
+    cache_state.stats.entry_cnt--;
+}
+
+void lv_obj_bitmap_cache_mark_dirty(const lv_obj_t * obj)
+{
+    if(lv_ll_get_head(&cache_state.entry_ll) == NULL) return;
+
+    /*The widget itself or any of its parents can be cached*/
+    while(obj) {
+        if(obj->spec_attr && obj->spec_attr->bitmap_cache) {
+            lv_obj_bitmap_cache_entry_t * entry = obj->spec_attr->bitmap_cache;
+            entry->valid = 0;
+        }
+        obj = obj->parent;
+    }
+}
+
+void lv_obj_bitmap_cache_refresh(lv_display_t * disp)
+{
+    LV_PROFILER_REFR_BEGIN;
+    lv_obj_bitmap_cache_entry_t * entry;
+    lv_obj_bitmap_cache_entry_t * entry_next;
+    for(entry = lv_ll_get_head(&cache_state.entry_ll); entry != NULL; entry = entry_next) {
+        /*`render` moves the entry to the head*/
+        entry_next = lv_ll_get_next(&cache_state.entry_ll, entry);
+
+        lv_obj_t * obj = entry->obj;
+        if(lv_obj_get_display(obj) != disp) continue;
+        if(lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE) continue;
+        if(!lv_obj_is_visible(obj)) continue;
+
+        lv_area_t area;
+        if(!get_render_area(obj, disp, &area)) continue;
+        if(entry_is_usable(entry, &area)) continue;
+
+        /*Render only if the widget is going to be drawn in this refresh*/
+        uint32_t i;
+        for(i = 0; i < disp->inv_p; i++) {
+            if(disp->inv_area_joined[i]) continue;
+            if(lv_area_is_on(&area, &disp->inv_areas[i])) break;
+        }
+        if(i == disp->inv_p) continue;
+
+        render(entry, disp, &area);
+    }
+    LV_PROFILER_REFR_END;
+}
+
+bool lv_obj_bitmap_cache_draw(lv_layer_t * layer, lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->bitmap_cache == NULL) return false;
+    if(cache_state.rendering == obj) return false;
+
+    lv_obj_bitmap_cache_entry_t * entry = obj->spec_attr->bitmap_cache;
+
+    /*Not drawn anyway*/
+    lv_area_t area;
+    if(!get_render_area(obj, lv_obj_get_display(obj), &area)) return false;
+    if(!lv_area_intersect(&area, &area, &layer->_clip_area)) return false;
+
+    /*The recolor of the parents is applied to the draw descriptors, it's not in the bitmap*/
+    if(layer->recolor.alpha != 0 || !entry_is_usable(entry, &area)) {
+        cache_state.stats.fallbacks++;
+        return false;
+    }
+
+    lv_area_t image_area = entry->area;
+    lv_area_move(&image_area, obj->coords.x1, obj->coords.y1);
+
+    lv_draw_image_dsc_t draw_dsc;
+    lv_draw_image_dsc_init(&draw_dsc);
+    draw_dsc.src = entry->draw_buf;
+    lv_draw_image(layer, &draw_dsc, &image_area);
+
+    lv_ll_move_before(&cache_state.entry_ll, entry, lv_ll_get_head(&cache_state.entry_ll));
+    cache_state.stats.hits++;
+    return true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the area of a widget which should be in its bitmap: the widget with its
+ * extra draw size, limited to the display to not cache the scrolled out parts.
+ * Returns false if the widget can't be cached or it's out of the display.
+ */
+static bool get_render_area(lv_obj_t * obj, lv_display_t * disp, lv_area_t * area_out)
+{
+    /*The children drawn out of the widget are not in the bitmap*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+
+    int32_t ext_draw_size = lv_obj_get_ext_draw_size(obj);
+    lv_area_t obj_area = obj->coords;
+    lv_area_increase(&obj_area, ext_draw_size, ext_draw_size);
+
+    lv_area_t disp_area;
+    lv_area_set(&disp_area, 0, 0, lv_display_get_horizontal_resolution(disp) - 1,
+                lv_display_get_vertical_resolution(disp) - 1);
+
+    return lv_area_intersect(area_out, &obj_area, &disp_area);
+}
+
+/**
+ * Check if the bitmap is up to date and contains `area`. The widget can move,
+ * as the bitmap is stored relative to the widget.
+ */
+static bool entry_is_usable(const lv_obj_bitmap_cache_entry_t * entry, const lv_area_t * area)
+{
+    if(!entry->valid || entry->draw_buf == NULL) return false;
+
+    const lv_obj_t * obj = entry->obj;
+    if(entry->obj_w != lv_area_get_width(&obj->coords)) return false;
+    if(entry->obj_h != lv_area_get_height(&obj->coords)) return false;
+
+    lv_area_t rel_area = *area;
+    lv_area_move(&rel_area, -obj->coords.x1, -obj->coords.y1);
+    return lv_area_is_in(&rel_area, &entry->area, 0);
+}
+
+static bool need_alpha(lv_obj_t * obj, const lv_area_t * area)
+{
+    /*Same test as for simple layers: use an opaque bitmap if the widget covers the whole area*/
+    if(!lv_area_is_on(area, &obj->coords)) return true;
+    if(!lv_area_is_in(area, &obj->coords, 0)) return true;
+    if(lv_obj_get_style_opa(obj, LV_PART_MAIN) < LV_OPA_MAX) return true;
+
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_COVER;
+    info.area = area;
+    lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
+    return info.res != LV_COVER_RES_COVER;
+}
+
+/**
+ * Free the least recently drawn bitmaps (except `entry`'s) until `size` bytes fit in the budget.
+ */
+static bool make_room(lv_obj_bitmap_cache_entry_t * entry, uint32_t size)
+{
+    if(size > cache_state.stats.budget) return false;
+
+    lv_obj_bitmap_cache_entry_t * victim;
+    LV_LL_READ_BACK(&cache_state.entry_ll, victim) {
+        if(cache_state.stats.used + size <= cache_state.stats.budget) break;
+        if(victim == entry || victim->draw_buf == NULL) continue;
+        free_draw_buf(victim);
+        cache_state.stats.evictions++;
+    }
+
+    return cache_state.stats.used + size <= cache_state.stats.budget;
+}
+
+static void free_draw_buf(lv_obj_bitmap_cache_entry_t * entry)
+{
+    if(entry->draw_buf == NULL) return;
+
+    /*The bitmap was drawn as an image source, don't let the address be found later*/
+    lv_image_cache_drop(entry->draw_buf);
+    lv_draw_buf_destroy(entry->draw_buf);
+    entry->draw_buf = NULL;
+    cache_state.stats.used -= entry->size;
+    entry->size = 0;
+    entry->valid = 0;
+}
+
+static void render(lv_obj_bitmap_cache_entry_t * entry, lv_display_t * disp, const lv_area_t * area)
+{
+    LV_PROFILER_REFR_BEGIN;
+    lv_obj_t * obj = entry->obj;
+    int32_t w = lv_area_get_width(area);
+    int32_t h = lv_area_get_height(area);
+    lv_color_format_t cf = need_alpha(obj, area) ? LV_COLOR_FORMAT_ARGB8888 : lv_refr_get_opaque_layer_cf(disp);
+    uint32_t size = lv_draw_buf_width_to_stride(w, cf) * h;
+
+    if(entry->draw_buf && entry->draw_buf->header.w == w && entry->draw_buf->header.h == h &&
+       entry->draw_buf->header.cf == cf) {
+        /*Reuse the buffer, but the image cache might have seen its old content*/
+        lv_image_cache_drop(entry->draw_buf);
+    }
+    else {
+        free_draw_buf(entry);
+        if(!make_room(entry, size)) {
+            LV_PROFILER_REFR_END;
+            return;
+        }
+
+        entry->draw_buf = lv_draw_buf_create(w, h, cf, LV_STRIDE_AUTO);
+        if(entry->draw_buf == NULL) {
+            LV_LOG_WARN("Couldn't allocate %" LV_PRIu32 " bytes for the bitmap of %p", size, (void *)obj);
+            LV_PROFILER_REFR_END;
+            return;
+        }
+        entry->size = size;
+        cache_state.stats.used += size;
+    }
+
+    if(lv_color_format_has_alpha(cf)) lv_draw_buf_clear(entry->draw_buf, NULL);
+
+    lv_layer_t layer;
+    lv_layer_init(&layer);
+    layer.draw_buf = entry->draw_buf;
+    layer.buf_area = *area;
+    layer.color_format = cf;
+    layer._clip_area = *area;
+    layer.phy_clip_area = *area;
+
+    /*Bake the widget's own opacity and recolor into the bitmap like `refr_obj` would apply them*/
+    lv_opa_t opa_main = lv_obj_get_style_opa(obj, LV_PART_MAIN);
+    if(opa_main < LV_OPA_MAX) layer.opa = opa_main;
+    layer.recolor = lv_obj_style_apply_recolor(obj, LV_PART_MAIN, layer.recolor);
+
+    /*Render it like a snapshot. The display's layers are empty now as the refreshing hasn't started yet.*/
+    lv_layer_t * layer_head_ori = disp->layer_head;
+    disp->layer_head = &layer;
+    cache_state.rendering = obj;
+
+    lv_obj_redraw(&layer, obj);
+    while(layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        lv_draw_dispatch();
+    }
+
+    cache_state.rendering = NULL;
+    disp->layer_head = layer_head_ori;
+
+    entry->area = *area;
+    lv_area_move(&entry->area, -obj->coords.x1, -obj->coords.y1);
+    entry->obj_w = lv_area_get_width(&obj->coords);
+    entry->obj_h = lv_area_get_height(&obj->coords);
+    entry->valid = 1;
+    lv_ll_move_before(&cache_state.entry_ll, entry, lv_ll_get_head(&cache_state.entry_ll));
+    cache_state.stats.renders++;
+    LV_PROFILER_REFR_END;
+}
+
+#endif /*LV_USE_OBJ_BITMAP_CACHE*/
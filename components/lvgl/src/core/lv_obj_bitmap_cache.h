@@ -0,0 +1,70 @@
+/**
+ * @file lv_obj_bitmap_cache.h
+ *
+ */
+
+#ifndef LV_OBJ_BITMAP_CACHE_H
+#define LV_OBJ_BITMAP_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+
+#if LV_USE_OBJ_BITMAP_CACHE
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t hits;          /**< Widgets drawn by blending their cached bitmap*/
+    uint32_t renders;       /**< Cached bitmaps (re)rendered because they were invalid, moved off or resized*/
+    uint32_t fallbacks;     /**< Widgets drawn normally because their bitmap didn't fit or wasn't usable*/
+    uint32_t evictions;     /**< Bitmaps freed to stay in the memory budget*/
+    uint32_t entry_cnt;     /**< Number of widgets having `LV_OBJ_FLAG_CACHE_AS_BITMAP`*/
+    uint32_t used;          /**< Memory used by the bitmaps [bytes]*/
+    uint32_t budget;        /**< Memory budget of the bitmaps [bytes]*/
+} lv_obj_bitmap_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Set the memory budget shared by the cached bitmaps of the widgets.
+ * The least recently used bitmaps are freed immediately if the new budget is smaller.
+ * @param budget    new budget in bytes. 0: free all and draw the widgets normally.
+ */
+void lv_obj_bitmap_cache_set_budget(uint32_t budget);
+
+/**
+ * Get the statistics of the widget bitmap cache.
+ * @param stats     pointer to a structure to fill
+ */
+void lv_obj_bitmap_cache_get_stats(lv_obj_bitmap_cache_stats_t * stats);
+
+/**
+ * Reset the hit/render/fallback/eviction counters of the widget bitmap cache.
+ */
+void lv_obj_bitmap_cache_reset_stats(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_OBJ_BITMAP_CACHE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_BITMAP_CACHE_H*/
@@ -0,0 +1,107 @@
+/**
+ * @file lv_obj_bitmap_cache_private.h
+ *
+ */
+
+#ifndef LV_OBJ_BITMAP_CACHE_PRIVATE_H
+#define LV_OBJ_BITMAP_CACHE_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_obj_bitmap_cache.h"
+
+#if LV_USE_OBJ_BITMAP_CACHE
+
+#include "../misc/lv_ll.h"
+#include "../misc/lv_area.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_obj_t * obj;
+    lv_draw_buf_t * draw_buf;   /**< The rendered widget or NULL if not rendered yet or evicted*/
+    lv_area_t area;             /**< Rendered area relative to the top left corner of the widget*/
+    int32_t obj_w;              /**< Size of the widget when it was rendered*/
+    int32_t obj_h;
+    uint32_t size;              /**< Size of `draw_buf` counted in the budget [bytes]*/
+    uint8_t valid : 1;          /**< 0: the widget or a child was invalidated since the rendering*/
+} lv_obj_bitmap_cache_entry_t;
+
+typedef struct {
+    lv_ll_t entry_ll;           /**< `lv_obj_bitmap_cache_entry_t`s, the most recently drawn first*/
+    lv_obj_t * rendering;       /**< The widget being rendered into its bitmap*/
+    lv_obj_bitmap_cache_stats_t stats;
+} lv_obj_bitmap_cache_state_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the widget bitmap cache. Called by `lv_init()`.
+ */
+void lv_obj_bitmap_cache_init(void);
+
+/**
+ * Free all the cached bitmaps. Called by `lv_deinit()`.
+ */
+void lv_obj_bitmap_cache_deinit(void);
+
+/**
+ * Start caching a widget. Called when `LV_OBJ_FLAG_CACHE_AS_BITMAP` is added.
+ * @param obj       pointer to a widget
+ */
+void lv_obj_bitmap_cache_add(lv_obj_t * obj);
+
+/**
+ * Stop caching a widget and free its bitmap.
+ * Called when `LV_OBJ_FLAG_CACHE_AS_BITMAP` is removed or the widget is deleted.
+ * @param obj       pointer to a widget
+ */
+void lv_obj_bitmap_cache_remove(lv_obj_t * obj);
+
+/**
+ * Mark the bitmap of the cached widgets containing `obj` as outdated.
+ * Called on every invalidation so it returns immediately if nothing is cached.
+ * @param obj       pointer to the invalidated widget
+ */
+void lv_obj_bitmap_cache_mark_dirty(const lv_obj_t * obj);
+
+/**
+ * Re-render the outdated bitmaps which are visible in the invalidated areas of a display.
+ * Called before the invalidated areas are refreshed, when the draw units are idle.
+ * @param disp      pointer to the display being refreshed
+ */
+void lv_obj_bitmap_cache_refresh(lv_display_t * disp);
+
+/**
+ * Draw a widget and its children by blending its cached bitmap.
+ * @param layer     pointer to a layer
+ * @param obj       pointer to a widget with `LV_OBJ_FLAG_CACHE_AS_BITMAP`
+ * @return          true: drawn from the cache; false: the bitmap is not usable, draw the widget normally
+ */
+bool lv_obj_bitmap_cache_draw(lv_layer_t * layer, lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_OBJ_BITMAP_CACHE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_BITMAP_CACHE_PRIVATE_H*/
@@ -16,6 +16,7 @@
 #include "../display/lv_display_private.h"
 #include "lv_refr_private.h"
 #include "../core/lv_global.h"
+#include "lv_obj_bitmap_cache_private.h"
 
 /*********************
  *      DEFINES
@@ -33,6 +34,7 @@
 static int32_t calc_content_width(lv_obj_t * obj);
 static int32_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
+static void mark_parents_with_dirty_child(lv_obj_t * obj);
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv);
 static bool is_transformed(const lv_obj_t * obj);
 
@@ -199,6 +201,7 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     lv_obj_invalidate(obj);
 
     obj->readjust_scroll_after_layout = 1;
+    mark_parents_with_dirty_child(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
@@ -283,13 +286,16 @@ void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
 {
     obj->layout_inv = 1;
 
+    /*Let the layout update find this object without walking the whole tree*/
+    mark_parents_with_dirty_child(obj);
+
     /*Mark the screen as dirty too to mark that there is something to do on this screen*/
     lv_obj_t * scr = lv_obj_get_screen(obj);
     scr->scr_layout_inv = 1;
 
-    /*Make the display refreshing*/
+    /*Make the display refreshing (once per animation frame, not per moved object)*/
     lv_display_t * disp = lv_obj_get_display(scr);
-    lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
+    lv_refr_request(disp);
 }
 
 void lv_obj_update_layout(const lv_obj_t * obj)
@@ -823,6 +829,11 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_USE_OBJ_BITMAP_CACHE
+    /*Even if the area is not visible now, the cached bitmap of a parent might contain it*/
+    lv_obj_bitmap_cache_mark_dirty(obj);
+#endif
+
     lv_display_t * disp   = lv_obj_get_display(obj);
     if(!lv_display_is_invalidation_enabled(disp)) return;
 
@@ -1225,9 +1236,17 @@ static void layout_update_core(lv_obj_t * obj)
 {
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_count(obj);
-    for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        layout_update_core(child);
+
+    /*Visit only the subtrees which have something to update.
+     *Clear the flag first so that invalidations made by the children are not lost*/
+    if(obj->layout_child_inv) {
+        obj->layout_child_inv = 0;
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_t * child = obj->spec_attr->children[i];
+            if(child->layout_inv || child->layout_child_inv || child->readjust_scroll_after_layout) {
+                layout_update_core(child);
+            }
+        }
     }
 
     if(obj->layout_inv) {
@@ -1246,6 +1265,17 @@ static void layout_update_core(lv_obj_t * obj)
     }
 }
 
+static void mark_parents_with_dirty_child(lv_obj_t * obj)
+{
+    /*Go up to the screen unconditionally: during a layout update the flag of the parents
+     *is already cleared while the children's flags are still set*/
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    while(parent) {
+        parent->layout_child_inv = 1;
+        parent = lv_obj_get_parent(parent);
+    }
+}
+
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv)
 {
 #if LV_DRAW_TRANSFORM_USE_MATRIX
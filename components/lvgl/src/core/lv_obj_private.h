@@ -37,6 +37,9 @@ struct _lv_obj_spec_attr_t {
     lv_event_list_t event_list;
 #if LV_USE_OBJ_NAME
     const char * name;              /**< Pointer to the name */
+#endif
+#if LV_USE_OBJ_BITMAP_CACHE
+    void * bitmap_cache;            /**< `lv_obj_bitmap_cache_entry_t` if `LV_OBJ_FLAG_CACHE_AS_BITMAP` is set*/
 #endif
     lv_point_t scroll;              /**< The current X/Y scroll offset*/
 
@@ -69,6 +72,7 @@ struct _lv_obj_t {
     lv_obj_flag_t flags;
     lv_state_t state;
     uint16_t layout_inv : 1;
+    uint16_t layout_child_inv : 1;  /**< A descendant waits for a layout update*/
     uint16_t readjust_scroll_after_layout : 1;
     uint16_t scr_layout_inv : 1;
     uint16_t skip_trans : 1;
@@ -24,6 +24,7 @@
 #include "../font/lv_font_fmt_txt.h"
 #include "../stdlib/lv_string.h"
 #include "lv_global.h"
+#include "lv_obj_bitmap_cache_private.h"
 
 /*********************
  *      DEFINES
@@ -32,6 +33,9 @@
 /*Display being refreshed*/
 #define disp_refr LV_GLOBAL_DEFAULT()->disp_refresh
 
+/*Don't split the tiles of the transformed layers below this size*/
+#define TRANSFORM_TILE_MIN_SIZE     16
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -39,6 +43,7 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void inv_area_store(lv_display_t * disp, const lv_area_t * area);
 static void lv_refr_join_area(void);
 static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
@@ -46,6 +51,12 @@ static void refr_area(const lv_area_t * area_p, int32_t y_offset);
 static void refr_configured_layer(lv_layer_t * layer);
 static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj);
 static void refr_obj(lv_layer_t * layer, lv_obj_t * obj);
+static void refr_obj_layer(lv_layer_t * layer, lv_obj_t * obj, lv_layer_type_t layer_type, lv_opa_t opa_layered,
+                           const lv_area_t * layer_area_full, const lv_area_t * obj_draw_size);
+#if LV_DRAW_LAYER_TRANSFORM_BUF_SIZE > 0
+    static void refr_obj_transform_tile(lv_layer_t * layer, lv_obj_t * obj, lv_opa_t opa_layered,
+                                        const lv_area_t * tile);
+#endif
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h);
 static void draw_buf_flush(lv_display_t * disp);
 static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
@@ -312,21 +323,50 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     if(res != LV_RESULT_OK) return;
 
     /*Save only if this area is not in one of the saved areas*/
-    uint16_t i;
+    uint32_t i;
     for(i = 0; i < disp->inv_p; i++) {
         if(lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
     }
 
-    /*Save the area*/
-    lv_area_t * tmp_area_p = &com_area;
-    if(disp->inv_p >= LV_INV_BUF_SIZE) { /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        tmp_area_p = &scr_area;
+    inv_area_store(disp, &com_area);
+
+    lv_refr_request(disp);
+}
+
+lv_color_format_t lv_refr_get_opaque_layer_cf(lv_display_t * disp)
+{
+    /*Keep the byte order of the display so the layer is blended without swapping the pixels*/
+    if(disp && disp->color_format == LV_COLOR_FORMAT_RGB565_SWAPPED) return LV_COLOR_FORMAT_RGB565_SWAPPED;
+    return LV_COLOR_FORMAT_NATIVE;
+}
+
+void lv_refr_inv_batch_begin(void)
+{
+    LV_GLOBAL_DEFAULT()->inv_batch_cnt++;
+}
+
+void lv_refr_inv_batch_end(void)
+{
+    LV_ASSERT_MSG(LV_GLOBAL_DEFAULT()->inv_batch_cnt > 0, "lv_refr_inv_batch_end() without lv_refr_inv_batch_begin()");
+    if(LV_GLOBAL_DEFAULT()->inv_batch_cnt == 0) return;
+
+    LV_GLOBAL_DEFAULT()->inv_batch_cnt--;
+    if(LV_GLOBAL_DEFAULT()->inv_batch_cnt) return;
+
+    lv_display_t * disp = lv_display_get_next(NULL);
+    while(disp) {
+        if(disp->refr_request_pending) {
+            disp->refr_request_pending = 0;
+            lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
+        }
+        disp = lv_display_get_next(disp);
     }
-    lv_area_copy(&disp->inv_areas[disp->inv_p], tmp_area_p);
-    disp->inv_p++;
+}
 
-    lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
+void lv_refr_request(lv_display_t * disp)
+{
+    if(LV_GLOBAL_DEFAULT()->inv_batch_cnt) disp->refr_request_pending = 1;
+    else lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
 }
 
 /**
@@ -378,16 +418,24 @@ void lv_display_refr_timer(lv_timer_t * tmr)
         return;
     }
 
+#if LV_USE_OBSERVER
+    /*Notify the Observers of the deferred Subjects once per frame, before the layout is updated*/
+    lv_subject_apply_deferred();
+#endif
+
     lv_display_send_event(disp_refr, LV_EVENT_REFR_START, NULL);
 
-    /*Refresh the screen's layout if required*/
+    /*Refresh the screen's layout if required.
+     *The moved objects invalidate their areas but the refresh is requested only once.*/
     LV_PROFILER_LAYOUT_BEGIN_TAG("layout");
+    lv_refr_inv_batch_begin();
     lv_obj_update_layout(disp_refr->act_scr);
     if(disp_refr->prev_scr) lv_obj_update_layout(disp_refr->prev_scr);
 
     lv_obj_update_layout(disp_refr->bottom_layer);
     lv_obj_update_layout(disp_refr->top_layer);
     lv_obj_update_layout(disp_refr->sys_layer);
+    lv_refr_inv_batch_end();
     LV_PROFILER_LAYOUT_END_TAG("layout");
 
     /*Do nothing if there is no active screen*/
@@ -453,6 +501,11 @@ lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
     lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
     if(info.res == LV_COVER_RES_MASKED) return NULL;
 
+#if LV_USE_OBJ_BITMAP_CACHE
+    /*The children are in the bitmap of the widget, no need to check them*/
+    if(info.res == LV_COVER_RES_COVER && lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_AS_BITMAP)) return obj;
+#endif
+
     int32_t i;
     int32_t child_cnt = lv_obj_get_child_count(obj);
     for(i = child_cnt - 1; i >= 0; i--) {
@@ -478,6 +531,77 @@ lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Add an area to the invalidated areas of a display, merging it into the stored areas
+ * where it's cheaper than redrawing them separately.
+ * Many small areas (e.g. from animations) would overflow the buffer and redraw the whole screen,
+ * so if the buffer is full the area is merged into the area which grows the least.
+ */
+static void inv_area_store(lv_display_t * disp, const lv_area_t * area)
+{
+    lv_area_t new_area = *area;
+    lv_area_t joined_area;
+    uint32_t i;
+
+    /*Remove the areas covered by the new one and merge it with the overlapping ones
+     *if it's not much larger than redrawing them separately. As a merged area might
+     *overlap others now, check all the areas again.*/
+    bool merged = false;
+    bool changed = true;
+    while(changed) {
+        changed = false;
+        i = 0;
+        while(i < disp->inv_p) {
+            lv_area_t * stored = &disp->inv_areas[i];
+            bool remove = false;
+            if(lv_area_is_in(stored, &new_area, 0)) {
+                remove = true;
+            }
+            else if(lv_area_is_on(stored, &new_area)) {
+                lv_area_join(&joined_area, stored, &new_area);
+                if(lv_area_get_size(&joined_area) < lv_area_get_size(stored) + lv_area_get_size(&new_area) + LV_INV_JOIN_SLACK) {
+                    new_area = joined_area;
+                    merged = true;
+                    changed = true;
+                    remove = true;
+                }
+            }
+
+            if(remove) {
+                /*Move the last area here*/
+                disp->inv_p--;
+                disp->inv_areas[i] = disp->inv_areas[disp->inv_p];
+            }
+            else {
+                i++;
+            }
+        }
+    }
+
+    if(disp->inv_p < LV_INV_BUF_SIZE) {
+        disp->inv_areas[disp->inv_p] = new_area;
+        disp->inv_p++;
+        if(merged) disp->inv_stats.merged++;
+        else disp->inv_stats.added++;
+        return;
+    }
+
+    /*No place for the area: join it to the area which grows the least*/
+    uint32_t best_i = 0;
+    uint32_t best_growth = UINT32_MAX;
+    for(i = 0; i < disp->inv_p; i++) {
+        lv_area_join(&joined_area, &disp->inv_areas[i], &new_area);
+        uint32_t growth = lv_area_get_size(&joined_area) - lv_area_get_size(&disp->inv_areas[i]);
+        if(growth < best_growth) {
+            best_growth = growth;
+            best_i = i;
+        }
+    }
+
+    lv_area_join(&disp->inv_areas[best_i], &disp->inv_areas[best_i], &new_area);
+    disp->inv_stats.overflows++;
+}
+
 /**
  * Join the areas which has got common parts
  */
@@ -627,6 +751,11 @@ static void refr_invalid_areas(void)
     if(disp_refr->inv_p == 0) return;
     LV_PROFILER_REFR_BEGIN;
 
+#if LV_USE_OBJ_BITMAP_CACHE
+    /*Render the outdated bitmaps now, as the display's layer can't be used while drawing the areas*/
+    lv_obj_bitmap_cache_refresh(disp_refr);
+#endif
+
     /*Find the last area which will be drawn*/
     int32_t i;
     int32_t last_i = 0;
@@ -1193,6 +1322,14 @@ static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
     const lv_opa_t opa_layered = lv_obj_get_style_opa_layered(obj, LV_PART_MAIN);
     if(opa_layered <= LV_OPA_MIN) return;
 
+#if LV_USE_OBJ_BITMAP_CACHE
+    /*The opacity and recolor of the widget are already applied in its bitmap*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_AS_BITMAP) && lv_obj_get_layer_type(obj) == LV_LAYER_TYPE_NONE &&
+       lv_obj_bitmap_cache_draw(layer, obj)) {
+        return;
+    }
+#endif
+
     const lv_opa_t layer_opa_ori = layer->opa;
     const lv_color32_t layer_recolor = layer->recolor;
 
@@ -1214,86 +1351,170 @@ static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
         refr_obj_matrix(layer, obj);
     }
 #endif /* LV_DRAW_TRANSFORM_USE_MATRIX */
+#if LV_DRAW_LAYER_TRANSFORM_BUF_SIZE > 0
+    else if(layer_type == LV_LAYER_TYPE_TRANSFORM) {
+        /*Draw only the part of the screen where the transformed widget is, in smaller tiles if needed*/
+        lv_area_t tranf_coords;
+        lv_obj_get_coords(obj, &tranf_coords);
+        int32_t ext_draw_size = lv_obj_get_ext_draw_size(obj);
+        lv_area_increase(&tranf_coords, ext_draw_size, ext_draw_size);
+        lv_obj_get_transformed_area(obj, &tranf_coords, LV_OBJ_POINT_TRANSFORM_FLAG_NONE);
+
+        lv_area_t tile;
+        if(lv_area_intersect(&tile, &layer->_clip_area, &tranf_coords)) {
+            refr_obj_transform_tile(layer, obj, opa_layered, &tile);
+        }
+    }
+#endif
     else {
         lv_area_t layer_area_full;
         lv_area_t obj_draw_size;
         lv_result_t res = layer_get_area(layer, obj, layer_type, &layer_area_full, &obj_draw_size);
-        if(res != LV_RESULT_OK) return;
-
-        /*Simple layers can be subdivided into smaller layers*/
-        uint32_t max_rgb_row_height = lv_area_get_height(&layer_area_full);
-        uint32_t max_argb_row_height = lv_area_get_height(&layer_area_full);
-        if(layer_type == LV_LAYER_TYPE_SIMPLE) {
-            int32_t w = lv_area_get_width(&layer_area_full);
-            uint8_t px_size = lv_color_format_get_size(disp_refr->color_format);
-            max_rgb_row_height = LV_DRAW_LAYER_SIMPLE_BUF_SIZE / w / px_size;
-            max_argb_row_height = LV_DRAW_LAYER_SIMPLE_BUF_SIZE / w / sizeof(lv_color32_t);
+        if(res == LV_RESULT_OK) {
+            refr_obj_layer(layer, obj, layer_type, opa_layered, &layer_area_full, &obj_draw_size);
         }
+    }
 
-        lv_area_t layer_area_act;
-        layer_area_act.x1 = layer_area_full.x1;
-        layer_area_act.x2 = layer_area_full.x2;
-        layer_area_act.y1 = layer_area_full.y1;
-        layer_area_act.y2 = layer_area_full.y1;
+    /* Restore the original layer opa and recolor */
+    layer->opa = layer_opa_ori;
+    layer->recolor = layer_recolor;
+}
 
-        while(layer_area_act.y2 < layer_area_full.y2) {
-            /* Test with an RGB layer size (which is larger than the ARGB layer size)
-             * If it really doesn't need alpha use it. Else switch to the ARGB size*/
-            layer_area_act.y2 = layer_area_act.y1 + max_rgb_row_height - 1;
-            if(layer_area_act.y2 > layer_area_full.y2) layer_area_act.y2 = layer_area_full.y2;
+#if LV_DRAW_LAYER_TRANSFORM_BUF_SIZE > 0
 
-            const void * bitmap_mask_src = lv_obj_get_style_bitmap_mask_src(obj, 0);
-            bool area_need_alpha = bitmap_mask_src || alpha_test_area_on_obj(obj, &layer_area_act);
+/**
+ * Draw a transformed widget on a tile of the screen.
+ * If the not transformed area needed to cover the tile wouldn't fit into `LV_DRAW_LAYER_TRANSFORM_BUF_SIZE`
+ * split the tile along its longer side and draw the two halves separately.
+ * @param layer         the layer to draw on, its clip area shall contain `tile`
+ * @param obj           the transformed widget
+ * @param opa_layered   opacity of the widget's layer
+ * @param tile          the area to draw, inside the transformed area of the widget
+ */
+static void refr_obj_transform_tile(lv_layer_t * layer, lv_obj_t * obj, lv_opa_t opa_layered,
+                                    const lv_area_t * tile)
+{
+    lv_area_t layer_area_full;
+    lv_area_t obj_draw_size;
+    lv_result_t res = layer_get_area(layer, obj, LV_LAYER_TYPE_TRANSFORM, &layer_area_full, &obj_draw_size);
+    if(res != LV_RESULT_OK) return;
 
-            if(area_need_alpha) {
-                layer_area_act.y2 = layer_area_act.y1 + max_argb_row_height - 1;
-                if(layer_area_act.y2 > layer_area_full.y2) layer_area_act.y2 = layer_area_full.y2;
-            }
+    uint32_t layer_size_byte = lv_area_get_height(&layer_area_full) *
+                               lv_draw_buf_width_to_stride(lv_area_get_width(&layer_area_full), LV_COLOR_FORMAT_ARGB8888);
+    int32_t tile_w = lv_area_get_width(tile);
+    int32_t tile_h = lv_area_get_height(tile);
 
-            lv_layer_t * new_layer = lv_draw_layer_create(layer,
-                                                          area_need_alpha ? LV_COLOR_FORMAT_ARGB8888 : LV_COLOR_FORMAT_NATIVE, &layer_area_act);
-            lv_obj_redraw(new_layer, obj);
+    if(layer_size_byte <= LV_DRAW_LAYER_TRANSFORM_BUF_SIZE ||
+       (tile_w <= TRANSFORM_TILE_MIN_SIZE && tile_h <= TRANSFORM_TILE_MIN_SIZE)) {
+        refr_obj_layer(layer, obj, LV_LAYER_TYPE_TRANSFORM, opa_layered, &layer_area_full, &obj_draw_size);
+        return;
+    }
 
-            lv_point_t pivot = {
-                .x = lv_obj_get_style_transform_pivot_x(obj, 0),
-                .y = lv_obj_get_style_transform_pivot_y(obj, 0)
-            };
+    /*Clip to the halves to blend only the part which is covered by the smaller layers*/
+    lv_area_t tile1 = *tile;
+    lv_area_t tile2 = *tile;
+    if(tile_h >= tile_w) {
+        tile1.y2 = tile->y1 + tile_h / 2 - 1;
+        tile2.y1 = tile1.y2 + 1;
+    }
+    else {
+        tile1.x2 = tile->x1 + tile_w / 2 - 1;
+        tile2.x1 = tile1.x2 + 1;
+    }
 
-            if(LV_COORD_IS_PCT(pivot.x)) {
-                pivot.x = (LV_COORD_GET_PCT(pivot.x) * lv_area_get_width(&obj->coords)) / 100;
-            }
-            if(LV_COORD_IS_PCT(pivot.y)) {
-                pivot.y = (LV_COORD_GET_PCT(pivot.y) * lv_area_get_height(&obj->coords)) / 100;
-            }
+    lv_area_t clip_area_ori = layer->_clip_area;
+    layer->_clip_area = tile1;
+    refr_obj_transform_tile(layer, obj, opa_layered, &tile1);
+    layer->_clip_area = tile2;
+    refr_obj_transform_tile(layer, obj, opa_layered, &tile2);
+    layer->_clip_area = clip_area_ori;
+}
+
+#endif /*LV_DRAW_LAYER_TRANSFORM_BUF_SIZE > 0*/
+
+/**
+ * Draw a widget on a new layer and blend the layer with the opacity and transformation of the widget.
+ * Simple layers are drawn in chunks of `LV_DRAW_LAYER_SIMPLE_BUF_SIZE`.
+ * @param layer             the layer to blend to
+ * @param obj               the widget to draw
+ * @param layer_type        LV_LAYER_TYPE_SIMPLE or LV_LAYER_TYPE_TRANSFORM
+ * @param opa_layered       opacity of the widget's layer
+ * @param layer_area_full   the area of the widget to draw (see `layer_get_area()`)
+ * @param obj_draw_size     the widget's coordinates with the extra draw size
+ */
+static void refr_obj_layer(lv_layer_t * layer, lv_obj_t * obj, lv_layer_type_t layer_type, lv_opa_t opa_layered,
+                           const lv_area_t * layer_area_full, const lv_area_t * obj_draw_size)
+{
+    /*Simple layers can be subdivided into smaller layers*/
+    uint32_t max_rgb_row_height = lv_area_get_height(layer_area_full);
+    uint32_t max_argb_row_height = lv_area_get_height(layer_area_full);
+    if(layer_type == LV_LAYER_TYPE_SIMPLE) {
+        int32_t w = lv_area_get_width(layer_area_full);
+        uint8_t px_size = lv_color_format_get_size(disp_refr->color_format);
+        max_rgb_row_height = LV_DRAW_LAYER_SIMPLE_BUF_SIZE / w / px_size;
+        max_argb_row_height = LV_DRAW_LAYER_SIMPLE_BUF_SIZE / w / sizeof(lv_color32_t);
+    }
+
+    lv_area_t layer_area_act;
+    layer_area_act.x1 = layer_area_full->x1;
+    layer_area_act.x2 = layer_area_full->x2;
+    layer_area_act.y1 = layer_area_full->y1;
+    layer_area_act.y2 = layer_area_full->y1;
+
+    while(layer_area_act.y2 < layer_area_full->y2) {
+        /* Test with an RGB layer size (which is larger than the ARGB layer size)
+         * If it really doesn't need alpha use it. Else switch to the ARGB size*/
+        layer_area_act.y2 = layer_area_act.y1 + max_rgb_row_height - 1;
+        if(layer_area_act.y2 > layer_area_full->y2) layer_area_act.y2 = layer_area_full->y2;
+
+        const void * bitmap_mask_src = lv_obj_get_style_bitmap_mask_src(obj, 0);
+        bool area_need_alpha = bitmap_mask_src || alpha_test_area_on_obj(obj, &layer_area_act);
+
+        if(area_need_alpha) {
+            layer_area_act.y2 = layer_area_act.y1 + max_argb_row_height - 1;
+            if(layer_area_act.y2 > layer_area_full->y2) layer_area_act.y2 = layer_area_full->y2;
+        }
 
-            lv_draw_image_dsc_t layer_draw_dsc;
-            lv_draw_image_dsc_init(&layer_draw_dsc);
-            layer_draw_dsc.pivot.x = obj->coords.x1 + pivot.x - new_layer->buf_area.x1;
-            layer_draw_dsc.pivot.y = obj->coords.y1 + pivot.y - new_layer->buf_area.y1;
-
-            layer_draw_dsc.opa = opa_layered;
-            layer_draw_dsc.rotation = lv_obj_get_style_transform_rotation(obj, 0);
-            while(layer_draw_dsc.rotation > 3600) layer_draw_dsc.rotation -= 3600;
-            while(layer_draw_dsc.rotation < 0) layer_draw_dsc.rotation += 3600;
-            layer_draw_dsc.scale_x = lv_obj_get_style_transform_scale_x(obj, 0);
-            layer_draw_dsc.scale_y = lv_obj_get_style_transform_scale_y(obj, 0);
-            layer_draw_dsc.skew_x = lv_obj_get_style_transform_skew_x(obj, 0);
-            layer_draw_dsc.skew_y = lv_obj_get_style_transform_skew_y(obj, 0);
-            layer_draw_dsc.blend_mode = lv_obj_get_style_blend_mode(obj, 0);
-            layer_draw_dsc.antialias = disp_refr->antialiasing;
-            layer_draw_dsc.bitmap_mask_src = bitmap_mask_src;
-            layer_draw_dsc.image_area = obj_draw_size;
-            layer_draw_dsc.src = new_layer;
-
-            lv_draw_layer(layer, &layer_draw_dsc, &layer_area_act);
-
-            layer_area_act.y1 = layer_area_act.y2 + 1;
+        lv_layer_t * new_layer = lv_draw_layer_create(layer,
+                                                      area_need_alpha ? LV_COLOR_FORMAT_ARGB8888 : lv_refr_get_opaque_layer_cf(disp_refr),
+                                                      &layer_area_act);
+        lv_obj_redraw(new_layer, obj);
+
+        lv_point_t pivot = {
+            .x = lv_obj_get_style_transform_pivot_x(obj, 0),
+            .y = lv_obj_get_style_transform_pivot_y(obj, 0)
+        };
+
+        if(LV_COORD_IS_PCT(pivot.x)) {
+            pivot.x = (LV_COORD_GET_PCT(pivot.x) * lv_area_get_width(&obj->coords)) / 100;
+        }
+        if(LV_COORD_IS_PCT(pivot.y)) {
+            pivot.y = (LV_COORD_GET_PCT(pivot.y) * lv_area_get_height(&obj->coords)) / 100;
         }
-    }
 
-    /* Restore the original layer opa and recolor */
-    layer->opa = layer_opa_ori;
-    layer->recolor = layer_recolor;
+        lv_draw_image_dsc_t layer_draw_dsc;
+        lv_draw_image_dsc_init(&layer_draw_dsc);
+        layer_draw_dsc.pivot.x = obj->coords.x1 + pivot.x - new_layer->buf_area.x1;
+        layer_draw_dsc.pivot.y = obj->coords.y1 + pivot.y - new_layer->buf_area.y1;
+
+        layer_draw_dsc.opa = opa_layered;
+        layer_draw_dsc.rotation = lv_obj_get_style_transform_rotation(obj, 0);
+        while(layer_draw_dsc.rotation > 3600) layer_draw_dsc.rotation -= 3600;
+        while(layer_draw_dsc.rotation < 0) layer_draw_dsc.rotation += 3600;
+        layer_draw_dsc.scale_x = lv_obj_get_style_transform_scale_x(obj, 0);
+        layer_draw_dsc.scale_y = lv_obj_get_style_transform_scale_y(obj, 0);
+        layer_draw_dsc.skew_x = lv_obj_get_style_transform_skew_x(obj, 0);
+        layer_draw_dsc.skew_y = lv_obj_get_style_transform_skew_y(obj, 0);
+        layer_draw_dsc.blend_mode = lv_obj_get_style_blend_mode(obj, 0);
+        layer_draw_dsc.antialias = disp_refr->antialiasing;
+        layer_draw_dsc.bitmap_mask_src = bitmap_mask_src;
+        layer_draw_dsc.image_area = *obj_draw_size;
+        layer_draw_dsc.src = new_layer;
+
+        lv_draw_layer(layer, &layer_draw_dsc, &layer_area_act);
+
+        layer_area_act.y1 = layer_area_act.y2 + 1;
+    }
 }
 
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h)
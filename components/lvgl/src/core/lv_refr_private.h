@@ -46,6 +46,33 @@ void lv_refr_deinit(void);
  */
 void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p);
 
+/**
+ * Get the color format to use for the layers which don't need alpha channel.
+ * @param disp      pointer to the display the layer is drawn on
+ * @return          `LV_COLOR_FORMAT_RGB565_SWAPPED` if the display is swapped, else `LV_COLOR_FORMAT_NATIVE`
+ */
+lv_color_format_t lv_refr_get_opaque_layer_cf(lv_display_t * disp);
+
+/**
+ * Start collecting the invalidations of all displays, e.g. for the changes of an animation frame.
+ * The areas are still stored immediately but `LV_EVENT_REFR_REQUEST` is sent only once per display
+ * by `lv_refr_inv_batch_end()`. Batches can be nested.
+ */
+void lv_refr_inv_batch_begin(void);
+
+/**
+ * End a batch started by `lv_refr_inv_batch_begin()` and request a refresh on the
+ * displays which were invalidated in the batch.
+ */
+void lv_refr_inv_batch_end(void);
+
+/**
+ * Send `LV_EVENT_REFR_REQUEST` to a display, or only note it if a batch is open
+ * (see `lv_refr_inv_batch_begin()`).
+ * @param disp      pointer to a display
+ */
+void lv_refr_request(lv_display_t * disp);
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -1046,6 +1046,31 @@ bool lv_display_is_invalidation_enabled(lv_display_t * disp)
     return (disp->inv_en_cnt > 0);
 }
 
+void lv_display_get_inv_stats(lv_display_t * disp, lv_display_inv_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    lv_memzero(stats, sizeof(lv_display_inv_stats_t));
+
+    if(!disp) disp = lv_display_get_default();
+    if(!disp) {
+        LV_LOG_WARN("no display registered");
+        return;
+    }
+
+    *stats = disp->inv_stats;
+}
+
+void lv_display_reset_inv_stats(lv_display_t * disp)
+{
+    if(!disp) disp = lv_display_get_default();
+    if(!disp) {
+        LV_LOG_WARN("no display registered");
+        return;
+    }
+
+    lv_memzero(&disp->inv_stats, sizeof(lv_display_inv_stats_t));
+}
+
 lv_timer_t * lv_display_get_refr_timer(lv_display_t * disp)
 {
     if(!disp) disp = lv_display_get_default();
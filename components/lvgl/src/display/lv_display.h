@@ -78,6 +78,12 @@ typedef enum {
     LV_SCREEN_LOAD_ANIM_OUT_BOTTOM,
 } lv_screen_load_anim_t;
 
+typedef struct {
+    uint32_t added;         /**< Areas added to the invalidation buffer as new entries*/
+    uint32_t merged;        /**< Areas merged into an overlapping or adjacent area of the buffer*/
+    uint32_t overflows;     /**< Areas merged into the closest area because the buffer was full*/
+} lv_display_inv_stats_t;
+
 typedef void (*lv_display_flush_cb_t)(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 typedef void (*lv_display_flush_wait_cb_t)(lv_display_t * disp);
 
@@ -587,6 +593,19 @@ void lv_display_enable_invalidation(lv_display_t * disp, bool en);
  */
 bool lv_display_is_invalidation_enabled(lv_display_t * disp);
 
+/**
+ * Get how the invalidated areas were stored in the `LV_INV_BUF_SIZE` sized buffer of the display.
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @param stats     pointer to a structure to fill
+ */
+void lv_display_get_inv_stats(lv_display_t * disp, lv_display_inv_stats_t * stats);
+
+/**
+ * Reset the invalidation statistics of the display.
+ * @param disp      pointer to a display (NULL to use the default display)
+ */
+void lv_display_reset_inv_stats(lv_display_t * disp);
+
 /**
  * Get a pointer to the screen refresher timer to
  * modify its parameters with `lv_timer_...` functions.
@@ -29,6 +29,10 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /**< Buffer size for invalid areas */
 #endif
 
+#ifndef LV_INV_JOIN_SLACK
+#define LV_INV_JOIN_SLACK 256 /**< Merge overlapping invalid areas if it adds less than this many pixels (pays the per-area overhead)*/
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -99,6 +103,9 @@ struct _lv_display_t {
     /** 1: The current screen rendering is in progress*/
     uint32_t rendering_in_progress : 1;
 
+    /** 1: An area was invalidated in a batch, send `LV_EVENT_REFR_REQUEST` when the batch ends*/
+    uint32_t refr_request_pending : 1;
+
     lv_color_format_t   color_format;
 
     /** Invalidated (marked to redraw) areas*/
@@ -106,6 +113,7 @@ struct _lv_display_t {
     uint8_t inv_area_joined[LV_INV_BUF_SIZE];
     uint32_t inv_p;
     int32_t inv_en_cnt;
+    lv_display_inv_stats_t inv_stats;
 
     /** Double buffer sync areas (redrawn during last refresh) */
     lv_ll_t sync_areas;
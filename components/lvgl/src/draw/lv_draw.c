@@ -38,6 +38,11 @@ static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check);
 static void cleanup_task(lv_draw_task_t * t, lv_display_t * disp);
 static inline size_t get_draw_dsc_size(lv_draw_task_type_t type);
 static lv_draw_task_t * get_first_available_task(lv_layer_t * layer);
+static lv_draw_buf_t * layer_buf_get(lv_layer_t * layer, uint32_t layer_size_byte);
+static void layer_buf_release(lv_draw_buf_t * draw_buf);
+#if LV_DRAW_LAYER_MAX_MEMORY > 0
+    static bool layer_is_waited_for(lv_layer_t * layer);
+#endif
 
 #if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
 static inline uint32_t get_layer_size_kb(uint32_t size_byte)
@@ -71,6 +76,15 @@ void lv_draw_deinit(void)
     lv_thread_sync_delete(&_draw_info.sync);
 #endif
 
+#if LV_DRAW_LAYER_BUF_POOL_CNT > 0
+    uint32_t i;
+    for(i = 0; i < _draw_info.layer_buf_pool_cnt; i++) {
+        lv_draw_buf_destroy(_draw_info.layer_buf_pool[i]);
+    }
+    _draw_info.layer_buf_pool_cnt = 0;
+    _draw_info.pooled_memory_for_layers = 0;
+#endif
+
     lv_draw_unit_t * u = _draw_info.unit_head;
     while(u) {
         lv_draw_unit_t * cur_unit = u;
@@ -466,14 +480,20 @@ void * lv_draw_layer_alloc_buf(lv_layer_t * layer)
 
 #if LV_DRAW_LAYER_MAX_MEMORY > 0
     /* Do not allocate the layer if the sum of allocated layer sizes
-     * will exceed `LV_DRAW_LAYER_MAX_MEMORY` */
+     * will exceed `LV_DRAW_LAYER_MAX_MEMORY`. It will be tried again when an other layer is freed.
+     * If no other layer can be freed without this one, allocate it anyway to not lock up. */
     if((_draw_info.used_memory_for_layers + layer_size_byte) > LV_DRAW_LAYER_MAX_MEMORY) {
-        LV_LOG_WARN("LV_DRAW_LAYER_MAX_MEMORY was reached when allocating the layer.");
-        return NULL;
+        if(!layer_is_waited_for(layer)) {
+            _draw_info.layer_wait_cnt++;
+            LV_PROFILER_DRAW_END;
+            return NULL;
+        }
+        LV_LOG_INFO("LV_DRAW_LAYER_MAX_MEMORY was exceeded to draw a layer the others might wait for.");
+        _draw_info.layer_over_limit_cnt++;
     }
 #endif
 
-    layer->draw_buf = lv_draw_buf_create(w, h, layer->color_format, 0);
+    layer->draw_buf = layer_buf_get(layer, layer_size_byte);
 
     if(layer->draw_buf == NULL) {
         LV_LOG_WARN("Allocating layer buffer failed. Try later");
@@ -481,7 +501,6 @@ void * lv_draw_layer_alloc_buf(lv_layer_t * layer)
         return NULL;
     }
 
-    _draw_info.used_memory_for_layers += layer_size_byte;
     LV_LOG_INFO("Layer memory used: %" LV_PRIu32 " kB", get_layer_size_kb(_draw_info.used_memory_for_layers));
 
     if(lv_color_format_has_alpha(layer->color_format)) {
@@ -492,6 +511,34 @@ void * lv_draw_layer_alloc_buf(lv_layer_t * layer)
     return layer->draw_buf->data;
 }
 
+void lv_draw_layer_get_mem_info(lv_draw_layer_mem_info_t * info)
+{
+    LV_ASSERT_NULL(info);
+    lv_memzero(info, sizeof(lv_draw_layer_mem_info_t));
+    info->used = _draw_info.used_memory_for_layers;
+#if LV_DRAW_LAYER_BUF_POOL_CNT > 0
+    info->pooled = _draw_info.pooled_memory_for_layers;
+#endif
+    info->peak = _draw_info.peak_memory_for_layers;
+    info->limit = LV_DRAW_LAYER_MAX_MEMORY;
+    info->alloc_cnt = _draw_info.layer_alloc_cnt;
+    info->reuse_cnt = _draw_info.layer_reuse_cnt;
+    info->wait_cnt = _draw_info.layer_wait_cnt;
+    info->over_limit_cnt = _draw_info.layer_over_limit_cnt;
+}
+
+void lv_draw_layer_reset_mem_info(void)
+{
+    _draw_info.peak_memory_for_layers = _draw_info.used_memory_for_layers;
+#if LV_DRAW_LAYER_BUF_POOL_CNT > 0
+    _draw_info.peak_memory_for_layers += _draw_info.pooled_memory_for_layers;
+#endif
+    _draw_info.layer_alloc_cnt = 0;
+    _draw_info.layer_reuse_cnt = 0;
+    _draw_info.layer_wait_cnt = 0;
+    _draw_info.layer_over_limit_cnt = 0;
+}
+
 void * lv_draw_layer_go_to_xy(lv_layer_t * layer, int32_t x, int32_t y)
 {
     return lv_draw_buf_goto_xy(layer->draw_buf, x, y);
@@ -609,18 +656,8 @@ static void cleanup_task(lv_draw_task_t * t, lv_display_t * disp)
         lv_layer_t * layer_drawn = (lv_layer_t *)draw_image_dsc->src;
 
         if(layer_drawn->draw_buf) {
-            int32_t h = lv_area_get_height(&layer_drawn->buf_area);
-            uint32_t layer_size_byte = h * layer_drawn->draw_buf->header.stride;
-
-            if(_draw_info.used_memory_for_layers >= layer_size_byte) {
-                _draw_info.used_memory_for_layers -= layer_size_byte;
-            }
-            else {
-                _draw_info.used_memory_for_layers = 0;
-                LV_LOG_WARN("More layers were freed than allocated");
-            }
+            layer_buf_release(layer_drawn->draw_buf);
             LV_LOG_INFO("Layer memory used: %" LV_PRIu32 " kB", get_layer_size_kb(_draw_info.used_memory_for_layers));
-            lv_draw_buf_destroy(layer_drawn->draw_buf);
             layer_drawn->draw_buf = NULL;
         }
 
@@ -681,3 +718,160 @@ static lv_draw_task_t * get_first_available_task(lv_layer_t * layer)
     LV_PROFILER_DRAW_END;
     return t;
 }
+
+/**
+ * Get a buffer for a layer from the pool of the freed layer buffers or allocate a new one
+ * @param layer             the layer whose `buf_area` and `color_format` shall fit into the buffer
+ * @param layer_size_byte   the required buffer size
+ * @return                  the draw buffer or NULL if the allocation failed
+ */
+static lv_draw_buf_t * layer_buf_get(lv_layer_t * layer, uint32_t layer_size_byte)
+{
+    int32_t w = lv_area_get_width(&layer->buf_area);
+    int32_t h = lv_area_get_height(&layer->buf_area);
+    lv_draw_buf_t * draw_buf = NULL;
+
+#if LV_DRAW_LAYER_BUF_POOL_CNT > 0
+    /*Reuse the smallest buffer which is large enough*/
+    uint32_t best = UINT32_MAX;
+    uint32_t i;
+    for(i = 0; i < _draw_info.layer_buf_pool_cnt; i++) {
+        lv_draw_buf_t * pooled = _draw_info.layer_buf_pool[i];
+        if(pooled->data_size < layer_size_byte) continue;
+        if(best == UINT32_MAX || pooled->data_size < _draw_info.layer_buf_pool[best]->data_size) best = i;
+    }
+
+    if(best != UINT32_MAX) {
+        draw_buf = _draw_info.layer_buf_pool[best];
+        _draw_info.layer_buf_pool_cnt--;
+        _draw_info.layer_buf_pool[best] = _draw_info.layer_buf_pool[_draw_info.layer_buf_pool_cnt];
+        _draw_info.pooled_memory_for_layers -= draw_buf->data_size;
+
+        lv_draw_buf_reshape(draw_buf, layer->color_format, w, h, LV_STRIDE_AUTO);
+        draw_buf->header.flags = LV_IMAGE_FLAGS_MODIFIABLE | LV_IMAGE_FLAGS_ALLOCATED;
+        _draw_info.layer_reuse_cnt++;
+    }
+    else {
+        /*None of them is large enough. Free them if they would take the memory of the new one.*/
+        while(_draw_info.layer_buf_pool_cnt > 0 &&
+              (LV_DRAW_LAYER_MAX_MEMORY == 0 ||
+               _draw_info.used_memory_for_layers + _draw_info.pooled_memory_for_layers + layer_size_byte > LV_DRAW_LAYER_MAX_MEMORY)) {
+            _draw_info.layer_buf_pool_cnt--;
+            lv_draw_buf_t * pooled = _draw_info.layer_buf_pool[_draw_info.layer_buf_pool_cnt];
+            _draw_info.pooled_memory_for_layers -= pooled->data_size;
+            lv_draw_buf_destroy(pooled);
+        }
+
+        draw_buf = lv_draw_buf_create(w, h, layer->color_format, 0);
+
+        /*Out of memory: give back all the pooled buffers and try again*/
+        if(draw_buf == NULL && _draw_info.layer_buf_pool_cnt > 0) {
+            while(_draw_info.layer_buf_pool_cnt > 0) {
+                _draw_info.layer_buf_pool_cnt--;
+                lv_draw_buf_destroy(_draw_info.layer_buf_pool[_draw_info.layer_buf_pool_cnt]);
+            }
+            _draw_info.pooled_memory_for_layers = 0;
+            draw_buf = lv_draw_buf_create(w, h, layer->color_format, 0);
+        }
+        if(draw_buf) _draw_info.layer_alloc_cnt++;
+    }
+#else
+    LV_UNUSED(layer_size_byte);
+    draw_buf = lv_draw_buf_create(w, h, layer->color_format, 0);
+    if(draw_buf) _draw_info.layer_alloc_cnt++;
+#endif
+
+    if(draw_buf == NULL) return NULL;
+
+    _draw_info.used_memory_for_layers += draw_buf->data_size;
+    uint32_t total = _draw_info.used_memory_for_layers;
+#if LV_DRAW_LAYER_BUF_POOL_CNT > 0
+    total += _draw_info.pooled_memory_for_layers;
+#endif
+    if(total > _draw_info.peak_memory_for_layers) _draw_info.peak_memory_for_layers = total;
+
+    return draw_buf;
+}
+
+/**
+ * Put the buffer of a drawn layer back to the pool or free it
+ * @param draw_buf      the buffer got from `layer_buf_get()`
+ */
+static void layer_buf_release(lv_draw_buf_t * draw_buf)
+{
+    if(_draw_info.used_memory_for_layers >= draw_buf->data_size) {
+        _draw_info.used_memory_for_layers -= draw_buf->data_size;
+    }
+    else {
+        _draw_info.used_memory_for_layers = 0;
+        LV_LOG_WARN("More layers were freed than allocated");
+    }
+
+#if LV_DRAW_LAYER_BUF_POOL_CNT > 0
+    /*Don't keep it if the limit was exceeded for it*/
+    if(LV_DRAW_LAYER_MAX_MEMORY > 0 &&
+       _draw_info.used_memory_for_layers + _draw_info.pooled_memory_for_layers + draw_buf->data_size >
+       LV_DRAW_LAYER_MAX_MEMORY) {
+        lv_draw_buf_destroy(draw_buf);
+        return;
+    }
+
+    /*If the pool is full keep the larger buffers as the smaller layers fit into them too*/
+    if(_draw_info.layer_buf_pool_cnt == LV_DRAW_LAYER_BUF_POOL_CNT) {
+        uint32_t smallest = 0;
+        uint32_t i;
+        for(i = 1; i < _draw_info.layer_buf_pool_cnt; i++) {
+            if(_draw_info.layer_buf_pool[i]->data_size < _draw_info.layer_buf_pool[smallest]->data_size) smallest = i;
+        }
+
+        lv_draw_buf_t * pooled = _draw_info.layer_buf_pool[smallest];
+        if(pooled->data_size >= draw_buf->data_size) {
+            lv_draw_buf_destroy(draw_buf);
+            return;
+        }
+
+        _draw_info.pooled_memory_for_layers -= pooled->data_size;
+        lv_draw_buf_destroy(pooled);
+        _draw_info.layer_buf_pool_cnt--;
+        _draw_info.layer_buf_pool[smallest] = _draw_info.layer_buf_pool[_draw_info.layer_buf_pool_cnt];
+    }
+
+    _draw_info.layer_buf_pool[_draw_info.layer_buf_pool_cnt] = draw_buf;
+    _draw_info.layer_buf_pool_cnt++;
+    _draw_info.pooled_memory_for_layers += draw_buf->data_size;
+#else
+    lv_draw_buf_destroy(draw_buf);
+#endif
+}
+
+#if LV_DRAW_LAYER_MAX_MEMORY > 0
+
+/**
+ * Check if the allocated layers might need this layer to be finished.
+ * The layers are created in drawing order, so an older layer which is not an ancestor of `layer`
+ * was completely added before `layer` and will be finished and freed without it.
+ * The ancestors and the newer layers might wait for `layer` (directly or by waiting for
+ * a buffer which is used by `layer`'s ancestors), so not allocating `layer` could lock up the rendering.
+ * @param layer     a layer whose buffer doesn't fit into `LV_DRAW_LAYER_MAX_MEMORY`
+ * @return          true: allocate the buffer anyway
+ */
+static bool layer_is_waited_for(lv_layer_t * layer)
+{
+    lv_display_t * disp = lv_refr_get_disp_refreshing();
+    if(disp == NULL) return true;
+
+    lv_layer_t * older = disp->layer_head;
+    while(older && older != layer) {
+        /*The layers without parent (the display's layer and its tiles) are not allocated here*/
+        if(older->parent && older->draw_buf) {
+            lv_layer_t * parent = layer->parent;
+            while(parent && parent != older) parent = parent->parent;
+            if(parent == NULL) return false;
+        }
+        older = older->next;
+    }
+
+    return true;
+}
+
+#endif /*LV_DRAW_LAYER_MAX_MEMORY > 0*/
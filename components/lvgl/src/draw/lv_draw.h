@@ -148,6 +148,17 @@ typedef struct {
     void * user_data;
 } lv_draw_dsc_base_t;
 
+typedef struct {
+    uint32_t used;              /**< Bytes of the layer buffers in use now*/
+    uint32_t pooled;            /**< Bytes of the freed layer buffers kept for reuse*/
+    uint32_t peak;              /**< Max. of `used + pooled` since the last reset*/
+    uint32_t limit;             /**< `LV_DRAW_LAYER_MAX_MEMORY`, 0: no limit*/
+    uint32_t alloc_cnt;         /**< Layer buffers allocated*/
+    uint32_t reuse_cnt;         /**< Layer buffers taken from the pool instead of allocating*/
+    uint32_t wait_cnt;          /**< Allocation attempts postponed until an other layer is freed*/
+    uint32_t over_limit_cnt;    /**< Allocations let over the limit as all the other layers were waiting for them*/
+} lv_draw_layer_mem_info_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -291,6 +302,17 @@ void lv_draw_layer_init(lv_layer_t * layer, lv_layer_t * parent_layer, lv_color_
  */
 void * lv_draw_layer_alloc_buf(lv_layer_t * layer);
 
+/**
+ * Get how much memory the layer buffers use now and used at most
+ * @param info              store the result here
+ */
+void lv_draw_layer_get_mem_info(lv_draw_layer_mem_info_t * info);
+
+/**
+ * Reset the peak and the counters of `lv_draw_layer_get_mem_info()`
+ */
+void lv_draw_layer_reset_mem_info(void);
+
 /**
  * Got to a pixel at X and Y coordinate on a layer
  * @param layer             pointer to a layer
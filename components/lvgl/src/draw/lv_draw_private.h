@@ -180,6 +180,17 @@ typedef struct {
     lv_draw_unit_t * unit_head;
     uint32_t unit_cnt;
     uint32_t used_memory_for_layers; /* measured as bytes */
+    uint32_t peak_memory_for_layers;
+    uint32_t layer_alloc_cnt;
+    uint32_t layer_reuse_cnt;
+    uint32_t layer_wait_cnt;
+    uint32_t layer_over_limit_cnt;
+#if LV_DRAW_LAYER_BUF_POOL_CNT > 0
+    /*Freed layer buffers to reuse for the next layers*/
+    lv_draw_buf_t * layer_buf_pool[LV_DRAW_LAYER_BUF_POOL_CNT];
+    uint32_t layer_buf_pool_cnt;
+    uint32_t pooled_memory_for_layers;
+#endif
 #if LV_USE_OS
     lv_thread_sync_t sync;
 #else
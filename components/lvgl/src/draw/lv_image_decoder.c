@@ -20,6 +20,7 @@
 #define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
 #define img_header_cache_p (LV_GLOBAL_DEFAULT()->img_header_cache)
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
+#define image_cache_stats (LV_GLOBAL_DEFAULT()->image_cache_stats)
 
 /**********************
  *      TYPEDEFS
@@ -97,6 +98,7 @@ lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src
     dsc->src = src;
     dsc->src_type = lv_image_src_get_type(src);
 
+    bool cache_miss = false;
     if(lv_image_cache_is_enabled()) {
         dsc->cache = img_cache_p;
         /*Try cache first, unless we are told to ignore cache.*/
@@ -105,9 +107,13 @@ lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src
             * Check the cache first
             * If the image is found in the cache, just return it.*/
             if(try_cache(dsc) == LV_RESULT_OK) return LV_RESULT_OK;
+            cache_miss = true;
         }
     }
 
+    /*The time to open is the cost of evicting the image from the cache*/
+    uint32_t t_start = lv_image_cache_get_time();
+
     /*Find the decoder that can open the image source, and get the header info in the same time.*/
     dsc->decoder = image_decoder_get_info(dsc, &dsc->header);
     if(dsc->decoder == NULL) return LV_RESULT_INVALID;
@@ -128,6 +134,23 @@ lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src
      * */
     lv_result_t res = dsc->decoder->open_cb(dsc->decoder, dsc);
 
+    if(res == LV_RESULT_OK) {
+        uint32_t t_open = lv_image_cache_get_time() - t_start;
+        if(dsc->time_to_open == 0) dsc->time_to_open = t_open / 1000;
+        /*Only the images the decoder has put in the cache are misses: the others could never hit*/
+        if(cache_miss && dsc->cache_entry) {
+            image_cache_stats.misses++;
+            image_cache_stats.decode_time += t_open;
+            lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(dsc->cache_entry);
+            cached_data->slot.cost = t_open;
+            uint32_t size = (uint32_t)lv_cache_get_size(img_cache_p, NULL);
+            if(size > image_cache_stats.peak_size) image_cache_stats.peak_size = size;
+        }
+        else if(cache_miss) {
+            image_cache_stats.uncached++;
+        }
+    }
+
     if(res == LV_RESULT_OK && dsc->decoded != NULL) {
         LV_ASSERT_MSG(dsc->decoded->unaligned_data && dsc->decoded->handlers, "Invalid draw buffer");
 
@@ -237,6 +260,7 @@ lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
     }
     cached_data->user_data = user_data; /*Need to free data on cache invalidate instead of decoder_close*/
     cached_data->decoder = decoder;
+    cached_data->slot.cost = 0;         /*Measured in `lv_image_decoder_open` when the decoder returns*/
 
     return cache_entry;
 }
@@ -325,9 +349,11 @@ static lv_image_decoder_t * image_decoder_get_info(lv_image_decoder_dsc_t * dsc,
             decoder = cached_data->decoder;
             lv_cache_release(img_header_cache_p, entry, NULL);
 
+            image_cache_stats.header_hits++;
             LV_LOG_TRACE("Found decoder %s in header cache", decoder->name);
             return decoder;
         }
+        image_cache_stats.header_misses++;
     }
 
     if(src_type == LV_IMAGE_SRC_FILE) {
@@ -410,6 +436,8 @@ static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc)
         dsc->decoded = cached_data->decoded;
         dsc->decoder = (lv_image_decoder_t *)cached_data->decoder;
         dsc->cache_entry = entry;     /*Save the cache to release it in decoder_close*/
+        image_cache_stats.hits++;
+        image_cache_stats.saved_time += cached_data->slot.cost;
         return LV_RESULT_OK;
     }
 
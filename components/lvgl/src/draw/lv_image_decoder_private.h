@@ -55,7 +55,7 @@ struct _lv_image_decoder_t {
 };
 
 struct _lv_image_cache_data_t {
-    lv_cache_slot_size_t slot;
+    lv_cache_slot_cost_t slot;  /**< `size`: set by the decoder, `cost`: measured time to open [us]*/
 
     const void * src;
     lv_image_src_t src_type;
@@ -79,6 +79,10 @@ void lv_draw_sw_init(void)
     lv_draw_sw_mask_init();
 #endif
 
+#if LV_DRAW_SW_CACHE_SIZE > 0
+    lv_draw_sw_cache_init();
+#endif
+
     lv_draw_sw_unit_t * draw_sw_unit = lv_draw_create_unit(sizeof(lv_draw_sw_unit_t));
     draw_sw_unit->base_unit.dispatch_cb = dispatch;
     draw_sw_unit->base_unit.evaluate_cb = evaluate;
@@ -121,6 +125,10 @@ void lv_draw_sw_deinit(void)
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_deinit();
 #endif
+
+#if LV_DRAW_SW_CACHE_SIZE > 0
+    lv_draw_sw_cache_deinit();
+#endif
 }
 
 static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
@@ -21,6 +21,7 @@
 #include "../../misc/lv_assert.h"
 #include "../../stdlib/lv_string.h"
 #include "../lv_draw_mask.h"
+#include "lv_draw_sw_cache_private.h"
 
 /*********************
  *      DEFINES
@@ -99,7 +100,34 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
 
     lv_opa_t * sh_buf;
 
-#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+#if LV_DRAW_SW_CACHE_SIZE > 0
+    /*The corner depends on the size of the blurred area only if it's not much larger than the corner*/
+    lv_draw_sw_cache_key_t key;
+    lv_draw_sw_cache_key_init(&key, LV_DRAW_SW_CACHE_TYPE_SHADOW);
+    key.size = corner_size;
+    key.param[0] = dsc->width;
+    key.param[1] = r_sh;
+    key.param[2] = LV_MIN(lv_area_get_width(&core_area), 2 * corner_size);
+    key.param[3] = LV_MIN(lv_area_get_height(&core_area), 2 * corner_size);
+
+    /*A cached corner is used in place until it's mirrored for the left side*/
+    lv_cache_entry_t * sh_entry;
+    sh_buf = (lv_opa_t *)lv_draw_sw_cache_acquire(&key, &sh_entry);
+    if(sh_buf == NULL) {
+        uint32_t sh_buf_size = corner_size * corner_size;
+        /*A larger buffer is required for calculation*/
+        sh_buf = lv_malloc(sh_buf_size * sizeof(uint16_t));
+        LV_ASSERT_MALLOC(sh_buf);
+        shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
+
+        /*Shrink it to the result and add it. The cost: blurring a pixel takes a few times longer than copying it*/
+        lv_opa_t * sh_buf_shrunk = lv_realloc(sh_buf, sh_buf_size);
+        if(sh_buf_shrunk) sh_buf = sh_buf_shrunk;
+        const void * cached = lv_draw_sw_cache_add(&key, sh_buf, sh_buf_size, sh_buf_size * 8, &sh_entry);
+        if(cached) sh_buf = (lv_opa_t *)cached;
+        else sh_entry = NULL;
+    }
+#elif LV_DRAW_SW_SHADOW_CACHE_SIZE
     lv_draw_sw_shadow_cache_t * cache = &shadow_cache;
     if(cache->cache_size == corner_size && cache->cache_r == r_sh) {
         /*Use the cache if available*/
@@ -382,6 +410,23 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
         }
     }
 
+#if LV_DRAW_SW_CACHE_SIZE > 0
+    /*The cached corner is shared, so mirror a copy of it*/
+    if(sh_entry) {
+        lv_opa_t * sh_buf_copy = lv_malloc(corner_size * corner_size);
+        LV_ASSERT_MALLOC(sh_buf_copy);
+        if(sh_buf_copy) lv_memcpy(sh_buf_copy, sh_buf, corner_size * corner_size);
+        lv_draw_sw_cache_release(sh_entry);
+        sh_entry = NULL;
+        sh_buf = sh_buf_copy;
+        if(sh_buf == NULL) {
+            if(!simple) lv_draw_sw_mask_free_param(&mask_rout_param);
+            lv_free(mask_buf);
+            return;
+        }
+    }
+#endif
+
     /*Mirror the shadow corner buffer horizontally*/
     sh_buf_tmp = sh_buf ;
     for(y = 0; y < corner_size; y++) {
@@ -555,7 +600,12 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
     if(!simple) {
         lv_draw_sw_mask_free_param(&mask_rout_param);
     }
+#if LV_DRAW_SW_CACHE_SIZE > 0
+    if(sh_entry) lv_draw_sw_cache_release(sh_entry);
+    else lv_free(sh_buf);
+#else
     lv_free(sh_buf);
+#endif
     lv_free(mask_buf);
 }
 
@@ -0,0 +1,496 @@
+/**
+ * @file lv_draw_sw_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_cache_private.h"
+#if LV_USE_DRAW_SW && LV_DRAW_SW_CACHE_SIZE > 0
+
+#include "../../misc/cache/lv_cache_private.h"
+#include "../../misc/cache/class/lv_cache_gdsf.h"
+#include "../../misc/lv_assert.h"
+#include "../../misc/lv_fs.h"
+#include "../../misc/lv_iter.h"
+#include "../../core/lv_global.h"
+#include "../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CACHE_NAME          "DRAW_SW"
+
+#define draw_sw_cache_p     (LV_GLOBAL_DEFAULT()->draw_sw_cache.cache)
+#define draw_sw_cache_stats (LV_GLOBAL_DEFAULT()->draw_sw_cache.stats)
+
+#define FILE_MAGIC          0x4353564CU     /*"LVSC"*/
+#define FILE_VERSION        1
+#define CHECKSUM_INIT       2166136261U     /*FNV-1a offset basis*/
+
+/*Sanity limit of the side of a saved shadow corner and the length of a gradient map*/
+#define ITEM_SIZE_MAX       4096
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_cache_slot_cost_t slot;      /*First for the GDSF cache class*/
+    lv_draw_sw_cache_key_t key;
+    void * data;
+    uint32_t data_size;
+} lv_draw_sw_cache_data_t;
+
+typedef struct {
+    void * data;
+    uint32_t data_size;
+    bool taken;
+} create_ctx_t;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t key_size;              /*Changes with `LV_GRADIENT_MAX_STOPS`*/
+    uint32_t item_cnt;
+    uint32_t payload_size;          /*The file is not truncated when rewritten, so the end is stored*/
+    uint32_t checksum;              /*FNV-1a of the payload*/
+} file_header_t;
+
+/*Followed by `data_size` bytes of data in the file*/
+typedef struct {
+    lv_draw_sw_cache_key_t key;
+    uint32_t cost;
+    uint32_t data_size;
+} file_item_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_cache_compare_res_t draw_sw_cache_compare_cb(const lv_draw_sw_cache_data_t * lhs,
+                                                       const lv_draw_sw_cache_data_t * rhs);
+static bool draw_sw_cache_create_cb(lv_draw_sw_cache_data_t * data, create_ctx_t * ctx);
+static void draw_sw_cache_free_cb(lv_draw_sw_cache_data_t * data, void * user_data);
+static uint32_t expected_data_size(const lv_draw_sw_cache_key_t * key);
+static uint32_t checksum_update(uint32_t sum, const void * buf, uint32_t len);
+static lv_result_t write_chunk(lv_fs_file_t * f, const void * buf, uint32_t len, uint32_t * sum);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sw_cache_init(void)
+{
+    if(draw_sw_cache_p != NULL) return;
+
+    draw_sw_cache_p = lv_cache_create(&lv_cache_class_gdsf,
+    sizeof(lv_draw_sw_cache_data_t), LV_DRAW_SW_CACHE_SIZE, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) draw_sw_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) draw_sw_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) draw_sw_cache_free_cb,
+    });
+
+    if(draw_sw_cache_p) lv_cache_set_name(draw_sw_cache_p, CACHE_NAME);
+    lv_memzero(&draw_sw_cache_stats, sizeof(lv_draw_sw_cache_stats_t));
+}
+
+void lv_draw_sw_cache_deinit(void)
+{
+    if(draw_sw_cache_p == NULL) return;
+
+    lv_cache_destroy(draw_sw_cache_p, NULL);
+    draw_sw_cache_p = NULL;
+}
+
+void lv_draw_sw_cache_key_init(lv_draw_sw_cache_key_t * key, lv_draw_sw_cache_type_t type)
+{
+    lv_memzero(key, sizeof(lv_draw_sw_cache_key_t));
+    key->type = (uint8_t)type;
+}
+
+const void * lv_draw_sw_cache_acquire(const lv_draw_sw_cache_key_t * key, lv_cache_entry_t ** entry)
+{
+    LV_ASSERT_NULL(key);
+    LV_ASSERT_NULL(entry);
+
+    *entry = NULL;
+    if(draw_sw_cache_p == NULL) return NULL;
+
+    lv_draw_sw_cache_data_t search_key;
+    search_key.key = *key;
+
+    /*The draw units run in parallel: the counters change only under the cache's (recursive) lock*/
+    lv_mutex_lock(&draw_sw_cache_p->lock);
+    lv_cache_entry_t * e = lv_cache_acquire(draw_sw_cache_p, &search_key, NULL);
+    bool grad = key->type == LV_DRAW_SW_CACHE_TYPE_GRAD;
+    if(e == NULL) {
+        if(grad) draw_sw_cache_stats.grad_misses++;
+        else draw_sw_cache_stats.shadow_misses++;
+    }
+    else {
+        if(grad) draw_sw_cache_stats.grad_hits++;
+        else draw_sw_cache_stats.shadow_hits++;
+    }
+    lv_mutex_unlock(&draw_sw_cache_p->lock);
+    if(e == NULL) return NULL;
+
+    *entry = e;
+    lv_draw_sw_cache_data_t * cached = lv_cache_entry_get_data(e);
+    return cached->data;
+}
+
+const void * lv_draw_sw_cache_add(const lv_draw_sw_cache_key_t * key, void * data, uint32_t data_size,
+                                  uint32_t cost, lv_cache_entry_t ** entry)
+{
+    LV_ASSERT_NULL(key);
+    LV_ASSERT_NULL(data);
+    LV_ASSERT_NULL(entry);
+
+    *entry = NULL;
+    if(draw_sw_cache_p == NULL) return NULL;
+
+    lv_draw_sw_cache_data_t search_key;
+    search_key.key = *key;
+    search_key.data = NULL;
+    search_key.data_size = data_size;
+    search_key.slot.size = data_size + sizeof(lv_draw_sw_cache_data_t);
+    search_key.slot.cost = cost;
+
+    create_ctx_t ctx = {
+        .data = data,
+        .data_size = data_size,
+        .taken = false,
+    };
+    lv_cache_entry_t * e = NULL;
+
+    lv_mutex_lock(&draw_sw_cache_p->lock);
+    /*Don't let a single large item flush the whole cache*/
+    if(search_key.slot.size <= lv_cache_get_max_size(draw_sw_cache_p, NULL) / 2) {
+        e = lv_cache_acquire_or_create(draw_sw_cache_p, &search_key, &ctx);
+    }
+    if(e == NULL) draw_sw_cache_stats.bypassed++;
+    else if(ctx.taken) draw_sw_cache_stats.unsaved++;
+    lv_mutex_unlock(&draw_sw_cache_p->lock);
+    if(e == NULL) return NULL;
+
+    /*An other draw unit has added the same item meanwhile*/
+    if(!ctx.taken) lv_free(data);
+
+    *entry = e;
+    lv_draw_sw_cache_data_t * cached = lv_cache_entry_get_data(e);
+    return cached->data;
+}
+
+void lv_draw_sw_cache_release(lv_cache_entry_t * entry)
+{
+    if(entry == NULL) return;
+    lv_cache_release(draw_sw_cache_p, entry, NULL);
+}
+
+void lv_draw_sw_cache_resize(uint32_t new_size, bool evict_now)
+{
+    if(draw_sw_cache_p == NULL) return;
+
+    lv_cache_set_max_size(draw_sw_cache_p, new_size, NULL);
+    if(evict_now) {
+        lv_cache_reserve(draw_sw_cache_p, new_size, NULL);
+    }
+}
+
+void lv_draw_sw_cache_drop_all(void)
+{
+    if(draw_sw_cache_p == NULL) return;
+    lv_cache_drop_all(draw_sw_cache_p, NULL);
+}
+
+lv_result_t lv_draw_sw_cache_save(const char * path)
+{
+    LV_ASSERT_NULL(path);
+    if(draw_sw_cache_p == NULL) return LV_RESULT_INVALID;
+
+    /*Reference every item while the cache is locked so the draw units can't evict them during writing*/
+    lv_mutex_lock(&draw_sw_cache_p->lock);
+
+    uint32_t elem_size = lv_cache_entry_get_size(draw_sw_cache_p->node_size);
+    lv_draw_sw_cache_data_t * elem = lv_malloc(elem_size);
+    lv_iter_t * iter = elem ? lv_cache_iter_create(draw_sw_cache_p) : NULL;
+    uint32_t item_cnt = 0;
+    if(iter) {
+        while(lv_iter_next(iter, elem) == LV_RESULT_OK) item_cnt++;
+        lv_iter_destroy(iter);
+    }
+
+    /*Acquiring reorders the items, so collect the keys first*/
+    lv_draw_sw_cache_data_t * keys = item_cnt ? lv_malloc(item_cnt * sizeof(lv_draw_sw_cache_data_t)) : NULL;
+    lv_cache_entry_t ** entries = item_cnt ? lv_malloc(item_cnt * sizeof(lv_cache_entry_t *)) : NULL;
+    uint32_t acquired_cnt = 0;
+    if(keys && entries) {
+        uint32_t key_cnt = 0;
+        iter = lv_cache_iter_create(draw_sw_cache_p);
+        while(iter && key_cnt < item_cnt && lv_iter_next(iter, elem) == LV_RESULT_OK) {
+            keys[key_cnt++] = *elem;
+        }
+        if(iter) lv_iter_destroy(iter);
+
+        uint32_t i;
+        for(i = 0; i < key_cnt; i++) {
+            /*The lock is recursive*/
+            lv_cache_entry_t * e = lv_cache_acquire(draw_sw_cache_p, &keys[i], NULL);
+            if(e) entries[acquired_cnt++] = e;
+        }
+    }
+
+    lv_mutex_unlock(&draw_sw_cache_p->lock);
+
+    bool out_of_mem = item_cnt > 0 && (keys == NULL || entries == NULL);
+    lv_free(elem);
+    lv_free(keys);
+    if(out_of_mem) {
+        lv_free(entries);
+        LV_LOG_WARN("Out of memory");
+        return LV_RESULT_INVALID;
+    }
+
+    lv_fs_file_t f;
+    lv_fs_res_t fs_res = lv_fs_open(&f, path, LV_FS_MODE_WR);
+    lv_result_t res = fs_res == LV_FS_RES_OK ? LV_RESULT_OK : LV_RESULT_INVALID;
+    if(res != LV_RESULT_OK) LV_LOG_WARN("Can't open %s (%d)", path, fs_res);
+
+    /*Write the header with an invalid checksum first and fix it at the end*/
+    file_header_t header;
+    lv_memzero(&header, sizeof(header));
+    if(res == LV_RESULT_OK) res = write_chunk(&f, &header, sizeof(header), NULL);
+
+    uint32_t payload_size = 0;
+    uint32_t checksum = CHECKSUM_INIT;
+    uint32_t i;
+    for(i = 0; i < acquired_cnt && res == LV_RESULT_OK; i++) {
+        lv_draw_sw_cache_data_t * cached = lv_cache_entry_get_data(entries[i]);
+        file_item_t item;
+        item.key = cached->key;
+        item.cost = cached->slot.cost;
+        item.data_size = cached->data_size;
+        res = write_chunk(&f, &item, sizeof(item), &checksum);
+        if(res == LV_RESULT_OK) res = write_chunk(&f, cached->data, cached->data_size, &checksum);
+        payload_size += sizeof(item) + cached->data_size;
+    }
+
+    for(i = 0; i < acquired_cnt; i++) {
+        lv_cache_release(draw_sw_cache_p, entries[i], NULL);
+    }
+    lv_free(entries);
+
+    if(res == LV_RESULT_OK) {
+        header.magic = FILE_MAGIC;
+        header.version = FILE_VERSION;
+        header.key_size = sizeof(lv_draw_sw_cache_key_t);
+        header.item_cnt = acquired_cnt;
+        header.payload_size = payload_size;
+        header.checksum = checksum;
+        if(lv_fs_seek(&f, 0, LV_FS_SEEK_SET) != LV_FS_RES_OK) res = LV_RESULT_INVALID;
+        else res = write_chunk(&f, &header, sizeof(header), NULL);
+    }
+
+    if(fs_res == LV_FS_RES_OK) lv_fs_close(&f);
+
+    if(res == LV_RESULT_OK) {
+        lv_mutex_lock(&draw_sw_cache_p->lock);
+        draw_sw_cache_stats.saved = acquired_cnt;
+        draw_sw_cache_stats.unsaved = 0;
+        lv_mutex_unlock(&draw_sw_cache_p->lock);
+        LV_LOG_INFO("%" LV_PRIu32 " items (%" LV_PRIu32 " bytes) saved to %s", acquired_cnt, payload_size, path);
+    }
+    else {
+        LV_LOG_WARN("Couldn't write %s", path);
+    }
+
+    return res;
+}
+
+lv_result_t lv_draw_sw_cache_load(const char * path)
+{
+    LV_ASSERT_NULL(path);
+    if(draw_sw_cache_p == NULL) return LV_RESULT_INVALID;
+
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        LV_LOG_INFO("No saved items in %s", path);
+        return LV_RESULT_INVALID;
+    }
+
+    file_header_t header;
+    uint32_t br = 0;
+    lv_fs_res_t fs_res = lv_fs_read(&f, &header, sizeof(header), &br);
+    uint32_t max_size = (uint32_t)lv_cache_get_max_size(draw_sw_cache_p, NULL);
+    if(fs_res != LV_FS_RES_OK || br != sizeof(header) || header.magic != FILE_MAGIC ||
+       header.version != FILE_VERSION || header.key_size != sizeof(lv_draw_sw_cache_key_t) ||
+       header.payload_size > 2 * max_size) {
+        LV_LOG_WARN("%s is not usable", path);
+        lv_fs_close(&f);
+        return LV_RESULT_INVALID;
+    }
+
+    uint8_t * payload = header.payload_size ? lv_malloc(header.payload_size) : NULL;
+    if(header.payload_size && payload == NULL) {
+        LV_LOG_WARN("Out of memory");
+        lv_fs_close(&f);
+        return LV_RESULT_INVALID;
+    }
+
+    br = 0;
+    if(payload) fs_res = lv_fs_read(&f, payload, header.payload_size, &br);
+    lv_fs_close(&f);
+
+    if(fs_res != LV_FS_RES_OK || br != header.payload_size ||
+       checksum_update(CHECKSUM_INIT, payload, header.payload_size) != header.checksum) {
+        LV_LOG_WARN("%s is damaged", path);
+        lv_free(payload);
+        return LV_RESULT_INVALID;
+    }
+
+    uint32_t loaded_cnt = 0;
+    lv_mutex_lock(&draw_sw_cache_p->lock);
+    uint32_t unsaved = draw_sw_cache_stats.unsaved;
+    lv_mutex_unlock(&draw_sw_cache_p->lock);
+    uint32_t ofs = 0;
+    uint32_t i;
+    for(i = 0; i < header.item_cnt; i++) {
+        file_item_t item;
+        if(ofs + sizeof(item) > header.payload_size) break;
+        lv_memcpy(&item, payload + ofs, sizeof(item));
+        ofs += sizeof(item);
+
+        uint32_t data_size = expected_data_size(&item.key);
+        if(data_size == 0 || item.data_size != data_size || ofs + data_size > header.payload_size) break;
+
+        void * data = lv_malloc(item.data_size);
+        if(data == NULL) break;
+        lv_memcpy(data, payload + ofs, item.data_size);
+        ofs += item.data_size;
+
+        lv_cache_entry_t * entry;
+        if(lv_draw_sw_cache_add(&item.key, data, item.data_size, item.cost, &entry) == NULL) {
+            lv_free(data);
+            continue;
+        }
+        lv_draw_sw_cache_release(entry);
+        loaded_cnt++;
+    }
+    lv_free(payload);
+
+    lv_mutex_lock(&draw_sw_cache_p->lock);
+    draw_sw_cache_stats.loaded = loaded_cnt;
+    draw_sw_cache_stats.unsaved = unsaved;    /*The loaded items are already in the file*/
+    lv_mutex_unlock(&draw_sw_cache_p->lock);
+    LV_LOG_INFO("%" LV_PRIu32 " items loaded from %s", loaded_cnt, path);
+
+    return LV_RESULT_OK;
+}
+
+void lv_draw_sw_cache_get_stats(lv_draw_sw_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+
+    if(draw_sw_cache_p == NULL) {
+        lv_memzero(stats, sizeof(lv_draw_sw_cache_stats_t));
+        return;
+    }
+
+    lv_mutex_lock(&draw_sw_cache_p->lock);
+    *stats = draw_sw_cache_stats;
+    stats->size = (uint32_t)lv_cache_get_size(draw_sw_cache_p, NULL);
+    stats->max_size = (uint32_t)lv_cache_get_max_size(draw_sw_cache_p, NULL);
+    lv_mutex_unlock(&draw_sw_cache_p->lock);
+}
+
+void lv_draw_sw_cache_reset_stats(void)
+{
+    if(draw_sw_cache_p == NULL) return;
+
+    lv_mutex_lock(&draw_sw_cache_p->lock);
+    lv_draw_sw_cache_stats_t * stats = &draw_sw_cache_stats;
+    stats->grad_hits = 0;
+    stats->grad_misses = 0;
+    stats->shadow_hits = 0;
+    stats->shadow_misses = 0;
+    stats->bypassed = 0;
+    stats->evictions = 0;
+    lv_mutex_unlock(&draw_sw_cache_p->lock);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_cache_compare_res_t draw_sw_cache_compare_cb(const lv_draw_sw_cache_data_t * lhs,
+                                                       const lv_draw_sw_cache_data_t * rhs)
+{
+    int32_t cmp_res = lv_memcmp(&lhs->key, &rhs->key, sizeof(lv_draw_sw_cache_key_t));
+    if(cmp_res != 0) return cmp_res > 0 ? 1 : -1;
+    return 0;
+}
+
+static bool draw_sw_cache_create_cb(lv_draw_sw_cache_data_t * data, create_ctx_t * ctx)
+{
+    /*The item is calculated before adding, just take it over*/
+    data->data = ctx->data;
+    data->data_size = ctx->data_size;
+    ctx->taken = true;
+    return true;
+}
+
+static void draw_sw_cache_free_cb(lv_draw_sw_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    if(data->data == NULL) return;
+
+    lv_free(data->data);
+    data->data = NULL;
+    draw_sw_cache_stats.evictions++;    /*Called with the cache locked*/
+}
+
+static uint32_t expected_data_size(const lv_draw_sw_cache_key_t * key)
+{
+    if(key->size <= 0 || key->size > ITEM_SIZE_MAX) return 0;
+
+    switch(key->type) {
+        case LV_DRAW_SW_CACHE_TYPE_GRAD:
+            if(key->stops_count == 0 || key->stops_count > LV_GRADIENT_MAX_STOPS) return 0;
+            return key->size * (sizeof(lv_color_t) + sizeof(lv_opa_t));
+        case LV_DRAW_SW_CACHE_TYPE_SHADOW:
+            return key->size * key->size;
+        default:
+            return 0;
+    }
+}
+
+static uint32_t checksum_update(uint32_t sum, const void * buf, uint32_t len)
+{
+    const uint8_t * p = buf;
+    uint32_t i;
+    for(i = 0; i < len; i++) {
+        sum ^= p[i];
+        sum *= 16777619U;
+    }
+    return sum;
+}
+
+static lv_result_t write_chunk(lv_fs_file_t * f, const void * buf, uint32_t len, uint32_t * sum)
+{
+    uint32_t bw = 0;
+    if(lv_fs_write(f, buf, len, &bw) != LV_FS_RES_OK || bw != len) return LV_RESULT_INVALID;
+    if(sum) *sum = checksum_update(*sum, buf, len);
+    return LV_RESULT_OK;
+}
+
+#endif /*LV_USE_DRAW_SW && LV_DRAW_SW_CACHE_SIZE > 0*/
@@ -0,0 +1,97 @@
+/**
+ * @file lv_draw_sw_cache.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_CACHE_H
+#define LV_DRAW_SW_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../misc/lv_types.h"
+
+#if LV_USE_DRAW_SW && LV_DRAW_SW_CACHE_SIZE > 0
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t grad_hits;         /**< Gradient color maps served from the cache*/
+    uint32_t grad_misses;       /**< Gradient color maps calculated*/
+    uint32_t shadow_hits;       /**< Blurred shadow corners served from the cache*/
+    uint32_t shadow_misses;     /**< Blurred shadow corners calculated*/
+    uint32_t bypassed;          /**< Calculated items which were not added (cache disabled or item too large)*/
+    uint32_t evictions;         /**< Items removed to make room or dropped*/
+    uint32_t loaded;            /**< Items added by the last `lv_draw_sw_cache_load()`*/
+    uint32_t saved;             /**< Items written by the last `lv_draw_sw_cache_save()`*/
+    uint32_t unsaved;           /**< Items calculated since the last save or load*/
+    uint32_t size;              /**< Bytes in the cache now*/
+    uint32_t max_size;          /**< The budget set by `LV_DRAW_SW_CACHE_SIZE` or `lv_draw_sw_cache_resize()`*/
+} lv_draw_sw_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Resize the cache of the gradient color maps and blurred shadow corners.
+ * @param new_size  new size of the cache in bytes. 0 disables the cache.
+ * @param evict_now true: evict the items above the new size now, false: on the next addition.
+ */
+void lv_draw_sw_cache_resize(uint32_t new_size, bool evict_now);
+
+/**
+ * Drop all the cached gradient color maps and shadow corners.
+ */
+void lv_draw_sw_cache_drop_all(void);
+
+/**
+ * Write the cached items to a file to preload them with `lv_draw_sw_cache_load()` on the next boot.
+ * Can be called from any thread, the items are referenced while they are written.
+ * @param path      path of the file, e.g. "L:/draw_cache.bin"
+ * @return          LV_RESULT_OK: saved; LV_RESULT_INVALID: the file couldn't be written
+ */
+lv_result_t lv_draw_sw_cache_save(const char * path);
+
+/**
+ * Add the items saved by `lv_draw_sw_cache_save()` to the cache.
+ * Files written by an other LVGL configuration or damaged ones are ignored.
+ * @param path      path of the file
+ * @return          LV_RESULT_OK: loaded; LV_RESULT_INVALID: no usable file
+ */
+lv_result_t lv_draw_sw_cache_load(const char * path);
+
+/**
+ * Get the statistics of the cache.
+ * The counters are updated under the cache's lock, so they are exact with parallel draw units too.
+ * If the cache couldn't be created everything is 0.
+ * @param stats     pointer to a structure to fill
+ */
+void lv_draw_sw_cache_get_stats(lv_draw_sw_cache_stats_t * stats);
+
+/**
+ * Reset the hit/miss/bypass/eviction counters of the cache.
+ */
+void lv_draw_sw_cache_reset_stats(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_SW && LV_DRAW_SW_CACHE_SIZE > 0*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_CACHE_H*/
@@ -0,0 +1,113 @@
+/**
+ * @file lv_draw_sw_cache_private.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_CACHE_PRIVATE_H
+#define LV_DRAW_SW_CACHE_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_draw_sw_cache.h"
+
+#if LV_USE_DRAW_SW && LV_DRAW_SW_CACHE_SIZE > 0
+
+#include "../../misc/lv_grad.h"
+#include "../../misc/cache/lv_cache.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    LV_DRAW_SW_CACHE_TYPE_GRAD = 1,     /**< `lv_color_t` map followed by an `lv_opa_t` map of a gradient*/
+    LV_DRAW_SW_CACHE_TYPE_SHADOW,       /**< `lv_opa_t` map of a blurred shadow corner*/
+} lv_draw_sw_cache_type_t;
+
+/**
+ * Key of a cached item. It's compared and saved byte by byte,
+ * so always prepare it with `lv_draw_sw_cache_key_init()`.
+ */
+typedef struct {
+    uint8_t type;                               /**< An `lv_draw_sw_cache_type_t`*/
+    uint8_t stops_count;                        /**< Gradient: number of used stops*/
+    uint16_t reserved;
+    int32_t size;                               /**< Gradient: length of the maps; shadow: side of the corner*/
+    int32_t param[4];                           /**< Shadow: width, radius, clamped width and height of the blurred area*/
+    lv_grad_stop_t stops[LV_GRADIENT_MAX_STOPS];    /**< Gradient: the used stops, the others are zero*/
+} lv_draw_sw_cache_key_t;
+
+typedef struct {
+    lv_cache_t * cache;
+    lv_draw_sw_cache_stats_t stats;
+} lv_draw_sw_cache_state_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create the cache with `LV_DRAW_SW_CACHE_SIZE`. Called by `lv_draw_sw_init()`.
+ */
+void lv_draw_sw_cache_init(void);
+
+/**
+ * Free all the cached items and the cache. Called by `lv_draw_sw_deinit()`.
+ */
+void lv_draw_sw_cache_deinit(void);
+
+/**
+ * Zero a key and set its type.
+ * @param key       pointer to a key to prepare
+ * @param type      type of the item
+ */
+void lv_draw_sw_cache_key_init(lv_draw_sw_cache_key_t * key, lv_draw_sw_cache_type_t type);
+
+/**
+ * Look up an item. On a hit the item is referenced until `lv_draw_sw_cache_release()`.
+ * @param key       the key of the item
+ * @param entry     set to the entry to release on a hit
+ * @return          the cached data or NULL on a miss
+ */
+const void * lv_draw_sw_cache_acquire(const lv_draw_sw_cache_key_t * key, lv_cache_entry_t ** entry);
+
+/**
+ * Add a calculated item. The data is calculated outside of the cache lock,
+ * so an other draw unit might have added the same item meanwhile: then that one is returned and `data` is freed.
+ * @param key       the key of the item
+ * @param data      the calculated data allocated with `lv_malloc()`. The cache takes it over on success.
+ * @param data_size size of `data` in bytes
+ * @param cost      estimated work to calculate the item again, compared only to the cost of the other items
+ * @param entry     set to the entry to release on success
+ * @return          the cached data or NULL if the item wasn't added (`data` is still owned by the caller)
+ */
+const void * lv_draw_sw_cache_add(const lv_draw_sw_cache_key_t * key, void * data, uint32_t data_size,
+                                  uint32_t cost, lv_cache_entry_t ** entry);
+
+/**
+ * Release an item got with `lv_draw_sw_cache_acquire()` or `lv_draw_sw_cache_add()`.
+ * @param entry     the entry of the item
+ */
+void lv_draw_sw_cache_release(lv_cache_entry_t * entry);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_SW && LV_DRAW_SW_CACHE_SIZE > 0*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_CACHE_PRIVATE_H*/
@@ -12,6 +12,7 @@
 #include "../../misc/lv_types.h"
 #include "../../osal/lv_os.h"
 #include "../../misc/lv_math.h"
+#include "lv_draw_sw_cache_private.h"
 
 /*********************
  *      DEFINES
@@ -74,10 +75,16 @@ typedef struct {
  **********************/
 typedef lv_result_t (*op_cache_t)(lv_draw_sw_grad_calc_t * c, void * ctx);
 static lv_draw_sw_grad_calc_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h);
+static lv_draw_sw_grad_calc_t * allocate_item_size(int32_t size);
+static void fill_item(const lv_grad_dsc_t * g, lv_draw_sw_grad_calc_t * item);
+#if LV_DRAW_SW_CACHE_SIZE > 0
+    static lv_draw_sw_grad_calc_t * get_cached_item(const lv_grad_dsc_t * g, int32_t size);
+#endif
 
 #if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
 
     static inline int32_t extend_w(int32_t w, lv_grad_extend_t extend);
+    static lv_draw_sw_grad_calc_t * get_color_table(const lv_grad_dsc_t * dsc);
 
 #endif
 
@@ -106,6 +113,11 @@ static lv_draw_sw_grad_calc_t * allocate_item(const lv_grad_dsc_t * g, int32_t w
             size = 64;
     }
 
+    return allocate_item_size(size);
+}
+
+static lv_draw_sw_grad_calc_t * allocate_item_size(int32_t size)
+{
     size_t req_size = ALIGN(sizeof(lv_draw_sw_grad_calc_t)) + ALIGN(size * sizeof(lv_color_t)) + ALIGN(size * sizeof(
                                                                                                            lv_opa_t));
     lv_draw_sw_grad_calc_t * item  = lv_malloc(req_size);
@@ -116,9 +128,82 @@ static lv_draw_sw_grad_calc_t * allocate_item(const lv_grad_dsc_t * g, int32_t w
     item->color_map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
     item->opa_map = (lv_opa_t *)(p + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_color_t)));
     item->size = size;
+    item->entry = NULL;
     return item;
 }
 
+static void fill_item(const lv_grad_dsc_t * g, lv_draw_sw_grad_calc_t * item)
+{
+    uint32_t i;
+    for(i = 0; i < item->size; i++) {
+        lv_draw_sw_grad_color_calculate(g, item->size, i, &item->color_map[i], &item->opa_map[i]);
+    }
+}
+
+#if LV_DRAW_SW_CACHE_SIZE > 0
+
+/**
+ * Get the color and opa maps of a gradient from the draw SW cache or calculate and add them.
+ * The maps depend only on the stops and the size, so e.g. all the horizontal gradients
+ * with the same stops and width share them.
+ * @return      the item (read only if it's in the cache) or NULL if the gradient can't be cached
+ */
+static lv_draw_sw_grad_calc_t * get_cached_item(const lv_grad_dsc_t * g, int32_t size)
+{
+    if(size <= 0 || g->stops_count == 0 || g->stops_count > LV_GRADIENT_MAX_STOPS) return NULL;
+
+    lv_draw_sw_cache_key_t key;
+    lv_draw_sw_cache_key_init(&key, LV_DRAW_SW_CACHE_TYPE_GRAD);
+    key.size = size;
+    key.stops_count = g->stops_count;
+    lv_memcpy(key.stops, g->stops, g->stops_count * sizeof(lv_grad_stop_t));
+
+    /*The color map is followed by the opa map*/
+    uint32_t data_size = size * (sizeof(lv_color_t) + sizeof(lv_opa_t));
+    lv_cache_entry_t * entry;
+    const uint8_t * data = lv_draw_sw_cache_acquire(&key, &entry);
+    if(data == NULL) {
+        /*Calculate a normal item and add a copy of its maps.
+         *If it can't be added the normal item is used.*/
+        lv_draw_sw_grad_calc_t * item = allocate_item_size(size);
+        if(item == NULL) return NULL;
+        fill_item(g, item);
+
+        uint8_t * new_data = lv_malloc(data_size);
+        if(new_data == NULL) return item;
+        lv_memcpy(new_data, item->color_map, size * sizeof(lv_color_t));
+        lv_memcpy(new_data + size * sizeof(lv_color_t), item->opa_map, size * sizeof(lv_opa_t));
+
+        /*The cost: calculating a value takes about as long as copying a few of them*/
+        data = lv_draw_sw_cache_add(&key, new_data, data_size, data_size * 2, &entry);
+        if(data == NULL) {
+            lv_free(new_data);
+            return item;
+        }
+
+        /*Use the descriptor of the normal item for the cached maps*/
+        item->color_map = (lv_color_t *)data;
+        item->opa_map = (lv_opa_t *)(data + size * sizeof(lv_color_t));
+        item->entry = entry;
+        return item;
+    }
+
+    lv_draw_sw_grad_calc_t * item = lv_malloc(sizeof(lv_draw_sw_grad_calc_t));
+    LV_ASSERT_MALLOC(item);
+    if(item == NULL) {
+        lv_draw_sw_cache_release(entry);
+        return NULL;
+    }
+
+    item->color_map = (lv_color_t *)data;
+    item->opa_map = (lv_opa_t *)(data + size * sizeof(lv_color_t));
+    item->size = size;
+    item->entry = entry;
+    return item;
+}
+
+#endif /*LV_DRAW_SW_CACHE_SIZE > 0*/
+
 #if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
 
 static inline int32_t extend_w(int32_t w, lv_grad_extend_t extend)
@@ -136,6 +221,18 @@ static inline int32_t extend_w(int32_t w, lv_grad_extend_t extend)
     return w;
 }
 
+/**
+ * Get the 256 element color map of a complex gradient which is indexed while rendering.
+ */
+static lv_draw_sw_grad_calc_t * get_color_table(const lv_grad_dsc_t * dsc)
+{
+#if LV_DRAW_SW_CACHE_SIZE > 0
+    lv_draw_sw_grad_calc_t * cached = get_cached_item(dsc, 256);
+    if(cached) return cached;
+#endif
+    return lv_draw_sw_grad_get(dsc, 256, 0);
+}
+
 #endif
 
 /**********************
@@ -147,7 +244,16 @@ lv_draw_sw_grad_calc_t * lv_draw_sw_grad_get(const lv_grad_dsc_t * g, int32_t w,
     /* No gradient, no cache */
     if(g->dir == LV_GRAD_DIR_NONE) return NULL;
 
-    /* Step 1: Search cache for the given key */
+#if LV_DRAW_SW_CACHE_SIZE > 0
+    /* Step 1: Search cache for the given key.
+     * The maps of the complex gradients are written by the renderer, so those are not cached. */
+    if(g->dir == LV_GRAD_DIR_HOR || g->dir == LV_GRAD_DIR_VER) {
+        lv_draw_sw_grad_calc_t * cached = get_cached_item(g, g->dir == LV_GRAD_DIR_HOR ? w : h);
+        if(cached) return cached;
+    }
+#endif
+
+    /* Step 2: Allocate a new item */
     lv_draw_sw_grad_calc_t * item = allocate_item(g, w, h);
     if(item == NULL) {
         LV_LOG_WARN("Failed to allocate item for the gradient");
@@ -155,10 +261,7 @@ lv_draw_sw_grad_calc_t * lv_draw_sw_grad_get(const lv_grad_dsc_t * g, int32_t w,
     }
 
     /* Step 3: Fill it with the gradient, as expected */
-    uint32_t i;
-    for(i = 0; i < item->size; i++) {
-        lv_draw_sw_grad_color_calculate(g, item->size, i, &item->color_map[i], &item->opa_map[i]);
-    }
+    fill_item(g, item);
     return item;
 }
 
@@ -217,6 +320,10 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_grad_color_calculate(const lv_grad_dsc_t *
 
 void lv_draw_sw_grad_cleanup(lv_draw_sw_grad_calc_t * grad)
 {
+#if LV_DRAW_SW_CACHE_SIZE > 0
+    /*The maps are in the cache, only the descriptor was allocated*/
+    if(grad->entry) lv_draw_sw_cache_release(grad->entry);
+#endif
     lv_free(grad);
 }
 
@@ -295,7 +402,7 @@ void lv_draw_sw_grad_radial_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords)
     LV_ASSERT(r_end != 0);
 
     /* Create gradient color map */
-    state->cgrad = lv_draw_sw_grad_get(dsc, 256, 0);
+    state->cgrad = get_color_table(dsc);
 
     state->x0 = start.x;
     state->y0 = start.y;
@@ -464,7 +571,7 @@ void lv_draw_sw_grad_linear_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords)
     dsc->state = state;
 
     /* Create gradient color map */
-    state->cgrad = lv_draw_sw_grad_get(dsc, 256, 0);
+    state->cgrad = get_color_table(dsc);
 
     /* Convert from percentage coordinates */
     int32_t wdt = lv_area_get_width(coords);
@@ -492,7 +599,7 @@ void lv_draw_sw_grad_linear_cleanup(lv_grad_dsc_t * dsc)
     if(state == NULL)
         return;
     if(state->cgrad)
-        lv_free(state->cgrad);
+        lv_draw_sw_grad_cleanup(state->cgrad);
     lv_free(state);
 }
 
@@ -539,7 +646,7 @@ void lv_draw_sw_grad_conical_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords
     dsc->state = state;
 
     /* Create gradient color map */
-    state->cgrad = lv_draw_sw_grad_get(dsc, 256, 0);
+    state->cgrad = get_color_table(dsc);
 
     /* Convert from percentage coordinates */
     int32_t wdt = lv_area_get_width(coords);
@@ -564,7 +671,7 @@ void lv_draw_sw_grad_conical_cleanup(lv_grad_dsc_t * dsc)
     if(state == NULL)
         return;
     if(state->cgrad)
-        lv_free(state->cgrad);
+        lv_draw_sw_grad_cleanup(state->cgrad);
     lv_free(state);
 }
 
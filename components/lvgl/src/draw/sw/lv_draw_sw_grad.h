@@ -30,6 +30,7 @@ typedef struct {
     lv_color_t   *  color_map;
     lv_opa_t   *  opa_map;
     uint32_t size;
+    lv_cache_entry_t * entry;   /**< Not NULL if the maps are in the draw SW cache (read only)*/
 } lv_draw_sw_grad_calc_t;
 
 
@@ -83,6 +83,18 @@ static void transform_and_recolor(lv_draw_task_t * t, const lv_draw_image_dsc_t
                                   const lv_image_decoder_dsc_t * decoder_dsc, lv_draw_image_sup_t * sup,
                                   const lv_area_t * img_coords, const lv_area_t * clipped_img_area);
 
+#if LV_DRAW_SW_RIGHT_ANGLE_ROTATION
+static bool is_right_angle_rotation(const lv_draw_image_dsc_t * draw_dsc, lv_color_format_t cf);
+
+static void rotate_right_angle(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_dsc,
+                               const lv_image_decoder_dsc_t * decoder_dsc,
+                               const lv_area_t * img_coords, const lv_area_t * clipped_img_area);
+
+static void LV_ATTRIBUTE_FAST_MEM rotate_right_angle_area(const lv_area_t * dest_area, const uint8_t * src_buf,
+                                                          int32_t src_stride, uint32_t px_size, int32_t rotation,
+                                                          const lv_point_t * pivot, uint8_t * dest_buf);
+#endif /*LV_DRAW_SW_RIGHT_ANGLE_ROTATION*/
+
 static void recolor(lv_area_t relative_area, uint8_t * src_buf, uint8_t * dest_buf, int32_t src_stride,
                     lv_color_format_t cf, const lv_draw_image_dsc_t * draw_dsc);
 
@@ -274,7 +286,8 @@ static void img_draw_core(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_d
         blend_dsc.src_color_format = cf;
         lv_draw_sw_blend(t, &blend_dsc);
     }
-    /*The simplest case just copy the pixels into the draw_buf. Blending will convert the colors if needed*/
+    /*The simplest case just copy the pixels into the draw_buf. Blending will convert the colors if needed.
+     *Opaque images of the same color format as the layer are copied row by row with `lv_memcpy`*/
     else if(!transformed && !radius && draw_dsc->recolor_opa <= LV_OPA_MIN) {
         blend_dsc.src_area = img_coords;
         blend_dsc.src_buf = src_buf;
@@ -300,8 +313,17 @@ static void img_draw_core(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_d
                                                   clipped_img_area, /* blend area */
                                                   t,                /* target buffer, buffer width, buffer height, buffer stride */
                                                   draw_dsc)) {      /* opa, recolour_opa and colour */
+#if LV_DRAW_SW_RIGHT_ANGLE_ROTATION
+        /*Rotating by 90, 180 or 270 degrees only moves the pixels, no need to interpolate*/
+        if(transformed && is_right_angle_rotation(draw_dsc, cf)) {
+            rotate_right_angle(t, draw_dsc, decoder_dsc, img_coords, clipped_img_area);
+        }
         /*In the other cases every pixel need to be checked one-by-one*/
-        transform_and_recolor(t, draw_dsc, decoder_dsc, sup, img_coords, clipped_img_area);
+        else
+#endif /*LV_DRAW_SW_RIGHT_ANGLE_ROTATION*/
+        {
+            transform_and_recolor(t, draw_dsc, decoder_dsc, sup, img_coords, clipped_img_area);
+        }
 
     }
 }
@@ -557,6 +579,186 @@ static void transform_and_recolor(lv_draw_task_t * t, const lv_draw_image_dsc_t
     lv_free(transformed_buf);
 }
 
+#if LV_DRAW_SW_RIGHT_ANGLE_ROTATION
+static bool is_right_angle_rotation(const lv_draw_image_dsc_t * draw_dsc, lv_color_format_t cf)
+{
+    if(draw_dsc->scale_x != LV_SCALE_NONE || draw_dsc->scale_y != LV_SCALE_NONE) return false;
+    if(draw_dsc->rotation != 900 && draw_dsc->rotation != 1800 && draw_dsc->rotation != 2700) return false;
+    if(draw_dsc->clip_radius > 0 || draw_dsc->recolor_opa > LV_OPA_MIN) return false;
+
+    /*Only the formats which can be blended as they are, without a separate alpha map*/
+    switch(cf) {
+        case LV_COLOR_FORMAT_RGB565:
+        case LV_COLOR_FORMAT_RGB565_SWAPPED:
+        case LV_COLOR_FORMAT_RGB888:
+        case LV_COLOR_FORMAT_XRGB8888:
+        case LV_COLOR_FORMAT_ARGB8888:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void rotate_right_angle(lv_draw_task_t * t, const lv_draw_image_dsc_t * draw_dsc,
+                               const lv_image_decoder_dsc_t * decoder_dsc,
+                               const lv_area_t * img_coords, const lv_area_t * clipped_img_area)
+{
+    const lv_draw_buf_t * decoded = decoder_dsc->decoded;
+    uint32_t img_stride = decoded->header.stride;
+    lv_color_format_t cf = decoded->header.cf;
+    uint32_t px_size = lv_color_format_get_size(cf);
+    const lv_point_t * pivot = &draw_dsc->pivot;
+
+    int32_t src_w = lv_area_get_width(img_coords);
+    int32_t src_h = lv_area_get_height(img_coords);
+
+    /*The rotated image relative to `img_coords`. Every pixel of it comes from exactly one source pixel
+     *so there are no partially covered pixels on the edges*/
+    lv_area_t rotated_area;
+    if(draw_dsc->rotation == 900) {
+        rotated_area.x1 = pivot->x + pivot->y - (src_h - 1);
+        rotated_area.x2 = pivot->x + pivot->y;
+        rotated_area.y1 = pivot->y - pivot->x;
+        rotated_area.y2 = pivot->y - pivot->x + (src_w - 1);
+    }
+    else if(draw_dsc->rotation == 1800) {
+        rotated_area.x1 = 2 * pivot->x - (src_w - 1);
+        rotated_area.x2 = 2 * pivot->x;
+        rotated_area.y1 = 2 * pivot->y - (src_h - 1);
+        rotated_area.y2 = 2 * pivot->y;
+    }
+    else {
+        rotated_area.x1 = pivot->x - pivot->y;
+        rotated_area.x2 = pivot->x - pivot->y + (src_h - 1);
+        rotated_area.y1 = pivot->x + pivot->y - (src_w - 1);
+        rotated_area.y2 = pivot->x + pivot->y;
+    }
+    lv_area_move(&rotated_area, img_coords->x1, img_coords->y1);
+
+    lv_area_t blend_area;
+    if(!lv_area_intersect(&blend_area, clipped_img_area, &rotated_area)) return;
+
+    /*Not all layer formats can be blended from RGB565_SWAPPED so swap the pixels back if needed*/
+    bool swap = cf == LV_COLOR_FORMAT_RGB565_SWAPPED &&
+                t->target_layer->color_format != LV_COLOR_FORMAT_RGB565_SWAPPED;
+
+    int32_t blend_w = lv_area_get_width(&blend_area);
+    int32_t blend_h = lv_area_get_height(&blend_area);
+    uint32_t buf_stride = blend_w * px_size;
+    int32_t buf_h = MAX_BUF_SIZE / buf_stride;
+    if(buf_h < 1) buf_h = 1;
+    if(buf_h > blend_h) buf_h = blend_h;
+    uint8_t * rotated_buf = lv_malloc(buf_stride * buf_h);
+    LV_ASSERT_MALLOC(rotated_buf);
+    if(rotated_buf == NULL) return;
+
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memzero(&blend_dsc, sizeof(lv_draw_sw_blend_dsc_t));
+    blend_dsc.opa = draw_dsc->opa;
+    blend_dsc.blend_mode = draw_dsc->blend_mode;
+    blend_dsc.src_buf = rotated_buf;
+    blend_dsc.src_stride = buf_stride;
+    blend_dsc.src_color_format = swap ? LV_COLOR_FORMAT_RGB565 : cf;
+    blend_dsc.src_area = &blend_area;
+    blend_dsc.blend_area = &blend_area;
+
+    int32_t y_last = blend_area.y2;
+    blend_area.y2 = blend_area.y1 + buf_h - 1;
+    while(blend_area.y1 <= y_last) {
+        lv_area_t relative_area;
+        lv_area_copy(&relative_area, &blend_area);
+        lv_area_move(&relative_area, -img_coords->x1, -img_coords->y1);
+        rotate_right_angle_area(&relative_area, decoded->data, img_stride, px_size, draw_dsc->rotation, pivot, rotated_buf);
+        if(swap) lv_draw_sw_rgb565_swap(rotated_buf, blend_w * lv_area_get_height(&blend_area));
+
+        lv_draw_sw_blend(t, &blend_dsc);
+
+        blend_area.y1 = blend_area.y2 + 1;
+        blend_area.y2 = blend_area.y1 + buf_h - 1;
+        if(blend_area.y2 > y_last) blend_area.y2 = y_last;
+    }
+
+    lv_free(rotated_buf);
+}
+
+/**
+ * Copy the pixels of a rotated image to a buffer. Same mapping as `lv_draw_sw_transform()` uses
+ * but without interpolation, as the pixel centers fall on pixel centers.
+ * @param dest_area     area to render relative to the image. All of its pixels need to be on the rotated image.
+ * @param src_buf       the pixels of the image
+ * @param src_stride    stride of `src_buf` in bytes
+ * @param px_size       size of a pixel in bytes (2, 3 or 4)
+ * @param rotation      900, 1800 or 2700
+ * @param pivot         the pivot of the rotation relative to the image
+ * @param dest_buf      buffer with `lv_area_get_size(dest_area)` pixels of the image's color format
+ */
+static void LV_ATTRIBUTE_FAST_MEM rotate_right_angle_area(const lv_area_t * dest_area, const uint8_t * src_buf,
+                                                          int32_t src_stride, uint32_t px_size, int32_t rotation,
+                                                          const lv_point_t * pivot, uint8_t * dest_buf)
+{
+    int32_t dest_w = lv_area_get_width(dest_area);
+    int32_t dest_h = lv_area_get_height(dest_area);
+
+    /*The source of the first pixel, and the step in bytes on the source
+     *when moving right (step_x) or down (step_y) on the destination*/
+    int32_t xs;
+    int32_t ys;
+    int32_t step_x;
+    int32_t step_y;
+    if(rotation == 900) {
+        xs = dest_area->y1 - pivot->y + pivot->x;
+        ys = pivot->x + pivot->y - dest_area->x1;
+        step_x = -src_stride;
+        step_y = px_size;
+    }
+    else if(rotation == 1800) {
+        xs = 2 * pivot->x - dest_area->x1;
+        ys = 2 * pivot->y - dest_area->y1;
+        step_x = -(int32_t)px_size;
+        step_y = -src_stride;
+    }
+    else {
+        xs = pivot->x + pivot->y - dest_area->y1;
+        ys = dest_area->x1 - pivot->x + pivot->y;
+        step_x = src_stride;
+        step_y = -(int32_t)px_size;
+    }
+
+    const uint8_t * src_row = src_buf + ys * src_stride + xs * (int32_t)px_size;
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < dest_h; y++) {
+        const uint8_t * src_px = src_row;
+        if(px_size == 2) {
+            uint16_t * dest_u16 = (uint16_t *)dest_buf;
+            for(x = 0; x < dest_w; x++) {
+                dest_u16[x] = *(const uint16_t *)src_px;
+                src_px += step_x;
+            }
+        }
+        else if(px_size == 4) {
+            uint32_t * dest_u32 = (uint32_t *)dest_buf;
+            for(x = 0; x < dest_w; x++) {
+                dest_u32[x] = *(const uint32_t *)src_px;
+                src_px += step_x;
+            }
+        }
+        else {
+            uint8_t * dest_u8 = dest_buf;
+            for(x = 0; x < dest_w; x++) {
+                dest_u8[0] = src_px[0];
+                dest_u8[1] = src_px[1];
+                dest_u8[2] = src_px[2];
+                dest_u8 += 3;
+                src_px += step_x;
+            }
+        }
+        src_row += step_y;
+        dest_buf += dest_w * px_size;
+    }
+}
+#endif /*LV_DRAW_SW_RIGHT_ANGLE_ROTATION*/
+
 static void recolor(lv_area_t relative_area, uint8_t * src_buf, uint8_t * dest_buf, int32_t src_stride,
                     lv_color_format_t cf, const lv_draw_image_dsc_t * draw_dsc)
 {
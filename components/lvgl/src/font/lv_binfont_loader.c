@@ -137,6 +137,9 @@ void lv_binfont_destroy(lv_font_t * font)
     const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
     if(dsc == NULL) return;
 
+    /*The address can be reused by the next font, don't let it hit the old glyphs*/
+    lv_font_glyph_cache_drop(font);
+
     if(dsc->kern_classes == 0) {
         const lv_font_fmt_txt_kern_pair_t * kern_dsc = dsc->kern_dsc;
         if(NULL != kern_dsc) {
@@ -8,6 +8,8 @@
  *********************/
 
 #include "lv_font.h"
+#include "lv_font_fmt_txt.h"
+#include "../misc/cache/lv_cache.h"
 #include "../misc/lv_text_private.h"
 #include "../misc/lv_utils.h"
 #include "../misc/lv_log.h"
@@ -89,6 +91,10 @@ void lv_font_glyph_release_draw_data(lv_font_glyph_dsc_t * g_dsc)
     if(font != NULL && font->release_glyph) {
         font->release_glyph(font, g_dsc);
     }
+    else if(font != NULL && font->get_glyph_bitmap == lv_font_get_bitmap_fmt_txt) {
+        /*The built-in fonts keep their decoded glyphs in the glyph cache*/
+        lv_font_glyph_cache_release(g_dsc);
+    }
 }
 
 bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
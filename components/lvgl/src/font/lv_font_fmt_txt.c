@@ -13,6 +13,7 @@
 #include "../misc/lv_types.h"
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
+#include "../misc/cache/lv_cache.h"
 #include "../stdlib/lv_mem.h"
 
 /*********************
@@ -38,6 +39,7 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
 static int unicode_list_compare(const void * ref, const void * element);
 static int kern_pair_8_compare(const void * ref, const void * element);
 static int kern_pair_16_compare(const void * ref, const void * element);
+static const void * decode_glyph_bitmap(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf);
 
 #if LV_USE_FONT_COMPRESSED
     static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h, uint8_t bpp, bool prefilter);
@@ -89,133 +91,12 @@ const lv_font_class_t lv_builtin_font_class = {
 
 const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf)
 {
-    const lv_font_t * font = g_dsc->resolved_font;
-
-    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
-    uint32_t gid = g_dsc->gid.index;
-    if(!gid) return NULL;
-
-    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
-
-    if(g_dsc->req_raw_bitmap) return &fdsc->glyph_bitmap[gdsc->bitmap_index];
-
-    uint8_t * bitmap_out = draw_buf->data;
-    int32_t gsize = (int32_t) gdsc->box_w * gdsc->box_h;
-    if(gsize == 0) return NULL;
-
-    uint16_t stride_in = g_dsc->stride;
-
-    if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
-        const uint8_t * bitmap_in = &fdsc->glyph_bitmap[gdsc->bitmap_index];
-        uint8_t * bitmap_out_tmp = bitmap_out;
-        int32_t i = 0;
-        int32_t x, y;
-        uint32_t stride_out = lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8);
-        if(fdsc->bpp == 1) {
-            for(y = 0; y < gdsc->box_h; y ++) {
-                uint16_t line_rem = stride_in != 0 ? stride_in : gdsc->box_w;
-                for(x = 0; x < gdsc->box_w; x++, i++) {
-                    i = i & 0x7;
-                    if(i == 0) bitmap_out_tmp[x] = (*bitmap_in) & 0x80 ? 0xff : 0x00;
-                    else if(i == 1) bitmap_out_tmp[x] = (*bitmap_in) & 0x40 ? 0xff : 0x00;
-                    else if(i == 2) bitmap_out_tmp[x] = (*bitmap_in) & 0x20 ? 0xff : 0x00;
-                    else if(i == 3) bitmap_out_tmp[x] = (*bitmap_in) & 0x10 ? 0xff : 0x00;
-                    else if(i == 4) bitmap_out_tmp[x] = (*bitmap_in) & 0x08 ? 0xff : 0x00;
-                    else if(i == 5) bitmap_out_tmp[x] = (*bitmap_in) & 0x04 ? 0xff : 0x00;
-                    else if(i == 6) bitmap_out_tmp[x] = (*bitmap_in) & 0x02 ? 0xff : 0x00;
-                    else if(i == 7) {
-                        bitmap_out_tmp[x] = (*bitmap_in) & 0x01 ? 0xff : 0x00;
-                        line_rem--;
-                        bitmap_in++;
-                    }
-                }
-                /*Handle stride*/
-                if(stride_in) {
-                    i = 0;  /*If there is a stride start from the next byte in the next line*/
-                    bitmap_in += line_rem;
-                }
-                bitmap_out_tmp += stride_out;
-            }
-        }
-        else if(fdsc->bpp == 2) {
-            for(y = 0; y < gdsc->box_h; y ++) {
-                uint16_t line_rem = stride_in != 0 ? stride_in : gdsc->box_w;
-                for(x = 0; x < gdsc->box_w; x++, i++) {
-                    i = i & 0x3;
-                    if(i == 0) bitmap_out_tmp[x] = opa2_table[(*bitmap_in) >> 6];
-                    else if(i == 1) bitmap_out_tmp[x] = opa2_table[((*bitmap_in) >> 4) & 0x3];
-                    else if(i == 2) bitmap_out_tmp[x] = opa2_table[((*bitmap_in) >> 2) & 0x3];
-                    else if(i == 3) {
-                        bitmap_out_tmp[x] = opa2_table[((*bitmap_in) >> 0) & 0x3];
-                        line_rem--;
-                        bitmap_in++;
-                    }
-                }
-
-                /*Handle stride*/
-                if(stride_in) {
-                    i = 0;  /*If there is a stride start from the next byte in the next line*/
-                    bitmap_in += line_rem;
-                }
-                bitmap_out_tmp += stride_out;
-            }
-
-        }
-        else if(fdsc->bpp == 4) {
-            for(y = 0; y < gdsc->box_h; y ++) {
-                uint16_t line_rem = stride_in != 0 ? stride_in : gdsc->box_w;
-                for(x = 0; x < gdsc->box_w; x++, i++) {
-                    i = i & 0x1;
-                    if(i == 0) {
-                        bitmap_out_tmp[x] = opa4_table[(*bitmap_in) >> 4];
-                    }
-                    else if(i == 1) {
-                        bitmap_out_tmp[x] = opa4_table[(*bitmap_in) & 0xF];
-                        line_rem--;
-                        bitmap_in++;
-                    }
-                }
-
-                /*Handle stride*/
-                if(stride_in) {
-                    i = 0;  /*If there is a stride start from the next byte in the next line*/
-                    bitmap_in += line_rem;
-                }
-                bitmap_out_tmp += stride_out;
-            }
-        }
-        else if(fdsc->bpp == 8) {
-            for(y = 0; y < gdsc->box_h; y ++) {
-                uint16_t line_rem = stride_in != 0 ? stride_in : gdsc->box_w;
-                for(x = 0; x < gdsc->box_w; x++, i++) {
-                    bitmap_out_tmp[x] = *bitmap_in;
-                    line_rem--;
-                    bitmap_in++;
-                }
-                bitmap_out_tmp += stride_out;
-                bitmap_in += line_rem;
-            }
-        }
-
-        lv_draw_buf_flush_cache(draw_buf, NULL);
-        return draw_buf;
-    }
-    /*Handle compressed bitmap*/
-    else {
-#if LV_USE_FONT_COMPRESSED
-        bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap_out, gdsc->box_w, gdsc->box_h,
-                   (uint8_t)fdsc->bpp, prefilter);
-        lv_draw_buf_flush_cache(draw_buf, NULL);
-        return draw_buf;
-#else /*!LV_USE_FONT_COMPRESSED*/
-        LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
-        return NULL;
-#endif
+    if(!g_dsc->req_raw_bitmap && g_dsc->gid.index && g_dsc->box_w && g_dsc->box_h) {
+        lv_draw_buf_t * cached = lv_font_glyph_cache_acquire(g_dsc, decode_glyph_bitmap);
+        if(cached) return cached;
     }
 
-    /*If not returned earlier then the letter is not found in this font*/
-    return NULL;
+    return decode_glyph_bitmap(g_dsc, draw_buf);
 }
 
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
@@ -404,6 +285,137 @@ static int kern_pair_16_compare(const void * ref, const void * element)
     else return ref16_p->gid_right - element16_p[1];
 }
 
+static const void * decode_glyph_bitmap(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf)
+{
+    const lv_font_t * font = g_dsc->resolved_font;
+
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    uint32_t gid = g_dsc->gid.index;
+    if(!gid) return NULL;
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+
+    if(g_dsc->req_raw_bitmap) return &fdsc->glyph_bitmap[gdsc->bitmap_index];
+
+    uint8_t * bitmap_out = draw_buf->data;
+    int32_t gsize = (int32_t) gdsc->box_w * gdsc->box_h;
+    if(gsize == 0) return NULL;
+
+    uint16_t stride_in = g_dsc->stride;
+
+    if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
+        const uint8_t * bitmap_in = &fdsc->glyph_bitmap[gdsc->bitmap_index];
+        uint8_t * bitmap_out_tmp = bitmap_out;
+        int32_t i = 0;
+        int32_t x, y;
+        uint32_t stride_out = lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8);
+        if(fdsc->bpp == 1) {
+            for(y = 0; y < gdsc->box_h; y ++) {
+                uint16_t line_rem = stride_in != 0 ? stride_in : gdsc->box_w;
+                for(x = 0; x < gdsc->box_w; x++, i++) {
+                    i = i & 0x7;
+                    if(i == 0) bitmap_out_tmp[x] = (*bitmap_in) & 0x80 ? 0xff : 0x00;
+                    else if(i == 1) bitmap_out_tmp[x] = (*bitmap_in) & 0x40 ? 0xff : 0x00;
+                    else if(i == 2) bitmap_out_tmp[x] = (*bitmap_in) & 0x20 ? 0xff : 0x00;
+                    else if(i == 3) bitmap_out_tmp[x] = (*bitmap_in) & 0x10 ? 0xff : 0x00;
+                    else if(i == 4) bitmap_out_tmp[x] = (*bitmap_in) & 0x08 ? 0xff : 0x00;
+                    else if(i == 5) bitmap_out_tmp[x] = (*bitmap_in) & 0x04 ? 0xff : 0x00;
+                    else if(i == 6) bitmap_out_tmp[x] = (*bitmap_in) & 0x02 ? 0xff : 0x00;
+                    else if(i == 7) {
+                        bitmap_out_tmp[x] = (*bitmap_in) & 0x01 ? 0xff : 0x00;
+                        line_rem--;
+                        bitmap_in++;
+                    }
+                }
+                /*Handle stride*/
+                if(stride_in) {
+                    i = 0;  /*If there is a stride start from the next byte in the next line*/
+                    bitmap_in += line_rem;
+                }
+                bitmap_out_tmp += stride_out;
+            }
+        }
+        else if(fdsc->bpp == 2) {
+            for(y = 0; y < gdsc->box_h; y ++) {
+                uint16_t line_rem = stride_in != 0 ? stride_in : gdsc->box_w;
+                for(x = 0; x < gdsc->box_w; x++, i++) {
+                    i = i & 0x3;
+                    if(i == 0) bitmap_out_tmp[x] = opa2_table[(*bitmap_in) >> 6];
+                    else if(i == 1) bitmap_out_tmp[x] = opa2_table[((*bitmap_in) >> 4) & 0x3];
+                    else if(i == 2) bitmap_out_tmp[x] = opa2_table[((*bitmap_in) >> 2) & 0x3];
+                    else if(i == 3) {
+                        bitmap_out_tmp[x] = opa2_table[((*bitmap_in) >> 0) & 0x3];
+                        line_rem--;
+                        bitmap_in++;
+                    }
+                }
+
+                /*Handle stride*/
+                if(stride_in) {
+                    i = 0;  /*If there is a stride start from the next byte in the next line*/
+                    bitmap_in += line_rem;
+                }
+                bitmap_out_tmp += stride_out;
+            }
+
+        }
+        else if(fdsc->bpp == 4) {
+            for(y = 0; y < gdsc->box_h; y ++) {
+                uint16_t line_rem = stride_in != 0 ? stride_in : gdsc->box_w;
+                for(x = 0; x < gdsc->box_w; x++, i++) {
+                    i = i & 0x1;
+                    if(i == 0) {
+                        bitmap_out_tmp[x] = opa4_table[(*bitmap_in) >> 4];
+                    }
+                    else if(i == 1) {
+                        bitmap_out_tmp[x] = opa4_table[(*bitmap_in) & 0xF];
+                        line_rem--;
+                        bitmap_in++;
+                    }
+                }
+
+                /*Handle stride*/
+                if(stride_in) {
+                    i = 0;  /*If there is a stride start from the next byte in the next line*/
+                    bitmap_in += line_rem;
+                }
+                bitmap_out_tmp += stride_out;
+            }
+        }
+        else if(fdsc->bpp == 8) {
+            for(y = 0; y < gdsc->box_h; y ++) {
+                uint16_t line_rem = stride_in != 0 ? stride_in : gdsc->box_w;
+                for(x = 0; x < gdsc->box_w; x++, i++) {
+                    bitmap_out_tmp[x] = *bitmap_in;
+                    line_rem--;
+                    bitmap_in++;
+                }
+                bitmap_out_tmp += stride_out;
+                bitmap_in += line_rem;
+            }
+        }
+
+        lv_draw_buf_flush_cache(draw_buf, NULL);
+        return draw_buf;
+    }
+    /*Handle compressed bitmap*/
+    else {
+#if LV_USE_FONT_COMPRESSED
+        bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED;
+        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap_out, gdsc->box_w, gdsc->box_h,
+                   (uint8_t)fdsc->bpp, prefilter);
+        lv_draw_buf_flush_cache(draw_buf, NULL);
+        return draw_buf;
+#else /*!LV_USE_FONT_COMPRESSED*/
+        LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
+        return NULL;
+#endif
+    }
+
+    /*If not returned earlier then the letter is not found in this font*/
+    return NULL;
+}
+
 #if LV_USE_FONT_COMPRESSED
 
 /**
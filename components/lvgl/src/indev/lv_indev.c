@@ -200,6 +200,8 @@ void indev_read_core(lv_indev_t * indev, lv_indev_data_t * data)
         LV_LOG_WARN("indev_read_cb is not registered");
     }
 
+    if(data->timestamp == 0) data->timestamp = lv_tick_get();
+
     LV_PROFILER_INDEV_END;
 }
 
@@ -792,7 +794,7 @@ static void indev_keypad_proc(lv_indev_t * i, lv_indev_data_t * data)
     /*Key press happened*/
     if(data->state == LV_INDEV_STATE_PRESSED && prev_state == LV_INDEV_STATE_RELEASED) {
         LV_LOG_INFO("%" LV_PRIu32 " key is pressed", data->key);
-        i->pr_timestamp = lv_tick_get();
+        i->pr_timestamp = data->timestamp;
 
         /*Move the focus on NEXT*/
         if(data->key == LV_KEY_NEXT) {
@@ -938,7 +940,7 @@ static void indev_encoder_proc(lv_indev_t * i, lv_indev_data_t * data)
     if(data->state == LV_INDEV_STATE_PRESSED && last_state == LV_INDEV_STATE_RELEASED) {
         LV_LOG_INFO("pressed");
 
-        i->pr_timestamp = lv_tick_get();
+        i->pr_timestamp = data->timestamp;
 
         if(data->key == LV_KEY_ENTER) {
             bool editable_or_scrollable = lv_obj_is_editable(indev_obj_act) ||
@@ -9,6 +9,7 @@
 #include "lv_gif_private.h"
 #if LV_USE_GIF
 #include "../../misc/lv_timer_private.h"
+#include "../../misc/lv_area_private.h"
 #include "../../misc/cache/lv_cache.h"
 #include "../../core/lv_obj_class_private.h"
 
@@ -29,6 +30,7 @@
 static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void next_frame_task_cb(lv_timer_t * t);
+static void invalidate_frame_area(lv_obj_t * obj, const lv_area_t * area);
 
 /**********************
  *  STATIC VARIABLES
@@ -204,7 +206,12 @@ static void next_frame_task_cb(lv_timer_t * t)
 
     gifobj->last_call = lv_tick_get();
 
-    int has_next = gd_get_frame(gifobj->gif);
+    /*Only the previous frame's rectangle (disposed now) and the new frame's rectangle change*/
+    gd_GIF * gif = gifobj->gif;
+    lv_area_t prev_area;
+    lv_area_set(&prev_area, gif->fx, gif->fy, gif->fx + gif->fw - 1, gif->fy + gif->fh - 1);
+
+    int has_next = gd_get_frame(gif);
     if(has_next == 0) {
         /*It was the last repeat*/
         lv_result_t res = lv_obj_send_event(obj, LV_EVENT_READY, NULL);
@@ -212,10 +219,37 @@ static void next_frame_task_cb(lv_timer_t * t)
         if(res != LV_RESULT_OK) return;
     }
 
-    gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
+    gd_render_frame(gif, (uint8_t *)gifobj->imgdsc.data);
+
+    lv_area_t dirty_area;
+    lv_area_set(&dirty_area, gif->fx, gif->fy, gif->fx + gif->fw - 1, gif->fy + gif->fh - 1);
+    if(lv_area_get_size(&prev_area) > 0) lv_area_join(&dirty_area, &dirty_area, &prev_area);
 
     lv_image_cache_drop(lv_image_get_src(obj));
-    lv_obj_invalidate(obj);
+    invalidate_frame_area(obj, &dirty_area);
+}
+
+/**
+ * Invalidate the changed part of the GIF. `area` is relative to the image.
+ * Rotated, scaled, tiled images, etc. are invalidated entirely.
+ */
+static void invalidate_frame_area(lv_obj_t * obj, const lv_area_t * area)
+{
+    lv_image_t * img = (lv_image_t *)obj;
+    if(img->align >= LV_IMAGE_ALIGN_AUTO_TRANSFORM || img->rotation != 0 ||
+       img->scale_x != LV_SCALE_NONE || img->scale_y != LV_SCALE_NONE) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    /*Same as in lv_image's draw_image()*/
+    lv_area_t image_area;
+    lv_area_set(&image_area, 0, 0, img->w - 1, img->h - 1);
+    lv_area_align(&obj->coords, &image_area, img->align, img->offset.x, img->offset.y);
+
+    lv_area_t a = *area;
+    lv_area_move(&a, image_area.x1, image_area.y1);
+    lv_obj_invalidate_area(obj, &a);
 }
 
 #endif /*LV_USE_GIF*/
@@ -14,6 +14,8 @@
 #include "tjpgd.h"
 #include "lv_tjpgd.h"
 #include "../../misc/lv_fs_private.h"
+#include "../../misc/lv_iter.h"
+#include "../../core/lv_global.h"
 #include <string.h>
 
 /*********************
@@ -21,13 +23,58 @@
  *********************/
 
 #define DECODER_NAME    "TJPGD"
+#define CACHE_NAME      "TJPGD_ROW"
 
 #define TJPGD_WORKBUFF_SIZE             4096    //Recommended by TJPGD library
 
+/*Number of images which keep their decoding position between two draws*/
+#define TJPGD_STREAM_CNT                2
+
+#define tjpgd_ctx_p (LV_GLOBAL_DEFAULT()->tjpgd_context)
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*A decoder which stays open between the draw tasks (bands) of an image,
+ *so drawing the next band continues where the previous one stopped*/
+typedef struct {
+    JDEC jd;
+    lv_fs_file_t file;
+    uint8_t * workb;
+    const void * src;           /*Own copy of the file name or the `lv_image_dsc_t` pointer*/
+    lv_image_src_t src_type;
+    uint32_t next_row;          /*The MCU row the next `jd_mcu_load()` belongs to*/
+    uint8_t * last_row;         /*Copy of the row `next_row - 1` if the rows aren't cached*/
+    uint32_t last_use;
+} tjpgd_stream_t;
+
+/*A decoded MCU row (full width, RGB888) in the cache*/
+typedef struct {
+    lv_cache_slot_size_t slot;  /*Size of `data`, counted in the cache's budget*/
+    const void * src;
+    lv_image_src_t src_type;
+    uint32_t row;
+    uint8_t * data;
+} tjpgd_row_t;
+
+typedef struct _lv_tjpgd_context_t {
+    lv_cache_t * rows;
+    lv_mutex_t lock;            /*Protects the streams and the statistics*/
+    tjpgd_stream_t * streams[TJPGD_STREAM_CNT];
+    uint32_t use_cnt;
+    lv_tjpgd_cache_stats_t stats;
+} lv_tjpgd_context_t;
+
+/*An opened image, `dsc->user_data`*/
+typedef struct {
+    lv_draw_buf_t decoded;      /*Points to the MCU row being drawn*/
+    lv_cache_entry_t * entry;   /*Cache entry of the row being drawn*/
+    uint8_t * row_buf;          /*Used when the row can't be cached*/
+    uint32_t row_size;
+    uint32_t mcu_h;
+} tjpgd_session_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -40,6 +87,19 @@ static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t *
 static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata);
 static int is_jpg(const uint8_t * raw_data, size_t len);
 
+static bool src_is_equal(const void * src_a, lv_image_src_t type_a, const void * src_b, lv_image_src_t type_b);
+static tjpgd_stream_t * stream_get(lv_tjpgd_context_t * ctx, const void * src, lv_image_src_t src_type);
+static lv_result_t stream_rewind(tjpgd_stream_t * stream, bool reparse);
+static lv_result_t stream_decode_row(lv_tjpgd_context_t * ctx, tjpgd_stream_t * stream, uint32_t row,
+                                     uint8_t * buf, bool cache_rows);
+static void stream_delete(tjpgd_stream_t * stream);
+static lv_cache_entry_t * row_cache_add(lv_tjpgd_context_t * ctx, tjpgd_stream_t * stream, uint32_t row,
+                                        uint8_t * data);
+static void session_release_row(lv_tjpgd_context_t * ctx, tjpgd_session_t * session);
+
+static lv_cache_compare_res_t row_compare_cb(const tjpgd_row_t * lhs, const tjpgd_row_t * rhs);
+static void row_free_cb(tjpgd_row_t * node, void * user_data);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -61,6 +121,25 @@ void lv_tjpgd_init(void)
     lv_image_decoder_set_close_cb(dec, decoder_close);
 
     dec->name = DECODER_NAME;
+
+    lv_tjpgd_context_t * ctx = lv_malloc_zeroed(sizeof(lv_tjpgd_context_t));
+    LV_ASSERT_MALLOC(ctx);
+    if(ctx == NULL) return;
+
+    ctx->rows = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(tjpgd_row_t), LV_TJPGD_CACHE_SIZE,
+    (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) row_compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t) row_free_cb,
+    });
+    if(ctx->rows == NULL) {
+        lv_free(ctx);
+        return;
+    }
+    lv_cache_set_name(ctx->rows, CACHE_NAME);
+    lv_mutex_init(&ctx->lock);
+    ctx->stats.max_size = LV_TJPGD_CACHE_SIZE;
+    tjpgd_ctx_p = ctx;
 }
 
 void lv_tjpgd_deinit(void)
@@ -72,6 +151,92 @@ void lv_tjpgd_deinit(void)
             break;
         }
     }
+
+    lv_tjpgd_context_t * ctx = tjpgd_ctx_p;
+    if(ctx == NULL) return;
+
+    for(uint32_t i = 0; i < TJPGD_STREAM_CNT; i++) {
+        if(ctx->streams[i]) stream_delete(ctx->streams[i]);
+    }
+    lv_cache_destroy(ctx->rows, NULL);
+    lv_mutex_delete(&ctx->lock);
+    lv_free(ctx);
+    tjpgd_ctx_p = NULL;
+}
+
+void lv_tjpgd_cache_resize(uint32_t new_size)
+{
+    lv_tjpgd_context_t * ctx = tjpgd_ctx_p;
+    if(ctx == NULL) return;
+
+    lv_cache_set_max_size(ctx->rows, new_size, NULL);
+    lv_cache_reserve(ctx->rows, new_size, NULL);
+
+    lv_mutex_lock(&ctx->lock);
+    ctx->stats.max_size = new_size;
+    lv_mutex_unlock(&ctx->lock);
+}
+
+void lv_tjpgd_cache_drop(const void * src)
+{
+    lv_tjpgd_context_t * ctx = tjpgd_ctx_p;
+    if(ctx == NULL) return;
+
+    lv_image_src_t src_type = src ? lv_image_src_get_type(src) : LV_IMAGE_SRC_UNKNOWN;
+
+    lv_mutex_lock(&ctx->lock);
+    for(uint32_t i = 0; i < TJPGD_STREAM_CNT; i++) {
+        tjpgd_stream_t * stream = ctx->streams[i];
+        if(stream && (src == NULL || src_is_equal(stream->src, stream->src_type, src, src_type))) {
+            stream_delete(stream);
+            ctx->streams[i] = NULL;
+        }
+    }
+    lv_mutex_unlock(&ctx->lock);
+
+    if(src == NULL) {
+        lv_cache_drop_all(ctx->rows, NULL);
+        return;
+    }
+
+    /*The rows of an image are unknown here: find them one by one.
+     *The cache holds only a few dozens of rows, so it's cheap.*/
+    while(1) {
+        lv_iter_t * iter = lv_cache_iter_create(ctx->rows);
+        if(iter == NULL) return;
+
+        tjpgd_row_t row;
+        bool found = false;
+        while(lv_iter_next(iter, &row) == LV_RESULT_OK) {
+            if(src_is_equal(row.src, row.src_type, src, src_type)) {
+                found = true;
+                break;
+            }
+        }
+        lv_iter_destroy(iter);
+        if(!found) return;
+
+        tjpgd_row_t search_key = {
+            .src = src,
+            .src_type = src_type,
+            .row = row.row,
+        };
+        lv_cache_drop(ctx->rows, &search_key, NULL);
+    }
+}
+
+void lv_tjpgd_get_cache_stats(lv_tjpgd_cache_stats_t * stats)
+{
+    lv_tjpgd_context_t * ctx = tjpgd_ctx_p;
+    if(ctx == NULL) {
+        lv_memzero(stats, sizeof(lv_tjpgd_cache_stats_t));
+        return;
+    }
+
+    lv_mutex_lock(&ctx->lock);
+    *stats = ctx->stats;
+    lv_mutex_unlock(&ctx->lock);
+    stats->size = (uint32_t)lv_cache_get_size(ctx->rows, NULL);
 }
 
 /**********************
@@ -145,7 +310,8 @@ static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata)
 }
 
 /**
- * Decode a JPG image and return the decoded data.
+ * Open a JPG image. Only the header is parsed here, the pixels are decoded
+ * in MCU rows by `decoder_get_area()`.
  * @param decoder pointer to the decoder
  * @param dsc     pointer to the decoder descriptor
  * @return LV_RESULT_OK: no error; LV_RESULT_INVALID: can't open the image
@@ -153,142 +319,135 @@ static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata)
 static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
 {
     LV_UNUSED(decoder);
-    lv_fs_file_t * f = lv_malloc(sizeof(lv_fs_file_t));
-    if(dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
-#if LV_USE_FS_MEMFS
-        const lv_image_dsc_t * img_dsc = dsc->src;
-        if(is_jpg(img_dsc->data, img_dsc->data_size) == true) {
-            lv_fs_path_ex_t path;
-            lv_fs_make_path_from_buffer(&path, LV_FS_MEMFS_LETTER, img_dsc->data, img_dsc->data_size);
-            lv_fs_res_t res;
-            res = lv_fs_open(f, (const char *)&path, LV_FS_MODE_RD);
-            if(res != LV_FS_RES_OK) {
-                lv_free(f);
-                return LV_RESULT_INVALID;
-            }
-        }
-#else
-        LV_LOG_WARN("LV_USE_FS_MEMFS needs to enabled to decode from data");
+    lv_tjpgd_context_t * ctx = tjpgd_ctx_p;
+    if(ctx == NULL) return LV_RESULT_INVALID;
+
+    lv_mutex_lock(&ctx->lock);
+    tjpgd_stream_t * stream = stream_get(ctx, dsc->src, dsc->src_type);
+    if(stream == NULL) {
+        lv_mutex_unlock(&ctx->lock);
         return LV_RESULT_INVALID;
-#endif
-    }
-    else if(dsc->src_type == LV_IMAGE_SRC_FILE) {
-        const char * fn = dsc->src;
-        if((lv_strcmp(lv_fs_get_ext(fn), "jpg") == 0) || (lv_strcmp(lv_fs_get_ext(fn), "jpeg") == 0)) {
-            lv_fs_res_t res;
-            res = lv_fs_open(f, fn, LV_FS_MODE_RD);
-            if(res != LV_FS_RES_OK) {
-                lv_free(f);
-                return LV_RESULT_INVALID;
-            }
-        }
     }
+    uint32_t w = stream->jd.width;
+    uint32_t h = stream->jd.height;
+    uint32_t mcu_h = stream->jd.msy * 8;
+    lv_mutex_unlock(&ctx->lock);
 
-    uint8_t * workb_temp = lv_malloc(TJPGD_WORKBUFF_SIZE);
-    JDEC * jd = lv_malloc(sizeof(JDEC));
-    dsc->user_data = jd;
-    JRESULT rc = jd_prepare(jd, input_func, workb_temp, (size_t)TJPGD_WORKBUFF_SIZE, f);
-    if(rc) return LV_RESULT_INVALID;
+    tjpgd_session_t * session = lv_malloc_zeroed(sizeof(tjpgd_session_t));
+    LV_ASSERT_MALLOC(session);
+    if(session == NULL) return LV_RESULT_INVALID;
 
-    dsc->header.cf = LV_COLOR_FORMAT_RGB888;
-    dsc->header.w = jd->width;
-    dsc->header.h = jd->height;
-    dsc->header.stride = jd->width * 3;
+    session->mcu_h = mcu_h;
+    session->row_size = w * 3 * mcu_h;
+    dsc->user_data = session;
 
-    if(rc != JDR_OK) {
-        lv_free(workb_temp);
-        lv_free(jd);
-        return LV_RESULT_INVALID;
-    }
+    dsc->header.cf = LV_COLOR_FORMAT_RGB888;
+    dsc->header.w = w;
+    dsc->header.h = h;
+    dsc->header.stride = w * 3;
 
     return LV_RESULT_OK;
 }
 
+/**
+ * Provide the image in full width MCU rows, only the rows of `full_area`.
+ * A row comes from the cache or it's decoded by the stream of the image.
+ */
 static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
                                     const lv_area_t * full_area, lv_area_t * decoded_area)
 {
     LV_UNUSED(decoder);
-    LV_UNUSED(full_area);
-
-    JDEC * jd = dsc->user_data;
-    lv_draw_buf_t * decoded = (void *)dsc->decoded;
-
-    uint32_t  mx, my;
-    mx = jd->msx * 8;
-    my = jd->msy * 8;         /* Size of the MCU (pixel) */
-    if(decoded_area->y1 == LV_COORD_MIN) {
-        decoded_area->y1 = 0;
-        decoded_area->y2 = my - 1;
-        decoded_area->x1 = -((int32_t)mx);
-        decoded_area->x2 = -1;
-        jd->scale = 0;
-        jd->dcv[2] = jd->dcv[1] = jd->dcv[0] = 0;   /* Initialize DC values */
-        jd->rst = 0;
-        jd->rsc = 0;
-        if(decoded == NULL) {
-            decoded = lv_malloc_zeroed(sizeof(lv_draw_buf_t));
-            dsc->decoded = decoded;
+
+    lv_tjpgd_context_t * ctx = tjpgd_ctx_p;
+    tjpgd_session_t * session = dsc->user_data;
+
+    /*The previous row is drawn already*/
+    session_release_row(ctx, session);
+
+    uint32_t row;
+    if(decoded_area->y1 == LV_COORD_MIN) row = LV_MAX(full_area->y1, 0) / session->mcu_h;
+    else row = decoded_area->y1 / session->mcu_h + 1;
+
+    int32_t y1 = (int32_t)(row * session->mcu_h);
+    if(y1 > full_area->y2 || y1 >= (int32_t)dsc->header.h) return LV_RESULT_INVALID;
+
+    tjpgd_row_t search_key = {
+        .src = dsc->src,
+        .src_type = dsc->src_type,
+        .row = row,
+    };
+
+    uint8_t * data = NULL;
+    session->entry = lv_cache_acquire(ctx->rows, &search_key, NULL);
+
+    lv_mutex_lock(&ctx->lock);
+    /*Check again: an other draw unit might have decoded it meanwhile*/
+    if(session->entry == NULL) session->entry = lv_cache_acquire(ctx->rows, &search_key, NULL);
+
+    if(session->entry) {
+        ctx->stats.hits++;
+        data = ((tjpgd_row_t *)lv_cache_entry_get_data(session->entry))->data;
+    }
+    else {
+        ctx->stats.misses++;
+        bool cacheable = session->row_size <= lv_cache_get_max_size(ctx->rows, NULL);
+        if(cacheable) {
+            data = lv_malloc(session->row_size);
         }
         else {
-            lv_fs_seek(jd->device, 0, LV_FS_SEEK_SET);
-            JRESULT rc = jd_prepare(jd, input_func, jd->pool_original, (size_t)TJPGD_WORKBUFF_SIZE, jd->device);
-            if(rc) return LV_RESULT_INVALID;
+            if(session->row_buf == NULL) session->row_buf = lv_malloc(session->row_size);
+            data = session->row_buf;
         }
-        decoded->data = jd->workbuf;
-        decoded->header = dsc->header;
-    }
 
-    decoded_area->x1 += mx;
-    decoded_area->x2 += mx;
+        tjpgd_stream_t * stream = stream_get(ctx, dsc->src, dsc->src_type);
+        if(data == NULL || stream == NULL || stream_decode_row(ctx, stream, row, data, cacheable) != LV_RESULT_OK) {
+            if(cacheable) lv_free(data);
+            lv_mutex_unlock(&ctx->lock);
+            return LV_RESULT_INVALID;
+        }
 
-    if(decoded_area->x1 >= jd->width) {
-        decoded_area->x1 = 0;
-        decoded_area->x2 = mx - 1;
-        decoded_area->y1 += my;
-        decoded_area->y2 += my;
+        if(cacheable) {
+            session->entry = row_cache_add(ctx, stream, row, data);
+            if(session->entry == NULL) {
+                /*Couldn't make room (all rows are being drawn), use it only this time*/
+                lv_free(session->row_buf);
+                session->row_buf = data;
+            }
+        }
     }
+    lv_mutex_unlock(&ctx->lock);
 
-    if(decoded_area->x2 >= jd->width) decoded_area->x2 = jd->width - 1;
-    if(decoded_area->y2 >= jd->height) decoded_area->y2 = jd->height - 1;
+    decoded_area->x1 = 0;
+    decoded_area->x2 = dsc->header.w - 1;
+    decoded_area->y1 = y1;
+    decoded_area->y2 = LV_MIN(y1 + (int32_t)session->mcu_h, (int32_t)dsc->header.h) - 1;
 
-    decoded->header.w = lv_area_get_width(decoded_area);
+    lv_draw_buf_t * decoded = &session->decoded;
+    decoded->header = dsc->header;
     decoded->header.h = lv_area_get_height(decoded_area);
-    decoded->header.stride = decoded->header.w * 3;
     decoded->data_size = decoded->header.stride * decoded->header.h;
-
-    /* Process restart interval if enabled */
-    JRESULT rc;
-    if(jd->nrst && jd->rst++ == jd->nrst) {
-        rc = jd_restart(jd, jd->rsc++);
-        if(rc != JDR_OK) return LV_RESULT_INVALID;
-        jd->rst = 1;
-    }
-
-    /* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
-    rc = jd_mcu_load(jd);
-    if(rc != JDR_OK) return LV_RESULT_INVALID;
-
-    /* Output the MCU (YCbCr to RGB, scaling and output) */
-    rc = jd_mcu_output(jd, NULL, decoded_area->x1, decoded_area->y1);
-    if(rc != JDR_OK) return LV_RESULT_INVALID;
+    decoded->data = data;
+    dsc->decoded = decoded;
 
     return LV_RESULT_OK;
 }
 
 /**
- * Free the allocated resources
+ * Free the allocated resources. The stream stays open for the next draw.
  * @param decoder pointer to the decoder where this function belongs
  * @param dsc pointer to a descriptor which describes this decoding session
  */
 static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
 {
     LV_UNUSED(decoder);
-    JDEC * jd = dsc->user_data;
-    lv_fs_close(jd->device);
-    lv_free(jd->device);
-    lv_free(jd->pool_original);
-    lv_free(jd);
-    lv_free((void *)dsc->decoded);
+    tjpgd_session_t * session = dsc->user_data;
+    if(session == NULL) return;
+
+    session_release_row(tjpgd_ctx_p, session);
+    lv_free(session->row_buf);
+    lv_free(session);
+    dsc->user_data = NULL;
+    dsc->decoded = NULL;
 }
 
 static int is_jpg(const uint8_t * raw_data, size_t len)
@@ -298,4 +457,269 @@ static int is_jpg(const uint8_t * raw_data, size_t len)
     return memcmp(jpg_signature, raw_data, sizeof(jpg_signature)) == 0;
 }
 
+static bool src_is_equal(const void * src_a, lv_image_src_t type_a, const void * src_b, lv_image_src_t type_b)
+{
+    if(type_a != type_b) return false;
+    if(type_a == LV_IMAGE_SRC_FILE) return lv_strcmp(src_a, src_b) == 0;
+    return src_a == src_b;
+}
+
+/**
+ * Get the open stream of an image or open a new one instead of the least recently used.
+ * `ctx->lock` needs to be taken.
+ */
+static tjpgd_stream_t * stream_get(lv_tjpgd_context_t * ctx, const void * src, lv_image_src_t src_type)
+{
+    ctx->use_cnt++;
+
+    /*Replace an empty slot or else the least recently used stream*/
+    uint32_t victim = 0;
+    for(uint32_t i = 0; i < TJPGD_STREAM_CNT; i++) {
+        tjpgd_stream_t * stream = ctx->streams[i];
+        if(stream == NULL) {
+            if(ctx->streams[victim]) victim = i;
+            continue;
+        }
+        if(src_is_equal(stream->src, stream->src_type, src, src_type)) {
+            stream->last_use = ctx->use_cnt;
+            return stream;
+        }
+        if(ctx->streams[victim] && stream->last_use < ctx->streams[victim]->last_use) victim = i;
+    }
+
+    lv_fs_path_ex_t path;
+    const char * fn = src;
+    if(src_type == LV_IMAGE_SRC_VARIABLE) {
+#if LV_USE_FS_MEMFS
+        const lv_image_dsc_t * img_dsc = src;
+        if(is_jpg(img_dsc->data, img_dsc->data_size) == false) return NULL;
+        lv_fs_make_path_from_buffer(&path, LV_FS_MEMFS_LETTER, img_dsc->data, img_dsc->data_size);
+        fn = (const char *)&path;
+#else
+        LV_UNUSED(path);
+        LV_LOG_WARN("LV_USE_FS_MEMFS needs to enabled to decode from data");
+        return NULL;
+#endif
+    }
+    else if(src_type == LV_IMAGE_SRC_FILE) {
+        if((lv_strcmp(lv_fs_get_ext(fn), "jpg") != 0) && (lv_strcmp(lv_fs_get_ext(fn), "jpeg") != 0)) return NULL;
+    }
+    else {
+        return NULL;
+    }
+
+    tjpgd_stream_t * stream = lv_malloc_zeroed(sizeof(tjpgd_stream_t));
+    LV_ASSERT_MALLOC(stream);
+    if(stream == NULL) return NULL;
+
+    if(lv_fs_open(&stream->file, fn, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        lv_free(stream);
+        return NULL;
+    }
+    stream->src_type = src_type;
+    stream->src = src_type == LV_IMAGE_SRC_FILE ? lv_strdup(src) : src;
+    stream->workb = lv_malloc(TJPGD_WORKBUFF_SIZE);
+    if(stream->src == NULL || stream->workb == NULL || stream_rewind(stream, false) != LV_RESULT_OK) {
+        stream_delete(stream);
+        return NULL;
+    }
+
+    if(ctx->streams[victim]) stream_delete(ctx->streams[victim]);
+    ctx->streams[victim] = stream;
+    stream->last_use = ctx->use_cnt;
+    return stream;
+}
+
+/**
+ * Parse the header (again) and get ready to decode the first MCU row.
+ */
+static lv_result_t stream_rewind(tjpgd_stream_t * stream, bool reparse)
+{
+    JDEC * jd = &stream->jd;
+    if(reparse) lv_fs_seek(&stream->file, 0, LV_FS_SEEK_SET);
+
+    JRESULT rc = jd_prepare(jd, input_func, stream->workb, (size_t)TJPGD_WORKBUFF_SIZE, &stream->file);
+    if(rc) {
+        LV_LOG_WARN("jd_prepare error: %d", rc);
+        return LV_RESULT_INVALID;
+    }
+
+    jd->scale = 0;
+    jd->dcv[2] = jd->dcv[1] = jd->dcv[0] = 0;   /* Initialize DC values */
+    jd->rst = 0;
+    jd->rsc = 0;
+    stream->next_row = 0;
+    return LV_RESULT_OK;
+}
+
+/**
+ * Decode an MCU row into `buf` (`width * 3 * mcu_h` bytes).
+ * The huffman stream can be read only forward, a row above the current position starts
+ * again from the beginning. The draw units draw the parts of a band in parallel and
+ * ask for the rows out of order, so the rows passed on the way are kept too:
+ * - `cache_rows`: they are added to the cache
+ * - else: only the last row is kept in the stream, the rest are parsed but not converted
+ * `ctx->lock` needs to be taken.
+ */
+static lv_result_t stream_decode_row(lv_tjpgd_context_t * ctx, tjpgd_stream_t * stream, uint32_t row,
+                                     uint8_t * buf, bool cache_rows)
+{
+    JDEC * jd = &stream->jd;
+    uint32_t mx = jd->msx * 8;
+    uint32_t my = jd->msy * 8;         /* Size of the MCU (pixel) */
+    uint32_t stride = jd->width * 3;
+    uint32_t row_size = stride * my;
+
+    if(row + 1 == stream->next_row && stream->last_row) {
+        lv_memcpy(buf, stream->last_row, row_size);
+        return LV_RESULT_OK;
+    }
+
+    if(row < stream->next_row) {
+        ctx->stats.restarts++;
+        if(stream_rewind(stream, true) != LV_RESULT_OK) return LV_RESULT_INVALID;
+    }
+
+    while(stream->next_row <= row) {
+        uint8_t * out = NULL;
+        if(stream->next_row == row) {
+            out = buf;
+        }
+        else if(cache_rows) {
+            tjpgd_row_t search_key = {
+                .src = stream->src,
+                .src_type = stream->src_type,
+                .row = stream->next_row,
+            };
+            lv_cache_entry_t * entry = lv_cache_acquire(ctx->rows, &search_key, NULL);
+            if(entry) lv_cache_release(ctx->rows, entry, NULL);
+            else out = lv_malloc(row_size);
+        }
+
+        uint32_t y = stream->next_row * my;
+        uint32_t ry = LV_MIN(my, jd->height - y);
+
+        for(uint32_t x = 0; x < jd->width; x += mx) {
+            /* Process restart interval if enabled */
+            JRESULT rc = JDR_OK;
+            if(jd->nrst && jd->rst++ == jd->nrst) {
+                rc = jd_restart(jd, jd->rsc++);
+                jd->rst = 1;
+            }
+
+            /* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
+            if(rc == JDR_OK) rc = jd_mcu_load(jd);
+            /* Output the MCU (YCbCr to RGB) into the workbuf, packed to `rx` pixels per line */
+            if(rc == JDR_OK && out) rc = jd_mcu_output(jd, NULL, x, y);
+            if(rc != JDR_OK) {
+                /*Unknown position, start again next time*/
+                stream->next_row = UINT32_MAX;
+                if(out != buf) lv_free(out);
+                return LV_RESULT_INVALID;
+            }
+            if(out == NULL) continue;
+
+            uint32_t rx = LV_MIN(mx, jd->width - x);
+            const uint8_t * src = jd->workbuf;
+            uint8_t * dest = out + x * 3;
+            for(uint32_t i = 0; i < ry; i++) {
+                lv_memcpy(dest, src, rx * 3);
+                src += rx * 3;
+                dest += stride;
+            }
+        }
+
+        if(out == NULL) {
+            ctx->stats.skipped_rows++;
+        }
+        else if(out != buf) {
+            lv_cache_entry_t * entry = row_cache_add(ctx, stream, stream->next_row, out);
+            if(entry) lv_cache_release(ctx->rows, entry, NULL);
+            else lv_free(out);
+        }
+        stream->next_row++;
+    }
+
+    if(!cache_rows && stream->last_row == NULL) stream->last_row = lv_malloc(row_size);
+    if(!cache_rows && stream->last_row) {
+        lv_memcpy(stream->last_row, buf, row_size);
+    }
+    else {
+        lv_free(stream->last_row);
+        stream->last_row = NULL;
+    }
+
+    return LV_RESULT_OK;
+}
+
+static void stream_delete(tjpgd_stream_t * stream)
+{
+    lv_fs_close(&stream->file);
+    if(stream->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)stream->src);
+    lv_free(stream->workb);
+    lv_free(stream->last_row);
+    lv_free(stream);
+}
+
+/**
+ * Add a decoded row to the cache. On success the cache owns `data`.
+ * @return the acquired entry or NULL if it couldn't be added
+ */
+static lv_cache_entry_t * row_cache_add(lv_tjpgd_context_t * ctx, tjpgd_stream_t * stream, uint32_t row,
+                                        uint8_t * data)
+{
+    tjpgd_row_t row_data = {
+        .src = stream->src,
+        .src_type = stream->src_type,
+        .row = row,
+        .data = data,
+    };
+    row_data.slot.size = stream->jd.width * 3 * stream->jd.msy * 8;
+    if(row_data.src_type == LV_IMAGE_SRC_FILE) {
+        row_data.src = lv_strdup(stream->src);
+        if(row_data.src == NULL) return NULL;
+    }
+
+    lv_cache_entry_t * entry = lv_cache_add(ctx->rows, &row_data, NULL);
+    if(entry == NULL) {
+        if(row_data.src_type == LV_IMAGE_SRC_FILE) lv_free((void *)row_data.src);
+        return NULL;
+    }
+
+    uint32_t size = (uint32_t)lv_cache_get_size(ctx->rows, NULL);
+    if(size > ctx->stats.peak_size) ctx->stats.peak_size = size;
+    return entry;
+}
+
+static void session_release_row(lv_tjpgd_context_t * ctx, tjpgd_session_t * session)
+{
+    if(session->entry) {
+        lv_cache_release(ctx->rows, session->entry, NULL);
+        session->entry = NULL;
+    }
+}
+
+static lv_cache_compare_res_t row_compare_cb(const tjpgd_row_t * lhs, const tjpgd_row_t * rhs)
+{
+    if(lhs->src_type != rhs->src_type) return lhs->src_type > rhs->src_type ? 1 : -1;
+
+    if(lhs->src_type == LV_IMAGE_SRC_FILE) {
+        int32_t cmp_res = lv_strcmp(lhs->src, rhs->src);
+        if(cmp_res != 0) return cmp_res > 0 ? 1 : -1;
+    }
+    else if(lhs->src != rhs->src) {
+        return lhs->src > rhs->src ? 1 : -1;
+    }
+
+    if(lhs->row != rhs->row) return lhs->row > rhs->row ? 1 : -1;
+    return 0;
+}
+
+static void row_free_cb(tjpgd_row_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+    if(node->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)node->src);
+    lv_free(node->data);
+}
+
 #endif /*LV_USE_TJPGD*/
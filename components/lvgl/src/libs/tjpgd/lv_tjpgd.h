@@ -13,6 +13,8 @@ extern "C" {
 /*********************
  *      INCLUDES
  *********************/
+#include "../../lv_conf_internal.h"
+#include "../../misc/lv_types.h"
 
 #if LV_USE_TJPGD
 
@@ -24,6 +26,20 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/**
+ * Statistics of the decoded MCU row cache.
+ * An MCU row is a full width strip of the image, 8 or 16 pixels high.
+ */
+typedef struct {
+    uint32_t hits;          /**< MCU rows served from the cache */
+    uint32_t misses;        /**< MCU rows which had to be decoded */
+    uint32_t skipped_rows;  /**< MCU rows parsed only to reach a later row (not converted to RGB) */
+    uint32_t restarts;      /**< Decoding had to start again from the beginning of an image */
+    uint32_t size;          /**< Bytes of decoded pixels in the cache now */
+    uint32_t max_size;      /**< The budget set by `LV_TJPGD_CACHE_SIZE` or `lv_tjpgd_cache_resize()` */
+    uint32_t peak_size;     /**< Largest `size` seen so far */
+} lv_tjpgd_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -32,6 +48,26 @@ void lv_tjpgd_init(void);
 
 void lv_tjpgd_deinit(void);
 
+/**
+ * Set the memory budget of the decoded MCU row cache.
+ * Rows over the budget are evicted, the least recently used first.
+ * @param new_size  new budget in bytes, 0 to disable the cache
+ */
+void lv_tjpgd_cache_resize(uint32_t new_size);
+
+/**
+ * Drop the decoded rows and the open decoding stream of an image,
+ * e.g. because the file has been changed.
+ * @param src       the image source (file name or `lv_image_dsc_t *`), NULL to drop everything
+ */
+void lv_tjpgd_cache_drop(const void * src);
+
+/**
+ * Get the statistics of the decoded MCU row cache.
+ * @param stats     store the statistics here
+ */
+void lv_tjpgd_get_cache_stats(lv_tjpgd_cache_stats_t * stats);
+
 /**********************
  *      MACROS
  **********************/
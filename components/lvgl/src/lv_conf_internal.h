@@ -343,7 +343,7 @@
 /* If a widget has `style_opa < 255` (not `bg_opa`, `text_opa` etc) or not NORMAL blend mode
  * it is buffered into a "simple" layer before rendering. The widget can be buffered in smaller chunks.
  * "Transformed layers" (if `transform_angle/zoom` are set) use larger buffers
- * and can't be drawn in chunks. */
+ * and are drawn in chunks only if `LV_DRAW_LAYER_TRANSFORM_BUF_SIZE` is set. */
 
 /** The target buffer size for simple layer chunks. */
 #ifndef LV_DRAW_LAYER_SIMPLE_BUF_SIZE
@@ -354,9 +354,23 @@
     #endif
 #endif
 
+/** The target buffer size for transformed layer chunks.
+ * The transformed widget is drawn in tiles of the screen whose (not transformed) source area fits into this size.
+ * Set it to 0 to draw the whole widget on one layer. */
+#ifndef LV_DRAW_LAYER_TRANSFORM_BUF_SIZE
+    #ifdef CONFIG_LV_DRAW_LAYER_TRANSFORM_BUF_SIZE
+        #define LV_DRAW_LAYER_TRANSFORM_BUF_SIZE CONFIG_LV_DRAW_LAYER_TRANSFORM_BUF_SIZE
+    #else
+        #define LV_DRAW_LAYER_TRANSFORM_BUF_SIZE 0  /**< [bytes]*/
+    #endif
+#endif
+
 /* Limit the max allocated memory for simple and transformed layers.
  * It should be at least `LV_DRAW_LAYER_SIMPLE_BUF_SIZE` sized but if transformed layers are also used
- * it should be enough to store the largest widget too (width x height x 4 area).
+ * it should be enough to store the largest widget too (width x height x 4 area) or the largest
+ * `LV_DRAW_LAYER_TRANSFORM_BUF_SIZE` chunk.
+ * A layer which doesn't fit is drawn when an other one is freed. The limit is exceeded only if
+ * the layers using the memory might wait for this one (e.g. nested layers).
  * Set it to 0 to have no limit. */
 #ifndef LV_DRAW_LAYER_MAX_MEMORY
     #ifdef CONFIG_LV_DRAW_LAYER_MAX_MEMORY
@@ -366,6 +380,17 @@
     #endif
 #endif
 
+/** Keep this many freed layer buffers to reuse them for the next layers
+ * instead of freeing and allocating them again. They are counted in `LV_DRAW_LAYER_MAX_MEMORY`.
+ * Set it to 0 to free the layer buffers immediately. */
+#ifndef LV_DRAW_LAYER_BUF_POOL_CNT
+    #ifdef CONFIG_LV_DRAW_LAYER_BUF_POOL_CNT
+        #define LV_DRAW_LAYER_BUF_POOL_CNT CONFIG_LV_DRAW_LAYER_BUF_POOL_CNT
+    #else
+        #define LV_DRAW_LAYER_BUF_POOL_CNT 0
+    #endif
+#endif
+
 /** Stack size of drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -615,6 +640,30 @@
         #endif
     #endif
 
+    /** Size of the cache of the calculated gradient color maps and blurred shadow corners [bytes].
+     *  Unlike `LV_DRAW_SW_SHADOW_CACHE_SIZE` it keeps many items, shared by the draw units,
+     *  and can be saved to a file and preloaded at boot (see `lv_draw_sw_cache_save()`).
+     *  Items larger than half of the cache are not cached.
+     *  - 0: disables caching */
+    #ifndef LV_DRAW_SW_CACHE_SIZE
+        #ifdef CONFIG_LV_DRAW_SW_CACHE_SIZE
+            #define LV_DRAW_SW_CACHE_SIZE CONFIG_LV_DRAW_SW_CACHE_SIZE
+        #else
+            #define LV_DRAW_SW_CACHE_SIZE 0
+        #endif
+    #endif
+
+    /** Draw the images rotated by 90, 180 or 270 degrees at 1:1 scale by copying the pixels
+     *  instead of with the general (interpolating) transform.
+     *  - 0: use the general transform, e.g. as a reference in tests */
+    #ifndef LV_DRAW_SW_RIGHT_ANGLE_ROTATION
+        #ifdef CONFIG_LV_DRAW_SW_RIGHT_ANGLE_ROTATION
+            #define LV_DRAW_SW_RIGHT_ANGLE_ROTATION CONFIG_LV_DRAW_SW_RIGHT_ANGLE_ROTATION
+        #else
+            #define LV_DRAW_SW_RIGHT_ANGLE_ROTATION 1
+        #endif
+    #endif
+
     #ifndef LV_USE_DRAW_SW_ASM
         #ifdef CONFIG_LV_USE_DRAW_SW_ASM
             #define LV_USE_DRAW_SW_ASM CONFIG_LV_USE_DRAW_SW_ASM
@@ -1329,6 +1378,18 @@
     #endif
 #endif
 
+/** Evict the decoded images by cost instead of LRU order (Greedy-Dual-Size-Frequency).
+ *  Small images, images used often and images which took long to decode are kept longer,
+ *  large images which were quick to decode are evicted first.
+ *  Set a microsecond clock with `lv_image_cache_set_clock_cb()` to measure the decoding time. */
+#ifndef LV_IMAGE_CACHE_USE_GDSF
+    #ifdef CONFIG_LV_IMAGE_CACHE_USE_GDSF
+        #define LV_IMAGE_CACHE_USE_GDSF CONFIG_LV_IMAGE_CACHE_USE_GDSF
+    #else
+        #define LV_IMAGE_CACHE_USE_GDSF 0
+    #endif
+#endif
+
 /** Default number of image header cache entries. The cache is used to store the headers of images
  *  The main logic is like `LV_CACHE_DEF_SIZE` but for image headers. */
 #ifndef LV_IMAGE_HEADER_CACHE_DEF_CNT
@@ -1390,6 +1451,27 @@
     #endif
 #endif
 
+/** Keep a rendered copy of widgets with `LV_OBJ_FLAG_CACHE_AS_BITMAP` and its children
+ *  and blend it instead of redrawing them until something in them is invalidated. */
+#ifndef LV_USE_OBJ_BITMAP_CACHE
+    #ifdef CONFIG_LV_USE_OBJ_BITMAP_CACHE
+        #define LV_USE_OBJ_BITMAP_CACHE CONFIG_LV_USE_OBJ_BITMAP_CACHE
+    #else
+        #define LV_USE_OBJ_BITMAP_CACHE 0
+    #endif
+#endif
+#if LV_USE_OBJ_BITMAP_CACHE
+    /** Memory budget shared by all the cached widget bitmaps.
+     *  The least recently used bitmaps are freed when it's exceeded. */
+    #ifndef LV_OBJ_BITMAP_CACHE_SIZE
+        #ifdef CONFIG_LV_OBJ_BITMAP_CACHE_SIZE
+            #define LV_OBJ_BITMAP_CACHE_SIZE CONFIG_LV_OBJ_BITMAP_CACHE_SIZE
+        #else
+            #define LV_OBJ_BITMAP_CACHE_SIZE (64 * 1024)    /**< [bytes]*/
+        #endif
+    #endif
+#endif
+
 /** Automatically assign an ID when obj is created */
 #ifndef LV_OBJ_ID_AUTO_ASSIGN
     #ifdef CONFIG_LV_OBJ_ID_AUTO_ASSIGN
@@ -1923,6 +2005,17 @@
     #endif
 #endif
 
+/** Size of the decoded glyph bitmap cache of the built-in fonts in bytes.
+ *  Glyphs are decoded to A8 once and reused until evicted in LRU order.
+ *  0: disable the cache and decode the glyphs on every draw. */
+#ifndef LV_FONT_GLYPH_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+        #define LV_FONT_GLYPH_CACHE_SIZE CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+    #else
+        #define LV_FONT_GLYPH_CACHE_SIZE 0
+    #endif
+#endif
+
 /** Enable drawing placeholders when glyph dsc is not found. */
 #ifndef LV_USE_FONT_PLACEHOLDER
     #ifdef LV_KCONFIG_PRESENT
@@ -2974,6 +3067,17 @@
         #define LV_USE_TJPGD 0
     #endif
 #endif
+#if LV_USE_TJPGD
+    /** Bytes of decoded MCU rows (full width strips, RGB888) kept between draws.
+     *  A 320x240 image needs 230400 bytes to stay fully decoded. 0: no cache */
+    #ifndef LV_TJPGD_CACHE_SIZE
+        #ifdef CONFIG_LV_TJPGD_CACHE_SIZE
+            #define LV_TJPGD_CACHE_SIZE CONFIG_LV_TJPGD_CACHE_SIZE
+        #else
+            #define LV_TJPGD_CACHE_SIZE 0
+        #endif
+    #endif
+#endif
 
 /** libjpeg-turbo decoder library.
  *  - Supports complete JPEG specifications and high-performance JPEG decoding. */
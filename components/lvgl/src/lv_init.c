@@ -39,6 +39,7 @@
 #include "misc/lv_fs.h"
 #include "osal/lv_os_private.h"
 #include "others/sysmon/lv_sysmon_private.h"
+#include "others/observer/lv_observer_private.h"
 #include "others/xml/lv_xml.h"
 
 #if LV_USE_SVG
@@ -280,11 +281,16 @@ void lv_init(void)
     /*Initialize the screen refresh system*/
     lv_refr_init();
 
+#if LV_USE_OBJ_BITMAP_CACHE
+    lv_obj_bitmap_cache_init();
+#endif
+
 #if LV_USE_SYSMON
     lv_sysmon_builtin_init();
 #endif
 
     lv_image_decoder_init(LV_CACHE_DEF_SIZE, LV_IMAGE_HEADER_CACHE_DEF_CNT);
+    lv_font_glyph_cache_init(LV_FONT_GLYPH_CACHE_SIZE);
     lv_bin_decoder_init();  /*LVGL built-in binary image decoder*/
 
 #if LV_USE_DRAW_VG_LITE
@@ -446,6 +452,20 @@ void lv_deinit(void)
     lv_theme_mono_deinit();
 #endif
 
+#if LV_USE_OBJ_BITMAP_CACHE
+    lv_obj_bitmap_cache_deinit();
+#endif
+
+    lv_font_glyph_cache_deinit();
+
+#if LV_USE_OBSERVER
+    lv_subject_deferred_deinit();
+#endif
+
+#if LV_USE_TJPGD
+    lv_tjpgd_deinit();
+#endif
+
     lv_image_decoder_deinit();
 
     lv_refr_deinit();
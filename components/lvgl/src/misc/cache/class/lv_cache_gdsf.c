@@ -0,0 +1,429 @@
+/**
+* @file lv_cache_gdsf.c
+*
+*/
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_cache_gdsf.h"
+#include "../lv_cache_entry.h"
+#include "../../../stdlib/lv_string.h"
+#include "../../lv_ll.h"
+#include "../../lv_rb_private.h"
+#include "../../lv_rb.h"
+#include "../../lv_iter.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Fixed point scale of `cost / size`. The cost is typically in us and the size in bytes,
+ *so without scaling most of the entries would have 0 priority.*/
+#define GDSF_PRIO_SCALE     1024
+
+#define GDSF_FREQ_MAX       UINT16_MAX
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Stored after the entry in the RB node (not aligned, always copied)*/
+typedef struct {
+    uint64_t base;      /*`L` when the entry was used the last time*/
+    uint32_t freq;      /*Number of times the entry was added or found*/
+    void * ll_node;     /*Node in the recently used list*/
+} gdsf_meta_t;
+
+struct _lv_gdsf_t {
+    lv_cache_t cache;
+
+    lv_rb_t rb;
+    lv_ll_t ll;         /*`lv_rb_node_t *`s, the most recently used is the head*/
+
+    uint64_t inflation; /*`L`: priority of the last victim*/
+};
+typedef struct _lv_gdsf_t lv_gdsf_t_;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void * alloc_cb(void);
+static bool init_cb(lv_cache_t * cache);
+static void destroy_cb(lv_cache_t * cache, void * user_data);
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data);
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data);
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void drop_all_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data);
+
+static lv_iter_t * cache_iter_create_cb(lv_cache_t * cache);
+static lv_result_t cache_iter_next_cb(void * instance, void * context, void * elem);
+
+static void meta_get(lv_gdsf_t_ * gdsf, lv_rb_node_t * node, gdsf_meta_t * meta);
+static void meta_set(lv_gdsf_t_ * gdsf, lv_rb_node_t * node, const gdsf_meta_t * meta);
+static uint64_t get_priority(const void * data, const gdsf_meta_t * meta);
+static void unlink_node(lv_gdsf_t_ * gdsf, lv_rb_node_t * node);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+const lv_cache_class_t lv_cache_class_gdsf = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb,
+    .iter_create_cb = cache_iter_create_cb,
+};
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void * alloc_cb(void)
+{
+    void * res = lv_malloc(sizeof(lv_gdsf_t_));
+    LV_ASSERT_MALLOC(res);
+    if(res == NULL) {
+        LV_LOG_ERROR("malloc failed");
+        return NULL;
+    }
+
+    lv_memzero(res, sizeof(lv_gdsf_t_));
+    return res;
+}
+
+static bool init_cb(lv_cache_t * cache)
+{
+    lv_gdsf_t_ * gdsf = (lv_gdsf_t_ *)cache;
+
+    LV_ASSERT_NULL(gdsf->cache.ops.compare_cb);
+    LV_ASSERT_NULL(gdsf->cache.ops.free_cb);
+    LV_ASSERT(gdsf->cache.node_size >= sizeof(lv_cache_slot_cost_t));
+
+    if(gdsf->cache.node_size < sizeof(lv_cache_slot_cost_t) || gdsf->cache.ops.compare_cb == NULL ||
+       gdsf->cache.ops.free_cb == NULL) {
+        return false;
+    }
+
+    /*add the meta data after the entry*/
+    if(!lv_rb_init(&gdsf->rb, gdsf->cache.ops.compare_cb,
+                   lv_cache_entry_get_size(gdsf->cache.node_size) + sizeof(gdsf_meta_t))) {
+        return false;
+    }
+    lv_ll_init(&gdsf->ll, sizeof(void *));
+    gdsf->inflation = 0;
+
+    return true;
+}
+
+static void destroy_cb(lv_cache_t * cache, void * user_data)
+{
+    lv_gdsf_t_ * gdsf = (lv_gdsf_t_ *)cache;
+
+    LV_ASSERT_NULL(gdsf);
+
+    if(gdsf == NULL) {
+        return;
+    }
+
+    cache->clz->drop_all_cb(cache, user_data);
+}
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_gdsf_t_ * gdsf = (lv_gdsf_t_ *)cache;
+
+    LV_ASSERT_NULL(gdsf);
+    LV_ASSERT_NULL(key);
+
+    if(gdsf == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&gdsf->rb, key);
+    if(node == NULL) {
+        return NULL;
+    }
+
+    /*cache hit: the priority is counted from the current `L` again*/
+    gdsf_meta_t meta;
+    meta_get(gdsf, node, &meta);
+    meta.base = gdsf->inflation;
+    if(meta.freq < GDSF_FREQ_MAX) meta.freq++;
+    meta_set(gdsf, node, &meta);
+
+    lv_ll_move_before(&gdsf->ll, meta.ll_node, lv_ll_get_head(&gdsf->ll));
+
+    return lv_cache_entry_get_entry(node->data, cache->node_size);
+}
+
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_gdsf_t_ * gdsf = (lv_gdsf_t_ *)cache;
+
+    LV_ASSERT_NULL(gdsf);
+    LV_ASSERT_NULL(key);
+
+    if(gdsf == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_insert(&gdsf->rb, (void *)key);
+    if(node == NULL) {
+        return NULL;
+    }
+
+    void * ll_node = lv_ll_ins_head(&gdsf->ll);
+    if(ll_node == NULL) {
+        lv_rb_drop_node(&gdsf->rb, node);
+        return NULL;
+    }
+    lv_memcpy(ll_node, &node, sizeof(void *));
+
+    lv_memcpy(node->data, key, cache->node_size);
+    gdsf_meta_t meta = {
+        .base = gdsf->inflation,
+        .freq = 1,
+        .ll_node = ll_node,
+    };
+    meta_set(gdsf, node, &meta);
+
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(node->data, cache->node_size);
+    lv_cache_entry_init(entry, cache, cache->node_size);
+
+    cache->size += ((const lv_cache_slot_cost_t *)key)->size;
+
+    return entry;
+}
+
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_gdsf_t_ * gdsf = (lv_gdsf_t_ *)cache;
+
+    LV_ASSERT_NULL(gdsf);
+    LV_ASSERT_NULL(entry);
+
+    if(gdsf == NULL || entry == NULL) {
+        return;
+    }
+
+    void * data = lv_cache_entry_get_data(entry);
+    lv_rb_node_t * node = lv_rb_find(&gdsf->rb, data);
+    if(node == NULL) {
+        return;
+    }
+
+    cache->size -= ((lv_cache_slot_cost_t *)data)->size;
+
+    /*The entry's data is not freed, it's either freed by the caller or when it's released*/
+    unlink_node(gdsf, node);
+    lv_rb_remove_node(&gdsf->rb, node);
+}
+
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    lv_gdsf_t_ * gdsf = (lv_gdsf_t_ *)cache;
+
+    LV_ASSERT_NULL(gdsf);
+    LV_ASSERT_NULL(key);
+
+    if(gdsf == NULL || key == NULL) {
+        return;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&gdsf->rb, key);
+    if(node == NULL) {
+        return;
+    }
+
+    void * data = node->data;
+
+    gdsf->cache.ops.free_cb(data, user_data);
+    cache->size -= ((lv_cache_slot_cost_t *)data)->size;
+
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(data, cache->node_size);
+    unlink_node(gdsf, node);
+    lv_rb_remove_node(&gdsf->rb, node);
+    lv_cache_entry_delete(entry);
+}
+
+static void drop_all_cb(lv_cache_t * cache, void * user_data)
+{
+    lv_gdsf_t_ * gdsf = (lv_gdsf_t_ *)cache;
+
+    LV_ASSERT_NULL(gdsf);
+
+    if(gdsf == NULL) {
+        return;
+    }
+
+    uint32_t used_cnt = 0;
+    lv_rb_node_t ** node;
+    LV_LL_READ(&gdsf->ll, node) {
+        /*free user handled data and do other clean up*/
+        void * search_key = (*node)->data;
+        lv_cache_entry_t * entry = lv_cache_entry_get_entry(search_key, cache->node_size);
+        if(lv_cache_entry_get_ref(entry) == 0) {
+            gdsf->cache.ops.free_cb(search_key, user_data);
+        }
+        else {
+            LV_LOG_WARN("entry (%p) is still referenced (%" LV_PRId32 ")", (void *)entry, lv_cache_entry_get_ref(entry));
+            used_cnt++;
+        }
+    }
+    if(used_cnt > 0) {
+        LV_LOG_WARN("%" LV_PRId32 " entries are still referenced", used_cnt);
+    }
+
+    lv_rb_destroy(&gdsf->rb);
+    lv_ll_clear(&gdsf->ll);
+
+    cache->size = 0;
+    gdsf->inflation = 0;
+}
+
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_gdsf_t_ * gdsf = (lv_gdsf_t_ *)cache;
+
+    LV_ASSERT_NULL(gdsf);
+
+    /*The caches using this class hold a few tens of large entries (e.g. decoded images),
+     *a linear search is cheaper than keeping the priorities sorted on every hit.
+     *Start from the least recently used to evict the older one on equal priority.*/
+    lv_cache_entry_t * victim = NULL;
+    uint64_t victim_prio = UINT64_MAX;
+    lv_rb_node_t ** node;
+    LV_LL_READ_BACK(&gdsf->ll, node) {
+        lv_cache_entry_t * entry = lv_cache_entry_get_entry((*node)->data, cache->node_size);
+        if(lv_cache_entry_get_ref(entry) != 0) continue;
+
+        gdsf_meta_t meta;
+        meta_get(gdsf, *node, &meta);
+        uint64_t prio = get_priority((*node)->data, &meta);
+        if(victim == NULL || prio < victim_prio) {
+            victim = entry;
+            victim_prio = prio;
+        }
+    }
+
+    /*The victim is removed right after this. Let the others age relative to it.*/
+    if(victim && victim_prio > gdsf->inflation) gdsf->inflation = victim_prio;
+
+    return victim;
+}
+
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_gdsf_t_ * gdsf = (lv_gdsf_t_ *)cache;
+
+    LV_ASSERT_NULL(gdsf);
+
+    if(gdsf == NULL) {
+        return LV_CACHE_RESERVE_COND_ERROR;
+    }
+
+    size_t data_size = key ? ((const lv_cache_slot_cost_t *)key)->size : 0;
+    if(data_size > cache->max_size) {
+        LV_LOG_ERROR("data size (%" LV_PRIu32 ") is larger than max size (%" LV_PRIu32 ")", (uint32_t)data_size,
+                     cache->max_size);
+        return LV_CACHE_RESERVE_COND_TOO_LARGE;
+    }
+
+    return cache->size + reserved_size + data_size > cache->max_size
+           ? LV_CACHE_RESERVE_COND_NEED_VICTIM
+           : LV_CACHE_RESERVE_COND_OK;
+}
+
+static lv_iter_t * cache_iter_create_cb(lv_cache_t * cache)
+{
+    return lv_iter_create(cache, lv_cache_entry_get_size(cache->node_size), sizeof(void *), cache_iter_next_cb);
+}
+
+static lv_result_t cache_iter_next_cb(void * instance, void * context, void * elem)
+{
+    lv_gdsf_t_ * gdsf = (lv_gdsf_t_ *)instance;
+    lv_rb_node_t *** ll_node = context;
+
+    LV_ASSERT_NULL(ll_node);
+
+    if(*ll_node == NULL) *ll_node = lv_ll_get_head(&gdsf->ll);
+    else *ll_node = lv_ll_get_next(&gdsf->ll, *ll_node);
+
+    lv_rb_node_t ** node = *ll_node;
+
+    if(node == NULL) return LV_RESULT_INVALID;
+
+    lv_memcpy(elem, (*node)->data, lv_cache_entry_get_size(gdsf->cache.node_size));
+
+    return LV_RESULT_OK;
+}
+
+static void meta_get(lv_gdsf_t_ * gdsf, lv_rb_node_t * node, gdsf_meta_t * meta)
+{
+    lv_memcpy(meta, (uint8_t *)node->data + lv_cache_entry_get_size(gdsf->cache.node_size), sizeof(gdsf_meta_t));
+}
+
+static void meta_set(lv_gdsf_t_ * gdsf, lv_rb_node_t * node, const gdsf_meta_t * meta)
+{
+    lv_memcpy((uint8_t *)node->data + lv_cache_entry_get_size(gdsf->cache.node_size), meta, sizeof(gdsf_meta_t));
+}
+
+/**
+ * `L + frequency * cost / size`. The cost is read from the slot every time,
+ * so it can be set after the entry was added.
+ */
+static uint64_t get_priority(const void * data, const gdsf_meta_t * meta)
+{
+    const lv_cache_slot_cost_t * slot = data;
+    uint64_t size = slot->size ? slot->size : 1;
+    /*+1: entries without measured cost are still kept by frequency and size*/
+    uint64_t value = (uint64_t)meta->freq * ((uint64_t)slot->cost + 1) * GDSF_PRIO_SCALE;
+
+    return meta->base + value / size;
+}
+
+static void unlink_node(lv_gdsf_t_ * gdsf, lv_rb_node_t * node)
+{
+    gdsf_meta_t meta;
+    meta_get(gdsf, node, &meta);
+    lv_ll_remove(&gdsf->ll, meta.ll_node);
+    lv_free(meta.ll_node);
+}
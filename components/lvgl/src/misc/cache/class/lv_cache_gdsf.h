@@ -0,0 +1,53 @@
+/**
+* @file lv_cache_gdsf.h
+*
+*/
+
+#ifndef LV_CACHE_GDSF_H
+#define LV_CACHE_GDSF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../lv_cache_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/*************************
+ *    GLOBAL VARIABLES
+ *************************/
+
+/**
+ * Size based cache with Greedy-Dual-Size-Frequency eviction policy.
+ * The data struct has to start with `lv_cache_slot_cost_t`.
+ * The victim is the entry with the lowest `L + frequency * cost / size` priority,
+ * where `L` is the priority of the last victim. So large entries which are cheap to
+ * create again are evicted first, and entries not used for a long time age out
+ * as `L` grows.
+ */
+LV_ATTRIBUTE_EXTERN_DATA extern const lv_cache_class_t lv_cache_class_gdsf;
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_CACHE_GDSF_H*/
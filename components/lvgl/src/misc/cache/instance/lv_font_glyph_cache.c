@@ -0,0 +1,263 @@
+/**
+* @file lv_font_glyph_cache.c
+*
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../lv_cache_private.h"
+#include "../../lv_assert.h"
+#include "../../../core/lv_global.h"
+#include "../../../draw/lv_draw_buf_private.h"
+
+#include "lv_font_glyph_cache.h"
+#include "../../lv_iter.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define CACHE_NAME  "FONT_GLYPH"
+
+#define font_glyph_cache_p (LV_GLOBAL_DEFAULT()->font_glyph_cache)
+#define font_glyph_cache_stats (LV_GLOBAL_DEFAULT()->font_glyph_cache_stats)
+#define font_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->font_draw_buf_handlers)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_cache_slot_size_t slot;
+
+    const lv_font_t * font;
+    uint32_t gid;
+
+    lv_draw_buf_t * draw_buf;
+} lv_font_glyph_cache_data_t;
+
+typedef struct {
+    lv_font_glyph_dsc_t * g_dsc;
+    lv_font_glyph_cache_decode_cb_t decode_cb;
+} font_glyph_create_ctx_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static lv_cache_compare_res_t font_glyph_cache_compare_cb(const lv_font_glyph_cache_data_t * lhs,
+                                                          const lv_font_glyph_cache_data_t * rhs);
+static bool font_glyph_cache_create_cb(lv_font_glyph_cache_data_t * data, font_glyph_create_ctx_t * ctx);
+static void font_glyph_cache_free_cb(lv_font_glyph_cache_data_t * data, void * user_data);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_font_glyph_cache_init(uint32_t size)
+{
+    if(font_glyph_cache_p != NULL) {
+        return LV_RESULT_OK;
+    }
+
+    font_glyph_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+    sizeof(lv_font_glyph_cache_data_t), size, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) font_glyph_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) font_glyph_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) font_glyph_cache_free_cb,
+    });
+
+    lv_cache_set_name(font_glyph_cache_p, CACHE_NAME);
+    lv_font_glyph_cache_reset_stats();
+    return font_glyph_cache_p != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+void lv_font_glyph_cache_deinit(void)
+{
+    if(font_glyph_cache_p == NULL) return;
+
+    lv_cache_destroy(font_glyph_cache_p, NULL);
+    font_glyph_cache_p = NULL;
+}
+
+void lv_font_glyph_cache_resize(uint32_t new_size, bool evict_now)
+{
+    lv_cache_set_max_size(font_glyph_cache_p, new_size, NULL);
+    if(evict_now) {
+        lv_cache_reserve(font_glyph_cache_p, new_size, NULL);
+    }
+}
+
+void lv_font_glyph_cache_drop(const lv_font_t * font)
+{
+    if(font_glyph_cache_p == NULL) return;
+
+    if(font == NULL) {
+        lv_cache_drop_all(font_glyph_cache_p, NULL);
+        return;
+    }
+
+    /*`lv_cache_drop` has no range form, so look up the glyphs of the font one by one.
+     *It's called only when a font is destroyed, hence the quadratic walk is fine.*/
+    void * elem = lv_malloc(lv_cache_entry_get_size(font_glyph_cache_p->node_size));
+    LV_ASSERT_MALLOC(elem);
+    if(elem == NULL) return;
+
+    bool found = true;
+    while(found) {
+        found = false;
+        lv_iter_t * iter = lv_cache_iter_create(font_glyph_cache_p);
+        if(iter == NULL) break;
+
+        while(lv_iter_next(iter, elem) == LV_RESULT_OK) {
+            lv_font_glyph_cache_data_t * data = elem;
+            if(data->font == font) {
+                found = true;
+                break;
+            }
+        }
+        lv_iter_destroy(iter);
+
+        if(found) lv_cache_drop(font_glyph_cache_p, elem, NULL);
+    }
+
+    lv_free(elem);
+}
+
+bool lv_font_glyph_cache_is_enabled(void)
+{
+    return font_glyph_cache_p != NULL && lv_cache_is_enabled(font_glyph_cache_p);
+}
+
+lv_draw_buf_t * lv_font_glyph_cache_acquire(lv_font_glyph_dsc_t * g_dsc, lv_font_glyph_cache_decode_cb_t decode_cb)
+{
+    LV_ASSERT_NULL(g_dsc);
+    LV_ASSERT_NULL(decode_cb);
+
+    /*Already acquired with this descriptor, don't take a second reference*/
+    if(g_dsc->entry) {
+        lv_font_glyph_cache_data_t * data = lv_cache_entry_get_data(g_dsc->entry);
+        return data->draw_buf;
+    }
+
+    if(!lv_font_glyph_cache_is_enabled()) {
+        font_glyph_cache_stats.bypassed++;
+        return NULL;
+    }
+
+    lv_font_glyph_cache_data_t search_key;
+    search_key.font = g_dsc->resolved_font;
+    search_key.gid = g_dsc->gid.index;
+    search_key.draw_buf = NULL;
+    search_key.slot.size = lv_draw_buf_width_to_stride_ex(font_draw_buf_handlers, g_dsc->box_w, LV_COLOR_FORMAT_A8) *
+                           g_dsc->box_h + sizeof(lv_draw_buf_t);
+
+    /*On a miss `font_glyph_cache_create_cb` decodes the glyph while the cache is locked*/
+    font_glyph_create_ctx_t ctx = {
+        .g_dsc = g_dsc,
+        .decode_cb = decode_cb,
+    };
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(font_glyph_cache_p, &search_key, &ctx);
+    if(entry == NULL) {
+        font_glyph_cache_stats.bypassed++;
+        return NULL;
+    }
+
+    font_glyph_cache_stats.hits++;
+    g_dsc->entry = entry;
+
+    lv_font_glyph_cache_data_t * data = lv_cache_entry_get_data(entry);
+    return data->draw_buf;
+}
+
+void lv_font_glyph_cache_release(lv_font_glyph_dsc_t * g_dsc)
+{
+    LV_ASSERT_NULL(g_dsc);
+    if(g_dsc->entry == NULL) return;
+
+    lv_cache_release(font_glyph_cache_p, g_dsc->entry, NULL);
+    g_dsc->entry = NULL;
+}
+
+void lv_font_glyph_cache_get_stats(lv_font_glyph_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+
+    *stats = font_glyph_cache_stats;
+    /*Every lookup counted as a hit first, misses are subtracted here*/
+    stats->hits = stats->hits >= stats->misses ? stats->hits - stats->misses : 0;
+}
+
+void lv_font_glyph_cache_reset_stats(void)
+{
+    lv_memzero(&font_glyph_cache_stats, sizeof(lv_font_glyph_cache_stats_t));
+}
+
+lv_iter_t * lv_font_glyph_cache_iter_create(void)
+{
+    return lv_cache_iter_create(font_glyph_cache_p);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_cache_compare_res_t font_glyph_cache_compare_cb(const lv_font_glyph_cache_data_t * lhs,
+                                                          const lv_font_glyph_cache_data_t * rhs)
+{
+    if(lhs->font != rhs->font) {
+        return lhs->font > rhs->font ? 1 : -1;
+    }
+
+    if(lhs->gid != rhs->gid) {
+        return lhs->gid > rhs->gid ? 1 : -1;
+    }
+
+    return 0;
+}
+
+static bool font_glyph_cache_create_cb(lv_font_glyph_cache_data_t * data, font_glyph_create_ctx_t * ctx)
+{
+    lv_font_glyph_dsc_t * g_dsc = ctx->g_dsc;
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create_ex(font_draw_buf_handlers, g_dsc->box_w, g_dsc->box_h,
+                                                     LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    if(draw_buf == NULL) {
+        data->draw_buf = NULL;
+        return false;
+    }
+
+    if(ctx->decode_cb(g_dsc, draw_buf) == NULL) {
+        lv_draw_buf_destroy(draw_buf);
+        data->draw_buf = NULL;
+        return false;
+    }
+
+    data->draw_buf = draw_buf;
+    font_glyph_cache_stats.misses++;
+    return true;
+}
+
+static void font_glyph_cache_free_cb(lv_font_glyph_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    if(data->draw_buf == NULL) return;
+
+    lv_draw_buf_destroy(data->draw_buf);
+    data->draw_buf = NULL;
+    font_glyph_cache_stats.evictions++;
+}
@@ -0,0 +1,126 @@
+/**
+* @file lv_font_glyph_cache.h
+*
+ */
+
+#ifndef LV_FONT_GLYPH_CACHE_H
+#define LV_FONT_GLYPH_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../lv_types.h"
+#include "../../../font/lv_font.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Decode a glyph into an A8 draw buffer of `box_w` x `box_h` size.
+ * Same signature as `lv_font_t::get_glyph_bitmap`.
+ */
+typedef const void * (*lv_font_glyph_cache_decode_cb_t)(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf);
+
+typedef struct {
+    uint32_t hits;          /**< Glyphs served from the cache*/
+    uint32_t misses;        /**< Glyphs decoded and added to the cache*/
+    uint32_t evictions;     /**< Glyphs removed to make room or dropped*/
+    uint32_t bypassed;      /**< Glyphs decoded without caching (cache disabled or glyph too large)*/
+} lv_font_glyph_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the glyph bitmap cache of the built-in (`lv_font_fmt_txt`) fonts.
+ * Decoded A8 glyph bitmaps are kept per font and glyph id and evicted in LRU order.
+ * The bitmaps are allocated with the font draw buffer handlers (see `lv_draw_buf_get_font_handlers()`).
+ * @param size  initial size of the cache in bytes. 0 disables the cache.
+ * @return LV_RESULT_OK: initialization succeeded, LV_RESULT_INVALID: failed.
+ */
+lv_result_t lv_font_glyph_cache_init(uint32_t size);
+
+/**
+ * Free all cached glyphs and destroy the cache.
+ */
+void lv_font_glyph_cache_deinit(void);
+
+/**
+ * Resize the glyph bitmap cache.
+ * If set to 0, the cache is disabled.
+ * @param new_size  new size of the cache in bytes.
+ * @param evict_now true: evict the glyphs that should be removed by the eviction policy, false: wait for the next cache cleanup.
+ */
+void lv_font_glyph_cache_resize(uint32_t new_size, bool evict_now);
+
+/**
+ * Drop the cached glyphs of a font. Use NULL to drop all glyphs.
+ * It's also automatically called when a binary font is destroyed.
+ * @param font  pointer to a font
+ */
+void lv_font_glyph_cache_drop(const lv_font_t * font);
+
+/**
+ * Return true if the glyph bitmap cache is enabled.
+ * @return true: enabled, false: disabled.
+ */
+bool lv_font_glyph_cache_is_enabled(void);
+
+/**
+ * Get the decoded A8 bitmap of a glyph from the cache, decoding it on a miss.
+ * On success `g_dsc->entry` holds a reference which has to be released with
+ * `lv_font_glyph_cache_release()` (done by `lv_font_glyph_release_draw_data()`).
+ * @param g_dsc     glyph descriptor of an `lv_font_fmt_txt` font
+ * @param decode_cb called on a miss to decode the glyph into the new cache entry
+ * @return          the cached draw buffer or NULL if the glyph can't be cached
+ */
+lv_draw_buf_t * lv_font_glyph_cache_acquire(lv_font_glyph_dsc_t * g_dsc, lv_font_glyph_cache_decode_cb_t decode_cb);
+
+/**
+ * Release a glyph acquired with `lv_font_glyph_cache_acquire()`.
+ * @param g_dsc     glyph descriptor whose `entry` will be released and cleared
+ */
+void lv_font_glyph_cache_release(lv_font_glyph_dsc_t * g_dsc);
+
+/**
+ * Get the hit/miss statistics of the cache.
+ * The counters are updated without locking, so with parallel draw units they are approximate.
+ * @param stats     pointer to a structure to fill
+ */
+void lv_font_glyph_cache_get_stats(lv_font_glyph_cache_stats_t * stats);
+
+/**
+ * Reset the hit/miss statistics of the cache.
+ */
+void lv_font_glyph_cache_reset_stats(void);
+
+/**
+ * Create an iterator to iterate over the glyph bitmap cache.
+ * @return an iterator to iterate over the glyph bitmap cache.
+ */
+lv_iter_t * lv_font_glyph_cache_iter_create(void);
+
+/*************************
+ *    GLOBAL VARIABLES
+ *************************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_FONT_GLYPH_CACHE_H*/
@@ -22,6 +22,14 @@
 
 #define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
+#define image_cache_stats (LV_GLOBAL_DEFAULT()->image_cache_stats)
+#define image_cache_clock_cb (LV_GLOBAL_DEFAULT()->image_cache_clock_cb)
+
+#if LV_IMAGE_CACHE_USE_GDSF
+    #define IMAGE_CACHE_CLASS lv_cache_class_gdsf
+#else
+    #define IMAGE_CACHE_CLASS lv_cache_class_lru_rb_size
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -58,7 +66,7 @@ lv_result_t lv_image_cache_init(uint32_t size)
         return LV_RESULT_OK;
     }
 
-    img_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+    img_cache_p = lv_cache_create(&IMAGE_CACHE_CLASS,
     sizeof(lv_image_cache_data_t), size, (lv_cache_ops_t) {
         .compare_cb = (lv_cache_compare_cb_t) image_cache_compare_cb,
         .create_cb = NULL,
@@ -115,6 +123,34 @@ void lv_image_cache_dump(void)
     lv_iter_inspect(iter, iter_inspect_cb);
 }
 
+void lv_image_cache_set_clock_cb(lv_image_cache_clock_cb_t clock_cb)
+{
+    image_cache_clock_cb = clock_cb;
+}
+
+uint32_t lv_image_cache_get_time(void)
+{
+    if(image_cache_clock_cb) return image_cache_clock_cb();
+    return lv_tick_get() * 1000;
+}
+
+void lv_image_cache_get_stats(lv_image_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+
+    *stats = image_cache_stats;
+    if(img_cache_p == NULL) return;
+
+    stats->size = (uint32_t)lv_cache_get_size(img_cache_p, NULL);
+    stats->max_size = (uint32_t)lv_cache_get_max_size(img_cache_p, NULL);
+    if(stats->size > stats->peak_size) stats->peak_size = stats->size;
+}
+
+void lv_image_cache_reset_stats(void)
+{
+    lv_memzero(&image_cache_stats, sizeof(lv_image_cache_stats_t));
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -150,6 +186,8 @@ static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data)
 {
     LV_UNUSED(user_data);
 
+    image_cache_stats.evictions++;
+
     /* Destroy the decoded draw buffer if necessary. */
     lv_draw_buf_t * decoded = (lv_draw_buf_t *)entry->decoded;
     if(lv_draw_buf_has_flag(decoded, LV_IMAGE_FLAGS_ALLOCATED)) {
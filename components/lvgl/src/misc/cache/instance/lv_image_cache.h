@@ -24,6 +24,26 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/**
+ * Return a time stamp in microseconds to measure how long opening an image takes.
+ * The difference of two calls is used, so it may overflow.
+ */
+typedef uint32_t (*lv_image_cache_clock_cb_t)(void);
+
+typedef struct {
+    uint32_t hits;          /**< Images served from the cache*/
+    uint32_t misses;        /**< Images opened by a decoder and added to the cache*/
+    uint32_t uncached;      /**< Images opened by a decoder which doesn't cache them (e.g. too large for the cache)*/
+    uint32_t evictions;     /**< Images removed to make room or dropped*/
+    uint32_t header_hits;   /**< Image headers served from the header cache*/
+    uint32_t header_misses; /**< Image headers read by the decoders*/
+    uint64_t decode_time;   /**< Time spent in opening the images counted in `misses` [us]*/
+    uint64_t saved_time;    /**< Sum of the measured opening time of the images served from the cache [us]*/
+    uint32_t size;          /**< Bytes of decoded images in the cache now*/
+    uint32_t max_size;      /**< The budget set by `LV_CACHE_DEF_SIZE` or `lv_image_cache_resize()`*/
+    uint32_t peak_size;     /**< Largest `size` seen so far*/
+} lv_image_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -66,6 +86,31 @@ lv_iter_t * lv_image_cache_iter_create(void);
  */
 void lv_image_cache_dump(void);
 
+/**
+ * Set the clock used to measure how long opening (decoding) an image takes.
+ * With `LV_IMAGE_CACHE_USE_GDSF` the images which took longer to open are kept longer.
+ * By default `lv_tick_get()` is used which can't measure small images.
+ * @param clock_cb  return the time in microseconds, NULL to use `lv_tick_get()`
+ */
+void lv_image_cache_set_clock_cb(lv_image_cache_clock_cb_t clock_cb);
+
+/**
+ * Get the current time of the image cache's clock.
+ * @return time in microseconds
+ */
+uint32_t lv_image_cache_get_time(void);
+
+/**
+ * Get the statistics of the image and image header caches.
+ * @param stats     pointer to a structure to fill
+ */
+void lv_image_cache_get_stats(lv_image_cache_stats_t * stats);
+
+/**
+ * Clear the counters of the image cache statistics.
+ */
+void lv_image_cache_reset_stats(void);
+
 /*************************
  *    GLOBAL VARIABLES
  *************************/
@@ -124,9 +124,10 @@ struct _lv_cache_ops_t {
  * The cache entry struct
  */
 struct _lv_cache_t {
-    const lv_cache_class_t * clz;     /**< Cache class. There are two built-in classes:
+    const lv_cache_class_t * clz;     /**< Cache class. There are three built-in classes:
                                        * - lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
-                                       * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy. */
+                                       * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+                                       * - lv_cache_class_gdsf for size-based cache with cost-aware (GDSF) eviction policy. */
 
     uint32_t node_size;               /**< Size of a node */
 
@@ -146,6 +147,7 @@ struct _lv_cache_t {
  * Examples:
  * - lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
  * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+ * - lv_cache_class_gdsf for size-based cache with cost-aware (GDSF) eviction policy.
  */
 struct _lv_cache_class_t {
     lv_cache_alloc_cb_t alloc_cb;                 /**< The allocation function for cache entries */
@@ -168,8 +170,10 @@ struct _lv_cache_class_t {
  *----------------*/
 
 struct _lv_cache_slot_size_t;
+struct _lv_cache_slot_cost_t;
 
 typedef struct _lv_cache_slot_size_t lv_cache_slot_size_t;
+typedef struct _lv_cache_slot_cost_t lv_cache_slot_cost_t;
 
 /**
  * Cache entry slot struct
@@ -180,6 +184,16 @@ typedef struct _lv_cache_slot_size_t lv_cache_slot_size_t;
 struct _lv_cache_slot_size_t {
     size_t size;
 };
+
+/**
+ * Cache entry slot with the cost of creating the data again.
+ * `size` is at the same place as in `lv_cache_slot_size_t`, so the size based classes can be used too.
+ * The cost can be set or updated after the entry was added, e.g. when the decoding time is known.
+ */
+struct _lv_cache_slot_cost_t {
+    size_t size;
+    uint32_t cost;      /**< Cost to create the data again, e.g. decoding time in microseconds */
+};
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -9,6 +9,7 @@
 #include "lv_anim_private.h"
 
 #include "../core/lv_global.h"
+#include "../core/lv_refr_private.h"
 #include "../tick/lv_tick.h"
 #include "lv_assert.h"
 #include "lv_timer.h"
@@ -570,9 +571,16 @@ static void anim_timer(lv_timer_t * param)
     /*Flip the run round*/
     state.anim_run_round = state.anim_run_round ? false : true;
 
+    /*Step all the animations to the same time and request only one refresh per display
+     *for all the invalidations of this frame*/
+    const uint32_t frame_tick = lv_tick_get();
+    lv_refr_inv_batch_begin();
+
     lv_anim_t * a = lv_ll_get_head(anim_ll_p);
     while(a != NULL) {
-        uint32_t elaps = lv_tick_elaps(a->last_timer_run);
+        /*Animations created meanwhile might have a later tick*/
+        int32_t elaps_signed = (int32_t)(frame_tick - a->last_timer_run);
+        uint32_t elaps = elaps_signed > 0 ? (uint32_t)elaps_signed : 0;
 
         if(a->is_paused) {
             const uint32_t time_paused = lv_tick_elaps(a->pause_time);
@@ -588,7 +596,7 @@ static void anim_timer(lv_timer_t * param)
         else {
             a->act_time += elaps;
         }
-        a->last_timer_run = lv_tick_get();
+        a->last_timer_run = frame_tick;
 
         /*It can be set by `lv_anim_delete()` typically in `end_cb`. If set then an animation delete
          * happened in `anim_completed_handler` which could make this linked list reading corrupt
@@ -652,6 +660,7 @@ static void anim_timer(lv_timer_t * param)
             a = lv_ll_get_next(anim_ll_p, a);
     }
 
+    lv_refr_inv_batch_end();
 }
 
 /**
@@ -24,6 +24,9 @@
 #define state LV_GLOBAL_DEFAULT()->timer_state
 #define timer_ll_p &(state.timer_ll)
 
+#define HEAP_NONE       UINT32_MAX          /*Paused, running or not scheduled yet*/
+#define HEAP_DEFERRED   (UINT32_MAX - 1)    /*In `state.deferred`*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -31,9 +34,17 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool lv_timer_exec(lv_timer_t * timer);
+static void lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
 static void lv_timer_handler_resume(void);
+static void timer_schedule(lv_timer_t * timer);
+static void timer_unschedule(lv_timer_t * timer);
+static bool timer_is_due(lv_timer_t * timer, uint32_t now);
+static bool heap_less(const lv_timer_t * a, const lv_timer_t * b);
+static void heap_sift_up(uint32_t i);
+static void heap_sift_down(uint32_t i);
+static void heap_insert(lv_timer_t * timer);
+static void heap_remove(lv_timer_t * timer);
 
 /**********************
  *  STATIC VARIABLES
@@ -90,44 +101,27 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    lv_timer_t * timer_active;
-    lv_ll_t * timer_head = timer_ll_p;
-    do {
-        state_p->timer_deleted             = false;
-        state_p->timer_created             = false;
-
-        timer_active = lv_ll_get_head(timer_head);
-        while(timer_active) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = lv_ll_get_next(timer_head, timer_active);
-
-            if(lv_timer_exec(timer_active)) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(state_p->timer_created || state_p->timer_deleted) {
-                    LV_TRACE_TIMER("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
+    state_p->round++;
 
-            timer_active = next; /*Load the next timer*/
-        }
-    } while(timer_active);
+    /*Run the due timers in the order of their deadlines. The timers created by the callbacks
+     *are run in this round too if they are due. The executed timers which are due again
+     *(period shorter than this round) wait in `deferred` for the next call.*/
+    while(state_p->heap_cnt > 0) {
+        lv_timer_t * timer_active = state_p->heap[0];
+        if(!timer_is_due(timer_active, lv_tick_get())) break;
 
-    uint32_t time_until_next = LV_NO_TIMER_READY;
-    next = lv_ll_get_head(timer_head);
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_until_next)
-                time_until_next = delay;
-        }
+        heap_remove(timer_active);
+        lv_timer_exec(timer_active);
+    }
 
-        next = lv_ll_get_next(timer_head, next); /*Find the next timer*/
+    while(state_p->deferred_cnt > 0) {
+        state_p->deferred_cnt--;
+        heap_insert(state_p->deferred[state_p->deferred_cnt]);
     }
 
+    uint32_t time_until_next = LV_NO_TIMER_READY;
+    if(state_p->heap_cnt > 0) time_until_next = lv_timer_time_remaining(state_p->heap[0]);
+
     state_p->busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(state_p->idle_period_start);
     if(idle_period_time >= IDLE_MEAS_PERIOD) {
@@ -166,6 +160,22 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+    /*Reserve the place in the heap now, so scheduling can't fail later*/
+    if(state.timer_cnt == state.capacity) {
+        uint32_t capacity = state.capacity ? state.capacity * 2 : 16;
+        lv_timer_t ** heap = lv_realloc(state.heap, capacity * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(heap);
+        if(heap == NULL) return NULL;
+        state.heap = heap;
+
+        lv_timer_t ** deferred = lv_realloc(state.deferred, capacity * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(deferred);
+        if(deferred == NULL) return NULL;
+        state.deferred = deferred;
+
+        state.capacity = capacity;
+    }
+
     new_timer = lv_ll_ins_head(timer_ll_p);
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
@@ -177,8 +187,12 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
     new_timer->auto_delete = true;
+    new_timer->seq = state.seq++;
+    new_timer->round = state.round - 1;
+    new_timer->heap_index = HEAP_NONE;
 
-    state.timer_created = true;
+    state.timer_cnt++;
+    timer_schedule(new_timer);
 
     lv_timer_handler_resume();
 
@@ -193,8 +207,11 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
 
 void lv_timer_delete(lv_timer_t * timer)
 {
+    timer_unschedule(timer);
+    if(timer == state.timer_running) state.timer_running_deleted = true;
+
     lv_ll_remove(timer_ll_p, timer);
-    state.timer_deleted = true;
+    state.timer_cnt--;
 
     lv_free(timer);
 }
@@ -203,12 +220,14 @@ void lv_timer_pause(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = true;
+    timer_unschedule(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = false;
+    timer_schedule(timer);
     lv_timer_handler_resume();
 }
 
@@ -216,18 +235,23 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     LV_ASSERT_NULL(timer);
     timer->period = period;
+    timer_schedule(timer);
 }
 
 void lv_timer_ready(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get() - timer->period - 1;
+    timer_schedule(timer);
 }
 
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     LV_ASSERT_NULL(timer);
     timer->repeat_count = repeat_count;
+
+    /*Deleted or paused in the next `lv_timer_handler()`*/
+    if(repeat_count == 0) timer_schedule(timer);
 }
 
 void lv_timer_set_auto_delete(lv_timer_t * timer, bool auto_delete)
@@ -246,6 +270,7 @@ void lv_timer_reset(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get();
+    timer_schedule(timer);
     lv_timer_handler_resume();
 }
 
@@ -260,6 +285,14 @@ void lv_timer_core_deinit(void)
     lv_timer_enable(false);
 
     lv_ll_clear(timer_ll_p);
+    lv_free(state.heap);
+    lv_free(state.deferred);
+    state.heap = NULL;
+    state.deferred = NULL;
+    state.heap_cnt = 0;
+    state.deferred_cnt = 0;
+    state.capacity = 0;
+    state.timer_cnt = 0;
 }
 
 uint32_t lv_timer_get_idle(void)
@@ -304,55 +337,50 @@ bool lv_timer_get_paused(lv_timer_t * timer)
  **********************/
 
 /**
- * Execute timer if its remaining time is zero
- * @param timer pointer to lv_timer
- * @return true: execute, false: not executed
+ * Execute a due timer and schedule it again
+ * @param timer pointer to lv_timer, already removed from the heap
  */
-static bool lv_timer_exec(lv_timer_t * timer)
-{
-    if(timer->paused) return false;
-
-    bool exec = false;
-    if(lv_timer_time_remaining(timer) == 0) {
-        /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
-         * but at least the repeat count is zero and the timer can be deleted in the next round*/
-        int32_t original_repeat_count = timer->repeat_count;
-        if(timer->repeat_count > 0) timer->repeat_count--;
-        timer->last_run = lv_tick_get();
-        LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
-
-        if(timer->timer_cb && original_repeat_count != 0) {
-            LV_PROFILER_TIMER_BEGIN_TAG("timer_cb");
-            timer->timer_cb(timer);
-            LV_PROFILER_TIMER_END_TAG("timer_cb");
-        }
+static void lv_timer_exec(lv_timer_t * timer)
+{
+    /* Decrement the repeat count before executing the timer_cb.
+     * If the timer is deleted by its callback `if(timer->repeat_count == 0)` is not executed below*/
+    int32_t original_repeat_count = timer->repeat_count;
+    if(timer->repeat_count > 0) timer->repeat_count--;
+    timer->last_run = lv_tick_get();
+    timer->round = state.round;
+    LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
+
+    state.timer_running = timer;
+    state.timer_running_deleted = false;
+    if(timer->timer_cb && original_repeat_count != 0) {
+        LV_PROFILER_TIMER_BEGIN_TAG("timer_cb");
+        timer->timer_cb(timer);
+        LV_PROFILER_TIMER_END_TAG("timer_cb");
+    }
+    state.timer_running = NULL;
 
-        if(!state.timer_deleted) {
-            LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
-        }
-        else {
-            LV_TRACE_TIMER("timer callback finished");
-        }
+    LV_ASSERT_MEM_INTEGRITY();
 
-        LV_ASSERT_MEM_INTEGRITY();
-        exec = true;
+    if(state.timer_running_deleted) { /*The timer might be deleted by itself*/
+        LV_TRACE_TIMER("timer callback finished");
+        return;
     }
 
-    if(state.timer_deleted == false) { /*The timer might be deleted by itself as well*/
-        if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
-            if(timer->auto_delete) {
-                LV_TRACE_TIMER("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
-                lv_timer_delete(timer);
-            }
-            else {
-                LV_TRACE_TIMER("pausing timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
-                lv_timer_pause(timer);
-            }
+    LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
+
+    if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
+        if(timer->auto_delete) {
+            LV_TRACE_TIMER("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
+            lv_timer_delete(timer);
+        }
+        else {
+            LV_TRACE_TIMER("pausing timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
+            lv_timer_pause(timer);
         }
+        return;
     }
 
-    return exec;
+    timer_schedule(timer);
 }
 
 /**
@@ -362,11 +390,136 @@ static bool lv_timer_exec(lv_timer_t * timer)
  */
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
 {
-    /*Check if at least 'period' time elapsed*/
-    uint32_t elp = lv_tick_elaps(timer->last_run);
-    if(elp >= timer->period)
-        return 0;
-    return timer->period - elp;
+    int32_t remaining = (int32_t)(timer->deadline - lv_tick_get());
+    return remaining > 0 ? (uint32_t)remaining : 0;
+}
+
+static bool timer_is_due(lv_timer_t * timer, uint32_t now)
+{
+    return (int32_t)(timer->deadline - now) <= 0;
+}
+
+/**
+ * Update the deadline of a timer and put it to its place: in the heap, in `deferred` if it
+ * already ran in this `lv_timer_handler()` and is due again, or nowhere if it's paused.
+ * Changes the heap, so the callers (create, pause, resume, set_period, ready, reset...) need to run
+ * on the LVGL thread or under `lv_lock()`, never from an other task without the lock.
+ * @param timer pointer to lv_timer
+ */
+static void timer_schedule(lv_timer_t * timer)
+{
+    /*The deadlines are compared with wrap around, so they need to be closer than 2^31 ms*/
+    uint32_t period = LV_MIN(timer->period, (uint32_t)INT32_MAX);
+    timer->deadline = timer->last_run + period;
+    if(timer->repeat_count == 0) timer->deadline = timer->last_run;
+
+    if(timer->paused) {
+        timer_unschedule(timer);
+        return;
+    }
+
+    /*Scheduled by `lv_timer_exec()` after the callback returns*/
+    if(timer == state.timer_running) return;
+
+    /*Put back to the heap at the end of `lv_timer_handler()`*/
+    if(timer->heap_index == HEAP_DEFERRED) return;
+
+    if(state.already_running && timer->round == state.round && timer_is_due(timer, lv_tick_get())) {
+        /*Ran in this `lv_timer_handler()` already and due again (e.g. period 0 or made ready
+         *by an other timer): run it only in the next one, else it could keep this one running forever*/
+        if(timer->heap_index != HEAP_NONE) heap_remove(timer);
+        timer->heap_index = HEAP_DEFERRED;
+        state.deferred[state.deferred_cnt++] = timer;
+    }
+    else if(timer->heap_index != HEAP_NONE) {
+        heap_sift_up(timer->heap_index);
+        heap_sift_down(timer->heap_index);
+    }
+    else {
+        heap_insert(timer);
+    }
+}
+
+static void timer_unschedule(lv_timer_t * timer)
+{
+    if(timer->heap_index == HEAP_DEFERRED) {
+        for(uint32_t i = 0; i < state.deferred_cnt; i++) {
+            if(state.deferred[i] == timer) {
+                state.deferred[i] = state.deferred[--state.deferred_cnt];
+                break;
+            }
+        }
+        timer->heap_index = HEAP_NONE;
+    }
+    else if(timer->heap_index != HEAP_NONE) {
+        heap_remove(timer);
+    }
+}
+
+/**
+ * Order of the heap: earlier deadline first, and on the same deadline the newer timer first
+ * as when the timers were run in the order of the list.
+ */
+static bool heap_less(const lv_timer_t * a, const lv_timer_t * b)
+{
+    int32_t diff = (int32_t)(a->deadline - b->deadline);
+    if(diff != 0) return diff < 0;
+    return (int32_t)(a->seq - b->seq) > 0;
+}
+
+static void heap_sift_up(uint32_t i)
+{
+    lv_timer_t ** heap = state.heap;
+    lv_timer_t * timer = heap[i];
+    while(i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if(!heap_less(timer, heap[parent])) break;
+        heap[i] = heap[parent];
+        heap[i]->heap_index = i;
+        i = parent;
+    }
+    heap[i] = timer;
+    timer->heap_index = i;
+}
+
+static void heap_sift_down(uint32_t i)
+{
+    lv_timer_t ** heap = state.heap;
+    uint32_t cnt = state.heap_cnt;
+    lv_timer_t * timer = heap[i];
+    while(1) {
+        uint32_t child = i * 2 + 1;
+        if(child >= cnt) break;
+        if(child + 1 < cnt && heap_less(heap[child + 1], heap[child])) child++;
+        if(!heap_less(heap[child], timer)) break;
+        heap[i] = heap[child];
+        heap[i]->heap_index = i;
+        i = child;
+    }
+    heap[i] = timer;
+    timer->heap_index = i;
+}
+
+static void heap_insert(lv_timer_t * timer)
+{
+    /*`capacity` is at least the number of timers*/
+    state.heap[state.heap_cnt] = timer;
+    state.heap_cnt++;
+    heap_sift_up(state.heap_cnt - 1);
+}
+
+static void heap_remove(lv_timer_t * timer)
+{
+    uint32_t i = timer->heap_index;
+    timer->heap_index = HEAP_NONE;
+
+    state.heap_cnt--;
+    if(i == state.heap_cnt) return;
+
+    state.heap[i] = state.heap[state.heap_cnt];
+    state.heap[i]->heap_index = i;
+    heap_sift_up(i);
+    heap_sift_down(state.heap[i]->heap_index);
 }
 
 /**
@@ -104,6 +104,8 @@ void lv_timer_pause(lv_timer_t * timer);
 
 /**
  * Resume a timer.
+ * Like the other functions changing a timer, it moves the timer in the timers' heap,
+ * so call it only from the LVGL thread or with `lv_lock()` held.
  * @param timer pointer to an lv_timer
  */
 void lv_timer_resume(lv_timer_t * timer);
@@ -117,6 +119,8 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb);
 
 /**
  * Set new period for a lv_timer
+ * Like the other functions changing a timer, it moves the timer in the timers' heap,
+ * so call it only from the LVGL thread or with `lv_lock()` held.
  * @param timer pointer to a lv_timer
  * @param period the new period
  */
@@ -124,6 +128,8 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period);
 
 /**
  * Make a lv_timer ready. It will not wait its period.
+ * Like the other functions changing a timer, it moves the timer in the timers' heap,
+ * so call it only from the LVGL thread or with `lv_lock()` held.
  * @param timer pointer to a lv_timer.
  */
 void lv_timer_ready(lv_timer_t * timer);
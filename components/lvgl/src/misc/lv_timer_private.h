@@ -33,6 +33,10 @@ struct _lv_timer_t {
     lv_timer_cb_t timer_cb;    /**< Timer function */
     void * user_data;          /**< Custom user data */
     int32_t repeat_count;      /**< 1: One time;  -1 : infinity;  n>0: residual times */
+    uint32_t deadline;         /**< Tick when the timer is due, the key in the heap */
+    uint32_t seq;              /**< Creation order, newer timers run first on equal deadlines */
+    uint32_t heap_index;       /**< Index in the heap, or not scheduled/deferred */
+    uint32_t round;            /**< `lv_timer_handler()` call in which the timer ran last */
     uint32_t paused : 1;
     uint32_t auto_delete : 1;
 };
@@ -40,10 +44,22 @@ struct _lv_timer_t {
 typedef struct {
     lv_ll_t timer_ll;          /**< Linked list to store the lv_timers */
 
+    /*The not paused timers are in a binary min-heap ordered by `deadline`, so finding the due
+     *timers and the time until the next one doesn't depend on the number of timers*/
+    lv_timer_t ** heap;
+    uint32_t heap_cnt;
+    lv_timer_t ** deferred;    /**< Ran in this `lv_timer_handler()` and already due again */
+    uint32_t deferred_cnt;
+    uint32_t capacity;         /**< Size of `heap` and `deferred`, at least the number of timers */
+    uint32_t timer_cnt;
+    uint32_t seq;
+    uint32_t round;            /**< Number of `lv_timer_handler()` calls */
+
+    lv_timer_t * timer_running;    /**< The timer whose callback is running */
+    bool timer_running_deleted;    /**< `timer_running` was deleted by its callback */
+
     bool lv_timer_run;
     uint8_t idle_last;
-    bool timer_deleted;
-    bool timer_created;
     uint32_t timer_time_until_next;
 
     bool already_running;
@@ -13,11 +13,23 @@
 #include "../../lvgl.h"
 #include "../../core/lv_obj_private.h"
 #include "../../misc/lv_event_private.h"
+#include "../../core/lv_global.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+#define subject_deferred (LV_GLOBAL_DEFAULT()->subject_deferred)
+
+/*`subject_deferred.head` is written under the lock but also read without it by the LVGL thread*/
+#if defined(__GNUC__) || defined(__clang__)
+    #define DEFERRED_HEAD_LOAD() __atomic_load_n(&subject_deferred.head, __ATOMIC_ACQUIRE)
+    #define DEFERRED_HEAD_STORE(subject) __atomic_store_n(&subject_deferred.head, (subject), __ATOMIC_RELEASE)
+#else
+    #define DEFERRED_HEAD_LOAD() deferred_head_locked()
+    #define DEFERRED_HEAD_STORE(subject) (subject_deferred.head = (subject))
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -77,6 +89,12 @@ static void obj_state_observer_cb(lv_observer_t * observer, lv_subject_t * subje
 static void obj_value_changed_event_cb(lv_event_t * e);
 
 static void lv_subject_notify_if_changed(lv_subject_t * subject);
+static void subject_defer(lv_subject_t * subject, lv_subject_value_t value);
+static bool subject_unlink_pending(lv_subject_t * subject);
+static void deferred_timer_cb(lv_timer_t * timer);
+#if !defined(__GNUC__) && !defined(__clang__)
+    static lv_subject_t * deferred_head_locked(void);
+#endif
 
 #if LV_USE_LABEL
     static void label_text_observer_cb(lv_observer_t * observer, lv_subject_t * subject);
@@ -133,6 +151,11 @@ void lv_subject_set_int(lv_subject_t * subject, int32_t value)
         return;
     }
 
+    if(subject->deferred) {
+        subject_defer(subject, (lv_subject_value_t) { .num = value });
+        return;
+    }
+
     subject->prev_value.num = subject->value.num;
     subject->value.num = value;
     lv_subject_notify_if_changed(subject);
@@ -176,6 +199,11 @@ void lv_subject_set_float(lv_subject_t * subject, float value)
         return;
     }
 
+    if(subject->deferred) {
+        subject_defer(subject, (lv_subject_value_t) { .float_v = value });
+        return;
+    }
+
     subject->prev_value.float_v = subject->value.float_v;
     subject->value.float_v = value;
     lv_subject_notify_if_changed(subject);
@@ -292,6 +320,11 @@ void lv_subject_set_pointer(lv_subject_t * subject, void * ptr)
         return;
     }
 
+    if(subject->deferred) {
+        subject_defer(subject, (lv_subject_value_t) { .pointer = ptr });
+        return;
+    }
+
     subject->prev_value.pointer = subject->value.pointer;
     subject->value.pointer = ptr;
     lv_subject_notify_if_changed(subject);
@@ -333,6 +366,11 @@ void lv_subject_set_color(lv_subject_t * subject, lv_color_t color)
         return;
     }
 
+    if(subject->deferred) {
+        subject_defer(subject, (lv_subject_value_t) { .color = color });
+        return;
+    }
+
     subject->prev_value.color = subject->value.color;
     subject->value.color = color;
     lv_subject_notify_if_changed(subject);
@@ -375,6 +413,13 @@ void lv_subject_init_group(lv_subject_t * group_subject, lv_subject_t * list[],
 
 void lv_subject_deinit(lv_subject_t * subject)
 {
+    if(subject->deferred) {
+        lv_mutex_lock(&subject_deferred.lock);
+        subject_unlink_pending(subject);
+        subject->deferred = 0;
+        lv_mutex_unlock(&subject_deferred.lock);
+    }
+
     lv_observer_t * observer = lv_ll_get_head(&subject->subs_ll);
     while(observer) {
         lv_observer_t * observer_next = lv_ll_get_next(&subject->subs_ll, observer);
@@ -540,6 +585,81 @@ void lv_subject_notify(lv_subject_t * subject)
     } while(subject->notify_restart_query);
 }
 
+void lv_subject_set_deferred(lv_subject_t * subject, bool en)
+{
+    LV_ASSERT_NULL(subject);
+
+    if(en) {
+        if(subject->type != LV_SUBJECT_TYPE_INT && subject->type != LV_SUBJECT_TYPE_FLOAT &&
+           subject->type != LV_SUBJECT_TYPE_POINTER && subject->type != LV_SUBJECT_TYPE_COLOR) {
+            LV_LOG_WARN("Only integer, float, pointer and color Subjects can be deferred");
+            return;
+        }
+
+        if(subject_deferred.timer == NULL) {
+            lv_mutex_init(&subject_deferred.lock);
+            /*Always running: the setters can be on other threads and must not touch the timers*/
+            subject_deferred.timer = lv_timer_create(deferred_timer_cb, LV_DEF_REFR_PERIOD, NULL);
+        }
+        subject->deferred = 1;
+        return;
+    }
+
+    if(subject->deferred == 0) return;
+
+    /*Apply the last value, but after the Subject can't be added to the list again*/
+    lv_mutex_lock(&subject_deferred.lock);
+    lv_subject_value_t value = subject->pending_value;
+    bool pending = subject_unlink_pending(subject);
+    subject->deferred = 0;
+    lv_mutex_unlock(&subject_deferred.lock);
+
+    if(pending) {
+        subject->prev_value = subject->value;
+        subject->value = value;
+        lv_subject_notify_if_changed(subject);
+    }
+}
+
+void lv_subject_apply_deferred(void)
+{
+    /*Checked without the lock: a value set right now is applied next time*/
+    if(DEFERRED_HEAD_LOAD() == NULL) return;
+
+    /*Only the Subjects which were in the list already, so that Observers setting deferred Subjects
+     *or other threads setting them again can't keep this loop running*/
+    lv_mutex_lock(&subject_deferred.lock);
+    uint32_t cnt = subject_deferred.cnt;
+    lv_mutex_unlock(&subject_deferred.lock);
+
+    while(cnt > 0) {
+        cnt--;
+
+        lv_mutex_lock(&subject_deferred.lock);
+        lv_subject_t * subject = subject_deferred.head;
+        if(subject == NULL) {
+            lv_mutex_unlock(&subject_deferred.lock);
+            break;
+        }
+        lv_subject_value_t value = subject->pending_value;
+        subject_unlink_pending(subject);
+        lv_mutex_unlock(&subject_deferred.lock);
+
+        subject->prev_value = subject->value;
+        subject->value = value;
+        lv_subject_notify_if_changed(subject);
+    }
+}
+
+void lv_subject_deferred_deinit(void)
+{
+    if(subject_deferred.timer == NULL) return;
+
+    lv_timer_delete(subject_deferred.timer);
+    lv_mutex_delete(&subject_deferred.lock);
+    lv_memzero(&subject_deferred, sizeof(lv_subject_deferred_t));
+}
+
 void lv_obj_add_subject_increment_event(lv_obj_t * obj, lv_subject_t * subject, lv_event_code_t trigger, int32_t step,
                                         int32_t min, int32_t max)
 {
@@ -1013,6 +1133,70 @@ static void lv_subject_notify_if_changed(lv_subject_t * subject)
     }
 }
 
+/**
+ * Store the value of a deferred Subject and add it to the list of pending Subjects.
+ * Can be called from any thread.
+ */
+static void subject_defer(lv_subject_t * subject, lv_subject_value_t value)
+{
+    lv_mutex_lock(&subject_deferred.lock);
+    subject->pending_value = value;
+    if(!subject->pending) {
+        subject->pending = true;
+        subject->pending_next = NULL;
+        if(subject_deferred.tail) subject_deferred.tail->pending_next = subject;
+        else DEFERRED_HEAD_STORE(subject);
+        subject_deferred.tail = subject;
+        subject_deferred.cnt++;
+    }
+    lv_mutex_unlock(&subject_deferred.lock);
+}
+
+/**
+ * Remove a Subject from the list of pending Subjects. `subject_deferred.lock` needs to be taken.
+ * @return true: the Subject had a pending value
+ */
+static bool subject_unlink_pending(lv_subject_t * subject)
+{
+    if(!subject->pending) return false;
+
+    lv_subject_t * prev = NULL;
+    lv_subject_t * s = subject_deferred.head;
+    while(s && s != subject) {
+        prev = s;
+        s = s->pending_next;
+    }
+    if(s == NULL) return false;
+
+    if(prev) prev->pending_next = subject->pending_next;
+    else DEFERRED_HEAD_STORE(subject->pending_next);
+    if(subject_deferred.tail == subject) subject_deferred.tail = prev;
+
+    subject->pending = false;
+    subject->pending_next = NULL;
+    subject_deferred.cnt--;
+    return true;
+}
+
+static void deferred_timer_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+
+    /*Usually applied by the display refresh, this is for when nothing else is invalidated.
+     *Returns right away if nothing is pending.*/
+    lv_subject_apply_deferred();
+}
+
+#if !defined(__GNUC__) && !defined(__clang__)
+static lv_subject_t * deferred_head_locked(void)
+{
+    lv_mutex_lock(&subject_deferred.lock);
+    lv_subject_t * head = subject_deferred.head;
+    lv_mutex_unlock(&subject_deferred.lock);
+    return head;
+}
+#endif
+
 #if LV_USE_LABEL
 
 static void label_text_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
@@ -61,8 +61,14 @@ typedef struct {
     void * user_data;                    /**< Additional parameter, can be used freely by user */
     uint32_t type                 :  4;  /**< One of the LV_SUBJECT_TYPE_... values */
     uint32_t size                 : 24;  /**< String buffer size or group length */
-    uint32_t notify_restart_query :  1;  /**< If an Observer was deleted during notification,
-                                          * start notifying from the beginning. */
+    uint32_t deferred             :  1;  /**< Notify once before the next refresh, see `lv_subject_set_deferred()` */
+    bool notify_restart_query;           /**< If an Observer was deleted during notification,
+                                          * start notifying from the beginning. (Not a bit field:
+                                          * other threads read `type` and `deferred`) */
+    bool pending;                        /**< A deferred value is waiting to be applied (not a bit field:
+                                          * written by other threads) */
+    lv_subject_value_t pending_value;    /**< Last value set while deferred */
+    void * pending_next;                 /**< Next Subject with pending value */
 } lv_subject_t;
 
 /**
@@ -342,6 +348,26 @@ void * lv_observer_get_user_data(const lv_observer_t * observer);
  */
 void lv_subject_notify(lv_subject_t * subject);
 
+/**
+ * Defer the notifications of an integer, float, pointer or color Subject to the next display refresh.
+ * After this `lv_subject_set_...()` can be called from any thread too. It only stores the value
+ * and the Observers are notified once, before the next refresh, with the last value.
+ * `lv_subject_get_...()` returns the value of the last notification.
+ * Call it from the LVGL thread before the Subject is set from other threads.
+ * The first call creates a timer which applies the values every `LV_DEF_REFR_PERIOD` ms
+ * when no refresh is running.
+ * @param subject   pointer to Subject
+ * @param en        true: defer the notifications; false: notify in `lv_subject_set_...()` again
+ */
+void lv_subject_set_deferred(lv_subject_t * subject, bool en);
+
+/**
+ * Apply the last value of the deferred Subjects and notify their Observers.
+ * Called before each display refresh, and by a timer when nothing needs to be redrawn.
+ * Can be called from the LVGL thread to apply the values earlier.
+ */
+void lv_subject_apply_deferred(void);
+
 /**
  * Add an event handler to increment (or decrement) the value of a subject on a trigger.
  * @param obj       pointer to a widget
@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 
 #include "lv_observer.h"
+#include "../../osal/lv_os.h"
 
 #if LV_USE_OBSERVER
 
@@ -39,11 +40,27 @@ struct _lv_observer_t {
     uint32_t for_obj : 1;               /**< Is `target` a pointer to a Widget (`lv_obj_t *`)? */
 };
 
+/**
+ * The Subjects with deferred notifications waiting to be applied
+ */
+typedef struct {
+    lv_mutex_t lock;                    /**< Protects the list and the pending values */
+    lv_subject_t * head;                /**< First Subject to apply, in the order of the first set */
+    lv_subject_t * tail;
+    uint32_t cnt;                       /**< Number of Subjects in the list */
+    lv_timer_t * timer;                 /**< Applies the values when no refresh is running */
+} lv_subject_deferred_t;
+
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Delete the timer and the lock of the deferred Subjects.
+ */
+void lv_subject_deferred_deinit(void);
+
 /**********************
  *      MACROS
  **********************/
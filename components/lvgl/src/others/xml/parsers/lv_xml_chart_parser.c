@@ -184,6 +184,7 @@ static lv_chart_update_mode_t chart_update_mode_to_enum(const char * txt)
 {
     if(lv_streq("shift", txt)) return LV_CHART_UPDATE_MODE_SHIFT;
     if(lv_streq("circular", txt)) return LV_CHART_UPDATE_MODE_CIRCULAR;
+    if(lv_streq("stream", txt)) return LV_CHART_UPDATE_MODE_STREAM;
 
     LV_LOG_WARN("%s is an unknown value for chart's chart_update_mode", txt);
     return 0; /*Return 0 in lack of a better option. */
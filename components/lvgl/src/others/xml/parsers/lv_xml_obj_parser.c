@@ -129,6 +129,8 @@ void lv_xml_obj_apply(lv_xml_parser_state_t * state, const char ** attrs)
                                                                             lv_xml_to_bool(value));
         else if(lv_streq("flex_in_new_track", name))    lv_obj_set_flag(item, LV_OBJ_FLAG_FLEX_IN_NEW_TRACK,
                                                                             lv_xml_to_bool(value));
+        else if(lv_streq("cache_as_bitmap", name))      lv_obj_set_flag(item, LV_OBJ_FLAG_CACHE_AS_BITMAP,
+                                                                            lv_xml_to_bool(value));
 
         else if(lv_streq("checked", name))  lv_obj_set_state(item, LV_STATE_CHECKED, lv_xml_to_bool(value));
         else if(lv_streq("focused", name))  lv_obj_set_state(item, LV_STATE_FOCUSED, lv_xml_to_bool(value));
@@ -653,6 +655,7 @@ static lv_obj_flag_t flag_to_enum(const char * txt)
     if(lv_streq("send_draw_task_evenTS", txt)) return LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS;
     if(lv_streq("overflow_visible", txt)) return LV_OBJ_FLAG_OVERFLOW_VISIBLE;
     if(lv_streq("flex_in_new_track", txt)) return LV_OBJ_FLAG_FLEX_IN_NEW_TRACK;
+    if(lv_streq("cache_as_bitmap", txt)) return LV_OBJ_FLAG_CACHE_AS_BITMAP;
     if(lv_streq("layout_1", txt)) return LV_OBJ_FLAG_LAYOUT_1;
     if(lv_streq("layout_2", txt)) return LV_OBJ_FLAG_LAYOUT_2;
     if(lv_streq("widget_1", txt)) return LV_OBJ_FLAG_WIDGET_1;
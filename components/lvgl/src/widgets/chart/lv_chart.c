@@ -44,6 +44,13 @@ static void draw_cursors(lv_obj_t * obj, lv_layer_t * layer);
 static uint32_t get_index_from_x(lv_obj_t * obj, int32_t x);
 static void invalidate_point(lv_obj_t * obj, uint32_t i);
 static void new_points_alloc(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t cnt, int32_t ** a);
+static void stream_invalidate_all(lv_obj_t * obj, bool free_columns);
+static void stream_columns_build(lv_obj_t * obj, lv_chart_series_t * ser, int32_t w);
+static bool stream_column_add(lv_chart_series_t * ser, int32_t value);
+static void stream_push(lv_obj_t * obj, lv_chart_series_t * ser, int32_t value);
+static void draw_series_stream(lv_obj_t * obj, lv_layer_t * layer, lv_chart_series_t * ser,
+                               lv_draw_line_dsc_t * line_dsc, const lv_area_t * clip_area,
+                               int32_t x_ofs, int32_t y_ofs, int32_t w, int32_t h);
 
 /**********************
  *  STATIC VARIABLES
@@ -101,6 +108,7 @@ void lv_chart_set_type(lv_obj_t * obj, lv_chart_type_t type)
     }
 
     chart->type = type;
+    stream_invalidate_all(obj, false);
 
     lv_chart_refresh(obj);
 }
@@ -125,6 +133,7 @@ void lv_chart_set_point_count(lv_obj_t * obj, uint32_t cnt)
     }
 
     chart->point_cnt = cnt;
+    stream_invalidate_all(obj, false);
 
     lv_chart_refresh(obj);
 }
@@ -206,6 +215,7 @@ void lv_chart_set_update_mode(lv_obj_t * obj, lv_chart_update_mode_t update_mode
     if(chart->update_mode == update_mode) return;
 
     chart->update_mode = update_mode;
+    stream_invalidate_all(obj, update_mode != LV_CHART_UPDATE_MODE_STREAM);
     lv_obj_invalidate(obj);
 }
 
@@ -336,7 +346,7 @@ void lv_chart_get_point_pos_by_id(lv_obj_t * obj, lv_chart_series_t * ser, uint3
     p_out->x += lv_obj_get_style_pad_left(obj, LV_PART_MAIN) + border_width;
     p_out->x -= lv_obj_get_scroll_left(obj);
 
-    uint32_t start_point = chart->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
+    uint32_t start_point = chart->update_mode != LV_CHART_UPDATE_MODE_CIRCULAR ? ser->start_point : 0;
     id = ((int32_t)start_point + id) % chart->point_cnt;
     int32_t temp_y = 0;
     temp_y = (int32_t)((int32_t)ser->y_points[id] - chart->ymin[ser->y_axis_sec]) * h;
@@ -350,6 +360,8 @@ void lv_chart_refresh(lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*The points might have been written directly (e.g. into an external array)*/
+    stream_invalidate_all(obj, false);
     lv_obj_invalidate(obj);
 }
 
@@ -427,6 +439,7 @@ void lv_chart_remove_series(lv_obj_t * obj, lv_chart_series_t * series)
     lv_chart_t * chart    = (lv_chart_t *)obj;
     if(!series->y_ext_buf_assigned && series->y_points) lv_free(series->y_points);
     if(!series->x_ext_buf_assigned && series->x_points) lv_free(series->x_points);
+    lv_free(series->columns);
 
     lv_ll_remove(&chart->series_ll, series);
     lv_free(series);
@@ -567,6 +580,7 @@ void lv_chart_set_all_values(lv_obj_t * obj, lv_chart_series_t * ser, int32_t va
         ser->y_points[i] = value;
     }
     ser->start_point = 0;
+    ser->column_w = 0;
     lv_chart_refresh(obj);
 }
 
@@ -578,6 +592,11 @@ void lv_chart_set_next_value(lv_obj_t * obj, lv_chart_series_t * ser, int32_t va
 
     lv_chart_t * chart  = (lv_chart_t *)obj;
     ser->y_points[ser->start_point] = value;
+    if(chart->update_mode == LV_CHART_UPDATE_MODE_STREAM) {
+        ser->start_point = (ser->start_point + 1) % chart->point_cnt;
+        stream_push(obj, ser, value);
+        return;
+    }
     invalidate_point(obj, ser->start_point);
     ser->start_point = (ser->start_point + 1) % chart->point_cnt;
     invalidate_point(obj, ser->start_point);
@@ -627,6 +646,7 @@ void lv_chart_set_series_value_by_id(lv_obj_t * obj, lv_chart_series_t * ser, ui
 
     if(id >= chart->point_cnt) return;
     ser->y_points[id] = value;
+    ser->column_w = 0;
     invalidate_point(obj, id);
 }
 
@@ -656,6 +676,7 @@ void lv_chart_set_series_ext_y_array(lv_obj_t * obj, lv_chart_series_t * ser, in
     if(!ser->y_ext_buf_assigned && ser->y_points) lv_free(ser->y_points);
     ser->y_ext_buf_assigned = true;
     ser->y_points = array;
+    ser->column_w = 0;
     lv_obj_invalidate(obj);
 }
 
@@ -756,6 +777,7 @@ static void lv_chart_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
         if(!ser->y_ext_buf_assigned) lv_free(ser->y_points);
         if(!ser->x_ext_buf_assigned) lv_free(ser->x_points);
+        lv_free(ser->columns);
 
         lv_ll_remove(&chart->series_ll, ser);
         lv_free(ser);
@@ -958,7 +980,19 @@ static void draw_series_line(lv_obj_t * obj, lv_layer_t * layer)
         line_dsc.base.id2 = 0;
         point_dsc_default.base.id2 = 0;
 
-        int32_t start_point = chart->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
+        if(chart->update_mode == LV_CHART_UPDATE_MODE_STREAM) {
+            if(crowded_mode) {
+                draw_series_stream(obj, layer, ser, &line_dsc, &clip_area_ori, x_ofs, y_ofs, w, h);
+                if(line_dsc.base.id1 > 0) {
+                    point_dsc_default.base.id1--;
+                    line_dsc.base.id1--;
+                }
+                continue;
+            }
+            ser->column_w = 0;  /*Drawn point by point, so new points need to invalidate the whole chart*/
+        }
+
+        int32_t start_point = chart->update_mode != LV_CHART_UPDATE_MODE_CIRCULAR ? ser->start_point : 0;
 
         line_dsc.p1.x = x_ofs;
         line_dsc.p2.x = x_ofs;
@@ -1100,7 +1134,7 @@ static void draw_series_scatter(lv_obj_t * obj, lv_layer_t * layer)
         line_dsc.color = ser->color;
         point_dsc_default.bg_color = ser->color;
 
-        int32_t start_point = chart->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
+        int32_t start_point = chart->update_mode != LV_CHART_UPDATE_MODE_CIRCULAR ? ser->start_point : 0;
 
         line_dsc.p1.x = x_ofs;
         line_dsc.p2.x = x_ofs;
@@ -1237,7 +1271,7 @@ static void draw_series_bar(lv_obj_t * obj, lv_layer_t * layer)
         LV_LL_READ(&chart->series_ll, ser) {
             if(ser->hidden) continue;
 
-            int32_t start_point = chart->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
+            int32_t start_point = chart->update_mode != LV_CHART_UPDATE_MODE_CIRCULAR ? ser->start_point : 0;
 
             col_a.x1 = x_act;
             col_a.x2 = col_a.x1 + col_w - 1;
@@ -1411,7 +1445,7 @@ static void invalidate_point(lv_obj_t * obj, uint32_t i)
     int32_t scroll_left = lv_obj_get_scroll_left(obj);
 
     /*In shift mode the whole chart changes so the whole object*/
-    if(chart->update_mode == LV_CHART_UPDATE_MODE_SHIFT) {
+    if(chart->update_mode != LV_CHART_UPDATE_MODE_CIRCULAR) {
         lv_obj_invalidate(obj);
         return;
     }
@@ -1510,4 +1544,231 @@ static void new_points_alloc(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t c
     }
 }
 
+/**
+ * Mark the stream columns of all series to be rebuilt on the next draw
+ * @param obj           pointer to a chart object
+ * @param free_columns  true: also free them (e.g. the chart is not in stream mode anymore)
+ */
+static void stream_invalidate_all(lv_obj_t * obj, bool free_columns)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    lv_chart_series_t * ser;
+    LV_LL_READ_BACK(&chart->series_ll, ser) {
+        ser->column_w = 0;
+        if(free_columns) {
+            lv_free(ser->columns);
+            ser->columns = NULL;
+            ser->column_cnt = 0;
+        }
+    }
+}
+
+/**
+ * (Re)build the columns of a series from its points for a given content width.
+ * Every column has the same number of points so the columns stay aligned when new points are added.
+ * `column_cnt * column_points <= point_cnt`, so every drawn point is still in `y_points`
+ * (the oldest `2 * column_points - 2` points at most are not drawn).
+ * @param obj       pointer to a chart object
+ * @param ser       pointer to a series
+ * @param w         content width of the chart, less than the point count
+ */
+static void stream_columns_build(lv_obj_t * obj, lv_chart_series_t * ser, int32_t w)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    if(w < 1) w = 1;
+
+    uint32_t column_points = (chart->point_cnt + w - 1) / w;
+    uint32_t column_cnt = chart->point_cnt / column_points;
+
+    if(ser->column_cnt != column_cnt) {
+        lv_free(ser->columns);
+        ser->columns = lv_malloc(sizeof(lv_chart_column_t) * column_cnt);
+        LV_ASSERT_MALLOC(ser->columns);
+        if(ser->columns == NULL) {
+            ser->column_cnt = 0;
+            ser->column_w = 0;
+            return;
+        }
+        ser->column_cnt = column_cnt;
+    }
+
+    ser->column_points = column_points;
+    ser->column_w = w;
+
+    /*The first point will open the first column*/
+    ser->column_head = column_cnt - 1;
+    ser->column_fill = column_points;
+
+    uint32_t i;
+    for(i = 0; i < chart->point_cnt; i++) {
+        stream_column_add(ser, ser->y_points[(ser->start_point + i) % chart->point_cnt]);
+    }
+}
+
+/**
+ * Add a point to the newest column, or open a new column if it's full
+ * @param ser       pointer to a series with built columns
+ * @param value     the new value
+ * @return          true: the newest column looks different (it's a new column or its min/max changed)
+ */
+static bool stream_column_add(lv_chart_series_t * ser, int32_t value)
+{
+    lv_chart_column_t * col;
+    bool changed = false;
+    if(ser->column_fill >= ser->column_points) {
+        ser->column_head = ser->column_head + 1 == ser->column_cnt ? 0 : ser->column_head + 1;
+        ser->column_fill = 0;
+        col = &ser->columns[ser->column_head];
+        col->min = INT32_MAX;
+        col->max = INT32_MIN;
+        col->first = LV_CHART_POINT_NONE;
+        col->last = LV_CHART_POINT_NONE;
+        changed = true;
+    }
+    else {
+        col = &ser->columns[ser->column_head];
+    }
+    ser->column_fill++;
+
+    if(value == LV_CHART_POINT_NONE) return changed;
+
+    if(col->first == LV_CHART_POINT_NONE) col->first = value;
+    col->last = value;
+    if(value < col->min) {
+        col->min = value;
+        changed = true;
+    }
+    if(value > col->max) {
+        col->max = value;
+        changed = true;
+    }
+
+    return changed;
+}
+
+/**
+ * Add a new point to the columns and invalidate only what has changed on the screen.
+ * A new column scrolls the whole series, so it invalidates the chart (at most once per column).
+ * Else only the band of the newest column is invalidated, and only if its min/max has changed.
+ * @param obj       pointer to a chart object
+ * @param ser       pointer to a series
+ * @param value     the new value
+ */
+static void stream_push(lv_obj_t * obj, lv_chart_series_t * ser, int32_t value)
+{
+    /*Not built yet or not valid anymore. The next draw will rebuild the columns from `y_points`*/
+    if(ser->column_w == 0 || ser->columns == NULL) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    if(stream_column_add(ser, value) == false) return;
+    if(ser->hidden) return;
+
+    if(ser->column_fill == 1) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    int32_t bwidth = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    int32_t pleft = lv_obj_get_style_pad_left(obj, LV_PART_MAIN);
+    int32_t x_ofs = obj->coords.x1 + pleft + bwidth - lv_obj_get_scroll_left(obj);
+    int32_t line_width = lv_obj_get_style_line_width(obj, LV_PART_ITEMS);
+    int32_t col_span = ser->column_cnt > 1 ? (int32_t)ser->column_cnt - 1 : 1;
+    int32_t column_step = (ser->column_w - 1 + col_span - 1) / col_span;
+
+    /*The newest column is the last one on the right, together with its line from the previous column*/
+    lv_area_t coords;
+    lv_area_copy(&coords, &obj->coords);
+    coords.x2 = x_ofs + ser->column_w - 1 + line_width;
+    coords.x1 = coords.x2 - column_step - 2 * line_width - 1;
+    coords.y1 -= line_width;
+    coords.y2 += line_width;
+    lv_obj_invalidate_area(obj, &coords);
+}
+
+static int32_t stream_value_to_y(int32_t value, int32_t ymin, int32_t yrange, int32_t h)
+{
+    int32_t y_tmp = (int32_t)(value - ymin) * h;
+    return h - y_tmp / yrange;
+}
+
+/**
+ * Draw a line series from its columns: a vertical min/max line per column and
+ * a line from the previous column's last point if the columns are not on adjacent pixels.
+ * Only the columns in the clip area are visited and only the lines crossing it are drawn.
+ */
+static void draw_series_stream(lv_obj_t * obj, lv_layer_t * layer, lv_chart_series_t * ser,
+                               lv_draw_line_dsc_t * line_dsc, const lv_area_t * clip_area,
+                               int32_t x_ofs, int32_t y_ofs, int32_t w, int32_t h)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+
+    if(ser->column_w != w || ser->columns == NULL) stream_columns_build(obj, ser, w);
+    if(ser->columns == NULL) return;
+
+    int32_t ymin = chart->ymin[ser->y_axis_sec];
+    int32_t yrange = chart->ymax[ser->y_axis_sec] - ymin;
+    if(yrange == 0) return;
+
+    int32_t col_span = ser->column_cnt > 1 ? (int32_t)ser->column_cnt - 1 : 1;
+    int32_t w_span = w > 1 ? w - 1 : 1;
+    int32_t ext = line_dsc->width + 1;
+
+    /*Columns covering the clip area, plus one on the left for the connecting line*/
+    int32_t j_start = ((clip_area->x1 - ext - x_ofs) * col_span) / w_span - 1;
+    int32_t j_end = ((clip_area->x2 + ext - x_ofs) * col_span) / w_span + 1;
+    if(j_start < 0) j_start = 0;
+    if(j_end > (int32_t)ser->column_cnt - 1) j_end = (int32_t)ser->column_cnt - 1;
+
+    bool prev_valid = false;
+    int32_t prev_x = 0;
+    int32_t prev_y = 0;
+    int32_t j;
+    for(j = j_start; j <= j_end; j++) {
+        const lv_chart_column_t * col = &ser->columns[(ser->column_head + 1 + j) % ser->column_cnt];
+        if(col->min > col->max) {
+            prev_valid = false;
+            continue;
+        }
+
+        int32_t x = (w_span * j) / col_span + x_ofs;
+        int32_t y_top = stream_value_to_y(col->max, ymin, yrange, h) + y_ofs;
+        int32_t y_bottom = stream_value_to_y(col->min, ymin, yrange, h) + y_ofs;
+
+        line_dsc->base.id2 = j;
+        if(prev_valid) {
+            if(x - prev_x > 1) {
+                int32_t y_first = stream_value_to_y(col->first, ymin, yrange, h) + y_ofs;
+                if(LV_MAX(prev_y, y_first) >= clip_area->y1 - ext && LV_MIN(prev_y, y_first) <= clip_area->y2 + ext) {
+                    line_dsc->p1.x = prev_x;
+                    line_dsc->p1.y = prev_y;
+                    line_dsc->p2.x = x;
+                    line_dsc->p2.y = y_first;
+                    lv_draw_line(layer, line_dsc);
+                }
+            }
+            else {
+                /*Adjacent pixels: the vertical line also covers the jump from the previous column*/
+                y_top = LV_MIN(y_top, prev_y);
+                y_bottom = LV_MAX(y_bottom, prev_y);
+            }
+        }
+
+        /*With partial rendering most columns are out of the current band. Don't create draw tasks for them.*/
+        if(y_bottom >= clip_area->y1 - ext && y_top <= clip_area->y2 + ext) {
+            line_dsc->p1.x = x;
+            line_dsc->p2.x = x;
+            line_dsc->p1.y = y_top;
+            line_dsc->p2.y = y_bottom;
+            if(line_dsc->p1.y == line_dsc->p2.y) line_dsc->p2.y++;    /*If they are the same no line will be drawn*/
+            lv_draw_line(layer, line_dsc);
+        }
+
+        prev_valid = true;
+        prev_x = x;
+        prev_y = stream_value_to_y(col->last, ymin, yrange, h) + y_ofs;
+    }
+}
+
 #endif
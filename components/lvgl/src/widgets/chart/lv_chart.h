@@ -46,6 +46,8 @@ typedef enum {
 typedef enum {
     LV_CHART_UPDATE_MODE_SHIFT,     /**< Shift old data to the left and add the new one the right*/
     LV_CHART_UPDATE_MODE_CIRCULAR,  /**< Add the new data in a circular way*/
+    LV_CHART_UPDATE_MODE_STREAM,    /**< Like SHIFT, but if there are more points than pixels, line series are drawn
+                                         from a min/max per pixel column updated on every `lv_chart_set_next_value`*/
 } lv_chart_update_mode_t;
 
 /**
@@ -172,7 +174,8 @@ uint32_t lv_chart_get_x_start_point(const lv_obj_t * obj, lv_chart_series_t * se
 void lv_chart_get_point_pos_by_id(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t id, lv_point_t * p_out);
 
 /**
- * Refresh a chart if its data line has changed
+ * Refresh a chart if its data line has changed.
+ * In `LV_CHART_UPDATE_MODE_STREAM` the columns are also rebuilt from the points on the next draw.
  * @param   obj   pointer to chart object
  */
 void lv_chart_refresh(lv_obj_t * obj);
@@ -27,6 +27,16 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/**
+ * The points of a series falling on one pixel column in `LV_CHART_UPDATE_MODE_STREAM`
+ */
+typedef struct {
+    int32_t min;                /**< `min > max` if the column has no valid point*/
+    int32_t max;
+    int32_t first;              /**< First valid point, the line from the previous column ends here*/
+    int32_t last;               /**< Last valid point, the line to the next column starts here*/
+} lv_chart_column_t;
+
 /**
  * Descriptor a chart series
  */
@@ -35,6 +45,12 @@ struct _lv_chart_series_t {
     int32_t * y_points;
     lv_color_t color;
     uint32_t start_point;
+    lv_chart_column_t * columns;    /**< Ring of columns in `LV_CHART_UPDATE_MODE_STREAM`*/
+    uint32_t column_cnt;
+    uint32_t column_points;         /**< Number of points per column*/
+    uint32_t column_head;           /**< Index of the newest column*/
+    uint32_t column_fill;           /**< Number of points already in the newest column*/
+    int32_t column_w;               /**< Content width the columns were built for, 0: needs rebuild*/
     uint32_t hidden : 1;
     uint32_t x_ext_buf_assigned : 1;
     uint32_t y_ext_buf_assigned : 1;
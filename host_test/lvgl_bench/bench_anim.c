@@ -0,0 +1,141 @@
+/**
+ * @file bench_anim.c
+ * 50 de animatii simultane (bile care se misca stanga-dreapta) pe 320x240 cu un sfert de ecran
+ * ca buffer. Se masoara timpul si pixelii trimisi pe cadru, cererile de refresh si contoarele
+ * buffer-ului de invalidare (adaugate, unite, depasiri). La final imaginea trebuie sa fie aceeasi
+ * ca dupa redesenarea intregului ecran, deci nicio zona murdara nu s-a pierdut la unire.
+ *
+ *   bench_anim
+ */
+
+#include "lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HOR_RES  320
+#define VER_RES  240
+#define ANIM_CNT 50
+#define FRAMES   600
+
+static uint32_t fake_tick;
+static uint16_t fb[HOR_RES * VER_RES];
+static uint64_t flushed_px;
+static uint32_t refr_requests;
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static uint32_t tick_ms(void)
+{
+    return fake_tick;
+}
+
+static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    int32_t w = lv_area_get_width(area);
+    for(int32_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&fb[y * HOR_RES + area->x1], px_map, w * 2);
+        px_map += w * 2;
+    }
+    flushed_px += lv_area_get_size(area);
+    lv_display_flush_ready(disp);
+}
+
+static void refr_request_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    refr_requests++;
+}
+
+static void set_x(void * obj, int32_t v)
+{
+    lv_obj_set_x(obj, v);
+}
+
+int main(void)
+{
+    lv_init();
+    lv_tick_set_cb(tick_ms);
+    lv_display_t * disp = lv_display_create(HOR_RES, VER_RES);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    size_t buf_size = HOR_RES * VER_RES * 2 / 4;
+    lv_display_set_buffers(disp, malloc(buf_size), NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_display_add_event_cb(disp, refr_request_cb, LV_EVENT_REFR_REQUEST, NULL);
+
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_remove_flag(scr, LV_OBJ_FLAG_SCROLLABLE);
+    for(int i = 0; i < ANIM_CNT; i++) {
+        lv_obj_t * ball = lv_obj_create(scr);
+        lv_obj_set_size(ball, 10, 10);
+        lv_obj_set_y(ball, (i % 25) * 9 + 4);
+        lv_obj_set_style_radius(ball, 5, 0);
+        lv_obj_set_style_border_width(ball, 0, 0);
+
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, ball);
+        lv_anim_set_exec_cb(&a, set_x);
+        lv_anim_set_values(&a, (i / 25) * 160, (i / 25) * 160 + 140);
+        lv_anim_set_duration(&a, 700 + i * 13);
+        lv_anim_set_playback_duration(&a, 700 + i * 13);
+        lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+        lv_anim_start(&a);
+    }
+    lv_refr_now(disp);
+    flushed_px = 0;
+    refr_requests = 0;
+    lv_display_inv_stats_t stats_start;
+    lv_display_get_inv_stats(disp, &stats_start);
+
+    double t0 = now_us();
+    for(int f = 0; f < FRAMES; f++) {
+        fake_tick += 16;
+        lv_timer_handler();
+    }
+    double us = (now_us() - t0) / FRAMES;
+    uint32_t requests = refr_requests;
+
+    lv_display_inv_stats_t stats;
+    lv_display_get_inv_stats(disp, &stats);
+    printf("%d animations | %.1f us/frame | %u px/frame (screen %d) | %.2f refresh requests/frame | "
+           "areas added %u merged %u overflows %u\n",
+           ANIM_CNT, us, (unsigned)(flushed_px / FRAMES), HOR_RES * VER_RES, (double)requests / FRAMES,
+           (unsigned)(stats.added - stats_start.added), (unsigned)(stats.merged - stats_start.merged),
+           (unsigned)(stats.overflows - stats_start.overflows));
+
+    /*Ce a mai ramas invalidat dupa ultimul pas, apoi acelasi moment redesenat complet*/
+    lv_refr_now(disp);
+    static uint16_t partial[HOR_RES * VER_RES];
+    memcpy(partial, fb, sizeof(fb));
+    lv_obj_invalidate(scr);
+    lv_refr_now(disp);
+    uint32_t stale = 0;
+    for(int i = 0; i < HOR_RES * VER_RES; i++) {
+        if(partial[i] != fb[i]) stale++;
+    }
+
+    int failed = 0;
+    if(stale) {
+        printf("%u pixels were not redrawn\n", (unsigned)stale);
+        failed++;
+    }
+    if(flushed_px / FRAMES >= HOR_RES * VER_RES) {
+        printf("The animations redraw the whole screen\n");
+        failed++;
+    }
+    /*O cerere de refresh de la pasul animatiilor si una de la layout, nu cate una pe obiect mutat*/
+    if(requests > FRAMES * 2) {
+        printf("More than 2 refresh requests per frame\n");
+        failed++;
+    }
+
+    lv_deinit();
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file bench_bitmap_cache.c
+ * LV_OBJ_FLAG_CACHE_AS_BITMAP pe un ecran animat doar partial: patru panouri statice (gradient,
+ * colturi rotunjite, umbra, opacitate) cu butoane si text, peste care se misca un cerc
+ * semi-transparent. Din cand in cand un panou se schimba, se muta sau se redeseneaza tot ecranul.
+ * Aceleasi cadre se randeaza fara flag, cu flag si bugetul din lv_conf.h (nu incap toate
+ * panourile) si cu flag si un buget in care incap; diferenta admisa e de 2 LSB pe canal
+ * (rotunjirea bitmap-urilor ARGB8888).
+ *
+ *   bench_bitmap_cache
+ */
+
+#include "lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HOR_RES    320
+#define VER_RES    240
+#define FRAMES     300
+#define SNAP_EVERY 50
+#define SNAP_CNT   (FRAMES / SNAP_EVERY)
+#define MAX_DIFF   2
+#define BIG_BUDGET (192 * 1024)
+
+static uint32_t fake_tick;
+static uint16_t fb[HOR_RES * VER_RES];
+static uint16_t snaps[3][SNAP_CNT][HOR_RES * VER_RES];
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static uint32_t tick_ms(void)
+{
+    return fake_tick;
+}
+
+static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    int32_t w = lv_area_get_width(area);
+    for(int32_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&fb[y * HOR_RES + area->x1], px_map, w * 2);
+        px_map += w * 2;
+    }
+    lv_display_flush_ready(disp);
+}
+
+static lv_obj_t * panel_create(lv_obj_t * parent, int32_t x, int32_t y, int32_t shadow, lv_opa_t opa)
+{
+    lv_obj_t * panel = lv_obj_create(parent);
+    lv_obj_set_pos(panel, x, y);
+    lv_obj_set_size(panel, 140, 100);
+    lv_obj_set_style_bg_grad_color(panel, lv_color_hex(0x3050a0), 0);
+    lv_obj_set_style_bg_grad_dir(panel, LV_GRAD_DIR_VER, 0);
+    lv_obj_set_style_radius(panel, 12, 0);
+    lv_obj_set_style_shadow_width(panel, shadow, 0);
+    lv_obj_set_style_opa(panel, opa, 0);
+    lv_obj_remove_flag(panel, LV_OBJ_FLAG_SCROLLABLE);
+    for(int i = 0; i < 3; i++) {
+        lv_obj_t * btn = lv_button_create(panel);
+        lv_obj_set_pos(btn, 4, 4 + i * 30);
+        lv_obj_set_size(btn, 80, 26);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Btn %d", i);
+    }
+    lv_obj_t * label = lv_label_create(panel);
+    lv_label_set_text(label, "Static\ntext");
+    lv_obj_set_pos(label, 90, 10);
+    return panel;
+}
+
+/*budget 0: fara LV_OBJ_FLAG_CACHE_AS_BITMAP*/
+static double run(lv_display_t * disp, int idx, uint32_t budget, lv_obj_bitmap_cache_stats_t * stats)
+{
+    bool cached = budget > 0;
+    lv_obj_t * scr = lv_obj_create(NULL);
+    lv_obj_t * panels[4] = {
+        panel_create(scr, 5, 5, 0, LV_OPA_COVER),
+        panel_create(scr, 165, 5, 15, LV_OPA_COVER),
+        panel_create(scr, 5, 125, 0, 180),
+        panel_create(scr, 165, 125, 8, LV_OPA_COVER),
+    };
+    if(cached) {
+        for(int i = 0; i < 4; i++) lv_obj_add_flag(panels[i], LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    }
+    lv_obj_t * dot = lv_obj_create(scr);
+    lv_obj_set_size(dot, 30, 30);
+    lv_obj_set_style_radius(dot, 15, 0);
+    lv_obj_set_style_bg_opa(dot, LV_OPA_50, 0);
+    lv_screen_load(scr);
+    if(cached) lv_obj_bitmap_cache_set_budget(budget);
+    lv_obj_bitmap_cache_reset_stats();
+
+    double t0 = now_us();
+    for(int f = 0; f < FRAMES; f++) {
+        lv_obj_set_pos(dot, (f * 3) % 290, (f * 2) % 210);
+        if(f == 100) lv_label_set_text(lv_obj_get_child(lv_obj_get_child(panels[0], 0), 0), "Changed");
+        if(f == 150) lv_obj_set_x(panels[3], 150);
+        if(f == 200) lv_obj_set_style_bg_color(panels[1], lv_color_hex(0x802020), 0);
+        if(f % SNAP_EVERY == 0) lv_obj_invalidate(scr);
+        fake_tick += 5;
+        lv_refr_now(disp);
+        if(f % SNAP_EVERY == SNAP_EVERY - 1) memcpy(snaps[idx][f / SNAP_EVERY], fb, sizeof(fb));
+    }
+    double us = (now_us() - t0) / FRAMES;
+
+    lv_obj_bitmap_cache_get_stats(stats);
+    lv_screen_load(lv_obj_create(NULL));
+    lv_obj_delete(scr);
+    return us;
+}
+
+static int channel_diff(uint16_t a, uint16_t b)
+{
+    int dr = LV_ABS((int)(a >> 11) - (int)(b >> 11));
+    int dg = LV_ABS((int)((a >> 5) & 0x3f) - (int)((b >> 5) & 0x3f));
+    int db = LV_ABS((int)(a & 0x1f) - (int)(b & 0x1f));
+    return LV_MAX3(dr, dg, db);
+}
+
+int main(void)
+{
+    lv_init();
+    lv_tick_set_cb(tick_ms);
+    lv_display_t * disp = lv_display_create(HOR_RES, VER_RES);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    size_t buf_size = HOR_RES * 40 * 2;
+    lv_display_set_buffers(disp, malloc(buf_size), NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+
+    static const uint32_t budgets[3] = {0, LV_OBJ_BITMAP_CACHE_SIZE, BIG_BUDGET};
+    int failed = 0;
+    for(int r = 0; r < 3; r++) {
+        lv_obj_bitmap_cache_stats_t st;
+        double us = run(disp, r, budgets[r], &st);
+        if(r == 0) {
+            printf("plain             %7.1f us/frame\n", us);
+            continue;
+        }
+
+        int max_diff = 0;
+        uint32_t diff_px = 0;
+        for(int s = 0; s < SNAP_CNT; s++) {
+            for(int i = 0; i < HOR_RES * VER_RES; i++) {
+                int d = channel_diff(snaps[0][s][i], snaps[r][s][i]);
+                if(d) diff_px++;
+                max_diff = LV_MAX(max_diff, d);
+            }
+        }
+        printf("cached, %3u kB    %7.1f us/frame | hits %u renders %u fallbacks %u evictions %u | used %u kB | "
+               "%u px differ, max %d LSB\n",
+               (unsigned)(budgets[r] / 1024), us, (unsigned)st.hits, (unsigned)st.renders, (unsigned)st.fallbacks,
+               (unsigned)st.evictions, (unsigned)(st.used / 1024), (unsigned)diff_px, max_diff);
+        if(max_diff > MAX_DIFF) {
+            printf("The cached bitmaps differ by more than %d LSB\n", MAX_DIFF);
+            failed++;
+        }
+        if(st.hits == 0) {
+            printf("No widget was drawn from its bitmap\n");
+            failed++;
+        }
+    }
+
+    lv_deinit();
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file bench_chart.c
+ * Chart de 320x170 cu 10000 de puncte alimentat la 10 kHz (10 puncte pe ms, 3 s), redesenat la
+ * fiecare 33 ms, in LV_CHART_UPDATE_MODE_SHIFT fata de LV_CHART_UPDATE_MODE_STREAM. Se masoara
+ * costul unui punct, timpul de redesenare (dupa prima secunda) si memoria seriei din heap-ul LVGL.
+ * In STREAM se verifica min/max-ul fiecarei coloane fata de punctele din y_points, si dupa ce
+ * punctele sunt scrise direct in array si se cheama lv_chart_refresh().
+ *
+ *   bench_chart
+ */
+
+#include "lvgl.h"
+#include "src/widgets/chart/lv_chart_private.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define HOR_RES  320
+#define VER_RES  240
+#define POINTS   10000
+#define RATE_KHZ 10
+#define RUN_MS   3000
+#define WARMUP_MS 1000
+#define FRAME_MS 33
+
+static uint32_t fake_tick;
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static uint32_t tick_ms(void)
+{
+    return fake_tick;
+}
+
+static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(px_map);
+    lv_display_flush_ready(disp);
+}
+
+/*3 Hz + 170 Hz + zgomot, esantionat la 10 kHz*/
+static int32_t signal_at(uint32_t n)
+{
+    double t = n / (RATE_KHZ * 1000.0);
+    return (int32_t)(600 * sin(2 * M_PI * 3 * t) + 200 * sin(2 * M_PI * 170 * t) + (rand() % 101 - 50));
+}
+
+static size_t heap_used(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+/*Min/max-ul coloanelor recalculat din y_points, de la cel mai nou punct inapoi*/
+static int check_columns(lv_obj_t * chart, lv_chart_series_t * ser)
+{
+    uint32_t point_cnt = lv_chart_get_point_count(chart);
+    if(ser->columns == NULL || ser->column_w == 0) return 1;
+    if((ser->column_cnt - 1) * ser->column_points + ser->column_fill > point_cnt) return 1;
+
+    int bad = 0;
+    uint32_t idx = (ser->start_point + point_cnt - 1) % point_cnt;
+    uint32_t col = ser->column_head;
+    uint32_t fill = ser->column_fill;
+    for(uint32_t c = 0; c < ser->column_cnt; c++) {
+        int32_t min = INT32_MAX;
+        int32_t max = INT32_MIN;
+        for(uint32_t k = 0; k < fill; k++) {
+            int32_t v = ser->y_points[idx];
+            idx = (idx + point_cnt - 1) % point_cnt;
+            if(v == LV_CHART_POINT_NONE) continue;
+            if(v < min) min = v;
+            if(v > max) max = v;
+        }
+        if(ser->columns[col].min != min || ser->columns[col].max != max) bad++;
+        col = (col + ser->column_cnt - 1) % ser->column_cnt;
+        fill = ser->column_points;
+    }
+    return bad;
+}
+
+static int run(lv_display_t * disp, lv_chart_update_mode_t mode, const char * name)
+{
+    size_t heap0 = heap_used();
+    lv_obj_t * chart = lv_chart_create(lv_screen_active());
+    lv_obj_set_size(chart, 320, 170);
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_point_count(chart, POINTS);
+    lv_chart_set_update_mode(chart, mode);
+    lv_chart_set_axis_range(chart, LV_CHART_AXIS_PRIMARY_Y, -1000, 1000);
+    lv_obj_set_style_size(chart, 0, 0, LV_PART_INDICATOR);
+    lv_chart_series_t * ser = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_RED), LV_CHART_AXIS_PRIMARY_Y);
+    srand(1);
+    fake_tick = 0;
+    lv_refr_now(disp);
+
+    double push_us = 0, redraw_us = 0, redraw_max = 0;
+    uint32_t frames = 0, n = 0;
+    for(uint32_t ms = 0; ms < RUN_MS; ms++) {
+        fake_tick++;
+        double t0 = now_us();
+        for(int k = 0; k < RATE_KHZ; k++) lv_chart_set_next_value(chart, ser, signal_at(n++));
+        push_us += now_us() - t0;
+        if(ms % FRAME_MS == 0) {
+            t0 = now_us();
+            lv_refr_now(disp);
+            double t = now_us() - t0;
+            /*Dupa ce fereastra de puncte s-a umplut*/
+            if(ms >= WARMUP_MS) {
+                redraw_us += t;
+                redraw_max = LV_MAX(redraw_max, t);
+                frames++;
+            }
+        }
+    }
+    size_t heap = heap_used() - heap0;
+
+    printf("%-6s %u pts: push %4.0f ns/point | redraw avg %6.0f us max %6.0f us (%u frames) | heap %6zu B",
+           name, POINTS, push_us * 1000 / n, redraw_us / frames, redraw_max, frames, heap);
+    int failed = 0;
+    if(mode == LV_CHART_UPDATE_MODE_STREAM) {
+        printf(" (%u columns x %u pts)", ser->column_cnt, ser->column_points);
+        int bad = check_columns(chart, ser);
+
+        /*Punctele scrise direct in array: lv_chart_refresh() reconstruieste coloanele la desenare*/
+        int32_t * y = lv_chart_get_series_y_array(chart, ser);
+        for(uint32_t i = 0; i < POINTS; i++) y[i] = -y[i];
+        lv_chart_refresh(chart);
+        lv_refr_now(disp);
+        int bad_refresh = check_columns(chart, ser);
+        printf(" | columns vs y_points: %d bad, %d bad after lv_chart_refresh()", bad, bad_refresh);
+        failed += bad != 0 || bad_refresh != 0;
+    }
+    printf("\n");
+
+    lv_obj_delete(chart);
+    return failed ? -1 : (int)(redraw_us / frames);
+}
+
+int main(void)
+{
+    lv_init();
+    lv_tick_set_cb(tick_ms);
+    lv_display_t * disp = lv_display_create(HOR_RES, VER_RES);
+    size_t buf_size = HOR_RES * 40 * 2;
+    lv_display_set_buffers(disp, malloc(buf_size), NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+
+    int shift_us = run(disp, LV_CHART_UPDATE_MODE_SHIFT, "shift");
+    int stream_us = run(disp, LV_CHART_UPDATE_MODE_STREAM, "stream");
+
+    int failed = 0;
+    if(stream_us < 0) {
+        printf("The stream columns don't match the points\n");
+        failed++;
+    }
+    else if(stream_us >= shift_us) {
+        printf("STREAM is not faster than SHIFT\n");
+        failed++;
+    }
+
+    lv_deinit();
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file bench_flex.c
+ * Relayout intr-un lv_list flex cu 500 de elemente: se schimba textul unei etichete pe cadru
+ * (doar subarborele ei e murdar) si latimea listei (doar copiii care depind de marimea
+ * parintelui). Se verifica ca pozitiile si marimile sunt aceleasi ca dupa un relayout complet.
+ *
+ *   bench_flex
+ */
+
+#include "lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define ITEM_CNT 500
+#define FRAMES   500
+
+typedef struct {
+    int32_t x, y, w, h;
+} geom_t;
+
+static lv_obj_t * buttons[ITEM_CNT];
+static lv_obj_t * labels[ITEM_CNT];
+static geom_t expected[ITEM_CNT * 2];
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static uint32_t tick_ms(void)
+{
+    return (uint32_t)(now_us() / 1000);
+}
+
+static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(px_map);
+    lv_display_flush_ready(disp);
+}
+
+static void geom_get(geom_t * g)
+{
+    for(int i = 0; i < ITEM_CNT; i++) {
+        g[i * 2] = (geom_t) {
+            lv_obj_get_x(buttons[i]), lv_obj_get_y(buttons[i]), lv_obj_get_width(buttons[i]), lv_obj_get_height(buttons[i])
+        };
+        g[i * 2 + 1] = (geom_t) {
+            lv_obj_get_x(labels[i]), lv_obj_get_y(labels[i]), lv_obj_get_width(labels[i]), lv_obj_get_height(labels[i])
+        };
+    }
+}
+
+/*Relayout complet: toate obiectele murdare, ca inainte de relayout-ul pe subarbori*/
+static int check_full_relayout(lv_obj_t * list, const char * what)
+{
+    static geom_t now[ITEM_CNT * 2];
+    geom_get(now);
+    for(int i = 0; i < ITEM_CNT; i++) {
+        lv_obj_mark_layout_as_dirty(buttons[i]);
+        lv_obj_mark_layout_as_dirty(labels[i]);
+    }
+    lv_obj_mark_layout_as_dirty(list);
+    lv_obj_update_layout(list);
+    geom_get(expected);
+    for(int i = 0; i < ITEM_CNT * 2; i++) {
+        if(now[i].x != expected[i].x || now[i].y != expected[i].y ||
+           now[i].w != expected[i].w || now[i].h != expected[i].h) {
+            printf("%s: object %d at %d,%d %dx%d, full relayout gives %d,%d %dx%d\n", what, i,
+                   (int)now[i].x, (int)now[i].y, (int)now[i].w, (int)now[i].h,
+                   (int)expected[i].x, (int)expected[i].y, (int)expected[i].w, (int)expected[i].h);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(void)
+{
+    lv_init();
+    lv_tick_set_cb(tick_ms);
+    lv_display_t * disp = lv_display_create(320, 240);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    size_t buf_size = 320 * 40 * 2;
+    lv_display_set_buffers(disp, malloc(buf_size), NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+
+    lv_obj_t * list = lv_list_create(lv_screen_active());
+    lv_obj_set_size(list, LV_PCT(100), LV_PCT(100));
+    for(int i = 0; i < ITEM_CNT; i++) {
+        buttons[i] = lv_list_add_button(list, NULL, "Item");
+        labels[i] = lv_obj_get_child(buttons[i], 0);
+    }
+    lv_obj_update_layout(list);
+
+    /*O eticheta pe cadru, ca un contor care se schimba*/
+    char text[32];
+    double t0 = now_us();
+    for(int f = 0; f < FRAMES; f++) {
+        lv_snprintf(text, sizeof(text), "Item %d", (f % 13) * 1000);
+        lv_label_set_text(labels[(f * 37) % ITEM_CNT], text);
+        lv_obj_update_layout(list);
+    }
+    double label_us = (now_us() - t0) / FRAMES;
+    int failed = check_full_relayout(list, "label");
+
+    /*Lista isi schimba latimea: elementele au latimea 100%, deci se refac toate*/
+    t0 = now_us();
+    for(int f = 0; f < FRAMES / 10; f++) {
+        lv_obj_set_width(list, 300 - (f % 2) * 40);
+        lv_obj_update_layout(list);
+    }
+    double resize_us = (now_us() - t0) / (FRAMES / 10);
+    failed += check_full_relayout(list, "resize");
+
+    /*Referinta: relayout complet la fiecare cadru*/
+    t0 = now_us();
+    for(int f = 0; f < FRAMES / 10; f++) {
+        for(int i = 0; i < ITEM_CNT; i++) lv_obj_mark_layout_as_dirty(buttons[i]);
+        lv_obj_update_layout(list);
+    }
+    double full_us = (now_us() - t0) / (FRAMES / 10);
+
+    printf("%d items | one label changed %.1f us/frame | list resized %.1f us/frame | full relayout %.1f us/frame\n",
+           ITEM_CNT, label_us, resize_us, full_us);
+
+    lv_deinit();
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file bench_glyph.c
+ * Cache-ul de glyph-uri (LV_FONT_GLYPH_CACHE_SIZE): paragrafe statice plus sase contoare
+ * care se schimba in fiecare cadru, o data cu cache-ul si o data fara (marime 0).
+ * Se masoara timpul pe cadru si se verifica ca pixelii sunt aceiasi in ambele cazuri.
+ *
+ *   bench_glyph
+ */
+
+#include "lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define FRAMES      400
+#define COUNTER_CNT 6
+
+static uint32_t fake_tick;
+static uint64_t fb_hash;
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/*Timp simulat: aceleasi cadre in ambele rulari*/
+static uint32_t tick_ms(void)
+{
+    return fake_tick;
+}
+
+static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    size_t size = (size_t)lv_area_get_size(area) * 2;
+    for(size_t i = 0; i < size; i++) fb_hash = (fb_hash ^ px_map[i]) * 1099511628211ULL;
+    lv_display_flush_ready(disp);
+}
+
+static const char * paragraph =
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore "
+    "et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation.";
+
+static double run(lv_display_t * disp, bool cached, lv_font_glyph_cache_stats_t * stats)
+{
+    lv_font_glyph_cache_resize(cached ? LV_FONT_GLYPH_CACHE_SIZE : 0, true);
+    lv_font_glyph_cache_reset_stats();
+    fb_hash = 1469598103934665603ULL;
+
+    lv_obj_t * scr = lv_obj_create(NULL);
+    lv_obj_t * label = lv_label_create(scr);
+    lv_label_set_text_static(label, paragraph);
+    lv_obj_set_width(label, 300);
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_14, 0);
+    label = lv_label_create(scr);
+    lv_label_set_text_static(label, paragraph);
+    lv_obj_set_width(label, 300);
+    lv_obj_set_y(label, 90);
+
+    lv_obj_t * counters[COUNTER_CNT];
+    for(int i = 0; i < COUNTER_CNT; i++) {
+        counters[i] = lv_label_create(scr);
+        lv_obj_set_pos(counters[i], 10 + (i % 3) * 100, 160 + (i / 3) * 30);
+        lv_obj_set_style_text_font(counters[i], &lv_font_montserrat_16, 0);
+    }
+    lv_screen_load(scr);
+
+    char text[32];
+    double t0 = now_us();
+    for(int f = 0; f < FRAMES; f++) {
+        for(int i = 0; i < COUNTER_CNT; i++) {
+            lv_snprintf(text, sizeof(text), "%d.%02d%%", (f * 7 + i * 13) % 1000, (f * 3 + i) % 100);
+            lv_label_set_text(counters[i], text);
+        }
+        /*Din cand in cand tot ecranul, ca la schimbarea tab-ului*/
+        if(f % 4 == 0) lv_obj_invalidate(scr);
+        fake_tick += 5;
+        lv_refr_now(disp);
+    }
+    double us = (now_us() - t0) / FRAMES;
+
+    lv_font_glyph_cache_get_stats(stats);
+    lv_screen_load(lv_obj_create(NULL));
+    lv_obj_delete(scr);
+    return us;
+}
+
+int main(void)
+{
+    lv_init();
+    lv_tick_set_cb(tick_ms);
+    lv_display_t * disp = lv_display_create(320, 240);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    size_t buf_size = 320 * 40 * 2;
+    lv_display_set_buffers(disp, malloc(buf_size), NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+
+    lv_font_glyph_cache_stats_t st_cached, st_uncached;
+    double us_cached = run(disp, true, &st_cached);
+    uint64_t hash_cached = fb_hash;
+    double us_uncached = run(disp, false, &st_uncached);
+    uint64_t hash_uncached = fb_hash;
+
+    printf("cached   %7.1f us/frame | hits %u misses %u evictions %u bypassed %u\n", us_cached,
+           (unsigned)st_cached.hits, (unsigned)st_cached.misses, (unsigned)st_cached.evictions, (unsigned)st_cached.bypassed);
+    printf("uncached %7.1f us/frame | hits %u misses %u evictions %u bypassed %u\n", us_uncached,
+           (unsigned)st_uncached.hits, (unsigned)st_uncached.misses, (unsigned)st_uncached.evictions,
+           (unsigned)st_uncached.bypassed);
+
+    int failed = 0;
+    if(hash_cached != hash_uncached) {
+        printf("The pixels differ with and without the cache\n");
+        failed++;
+    }
+    if(st_cached.hits == 0 || st_uncached.hits != 0) {
+        printf("The cache was not used as configured\n");
+        failed++;
+    }
+
+    lv_deinit();
+    return failed == 0 ? 0 : 1;
+}
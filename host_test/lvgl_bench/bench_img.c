@@ -0,0 +1,201 @@
+/**
+ * @file bench_img.c
+ * Vizualizatorul de poze pe 320x240: un JPEG de 320x240 (TJPGD) cu un ceas deasupra si un GIF
+ * animat de 320x240, cu buffer-ul de desenare de `lines` linii. Se masoara timpul pe cadru
+ * (prima desenare, redesenarea intregii poze, doar ceasul, un cadru de GIF) si varful heap-ului
+ * LVGL. Pentru JPEG randurile de MCU decodate trebuie sa vina din cache dupa prima desenare si
+ * cache-ul sa ramana in buget; pentru GIF se trimite pe ecran doar dreptunghiul schimbat.
+ * Imaginile sunt in assets/, incluse ca array-uri de CMake.
+ *
+ *   bench_img jpg <lines> [cache_bytes]
+ *   bench_img gif <lines>
+ */
+
+#include "lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HOR_RES   320
+#define VER_RES   240
+#define REDRAWS   20
+#define GIF_LOOPS 4
+
+extern const uint8_t photo_jpg[];
+extern const uint32_t photo_jpg_size;
+extern const uint8_t anim_gif[];
+extern const uint32_t anim_gif_size;
+
+static uint32_t fake_tick;
+static uint64_t flushed_px;
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static uint32_t tick_ms(void)
+{
+    return fake_tick;
+}
+
+static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(px_map);
+    flushed_px += lv_area_get_size(area);
+    lv_display_flush_ready(disp);
+}
+
+static size_t heap_used(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+static size_t heap_peak(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.max_used;
+}
+
+static int run_jpg(lv_display_t * disp, int lines, long cache)
+{
+    static lv_image_dsc_t photo;
+    photo.header.cf = LV_COLOR_FORMAT_RAW;
+    photo.header.w = HOR_RES;   /*TJPGD nu citeste dimensiunile din date*/
+    photo.header.h = VER_RES;
+    photo.data = photo_jpg;
+    photo.data_size = photo_jpg_size;
+
+    if(cache >= 0) lv_tjpgd_cache_resize((uint32_t)cache);
+    size_t heap0 = heap_used();
+    size_t peak0 = heap_peak();
+
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_t * img = lv_image_create(scr);
+    lv_image_set_src(img, &photo);
+    lv_obj_center(img);
+    lv_obj_t * clock = lv_label_create(scr);
+    lv_obj_align(clock, LV_ALIGN_TOP_RIGHT, -4, 4);
+    lv_label_set_text(clock, "12:00:00");
+
+    double t0 = now_us();
+    lv_refr_now(disp);
+    double first_us = now_us() - t0;
+    lv_tjpgd_cache_stats_t st0;
+    lv_tjpgd_get_cache_stats(&st0);
+
+    /*Toata poza, de ex. cand intra pe ecran*/
+    t0 = now_us();
+    for(int i = 0; i < REDRAWS; i++) {
+        lv_obj_invalidate(img);
+        lv_refr_now(disp);
+    }
+    double full_us = (now_us() - t0) / REDRAWS;
+
+    /*Doar ceasul de deasupra pozei*/
+    t0 = now_us();
+    for(int i = 0; i < REDRAWS; i++) {
+        lv_label_set_text_fmt(clock, "12:00:%02d", i);
+        lv_refr_now(disp);
+    }
+    double clock_us = (now_us() - t0) / REDRAWS;
+
+    lv_tjpgd_cache_stats_t st;
+    lv_tjpgd_get_cache_stats(&st);
+    size_t peak = heap_peak() - peak0;
+    printf("jpg lines %3d cache %7u B: first %7.0f us, full %7.0f us, clock %6.0f us | heap now %6zu B, peak %6zu B | "
+           "rows hit %u miss %u skipped %u restarts %u, cache peak %u B\n",
+           lines, (unsigned)st.max_size, first_us, full_us, clock_us, heap_used() - heap0, peak,
+           (unsigned)st.hits, (unsigned)st.misses, (unsigned)st.skipped_rows, (unsigned)st.restarts,
+           (unsigned)st.peak_size);
+
+    int failed = 0;
+    if(st.peak_size > st.max_size) failed++;
+    if(st.max_size >= HOR_RES * VER_RES * 3) {
+        /*Toata poza incape in cache: nimic nu se mai decodeaza dupa prima desenare*/
+        if(st.misses != st0.misses || st.restarts != st0.restarts || st.hits == st0.hits) failed++;
+        if(full_us >= first_us) failed++;
+    }
+    /*Cache-ul plus fluxul de decodare, nu o copie decodata a pozei peste el*/
+    if(peak > st.max_size + 64 * 1024) failed++;
+    if(clock_us >= full_us) failed++;
+
+    lv_obj_delete(img);
+    lv_obj_delete(clock);
+    return failed;
+}
+
+static int run_gif(lv_display_t * disp, int lines)
+{
+    static lv_image_dsc_t anim;
+    anim.header.cf = LV_COLOR_FORMAT_RAW;
+    anim.data = anim_gif;
+    anim.data_size = anim_gif_size;
+
+    size_t heap0 = heap_used();
+    size_t peak0 = heap_peak();
+    lv_obj_t * gif = lv_gif_create(lv_screen_active());
+    lv_gif_set_src(gif, &anim);
+    lv_obj_center(gif);
+    lv_refr_now(disp);
+
+    /*Cadrele la 40 ms, decodare si desenare*/
+    double sum_us = 0, max_us = 0;
+    int frames = 0;
+    flushed_px = 0;
+    for(int i = 0; i < 30 * GIF_LOOPS; i++) {
+        fake_tick += 40;
+        double t0 = now_us();
+        lv_timer_handler();
+        lv_refr_now(disp);
+        double t = now_us() - t0;
+        sum_us += t;
+        max_us = LV_MAX(max_us, t);
+        frames++;
+    }
+    double px_per_frame = (double)flushed_px / frames;
+    size_t peak = heap_peak() - peak0;
+    printf("gif lines %3d: frame avg %6.0f us max %6.0f us (%d frames) | %5.1f%% of the screen flushed per frame | "
+           "heap now %6zu B, peak %6zu B\n",
+           lines, sum_us / frames, max_us, frames, px_per_frame * 100 / (HOR_RES * VER_RES), heap_used() - heap0, peak);
+
+    int failed = 0;
+    /*Doar dreptunghiul schimbat al fiecarui cadru, nu tot GIF-ul*/
+    if(px_per_frame >= HOR_RES * VER_RES / 2) failed++;
+    /*gifdec: canvas-ul ARGB8888 plus indexurile cadrului (5 B/pixel), plus tabela LZW; nicio copie a cadrului*/
+    if(peak > HOR_RES * VER_RES * 5 + 32 * 1024) failed++;
+
+    lv_obj_delete(gif);
+    return failed;
+}
+
+int main(int argc, char ** argv)
+{
+    if(argc < 3) {
+        printf("usage: bench_img jpg|gif <lines> [cache_bytes]\n");
+        return 1;
+    }
+    int lines = atoi(argv[2]);
+    long cache = argc > 3 ? atol(argv[3]) : -1;
+
+    lv_init();
+    lv_tick_set_cb(tick_ms);
+    lv_display_t * disp = lv_display_create(HOR_RES, VER_RES);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    size_t buf_size = HOR_RES * lines * 2;
+    lv_display_set_buffers(disp, malloc(buf_size), NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_obj_remove_flag(lv_screen_active(), LV_OBJ_FLAG_SCROLLABLE);
+    lv_refr_now(disp);
+
+    int failed = strcmp(argv[1], "jpg") == 0 ? run_jpg(disp, lines, cache) : run_gif(disp, lines);
+
+    lv_deinit();
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+/**
+ * @file bench_imgcache.c
+ * Cache-ul de imagini decodate: secvente de accese inregistrate dintr-un model al UI-ului (6 ecrane
+ * cu fundal si iconite, bara de stare, galerie cu miniaturi si poze) reluate prin clasele reale
+ * lv_cache_class_lru_rb_size si lv_cache_class_gdsf, cu bugete de 128/256/512 KB. Costul decodarii
+ * fiecarei imagini e cel de pe ESP32-S3 (PNG ~1.3 MB/s, JPEG ~2.5 MB/s, bin din LittleFS ~10 MB/s).
+ * Se compara rata de hit si timpul de decodare; GDSF nu trebuie sa fie mai slab ca LRU si
+ * cache-ul distrus nu lasa nimic in heap. Secventele sunt generate determinist din 3 seed-uri.
+ *
+ *   bench_imgcache
+ */
+
+#include "lvgl.h"
+#include "src/misc/cache/lv_cache_private.h"
+#include "src/misc/cache/class/lv_cache_gdsf.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N_ICON  48
+#define N_BG    6
+#define N_THUMB 40
+#define N_PHOTO 40
+#define N_IMG   (N_ICON + N_BG + N_THUMB + N_PHOTO)
+#define VISITS  2000
+#define TRACE_MAX (VISITS * 24)
+
+typedef struct {
+    uint32_t size;
+    uint32_t cost_us;
+} img_t;
+
+typedef struct {
+    lv_cache_slot_cost_t slot;
+    uint32_t id;
+} node_t;
+
+typedef struct {
+    uint16_t ids[TRACE_MAX];
+    uint32_t len;
+} trace_t;
+
+typedef struct {
+    double hit;
+    double decode_s;
+} result_t;
+
+static img_t catalog[N_IMG];
+static uint32_t rnd_state;
+static uint32_t evicted;
+
+/*Bufferele decodate si timpii de decodare*/
+static void make_catalog(void)
+{
+    int k = 0;
+    for(int i = 0; i < N_ICON; i++) catalog[k++] = (img_t) {48 * 48 * 4, 48 * 48 * 4 * 10 / 13};  /*PNG ARGB*/
+    for(int i = 0; i < N_BG; i++) {
+        if(i < 3) catalog[k++] = (img_t) {320 * 240 * 2, 320 * 240 * 2 / 10};                     /*bin*/
+        else catalog[k++] = (img_t) {320 * 240 * 2, 320 * 240 * 2 * 10 / 13};                     /*PNG*/
+    }
+    /*JPEG plus deschiderea fisierului*/
+    for(int i = 0; i < N_THUMB; i++) catalog[k++] = (img_t) {80 * 60 * 2, 80 * 60 * 2 * 10 / 25 + 3000};
+    for(int i = 0; i < N_PHOTO; i++) catalog[k++] = (img_t) {320 * 240 * 2, 320 * 240 * 2 * 10 / 25};
+}
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245u + 12345u;
+    return rnd_state >> 8;
+}
+
+/*P(i) ~ 1/(i+1)*/
+static int zipf(int n)
+{
+    double h = 0;
+    for(int i = 0; i < n; i++) h += 1.0 / (i + 1);
+    double r = (rnd() % 1000000) / 1e6 * h;
+    double acc = 0;
+    for(int i = 0; i < n; i++) {
+        acc += 1.0 / (i + 1);
+        if(r <= acc) return i;
+    }
+    return n - 1;
+}
+
+static void trace_add(trace_t * t, int id)
+{
+    if(t->len < TRACE_MAX) t->ids[t->len++] = (uint16_t)id;
+}
+
+/*Ecranul 0 e cel principal; la fiecare vizita se deseneaza bara de stare (4 iconite), fundalul si
+ *iconitele ecranului, cu cateva redesenari la apasare. Ecranul 5 e galeria: o pagina de 8 miniaturi
+ *si 1..3 poze deschise.*/
+static void record(trace_t * t, uint32_t seed)
+{
+    rnd_state = seed;
+    t->len = 0;
+    int screen = 0;
+    for(int v = 0; v < VISITS; v++) {
+        for(int i = 0; i < 4; i++) trace_add(t, i);
+        if(screen < 5) {
+            trace_add(t, N_ICON + screen % N_BG);
+            for(int i = 0; i < 8; i++) trace_add(t, 4 + screen * 8 + i);
+            for(int r = 0; r < 3; r++) trace_add(t, 4 + screen * 8 + rnd() % 8);
+        }
+        else {
+            trace_add(t, N_ICON + 5);
+            int page = zipf(5);
+            for(int i = 0; i < 8; i++) trace_add(t, N_ICON + N_BG + page * 8 + i);
+            int opens = 1 + rnd() % 3;
+            for(int i = 0; i < opens; i++) trace_add(t, N_ICON + N_BG + N_THUMB + zipf(N_PHOTO));
+        }
+        screen = screen == 0 ? 1 + zipf(5) : (rnd() % 3 == 0 ? 1 + zipf(5) : 0);
+    }
+}
+
+static lv_cache_compare_res_t compare_cb(const node_t * a, const node_t * b)
+{
+    if(a->id == b->id) return 0;
+    return a->id > b->id ? 1 : -1;
+}
+
+static void free_cb(node_t * node, void * user_data)
+{
+    LV_UNUSED(node);
+    LV_UNUSED(user_data);
+    evicted++;
+}
+
+static result_t replay(const trace_t * t, const lv_cache_class_t * cache_class, const char * name, uint32_t budget,
+                       int * failed)
+{
+    lv_mem_monitor_t mon0;
+    lv_mem_monitor(&mon0);
+    lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)compare_cb,
+        .free_cb = (lv_cache_free_cb_t)free_cb,
+    };
+    lv_cache_t * cache = lv_cache_create(cache_class, sizeof(node_t), budget, ops);
+
+    uint32_t hits = 0;
+    uint64_t bytes = 0, hit_bytes = 0, decode_us = 0, uncached_us = 0;
+    evicted = 0;
+    for(uint32_t i = 0; i < t->len; i++) {
+        const img_t * img = &catalog[t->ids[i]];
+        bytes += img->size;
+        uncached_us += img->cost_us;
+        node_t key = {.id = t->ids[i]};
+        lv_cache_entry_t * entry = lv_cache_acquire(cache, &key, NULL);
+        if(entry) {
+            hits++;
+            hit_bytes += img->size;
+        }
+        else {
+            decode_us += img->cost_us;
+            key.slot.size = img->size;
+            entry = lv_cache_add(cache, &key, NULL);
+            /*Costul se afla dupa adaugare, ca in lv_image_decoder_open()*/
+            if(entry) ((node_t *)lv_cache_entry_get_data(entry))->slot.cost = img->cost_us;
+        }
+        if(entry) lv_cache_release(cache, entry, NULL);
+    }
+    lv_cache_destroy(cache, NULL);
+
+    lv_mem_monitor_t mon1;
+    lv_mem_monitor(&mon1);
+    int32_t leak = (int32_t)(mon0.free_size - mon1.free_size);
+    if(leak != 0) (*failed)++;
+
+    result_t res = {100.0 * hits / t->len, decode_us / 1e6};
+    printf("%-4s %3u KB: hit %5.1f%%, byte hit %5.1f%%, decode %6.1f s (%5.1f%% of uncached), evictions %5u, "
+           "heap left %d B\n",
+           name, (unsigned)(budget / 1024), res.hit, 100.0 * hit_bytes / bytes, res.decode_s,
+           100.0 * decode_us / uncached_us, (unsigned)evicted, (int)leak);
+    return res;
+}
+
+int main(void)
+{
+    static trace_t trace;
+    static const uint32_t budgets_kb[] = {128, 256, 512};
+
+    lv_init();
+    make_catalog();
+
+    int failed = 0;
+    for(uint32_t seed = 1; seed <= 3; seed++) {
+        record(&trace, seed);
+        printf("trace %u: %u accesses\n", (unsigned)seed, (unsigned)trace.len);
+        for(size_t b = 0; b < sizeof(budgets_kb) / sizeof(budgets_kb[0]); b++) {
+            uint32_t budget = budgets_kb[b] * 1024;
+            result_t lru = replay(&trace, &lv_cache_class_lru_rb_size, "LRU", budget, &failed);
+            result_t gdsf = replay(&trace, &lv_cache_class_gdsf, "GDSF", budget, &failed);
+            if(gdsf.hit < lru.hit || gdsf.decode_s > lru.decode_s) {
+                printf("GDSF is worse than LRU at %u KB\n", (unsigned)budgets_kb[b]);
+                failed++;
+            }
+        }
+    }
+
+    lv_deinit();
+    return failed == 0 ? 0 : 1;
+}
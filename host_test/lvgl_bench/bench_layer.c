@@ -0,0 +1,139 @@
+/**
+ * @file bench_layer.c
+ * Scenele cu layere din demos/render (normal, blend mode, opacitate), plus ecranul intreg
+ * cu opa_layered si rotit, cu configuratia proiectului (LV_DRAW_LAYER_TRANSFORM_BUF_SIZE,
+ * LV_DRAW_LAYER_MAX_MEMORY, LV_DRAW_LAYER_BUF_POOL_CNT). Se masoara timpul pe cadru,
+ * heap-ul si memoria layerelor; se verifica limita de memorie si ca imaginea nu depinde
+ * de cadru (bucatile si pool-ul nu schimba pixelii).
+ *
+ *   bench_layer [scene_index]
+ */
+
+#include "lvgl.h"
+#include "demos/render/lv_demo_render.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HOR_RES 320
+#define VER_RES 240
+#define REPS    20
+
+typedef enum {
+    SCENE_AS_IS,
+    SCENE_SCREEN_OPA,
+    SCENE_SCREEN_ROTATED,
+} scene_extra_t;
+
+typedef struct {
+    const char * name;
+    lv_demo_render_scene_t id;
+    lv_opa_t opa;
+    scene_extra_t extra;
+} scene_t;
+
+static const scene_t scenes[] = {
+    {"layer_normal",            LV_DEMO_RENDER_SCENE_LAYER_NORMAL, LV_OPA_COVER, SCENE_AS_IS},
+    {"layer_normal/opa50",      LV_DEMO_RENDER_SCENE_LAYER_NORMAL, LV_OPA_50,    SCENE_AS_IS},
+    {"blend_mode",              LV_DEMO_RENDER_SCENE_BLEND_MODE,   LV_OPA_COVER, SCENE_AS_IS},
+    {"blend_mode/opa50",        LV_DEMO_RENDER_SCENE_BLEND_MODE,   LV_OPA_50,    SCENE_AS_IS},
+    {"layer_normal+screen opa", LV_DEMO_RENDER_SCENE_LAYER_NORMAL, LV_OPA_COVER, SCENE_SCREEN_OPA},
+    {"layer_normal+screen rot", LV_DEMO_RENDER_SCENE_LAYER_NORMAL, LV_OPA_COVER, SCENE_SCREEN_ROTATED},
+};
+
+static uint16_t fb[HOR_RES * VER_RES];
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static uint32_t tick_ms(void)
+{
+    return (uint32_t)now_ms();
+}
+
+static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    int32_t w = lv_area_get_width(area);
+    for(int32_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&fb[y * HOR_RES + area->x1], px_map, w * 2);
+        px_map += w * 2;
+    }
+    lv_display_flush_ready(disp);
+}
+
+static uint32_t fb_hash(void)
+{
+    uint32_t h = 2166136261u;
+    for(uint32_t i = 0; i < HOR_RES * VER_RES; i++) h = (h ^ fb[i]) * 16777619u;
+    return h;
+}
+
+int main(int argc, char ** argv)
+{
+    int only = argc > 1 ? atoi(argv[1]) : -1;
+
+    lv_init();
+    lv_tick_set_cb(tick_ms);
+    lv_display_t * disp = lv_display_create(HOR_RES, VER_RES);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    /*Ca pe placa: 40 de linii, randare partiala*/
+    size_t buf_size = HOR_RES * 40 * 2;
+    lv_display_set_buffers(disp, malloc(buf_size), NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+
+    int failed = 0;
+    double total = 0;
+    for(int s = 0; s < (int)(sizeof(scenes) / sizeof(scenes[0])); s++) {
+        if(only >= 0 && s != only) continue;
+        const scene_t * scene = &scenes[s];
+
+        lv_demo_render(scene->id, scene->opa);
+        lv_obj_t * main_parent = lv_obj_get_child(lv_screen_active(), 0);
+        if(scene->extra == SCENE_SCREEN_OPA) {
+            lv_obj_set_style_opa_layered(main_parent, 200, 0);
+        }
+        else if(scene->extra == SCENE_SCREEN_ROTATED) {
+            lv_obj_set_style_transform_rotation(main_parent, 50, 0);
+            lv_obj_set_style_transform_pivot_x(main_parent, HOR_RES / 2, 0);
+            lv_obj_set_style_transform_pivot_y(main_parent, VER_RES / 2, 0);
+        }
+        lv_refr_now(disp);
+        uint32_t first_hash = fb_hash();
+        lv_draw_layer_reset_mem_info();
+
+        double t0 = now_ms();
+        for(int r = 0; r < REPS; r++) {
+            lv_obj_invalidate(lv_screen_active());
+            lv_refr_now(disp);
+        }
+        double t = (now_ms() - t0) / REPS;
+        total += t;
+
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        lv_draw_layer_mem_info_t info;
+        lv_draw_layer_get_mem_info(&info);
+        uint32_t hash = fb_hash();
+
+        /*Peste limita doar daca toate celelalte layere asteptau dupa cel nou, si atunci e numarat*/
+        bool over = info.limit && info.peak > info.limit && info.over_limit_cnt == 0;
+        bool changed = hash != first_hash;
+        if(over || changed) failed++;
+
+        printf("%-24s %6.2f ms/frame | heap max %4u kB frag %2u%% | layers peak %4u kB (pooled %3u kB) "
+               "alloc %4u reuse %4u wait %4u over %u | fb %08x%s%s\n",
+               scene->name, t, (unsigned)(mon.max_used / 1024), (unsigned)mon.frag_pct,
+               (unsigned)(info.peak / 1024), (unsigned)(info.pooled / 1024), (unsigned)info.alloc_cnt,
+               (unsigned)info.reuse_cnt, (unsigned)info.wait_cnt, (unsigned)info.over_limit_cnt, (unsigned)hash,
+               over ? " | OVER THE LIMIT" : "", changed ? " | IMAGE CHANGED" : "");
+    }
+    printf("total %.2f ms\n", total);
+
+    lv_deinit();
+    return failed == 0 ? 0 : 1;
+}
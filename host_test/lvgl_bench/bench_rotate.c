@@ -0,0 +1,236 @@
+/**
+ * @file bench_rotate.c
+ * Imagini rotite cu 0/90/180/270 de grade pe 320x240 (RGB565 si RGB565_SWAPPED ca pe placa),
+ * 12 imagini pe ecran, unele taiate de margini, una cu opacitate 50%, buffer de 40 de linii.
+ * Se masoara cel mai bun timp de redesenare a ecranului pentru fiecare format de imagine.
+ * Rotatia 0 trece prin copierea pe randuri, fara transformare; se verifica pixel cu pixel fata de
+ * imaginea sursa. Acelasi program e compilat si cu LV_DRAW_SW_RIGHT_ANGLE_ROTATION 0
+ * (bench_rotate_ref), adica cu transform_and_recolor(): el scrie imaginile si timpii intr-un
+ * fisier, iar bench_rotate compara cu ele. Imaginile RGB565 trebuie sa fie identice, cele pe
+ * 24/32 de biti pot diferi cu 1 LSB (nu mai sunt interpolate prin ARGB8888), cele ARGB8888
+ * semitransparente cu 2 LSB (1 LSB in culoare si 1 in alpha).
+ *
+ *   bench_rotate_ref rotate_ref.bin
+ *   bench_rotate - rotate_ref.bin
+ */
+
+#include "lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HOR_RES 320
+#define VER_RES 240
+#define LINES   40
+#define ITERS   30
+
+typedef struct {
+    const char * name;
+    lv_color_format_t cf;
+    int max_lsb;    /*diferenta permisa fata de transformarea generala, pe canalele RGB565*/
+} img_format_t;
+
+static const img_format_t img_formats[] = {
+    {"RGB565", LV_COLOR_FORMAT_RGB565, 0},
+    {"RGB565_SWAPPED", LV_COLOR_FORMAT_RGB565_SWAPPED, 0},
+    {"RGB888", LV_COLOR_FORMAT_RGB888, 1},
+    {"XRGB8888", LV_COLOR_FORMAT_XRGB8888, 1},
+    {"ARGB8888", LV_COLOR_FORMAT_ARGB8888, 2},
+};
+
+static const lv_color_format_t disp_formats[] = {LV_COLOR_FORMAT_RGB565_SWAPPED, LV_COLOR_FORMAT_RGB565};
+static const int32_t rotations[] = {0, 900, 1800, 2700};
+static const lv_point_t sizes[] = {{160, 120}, {47, 33}};
+
+static uint16_t fb[HOR_RES * VER_RES];
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    int32_t w = lv_area_get_width(area);
+    for(int32_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&fb[y * HOR_RES + area->x1], px_map, w * 2);
+        px_map += w * 2;
+    }
+    lv_display_flush_ready(disp);
+}
+
+static void make_image(lv_image_dsc_t * dsc, lv_color_format_t cf, int32_t w, int32_t h)
+{
+    uint32_t px_size = lv_color_format_get_size(cf);
+    uint32_t stride = w * px_size;
+    uint8_t * data = malloc(stride * h);
+    srand(w * 7 + h);
+    for(int32_t y = 0; y < h; y++) {
+        for(int32_t x = 0; x < w; x++) {
+            uint8_t * p = data + y * stride + x * px_size;
+            uint32_t v = (uint32_t)rand();
+            for(uint32_t i = 0; i < px_size; i++) p[i] = (uint8_t)(v >> (i * 8));
+            if(cf == LV_COLOR_FORMAT_ARGB8888) p[3] = (uint8_t)((x + y) * 8);
+            else if(cf == LV_COLOR_FORMAT_XRGB8888) p[3] = 0xff;
+        }
+    }
+    lv_memzero(dsc, sizeof(lv_image_dsc_t));
+    dsc->header.magic = LV_IMAGE_HEADER_MAGIC;
+    dsc->header.cf = cf;
+    dsc->header.w = w;
+    dsc->header.h = h;
+    dsc->header.stride = stride;
+    dsc->data = data;
+    dsc->data_size = stride * h;
+}
+
+static uint16_t to_rgb565(lv_color_format_t disp_cf, uint16_t px)
+{
+    return disp_cf == LV_COLOR_FORMAT_RGB565_SWAPPED ? (uint16_t)((px << 8) | (px >> 8)) : px;
+}
+
+/*Cea mai mare diferenta pe un canal R/G/B si numarul de pixeli diferiti*/
+static int compare(lv_color_format_t disp_cf, const uint16_t * a, const uint16_t * b, uint32_t * diff_px)
+{
+    int max_diff = 0;
+    *diff_px = 0;
+    for(uint32_t i = 0; i < HOR_RES * VER_RES; i++) {
+        if(a[i] == b[i]) continue;
+        uint16_t pa = to_rgb565(disp_cf, a[i]);
+        uint16_t pb = to_rgb565(disp_cf, b[i]);
+        int d[3] = {abs((pa >> 11) - (pb >> 11)), abs(((pa >> 5) & 0x3f) - ((pb >> 5) & 0x3f)), abs((pa & 0x1f) - (pb & 0x1f))};
+        max_diff = LV_MAX(max_diff, LV_MAX(d[0], LV_MAX(d[1], d[2])));
+        (*diff_px)++;
+    }
+    return max_diff;
+}
+
+/*Rotatia 0, o imagine RGB565 intreaga pe ecran: pixelii sunt copiati exact*/
+static int check_identity(lv_display_t * disp, lv_color_format_t disp_cf, const lv_image_dsc_t * img)
+{
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_clean(scr);
+    lv_obj_t * obj = lv_image_create(scr);
+    lv_image_set_src(obj, img);
+    lv_obj_set_pos(obj, 7, 5);
+    lv_refr_now(disp);
+
+    int bad = 0;
+    const uint16_t * src = (const uint16_t *)img->data;
+    for(int32_t y = 0; y < img->header.h; y++) {
+        for(int32_t x = 0; x < img->header.w; x++) {
+            if(to_rgb565(disp_cf, fb[(y + 5) * HOR_RES + x + 7]) != src[y * img->header.w + x]) bad++;
+        }
+    }
+    lv_obj_clean(scr);
+    return bad;
+}
+
+static double render(lv_display_t * disp, const lv_image_dsc_t * img, int32_t rotation)
+{
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_clean(scr);
+    int32_t w = img->header.w;
+    int32_t h = img->header.h;
+    for(int r = 0; r < 3; r++) {
+        for(int c = 0; c < 4; c++) {
+            lv_obj_t * obj = lv_image_create(scr);
+            lv_image_set_src(obj, img);
+            lv_obj_set_pos(obj, -w / 3 + c * (HOR_RES / 3), -h / 4 + r * (VER_RES * 2 / 5));
+            lv_image_set_rotation(obj, rotation);
+            if(r == 2 && c == 3) lv_obj_set_style_image_opa(obj, LV_OPA_50, 0);
+        }
+    }
+    lv_refr_now(disp);
+
+    double best = 1e9;
+    for(int i = 0; i < ITERS; i++) {
+        lv_obj_invalidate(scr);
+        double t0 = now_us();
+        lv_refr_now(disp);
+        best = LV_MIN(best, now_us() - t0);
+    }
+    return best;
+}
+
+int main(int argc, char ** argv)
+{
+    if(argc < 2) {
+        printf("usage: bench_rotate <out.bin|-> [ref.bin]\n");
+        return 1;
+    }
+    FILE * out = strcmp(argv[1], "-") != 0 ? fopen(argv[1], "wb") : NULL;
+    FILE * ref = argc > 2 ? fopen(argv[2], "rb") : NULL;
+    if((strcmp(argv[1], "-") != 0 && out == NULL) || (argc > 2 && ref == NULL)) {
+        printf("Can't open the output or the reference file\n");
+        return 1;
+    }
+
+    lv_init();
+    lv_display_t * disp = lv_display_create(HOR_RES, VER_RES);
+    size_t buf_size = HOR_RES * LINES * 2;
+    lv_display_set_buffers(disp, malloc(buf_size), NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_remove_flag(scr, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x204060), 0);
+
+    static uint16_t ref_fb[HOR_RES * VER_RES];
+    int failed = 0;
+    for(size_t d = 0; d < sizeof(disp_formats) / sizeof(disp_formats[0]); d++) {
+        lv_color_format_t disp_cf = disp_formats[d];
+        lv_display_set_color_format(disp, disp_cf);
+        printf("%s display\n", disp_cf == LV_COLOR_FORMAT_RGB565 ? "RGB565" : "RGB565_SWAPPED");
+        for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            for(size_t f = 0; f < sizeof(img_formats) / sizeof(img_formats[0]); f++) {
+                const img_format_t * fmt = &img_formats[f];
+                lv_image_dsc_t img;
+                make_image(&img, fmt->cf, sizes[s].x, sizes[s].y);
+                if(fmt->cf == LV_COLOR_FORMAT_RGB565) {
+                    int bad = check_identity(disp, disp_cf, &img);
+                    if(bad) {
+                        printf("  rotation 0 changed %d pixels of a %s image\n", bad, fmt->name);
+                        failed++;
+                    }
+                }
+
+                for(size_t r = 0; r < sizeof(rotations) / sizeof(rotations[0]); r++) {
+                    double us = render(disp, &img, rotations[r]);
+                    printf("  %-14s %3dx%-3d rot %3d: %6.0f us", fmt->name, (int)sizes[s].x, (int)sizes[s].y,
+                           (int)rotations[r] / 10, us);
+                    if(out) {
+                        fwrite(&us, sizeof(us), 1, out);
+                        fwrite(fb, sizeof(fb), 1, out);
+                    }
+                    double ref_us = 0;
+                    if(ref && fread(&ref_us, sizeof(ref_us), 1, ref) == 1 && fread(ref_fb, sizeof(ref_fb), 1, ref) == 1) {
+                        uint32_t diff_px;
+                        int max_diff = compare(disp_cf, fb, ref_fb, &diff_px);
+                        printf(" | transform %6.0f us | %5u pixels differ, max %d LSB", ref_us, (unsigned)diff_px, max_diff);
+                        if(max_diff > fmt->max_lsb) failed++;
+                        /*Imaginile mari: copierea trebuie sa fie mai rapida decat transformarea*/
+                        if(rotations[r] != 0 && s == 0 && us >= ref_us) {
+                            printf(" | not faster");
+                            failed++;
+                        }
+                    }
+                    else if(ref) {
+                        printf(" | the reference file is too short");
+                        failed++;
+                    }
+                    printf("\n");
+                }
+                lv_obj_clean(scr);
+                free((void *)img.data);
+            }
+        }
+    }
+
+    if(out) fclose(out);
+    if(ref) fclose(ref);
+    lv_deinit();
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file bench_subject.c
+ * Subject-e setate dintr-un alt thread: notificare imediata (cu lv_lock()) fata de
+ * lv_subject_set_deferred(). Un producator seteaza 20 de Subject-e la 1 kHz, legate de
+ * etichete si arce; se masoara CPU-ul, cadrele si latenta set -> flush.
+ *
+ *   bench_subject immediate | deferred
+ */
+
+#include "lvgl.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SUBJECT_CNT 20
+#define RUN_MS      2000
+
+static lv_subject_t subjects[SUBJECT_CNT];
+static double set_time[1 << 16];
+static atomic_bool stop;
+static bool deferred;
+static uint32_t observer_calls, frames, sets;
+static int32_t last_value[SUBJECT_CNT];
+static double latency_sum, latency_max, blocked_ms;
+static uint32_t latency_cnt;
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static double cpu_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static uint32_t tick_ms(void)
+{
+    return (uint32_t)now_ms();
+}
+
+static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(px_map);
+    /*Magistrala i80 a panoului, ~8 MB/s: nu consuma CPU, dar thread-ul LVGL o asteapta*/
+    usleep(lv_area_get_size(area) * 2 / 8);
+    if(lv_display_flush_is_last(disp)) {
+        int32_t v = lv_subject_get_int(&subjects[0]);
+        if(v > 0) {
+            double latency = now_ms() - set_time[v & 0xffff];
+            latency_sum += latency;
+            latency_cnt++;
+            if(latency > latency_max) latency_max = latency;
+        }
+        frames++;
+    }
+    lv_display_flush_ready(disp);
+}
+
+static void count_cb(lv_observer_t * observer, lv_subject_t * subject)
+{
+    LV_UNUSED(observer);
+    LV_UNUSED(subject);
+    observer_calls++;
+}
+
+static void * producer(void * arg)
+{
+    LV_UNUSED(arg);
+    int32_t seq = 1;
+    double next = now_ms();
+    while(!stop) {
+        for(int i = 0; i < SUBJECT_CNT; i++) {
+            int32_t v = i == 0 ? seq : seq % 100;
+            if(i == 0) set_time[seq & 0xffff] = now_ms();
+            double t0 = now_ms();
+            if(!deferred) lv_lock();
+            lv_subject_set_int(&subjects[i], v);
+            if(!deferred) lv_unlock();
+            blocked_ms += now_ms() - t0;
+            last_value[i] = v;
+            sets++;
+        }
+        seq++;
+        next += 1.0;
+        double wait = next - now_ms();
+        if(wait > 0) usleep((useconds_t)(wait * 1000));
+    }
+    return NULL;
+}
+
+int main(int argc, char ** argv)
+{
+    deferred = argc > 1 && strcmp(argv[1], "deferred") == 0;
+
+    lv_init();
+    lv_tick_set_cb(tick_ms);
+    lv_display_t * disp = lv_display_create(320, 240);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    size_t buf_size = 320 * 40 * 2;
+    lv_display_set_buffers(disp, malloc(buf_size), NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+
+    lv_obj_t * scr = lv_screen_active();
+    for(int i = 0; i < SUBJECT_CNT; i++) {
+        lv_subject_init_int(&subjects[i], 0);
+        if(deferred) lv_subject_set_deferred(&subjects[i], true);
+        lv_subject_add_observer(&subjects[i], count_cb, NULL);
+        if(i % 2) {
+            lv_obj_t * label = lv_label_create(scr);
+            lv_obj_set_pos(label, (i % 5) * 64, (i / 5) * 60);
+            lv_label_bind_text(label, &subjects[i], "%d");
+        }
+        else {
+            lv_obj_t * arc = lv_arc_create(scr);
+            lv_obj_set_size(arc, 50, 50);
+            lv_obj_set_pos(arc, (i % 5) * 64, (i / 5) * 60);
+            lv_arc_bind_value(arc, &subjects[i]);
+        }
+    }
+    lv_refr_now(disp);
+    frames = 0;
+    observer_calls = 0;
+
+    /*Ca lv_main_task de pe placa: lv_timer_handler() sub lv_lock()*/
+    pthread_t thread;
+    double cpu_start = cpu_ms();
+    double start = now_ms();
+    pthread_create(&thread, NULL, producer, NULL);
+    while(now_ms() - start < RUN_MS) {
+        lv_lock();
+        uint32_t wait = lv_timer_handler();
+        lv_unlock();
+        usleep((wait > 5 ? 5 : wait) * 1000 + 100);
+    }
+    stop = true;
+    pthread_join(thread, NULL);
+    double cpu = cpu_ms() - cpu_start;
+
+    /*Ultima valoare trebuie sa ajunga la Observer-i si fara alt set*/
+    for(int i = 0; i < 100; i++) {
+        lv_lock();
+        lv_timer_handler();
+        lv_unlock();
+        usleep(1000);
+    }
+    int wrong = 0;
+    for(int i = 0; i < SUBJECT_CNT; i++) {
+        if(lv_subject_get_int(&subjects[i]) != last_value[i]) wrong++;
+    }
+
+    printf("%-9s sets %u | observer calls %u | frames %u | CPU %.0f ms / %d ms | "
+           "set->flush latency avg %.2f max %.2f ms | producer blocked %.0f ms | stale %d\n",
+           deferred ? "deferred" : "immediate", sets, observer_calls, frames, cpu, RUN_MS,
+           latency_cnt ? latency_sum / latency_cnt : 0, latency_max, blocked_ms, wrong);
+    lv_deinit();
+    return wrong == 0 ? 0 : 1;
+}
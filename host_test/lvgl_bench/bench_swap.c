@@ -0,0 +1,199 @@
+/**
+ * @file bench_swap.c
+ * Ecranul randat in RGB565 cu octetii inversati in flush (lv_draw_sw_rgb565_swap(), ca inainte)
+ * fata de ecranul randat direct in RGB565_SWAPPED si trimis neatins. Scena are gradient,
+ * umbra, text, arc, slider, opacitate, layere opace si transformate, un widget cache-uit ca
+ * bitmap si canvas-uri ARGB8888/RGB565. Se masoara timpul de randare si de flush pe cadru
+ * si se verifica ca la panou ajung exact aceiasi octeti.
+ *
+ *   bench_swap
+ */
+
+#include "lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HOR_RES 320
+#define VER_RES 240
+#define FRAMES  200
+
+static uint32_t fake_tick;
+/*Octetii in ordinea panoului (big-endian)*/
+static uint16_t fb[HOR_RES * VER_RES];
+static bool swap_in_flush;
+static double flush_us;
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static uint32_t tick_ms(void)
+{
+    return fake_tick;
+}
+
+static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    double t0 = now_us();
+    if(swap_in_flush) lv_draw_sw_rgb565_swap(px_map, lv_area_get_size(area));
+    flush_us += now_us() - t0;
+
+    int32_t w = lv_area_get_width(area);
+    for(int32_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&fb[y * HOR_RES + area->x1], px_map, w * 2);
+        px_map += w * 2;
+    }
+    lv_display_flush_ready(disp);
+}
+
+static void set_x(void * obj, int32_t v)
+{
+    lv_obj_set_x(obj, v);
+}
+
+static lv_obj_t * scene_create(void)
+{
+    lv_obj_t * scr = lv_obj_create(NULL);
+    lv_obj_remove_flag(scr, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_style_bg_grad_color(scr, lv_color_hex(0x102060), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_HOR, 0);
+
+    lv_obj_t * panel = lv_obj_create(scr);
+    lv_obj_set_size(panel, 150, 120);
+    lv_obj_set_pos(panel, 10, 10);
+    lv_obj_set_style_shadow_width(panel, 20, 0);
+    lv_obj_set_style_radius(panel, 15, 0);
+    lv_label_set_text(lv_label_create(panel), "Hello swapped\nRGB565 world 123");
+
+    lv_obj_t * arc = lv_arc_create(scr);
+    lv_obj_set_pos(arc, 180, 10);
+    lv_obj_set_size(arc, 110, 110);
+
+    lv_obj_t * slider = lv_slider_create(scr);
+    lv_obj_set_pos(slider, 20, 160);
+    lv_obj_set_width(slider, 200);
+
+    lv_obj_t * obj = lv_obj_create(scr);
+    lv_obj_set_size(obj, 80, 60);
+    lv_obj_set_pos(obj, 200, 150);
+    lv_obj_set_style_opa(obj, LV_OPA_50, 0);
+
+    obj = lv_button_create(scr);
+    lv_obj_set_pos(obj, 120, 190);
+    lv_obj_set_style_transform_rotation(obj, 150, 0);
+    lv_label_set_text(lv_label_create(obj), "Rot");
+
+    /*Layere opace: in format swapped pe un display swapped*/
+    obj = lv_obj_create(scr);
+    lv_obj_set_size(obj, 50, 50);
+    lv_obj_set_pos(obj, 240, 90);
+    lv_obj_set_style_radius(obj, 0, 0);
+    lv_obj_set_style_opa_layered(obj, LV_OPA_60, 0);
+    lv_obj_set_style_bg_grad_color(obj, lv_color_hex(0xff8000), 0);
+    lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_VER, 0);
+
+    obj = lv_obj_create(scr);
+    lv_obj_set_size(obj, 60, 40);
+    lv_obj_set_pos(obj, 100, 120);
+    lv_obj_set_style_radius(obj, 0, 0);
+    lv_obj_set_style_transform_scale(obj, 300, 0);
+    lv_obj_set_style_bg_grad_color(obj, lv_color_hex(0x20ff80), 0);
+    lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_HOR, 0);
+
+    obj = lv_obj_create(scr);
+    lv_obj_set_size(obj, 60, 40);
+    lv_obj_set_pos(obj, 170, 60);
+    lv_obj_set_style_radius(obj, 0, 0);
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_label_set_text(lv_label_create(obj), "Cached");
+
+    static uint8_t argb_buf[LV_CANVAS_BUF_SIZE(30, 30, 32, 1)];
+    lv_obj_t * canvas = lv_canvas_create(scr);
+    lv_canvas_set_buffer(canvas, argb_buf, 30, 30, LV_COLOR_FORMAT_ARGB8888);
+    lv_canvas_fill_bg(canvas, lv_color_hex(0xff0000), LV_OPA_60);
+    lv_obj_set_pos(canvas, 5, 205);
+
+    static uint8_t rgb565_buf[LV_CANVAS_BUF_SIZE(30, 30, 16, 1)];
+    canvas = lv_canvas_create(scr);
+    lv_canvas_set_buffer(canvas, rgb565_buf, 30, 30, LV_COLOR_FORMAT_RGB565);
+    lv_canvas_fill_bg(canvas, lv_color_hex(0x00ff40), LV_OPA_COVER);
+    lv_obj_set_pos(canvas, 40, 205);
+    lv_obj_set_style_image_recolor(canvas, lv_color_hex(0x0000ff), 0);
+    lv_obj_set_style_image_recolor_opa(canvas, LV_OPA_50, 0);
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, panel);
+    lv_anim_set_exec_cb(&a, set_x);
+    lv_anim_set_values(&a, 0, 150);
+    lv_anim_set_duration(&a, 1000);
+    lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+    lv_anim_start(&a);
+
+    lv_screen_load(scr);
+    return scr;
+}
+
+static double run(lv_display_t * disp, bool swapped, uint64_t * hash)
+{
+    lv_display_set_color_format(disp, swapped ? LV_COLOR_FORMAT_RGB565_SWAPPED : LV_COLOR_FORMAT_RGB565);
+    swap_in_flush = !swapped;
+    fake_tick = 0;
+    lv_obj_t * scr = scene_create();
+    lv_obj_t * arc = lv_obj_get_child(scr, 1);
+    lv_obj_t * slider = lv_obj_get_child(scr, 2);
+
+    *hash = 1469598103934665603ULL;
+    flush_us = 0;
+    double t0 = now_us();
+    for(int f = 0; f < FRAMES; f++) {
+        fake_tick += 16;
+        lv_arc_set_value(arc, f % 100);
+        lv_slider_set_value(slider, (f * 3) % 100, LV_ANIM_OFF);
+        lv_obj_invalidate(scr);
+        lv_refr_now(disp);
+        const uint8_t * p = (const uint8_t *)fb;
+        for(size_t i = 0; i < sizeof(fb); i++) *hash = (*hash ^ p[i]) * 1099511628211ULL;
+    }
+    double us = (now_us() - t0) / FRAMES;
+
+    lv_anim_delete_all();
+    lv_screen_load(lv_obj_create(NULL));
+    lv_obj_delete(scr);
+    return us;
+}
+
+int main(void)
+{
+    lv_init();
+    lv_tick_set_cb(tick_ms);
+    lv_display_t * disp = lv_display_create(HOR_RES, VER_RES);
+    size_t buf_size = HOR_RES * VER_RES * 2 / 4;
+    lv_display_set_buffers(disp, malloc(buf_size), NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+
+    uint64_t hash_native, hash_swapped;
+    double us_native = run(disp, false, &hash_native);
+    double flush_native = flush_us / FRAMES;
+    double us_swapped = run(disp, true, &hash_swapped);
+    double flush_swapped = flush_us / FRAMES;
+
+    printf("RGB565 + swap in flush %7.1f us/frame (swap %5.1f us) | panel bytes %016llx\n", us_native, flush_native,
+           (unsigned long long)hash_native);
+    printf("RGB565_SWAPPED         %7.1f us/frame (swap %5.1f us) | panel bytes %016llx\n", us_swapped, flush_swapped,
+           (unsigned long long)hash_swapped);
+
+    int failed = 0;
+    if(hash_native != hash_swapped) {
+        printf("The panel receives different bytes\n");
+        failed++;
+    }
+
+    lv_deinit();
+    return failed == 0 ? 0 : 1;
+}
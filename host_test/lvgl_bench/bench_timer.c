@@ -0,0 +1,214 @@
+/**
+ * @file bench_timer.c
+ * lv_timer_handler() cu 1000 de timere active (perioade 16..2015 ms), apelat la fiecare 1 ms
+ * timp de 100 s. Se masoara timpul CPU pe apel si se verifica numarul de rulari al fiecarui timer
+ * si timpul pana la urmatorul timer intors de lv_timer_handler() fata de valorile calculate.
+ * Un apel fara niciun timer de rulat nu trebuie sa coste mai mult cu 1000 de timere decat cu 10.
+ * Inainte, semantica: un timer cu perioada 0 ruleaza o data pe apel, un timer creat dintr-un
+ * callback (lv_async_call) ruleaza in acelasi apel, lv_timer_ready() din alt callback nu ruleaza
+ * un timer a doua oara in acelasi apel, stergerea din propriul callback, repeat_count.
+ *
+ *   bench_timer
+ */
+
+#include "lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define TIMER_CNT 1000
+#define CALLS     100000
+#define IDLE_CALLS 1000000
+
+static uint32_t fake_tick;
+static uint32_t handler_call;  /*numarul apelului lv_timer_handler() curent*/
+static uint32_t run_cnt[TIMER_CNT];
+static uint32_t period[TIMER_CNT];
+
+static int zero_runs, zero_twice, async_runs, async_late, self_del_runs, oneshot_runs, chain_runs, chain_twice;
+static uint32_t zero_last_call = UINT32_MAX, async_posted_call;
+static uint32_t ping_last_call = UINT32_MAX, pong_last_call = UINT32_MAX;
+static lv_timer_t * ping;
+static lv_timer_t * pong;
+
+static double cpu_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static uint32_t tick_ms(void)
+{
+    return fake_tick;
+}
+
+static void count_cb(lv_timer_t * t)
+{
+    run_cnt[(uintptr_t)lv_timer_get_user_data(t)]++;
+}
+
+static void zero_cb(lv_timer_t * t)
+{
+    LV_UNUSED(t);
+    if(zero_last_call == handler_call) zero_twice++;
+    zero_last_call = handler_call;
+    zero_runs++;
+}
+
+static void async_cb(void * user_data)
+{
+    LV_UNUSED(user_data);
+    if(handler_call != async_posted_call) async_late++;
+    async_runs++;
+}
+
+/*Timerul creat aici trebuie sa ruleze in acelasi lv_timer_handler()*/
+static void creator_cb(lv_timer_t * t)
+{
+    LV_UNUSED(t);
+    async_posted_call = handler_call;
+    lv_async_call(async_cb, NULL);
+}
+
+static void self_del_cb(lv_timer_t * t)
+{
+    self_del_runs++;
+    lv_timer_delete(t);
+}
+
+static void oneshot_cb(lv_timer_t * t)
+{
+    LV_UNUSED(t);
+    oneshot_runs++;
+}
+
+/*ping si pong se fac gata unul pe altul: cel mult o rulare fiecare pe apel*/
+static void ping_cb(lv_timer_t * t)
+{
+    LV_UNUSED(t);
+    if(ping_last_call == handler_call) chain_twice++;
+    ping_last_call = handler_call;
+    chain_runs++;
+    lv_timer_ready(pong);
+}
+
+static void pong_cb(lv_timer_t * t)
+{
+    LV_UNUSED(t);
+    if(pong_last_call == handler_call) chain_twice++;
+    pong_last_call = handler_call;
+    chain_runs++;
+    lv_timer_ready(ping);
+}
+
+static int check_semantics(void)
+{
+    fake_tick = 1;
+    lv_timer_t * creator = lv_timer_create(creator_cb, 10, NULL);
+    lv_timer_set_repeat_count(creator, 3);
+    lv_timer_create(self_del_cb, 5, NULL);
+    lv_timer_t * oneshot = lv_timer_create(oneshot_cb, 20, NULL);
+    lv_timer_set_repeat_count(oneshot, 1);
+    lv_timer_t * zero = lv_timer_create(zero_cb, 0, NULL);
+    lv_timer_t * stopped = lv_timer_create(zero_cb, 1000, NULL);
+    lv_timer_set_auto_delete(stopped, false);
+    lv_timer_set_repeat_count(stopped, 0);
+    ping = lv_timer_create(ping_cb, 100000, NULL);
+    pong = lv_timer_create(pong_cb, 100000, NULL);
+    lv_timer_ready(ping);
+
+    for(handler_call = 0; handler_call < 100; handler_call++) {
+        lv_timer_handler();
+        fake_tick++;
+    }
+
+    printf("semantics: period 0 %d runs (%d twice in a call), async %d (%d in a later call), self delete %d, "
+           "one shot %d, repeat 0 paused %d, ping-pong %d (%d twice in a call)\n",
+           zero_runs, zero_twice, async_runs, async_late, self_del_runs, oneshot_runs, lv_timer_get_paused(stopped),
+           chain_runs, chain_twice);
+
+    int failed = 0;
+    if(zero_runs != 100 || zero_twice != 0) failed++;
+    if(async_runs != 3 || async_late != 0) failed++;
+    if(self_del_runs != 1 || oneshot_runs != 1 || !lv_timer_get_paused(stopped)) failed++;
+    if(chain_runs != 2 * 100 || chain_twice != 0) failed++;
+
+    lv_timer_delete(zero);
+    lv_timer_delete(stopped);
+    lv_timer_delete(ping);
+    lv_timer_delete(pong);
+    return failed;
+}
+
+/*Apeluri in care niciun timer nu e de rulat*/
+static double idle_call_us(uint32_t timer_cnt)
+{
+    lv_timer_t * timers[TIMER_CNT];
+    for(uint32_t i = 0; i < timer_cnt; i++) timers[i] = lv_timer_create(count_cb, 1000000 + i, NULL);
+    double t0 = cpu_us();
+    for(int i = 0; i < IDLE_CALLS; i++) lv_timer_handler();
+    double us = (cpu_us() - t0) / IDLE_CALLS;
+    for(uint32_t i = 0; i < timer_cnt; i++) lv_timer_delete(timers[i]);
+    return us;
+}
+
+static int run_timers(void)
+{
+    lv_timer_t * timers[TIMER_CNT];
+    uint32_t start = fake_tick;
+    srand(1);
+    for(uint32_t i = 0; i < TIMER_CNT; i++) {
+        period[i] = 16 + rand() % 2000;
+        timers[i] = lv_timer_create(count_cb, period[i], (void *)(uintptr_t)i);
+    }
+
+    uint32_t bad_next = 0;
+    double t0 = cpu_us();
+    for(uint32_t c = 0; c < CALLS; c++) {
+        uint32_t next = lv_timer_handler();
+        /*Calculat separat: cel mai apropiat start + (rulari + 1) * perioada*/
+        uint32_t expected = UINT32_MAX;
+        if(c % 1000 == 0) {
+            for(uint32_t i = 0; i < TIMER_CNT; i++) {
+                uint32_t due = start + (run_cnt[i] + 1) * period[i] - fake_tick;
+                if(due < expected) expected = due;
+            }
+            if(next != expected) bad_next++;
+        }
+        fake_tick++;
+    }
+    double us = (cpu_us() - t0) / CALLS;
+
+    uint64_t total = 0;
+    uint32_t bad_cnt = 0;
+    for(uint32_t i = 0; i < TIMER_CNT; i++) {
+        total += run_cnt[i];
+        if(run_cnt[i] != (CALLS - 1) / period[i]) bad_cnt++;
+        lv_timer_delete(timers[i]);
+    }
+    printf("%d timers, %d calls at 1 ms: %.2f us/call CPU, %llu callbacks | %u timers with a wrong run count, "
+           "%u wrong next-timer times\n",
+           TIMER_CNT, CALLS, us, (unsigned long long)total, (unsigned)bad_cnt, (unsigned)bad_next);
+    return bad_cnt != 0 || bad_next != 0;
+}
+
+int main(void)
+{
+    lv_init();
+    lv_tick_set_cb(tick_ms);
+
+    int failed = check_semantics();
+    failed += run_timers();
+
+    double idle_10 = idle_call_us(10);
+    double idle_1000 = idle_call_us(TIMER_CNT);
+    printf("call with nothing due: %.3f us with 10 timers, %.3f us with %d timers\n", idle_10, idle_1000, TIMER_CNT);
+    if(idle_1000 > 3 * idle_10 + 0.05) {
+        printf("The cost of lv_timer_handler() grows with the number of timers\n");
+        failed++;
+    }
+
+    lv_deinit();
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,215 @@
+/**
+ * @file bench_vlist.cpp
+ * main/virtual_list.cpp cu 100000 de randuri pe 320x240: tabel cu 2 coloane ca in tab-ul List
+ * si lista cu randuri de inaltime variabila. Se deruleaza 120 px pe cadru de la inceput, din
+ * mijloc si pana la capat, cu hit-test pe randul de sus la fiecare cadru. Se masoara timpul pe
+ * cadru si heap-ul LVGL (dupa creare, dupa derulare, dupa stergere) fata de lv_list si lv_table
+ * cu 1000 de elemente. Dupa stergere heap-ul trebuie sa revina exact.
+ *
+ *   bench_vlist
+ */
+
+#include "lvgl.h"
+#include "src/core/lv_obj_private.h"
+#include "../../main/virtual_list.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define HOR_RES     320
+#define VER_RES     240
+#define ROWS        100000
+#define STEP_PX     120
+#define FRAMES      600     /*per pozitie de start*/
+#define WIDGET_ROWS 1000
+
+static uint32_t fake_tick;
+static int failed;
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static uint32_t tick_ms(void)
+{
+    return fake_tick;
+}
+
+static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(px_map);
+    lv_display_flush_ready(disp);
+}
+
+static size_t heap_used(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+/*Ca list_bind_row() din main/ui.h*/
+static void bind_table(lv_obj_t * row, uint32_t index, void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_label_set_text_fmt(lv_obj_get_child(row, 0), "file_%05" LV_PRIu32 ".bin", index);
+    lv_label_set_text_fmt(lv_obj_get_child(row, 1), "%" LV_PRIu32 " B", index * 37 % 100000);
+}
+
+/*Un rand din 7 trece pe mai multe linii*/
+static void bind_text(lv_obj_t * row, uint32_t index, void * user_data)
+{
+    LV_UNUSED(user_data);
+    if(index % 7 == 3) {
+        lv_label_set_text_fmt(row, "%" LV_PRIu32 ": a longer row that wraps to two or three lines on a narrow list",
+                              index);
+    }
+    else {
+        lv_label_set_text_fmt(row, "%" LV_PRIu32 ": file_%05" LV_PRIu32 ".bin", index, index);
+    }
+}
+
+/*FRAMES cadre de la randul `start`; randul de sus trebuie sa fie legat si sa primeasca click-ul*/
+static void scroll_frames(lv_obj_t * list, uint32_t start, double * sum_us, double * max_us, uint32_t * frames,
+                          uint32_t * misses)
+{
+    virtual_list_scroll_to(list, start, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    for(int f = 0; f < FRAMES; f++) {
+        int32_t before = lv_obj_get_scroll_y(list);
+        double t0 = now_us();
+        lv_obj_scroll_by_bounded(list, 0, -STEP_PX, LV_ANIM_OFF);
+        lv_refr_now(NULL);
+        double t = now_us() - t0;
+        *sum_us += t;
+        *max_us = LV_MAX(*max_us, t);
+        (*frames)++;
+        fake_tick += 16;
+
+        virtual_list_stats_t st;
+        virtual_list_get_stats(list, &st);
+        lv_point_t p = {HOR_RES / 2, list->coords.y1 + 30};
+        uint32_t index = virtual_list_get_row_index(list, lv_indev_search_obj(lv_screen_active(), &p));
+        if(index == VIRTUAL_LIST_NO_ROW || index < st.first || index > st.last) (*misses)++;
+        if(lv_obj_get_scroll_y(list) == before) break;  /*capatul listei*/
+    }
+}
+
+/*report == false: trecere de incalzire (cache-ul de glyph-uri si altele raman alocate dupa prima derulare)*/
+static void run(const char * name, const virtual_list_config_t * config, bool report)
+{
+    size_t heap0 = heap_used();
+    lv_obj_t * list = virtual_list_create(lv_screen_active(), config);
+    lv_obj_set_size(list, HOR_RES, VER_RES);
+    lv_refr_now(NULL);
+    size_t heap_created = heap_used() - heap0;
+
+    double sum_us = 0, max_us = 0;
+    uint32_t frames = 0, misses = 0;
+    scroll_frames(list, 0, &sum_us, &max_us, &frames, &misses);
+    scroll_frames(list, ROWS / 2, &sum_us, &max_us, &frames, &misses);
+    scroll_frames(list, ROWS - 200, &sum_us, &max_us, &frames, &misses);
+    size_t heap_scrolled = heap_used() - heap0;
+
+    virtual_list_stats_t st;
+    virtual_list_get_stats(list, &st);
+    lv_obj_delete(list);
+    size_t heap_left = heap_used() - heap0;
+    if(!report) return;
+
+    printf("%-14s %u rows: frame avg %5.0f us max %6.0f us (%u frames) | layout max %5u us | row objs %2u | "
+           "index %6zu B | heap created %6zu B scrolled %6zu B after delete %zd B | last row %u | misses %u\n",
+           name, (unsigned)ROWS, sum_us / frames, max_us, (unsigned)frames, (unsigned)st.layout_us_max,
+           (unsigned)st.row_objs, st.index_bytes, heap_created, heap_scrolled, (ssize_t)heap_left,
+           (unsigned)st.last, (unsigned)misses);
+
+    /*Heap-ul nu depinde de numarul de randuri: doar pool-ul de obiecte si indexul de inaltimi*/
+    if(misses > 0 || st.last != ROWS - 1 || st.row_objs > 2 * VER_RES / config->row_height) failed++;
+    if(!config->variable_height && heap_scrolled > heap_created + 4096) failed++;
+    if(heap_left != 0) failed++;
+}
+
+/*Pentru comparatie: widget-urile LVGL cu toate elementele create*/
+static void run_widgets(void)
+{
+    size_t heap0 = heap_used();
+    double t0 = now_us();
+    lv_obj_t * list = lv_list_create(lv_screen_active());
+    lv_obj_set_size(list, HOR_RES, VER_RES);
+    for(uint32_t i = 0; i < WIDGET_ROWS; i++) {
+        char text[32];
+        lv_snprintf(text, sizeof(text), "file_%05" LV_PRIu32 ".bin", i);
+        lv_list_add_button(list, NULL, text);
+    }
+    lv_refr_now(NULL);
+    double create_us = now_us() - t0;
+    size_t heap = heap_used() - heap0;
+    t0 = now_us();
+    for(int f = 0; f < 20; f++) {
+        lv_obj_scroll_by(list, 0, -STEP_PX, LV_ANIM_OFF);
+        lv_refr_now(NULL);
+    }
+    printf("lv_list        %u items: frame avg %5.0f us | create %7.0f us | heap %6zu B (%zu B/item)\n",
+           (unsigned)WIDGET_ROWS, (now_us() - t0) / 20, create_us, heap, heap / WIDGET_ROWS);
+    lv_obj_delete(list);
+
+    heap0 = heap_used();
+    t0 = now_us();
+    lv_obj_t * table = lv_table_create(lv_screen_active());
+    lv_obj_set_size(table, HOR_RES, VER_RES);
+    lv_table_set_column_count(table, 2);
+    lv_table_set_column_width(table, 0, 200);
+    lv_table_set_column_width(table, 1, 90);
+    for(uint32_t i = 0; i < WIDGET_ROWS; i++) {
+        lv_table_set_cell_value_fmt(table, i, 0, "file_%05" LV_PRIu32 ".bin", i);
+        lv_table_set_cell_value_fmt(table, i, 1, "%" LV_PRIu32 " B", i * 37 % 100000);
+    }
+    lv_refr_now(NULL);
+    create_us = now_us() - t0;
+    heap = heap_used() - heap0;
+    t0 = now_us();
+    for(int f = 0; f < 20; f++) {
+        lv_obj_scroll_by(table, 0, -STEP_PX, LV_ANIM_OFF);
+        lv_refr_now(NULL);
+    }
+    printf("lv_table       %u rows : frame avg %5.0f us | create %7.0f us | heap %6zu B (%zu B/row)\n",
+           (unsigned)WIDGET_ROWS, (now_us() - t0) / 20, create_us, heap, heap / WIDGET_ROWS);
+    lv_obj_delete(table);
+}
+
+int main(void)
+{
+    lv_init();
+    lv_tick_set_cb(tick_ms);
+    lv_display_t * disp = lv_display_create(HOR_RES, VER_RES);
+    size_t buf_size = HOR_RES * 40 * 2;
+    lv_display_set_buffers(disp, malloc(buf_size), NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+
+    virtual_list_config_t table = {};
+    table.row_cnt = ROWS;
+    table.row_height = 24;
+    table.col_cnt = 2;
+    table.col_width[0] = 200;
+    table.col_width[1] = 90;
+    table.bind_row = bind_table;
+    run("table 2 cols", &table, false);
+    run("table 2 cols", &table, true);
+
+    virtual_list_config_t text = {};
+    text.row_cnt = ROWS;
+    text.row_height = 24;
+    text.variable_height = true;
+    text.bind_row = bind_text;
+    run("variable", &text, false);
+    run("variable", &text, true);
+
+    run_widgets();
+
+    lv_deinit();
+    return failed == 0 ? 0 : 1;
+}
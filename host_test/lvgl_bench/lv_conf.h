@@ -0,0 +1,48 @@
+/**
+ * @file lv_conf.h
+ * Configuratia LVGL a proiectului (main/lv_conf.h), cu ce nu exista pe host inlocuit.
+ * Tot restul (buffere de layer, cache-uri, LV_DEF_REFR_PERIOD) ramane ca pe placa.
+ */
+
+#include "../../main/lv_conf.h"
+
+#ifndef LV_CONF_HOST_H
+#define LV_CONF_HOST_H
+
+/*FreeRTOS -> pthread; lv_lock() ramane, ca in task-ul LVGL de pe placa*/
+#undef LV_USE_OS
+#define LV_USE_OS LV_OS_PTHREAD
+
+/*Heap-ul LVGL din heap-ul procesului, nu din PSRAM*/
+#undef LV_MEM_POOL_INCLUDE
+#undef LV_MEM_POOL_ALLOC
+
+/*Fara SD / LittleFS*/
+#undef LV_USE_FS_FATFS
+#define LV_USE_FS_FATFS 0
+#undef LV_FS_FATFS_LETTER
+#undef LV_USE_FS_POSIX
+#define LV_USE_FS_POSIX 0
+#undef LV_FS_POSIX_LETTER
+#undef LV_USE_FS_STDIO
+#define LV_USE_FS_STDIO 0
+#undef LV_FS_STDIO_LETTER
+
+/*TJPGD citeste un JPEG din memorie (lv_image_dsc_t) prin MEMFS; bench_img nu are fisiere*/
+#undef LV_USE_FS_MEMFS
+#define LV_USE_FS_MEMFS 1
+#undef LV_FS_MEMFS_LETTER
+#define LV_FS_MEMFS_LETTER 'M'
+
+/*Monitoarele de performanta / memorie ar desena si ele in fiecare cadru*/
+#undef LV_USE_PERF_MONITOR
+#define LV_USE_PERF_MONITOR 0
+#undef LV_USE_MEM_MONITOR
+#define LV_USE_MEM_MONITOR 0
+
+/*Scenele de layer din demos/render*/
+#undef LV_BUILD_DEMOS
+#define LV_BUILD_DEMOS 1
+#define LV_USE_DEMO_RENDER 1
+
+#endif /*LV_CONF_HOST_H*/
@@ -0,0 +1,167 @@
+/*
+ * Benchmark pe host pentru log-ul asincron: costul unui ALOGI() pe calea rapida (copierea
+ * argumentelor in ring) fata de formatarea si scrierea sincrona ca la ESP_LOGI(), plus un
+ * mesaj filtrat de nivelul tag-ului. Se verifica ca textul scris de task-ul de drain e
+ * identic cu cel formatat de vsnprintf() si ca nu s-a pierdut niciun mesaj.
+ *
+ *   cmake -S lib/async-log-v0001/host_test -B build_host -DCMAKE_BUILD_TYPE=Release && cmake --build build_host &&
+ *   ctest --test-dir build_host
+ */
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "async_log.h"
+#include "async_log_fmt.h"
+
+#define ROUNDS    2000
+#define PER_ROUND 32  // sub ASYNC_LOG_RING_LEN: ringul se goleste intre runde, in afara masuratorii
+
+static int s_failures;
+
+#define CHECK(cond)                                                    \
+    do                                                                 \
+    {                                                                  \
+        if (!(cond))                                                   \
+        {                                                              \
+            fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #cond); \
+            s_failures++;                                              \
+        }                                                              \
+    } while (0)
+
+/* Ce scrie task-ul de drain: ultima linie si o suma a tuturor liniilor */
+static char     s_last_line[ASYNC_LOG_LINE_MAX];
+static uint64_t s_lines_hash = 1469598103934665603ULL;
+static uint32_t s_lines;
+
+esp_log_level_t esp_log_level_get(const char *tag) {
+    return strcmp(tag, "QUIET") == 0 ? ESP_LOG_WARN : ESP_LOG_INFO;
+}
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...) {
+    (void) level, (void) tag;
+    va_list ap;
+    va_start(ap, format);
+    vsnprintf(s_last_line, sizeof(s_last_line), format, ap);
+    va_end(ap);
+    for (const char *p = s_last_line; *p != '\0'; p++)
+    {
+        s_lines_hash = (s_lines_hash ^ (uint8_t) *p) * 1099511628211ULL;
+    }
+    s_lines++;
+}
+
+/* Timpul fix: liniile async si sync au acelasi prefix */
+uint32_t esp_log_timestamp(void) {
+    return 1234;
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* async_log_capture() + async_log_format() trebuie sa dea acelasi text ca vsnprintf() */
+static void check_format(const char *format, ...) {
+    char    expected[ASYNC_LOG_LINE_MAX], got[ASYNC_LOG_LINE_MAX];
+    uint8_t args[ASYNC_LOG_ARGS_MAX];
+    bool    truncated;
+    va_list ap, ap_copy;
+    va_start(ap, format);
+    va_copy(ap_copy, ap);
+    vsnprintf(expected, sizeof(expected), format, ap);
+    size_t len = async_log_capture(args, sizeof(args), format, ap_copy, &truncated);
+    async_log_format(got, sizeof(got), format, args, len);
+    va_end(ap_copy);
+    va_end(ap);
+    if (strcmp(expected, got) != 0)
+    {
+        fprintf(stderr, "format '%s':\n  vsnprintf '%s'\n  async     '%s'\n", format, expected, got);
+        s_failures++;
+    }
+}
+
+#define STATS_FORMAT "flush last=%.2f ms | avg=%.2f ms | FPS(inst)=%.1f | FPS(avg)=%.1f | MB/s(inst)=%.2f"
+
+int main(void) {
+    check_format("plain");
+    check_format("%d %i %u %x %X %o %c %%", -5, 7, 3000000000u, 255, 255, 8, 'z');
+    check_format("%ld %lu %lld %llu %zu %td %jd", -1L, 2UL, -3LL, 4ULL, (size_t) 5, (ptrdiff_t) -6, (intmax_t) 7);
+    check_format("%hhd %hd %05d|%-6d|%+d|% d|%#x", 300, 70000, 42, 42, 42, 42, 42);
+    check_format("%.2f %10.3e %g %G", 3.14159, 1e-7, 0.0001, 1e20);
+    check_format("%*d|%-*.*f|%.*s", 6, 1, 10, 3, 2.5, 3, "abcdef");
+    check_format("%s and %10s and %-8s|", "str", "right", "left");
+    check_format("%p", (void *) 0x1234);
+    check_format("%" PRIu32 " %" PRId64 " %" PRIx32, (uint32_t) 1, (int64_t) -2, (uint32_t) 0xAB);
+    check_format(STATS_FORMAT, 12.34, 13.5, 81.0, 74.1, 9.87);
+
+    CHECK(async_log_init() == ESP_OK);
+
+    /* Aceleasi mesaje: o data prin ring, o data formatate si scrise pe loc */
+    char     line[ASYNC_LOG_LINE_MAX];
+    uint64_t sync_hash = 1469598103934665603ULL;
+    double   async_ns = 0, sync_ns = 0, filtered_ns = 0;
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        async_log_flush();
+
+        double t0 = now_ns();
+        for (int i = 0; i < PER_ROUND; i++)
+        {
+            ALOGI("STATS", STATS_FORMAT, i / 1000.0, 13.5, 81.0, 74.1, 9.87);
+        }
+        double t1 = now_ns();
+        for (int i = 0; i < PER_ROUND; i++)
+        {
+            int n = snprintf(line, sizeof(line), "I (%u) %s: ", 1234u, "STATS");
+            snprintf(line + n, sizeof(line) - (size_t) n, STATS_FORMAT "\n", i / 1000.0, 13.5, 81.0, 74.1, 9.87);
+            for (const char *p = line; *p != '\0'; p++)
+            {
+                sync_hash = (sync_hash ^ (uint8_t) *p) * 1099511628211ULL;
+            }
+        }
+        double t2 = now_ns();
+        for (int i = 0; i < PER_ROUND; i++)
+        {
+            ALOGI("QUIET", "filtered %d", i);
+        }
+        double t3 = now_ns();
+
+        async_ns += t1 - t0;
+        sync_ns += t2 - t1;
+        filtered_ns += t3 - t2;
+    }
+    async_log_flush();
+
+    async_log_stats_t st;
+    async_log_get_stats(&st);
+    const int calls = ROUNDS * PER_ROUND;
+    printf("per call: ALOGI (5 doubles) %.0f ns | snprintf + write %.0f ns | filtered by tag level %.0f ns | "
+           "logged %u dropped %u\n",
+           async_ns / calls, sync_ns / calls, filtered_ns / calls, st.logged, st.dropped);
+    CHECK(st.logged == (uint32_t) calls && st.dropped == 0 && st.truncated == 0);
+    CHECK(s_lines == (uint32_t) calls);
+    CHECK(s_lines_hash == sync_hash);
+
+    /* Ring plin fara drain: mesajele se pierd si se raporteaza, apelantul nu asteapta */
+    for (int i = 0; i < 4 * ASYNC_LOG_RING_LEN; i++)
+    {
+        ALOGI("STATS", "burst %d", i);
+    }
+    async_log_flush();
+    async_log_get_stats(&st);
+    printf("burst of %d: dropped %u | %s", 4 * ASYNC_LOG_RING_LEN, st.dropped, s_last_line);
+    CHECK(st.dropped > 0 && strstr(s_last_line, "messages dropped") != NULL);
+
+    if (s_failures > 0)
+    {
+        fprintf(stderr, "%d check(s) failed\n", s_failures);
+        return 1;
+    }
+    printf("async log host bench: OK\n");
+    return 0;
+}
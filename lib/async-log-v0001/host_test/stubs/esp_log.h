@@ -0,0 +1,19 @@
+#pragma once
+// doar ce foloseste async_log; implementarea e in testul de pe host
+#include <stdint.h>
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE,
+} esp_log_level_t;
+
+#define LOG_LOCAL_LEVEL ESP_LOG_INFO
+
+esp_log_level_t esp_log_level_get(const char *tag);
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...)
+    __attribute__((format(printf, 3, 4)));
+uint32_t esp_log_timestamp(void);
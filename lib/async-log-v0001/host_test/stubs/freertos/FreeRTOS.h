@@ -0,0 +1,17 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef unsigned UBaseType_t;
+
+#define portNUM_PROCESSORS 2
+#define portMAX_DELAY 0xffffffffu
+#define pdTRUE 1
+#define pdPASS 1
+#define tskIDLE_PRIORITY 0
+#define pdMS_TO_TICKS(ms) (ms)
+
+// un singur ring pe host: producatorii din test ruleaza pe un thread
+static inline int xPortGetCoreID(void) {
+    return 0;
+}
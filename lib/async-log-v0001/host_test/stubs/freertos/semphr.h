@@ -0,0 +1,26 @@
+#pragma once
+// mutex FreeRTOS peste pthread
+#include <pthread.h>
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+
+typedef pthread_mutex_t *SemaphoreHandle_t;
+
+static inline SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    pthread_mutex_t *m = malloc(sizeof(*m));
+    if (m != NULL)
+        pthread_mutex_init(m, NULL);
+    return m;
+}
+
+// timeout-ul e ignorat: se asteapta mereu portMAX_DELAY
+static inline int xSemaphoreTake(SemaphoreHandle_t m, uint32_t ticks) {
+    (void)ticks;
+    pthread_mutex_lock(m);
+    return pdTRUE;
+}
+
+static inline int xSemaphoreGive(SemaphoreHandle_t m) {
+    pthread_mutex_unlock(m);
+    return pdTRUE;
+}
@@ -0,0 +1,42 @@
+#pragma once
+// task-urile FreeRTOS devin thread-uri detasate
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "freertos/FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+
+typedef struct {
+    void (*fn)(void *);
+    void *arg;
+} host_task_t;
+
+static inline void *host_task_entry(void *p) {
+    host_task_t t = *(host_task_t *)p;
+    free(p);
+    t.fn(t.arg);
+    return NULL;
+}
+
+static inline int xTaskCreate(void (*fn)(void *), const char *name, uint32_t stack, void *arg,
+                              UBaseType_t prio, TaskHandle_t *handle) {
+    (void)name, (void)stack, (void)prio;
+    pthread_t th;
+    host_task_t *t = malloc(sizeof(*t));
+    t->fn = fn;
+    t->arg = arg;
+    if (pthread_create(&th, NULL, host_task_entry, t) != 0)
+    {
+        free(t);
+        return 0;
+    }
+    pthread_detach(th);
+    if (handle != NULL)
+        *handle = (TaskHandle_t)th;
+    return pdPASS;
+}
+
+static inline void vTaskDelay(uint32_t ms) {
+    usleep(ms * 1000);
+}
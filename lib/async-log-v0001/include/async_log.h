@@ -0,0 +1,62 @@
+#pragma once
+#ifndef ASYNC_LOG_H_
+#define ASYNC_LOG_H_
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_log.h"
+
+/**
+ * Log cu formatare amanata. ALOGx() copiaza doar pointerul la format si argumentele brute
+ * intr-un ring lock-free al core-ului curent; textul e construit si scris cu esp_log_write()
+ * de un task de prioritate mica. Nivelul per tag ramane cel din esp_log_level_set()
+ * (comanda `log_level`), verificat la apel, ca la ESP_LOGx().
+ *
+ * Tag-ul si formatul trebuie sa fie statice (literale); sirurile %s sunt copiate.
+ * Doar din task-uri, nu din ISR (esp_log_level_get() ia un lock).
+ */
+
+#define ASYNC_LOG_RING_LEN        (64)   // mesaje in asteptare per core, putere a lui 2
+#define ASYNC_LOG_ARGS_MAX        (56)   // bytes de argumente per mesaj (7 double)
+#define ASYNC_LOG_LINE_MAX        (256)
+#define ASYNC_LOG_DRAIN_PERIOD_MS (10)
+
+typedef struct {
+    uint32_t logged;     // mesaje puse in ring
+    uint32_t dropped;    // mesaje pierdute (ring plin)
+    uint32_t truncated;  // mesaje cu argumente taiate (ASYNC_LOG_ARGS_MAX)
+} async_log_stats_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* #ifdef __cplusplus */
+
+    esp_err_t async_log_init(void);
+    // inainte de init scrie sincron, ca ESP_LOGx()
+    void async_log_write(esp_log_level_t level, const char *tag, const char *format, ...)
+        __attribute__((format(printf, 3, 4)));
+    // goleste ringurile din task-ul curent (ex. inainte de esp_restart())
+    void async_log_flush(void);
+    void async_log_get_stats(async_log_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif /* #ifdef __cplusplus */
+
+#define ALOG_LEVEL_LOCAL(level, tag, format, ...)                   \
+    do                                                              \
+    {                                                               \
+        if (LOG_LOCAL_LEVEL >= (level))                             \
+        {                                                           \
+            async_log_write((level), (tag), format, ##__VA_ARGS__); \
+        }                                                           \
+    } while (0)
+
+#define ALOGE(tag, format, ...) ALOG_LEVEL_LOCAL(ESP_LOG_ERROR, tag, format, ##__VA_ARGS__)
+#define ALOGW(tag, format, ...) ALOG_LEVEL_LOCAL(ESP_LOG_WARN, tag, format, ##__VA_ARGS__)
+#define ALOGI(tag, format, ...) ALOG_LEVEL_LOCAL(ESP_LOG_INFO, tag, format, ##__VA_ARGS__)
+#define ALOGD(tag, format, ...) ALOG_LEVEL_LOCAL(ESP_LOG_DEBUG, tag, format, ##__VA_ARGS__)
+#define ALOGV(tag, format, ...) ALOG_LEVEL_LOCAL(ESP_LOG_VERBOSE, tag, format, ##__VA_ARGS__)
+
+#endif /* #ifndef ASYNC_LOG_H_ */
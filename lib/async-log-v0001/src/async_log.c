@@ -0,0 +1,231 @@
+#include "async_log.h"
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+
+#include "async_log_fmt.h"
+
+#define RING_MASK (ASYNC_LOG_RING_LEN - 1)
+_Static_assert((ASYNC_LOG_RING_LEN & RING_MASK) == 0, "ASYNC_LOG_RING_LEN trebuie sa fie putere a lui 2");
+
+/* Un slot = un mesaj nerezolvat. Ring MPSC marginit cu numar de secventa per slot:
+ * task-urile de pe acelasi core se pot intrerupe intre ele, deci rezervarea e tot cu CAS. */
+typedef struct {
+    atomic_uint     seq;
+    uint32_t        ts_ms;
+    const char     *tag;
+    const char     *format;
+    esp_log_level_t level;
+    uint8_t         len;
+    uint8_t         args[ASYNC_LOG_ARGS_MAX];
+} slot_t;
+
+typedef struct {
+    slot_t      slots[ASYNC_LOG_RING_LEN];
+    atomic_uint head;
+    uint32_t    tail;     // doar consumatorul (sub s_drain_lock)
+    atomic_uint dropped;
+} ring_t;
+
+static ring_t            s_rings[portNUM_PROCESSORS];
+static atomic_bool       s_running;
+static atomic_uint       s_logged;
+static atomic_uint       s_truncated;
+static uint32_t          s_dropped_reported;
+static SemaphoreHandle_t s_drain_lock = NULL;
+static TaskHandle_t      s_drain_task = NULL;
+
+static const char s_letters[] = "NEWIDV";
+#if CONFIG_LOG_COLORS
+static const char *const s_colors[] = {"", LOG_COLOR_E, LOG_COLOR_W, LOG_COLOR_I, LOG_COLOR_D, LOG_COLOR_V};
+#define LINE_RESET LOG_RESET_COLOR
+#else
+static const char *const s_colors[] = {"", "", "", "", "", ""};
+#define LINE_RESET ""
+#endif /* #if CONFIG_LOG_COLORS */
+
+// -------------------------------------------------
+
+/* Acelasi prefix ca LOG_FORMAT() din esp_log, cu timpul de la apel, nu de la scriere */
+static void emit(esp_log_level_t level, uint32_t ts_ms, const char *tag, const char *format, const uint8_t *args, size_t len) {
+    char   line[ASYNC_LOG_LINE_MAX];
+    int    n   = snprintf(line, sizeof(line), "%s%c (%lu) %s: ", s_colors[level], s_letters[level], (unsigned long) ts_ms, tag);
+    size_t pos = n > 0 && (size_t) n < sizeof(line) ? (size_t) n : sizeof(line) - 1;
+
+    pos += async_log_format(line + pos, sizeof(line) - pos, format, args, len);
+    snprintf(line + pos, sizeof(line) - pos, "%s\n", LINE_RESET);
+    esp_log_write(level, tag, "%s", line);
+}
+
+static slot_t *ring_peek(ring_t *ring) {
+    slot_t *slot = &ring->slots[ring->tail & RING_MASK];
+    return atomic_load_explicit(&slot->seq, memory_order_acquire) == ring->tail + 1 ? slot : NULL;
+}
+
+static void ring_release(ring_t *ring, slot_t *slot) {
+    atomic_store_explicit(&slot->seq, ring->tail + ASYNC_LOG_RING_LEN, memory_order_release);
+    ring->tail++;
+}
+
+/* Scrie tot ce e in ringuri, in ordinea timpului de la apel (interclasare intre core-uri) */
+static void drain(void) {
+    xSemaphoreTake(s_drain_lock, portMAX_DELAY);
+    while (true)
+    {
+        ring_t *best      = NULL;
+        slot_t *best_slot = NULL;
+        for (int core = 0; core < portNUM_PROCESSORS; core++)
+        {
+            slot_t *slot = ring_peek(&s_rings[core]);
+            if (slot != NULL && (best_slot == NULL || (int32_t) (slot->ts_ms - best_slot->ts_ms) < 0))
+            {
+                best      = &s_rings[core];
+                best_slot = slot;
+            }
+        }
+        if (best_slot == NULL)
+        {
+            break;
+        }
+        emit(best_slot->level, best_slot->ts_ms, best_slot->tag, best_slot->format, best_slot->args, best_slot->len);
+        ring_release(best, best_slot);
+    }
+
+    uint32_t dropped = 0;
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        dropped += atomic_load_explicit(&s_rings[core].dropped, memory_order_relaxed);
+    }
+    if (dropped != s_dropped_reported)
+    {
+        esp_log_write(ESP_LOG_WARN, "ALOG", "%sW (%lu) ALOG: %lu messages dropped (ring full)%s\n", s_colors[ESP_LOG_WARN],
+            (unsigned long) esp_log_timestamp(), (unsigned long) (dropped - s_dropped_reported), LINE_RESET);
+        s_dropped_reported = dropped;
+    }
+    xSemaphoreGive(s_drain_lock);
+}
+
+static void async_log_drain_task(void *parameter) {
+    (void) parameter;
+    while (true)
+    {
+        vTaskDelay(pdMS_TO_TICKS(ASYNC_LOG_DRAIN_PERIOD_MS));
+        drain();
+    }
+}
+
+// -------------------------------------------------
+
+esp_err_t async_log_init(void) {
+    if (s_drain_task != NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        for (unsigned i = 0; i < ASYNC_LOG_RING_LEN; i++)
+        {
+            atomic_init(&s_rings[core].slots[i].seq, i);
+        }
+        atomic_init(&s_rings[core].head, 0);
+        s_rings[core].tail = 0;
+    }
+
+    s_drain_lock = xSemaphoreCreateMutex();
+    if (s_drain_lock == NULL)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    /* Stack mare: vsnprintf cu double + linia de ASYNC_LOG_LINE_MAX */
+    if (xTaskCreate(async_log_drain_task, "Async log", 4096, NULL, tskIDLE_PRIORITY + 1, &s_drain_task) != pdPASS)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    atomic_store_explicit(&s_running, true, memory_order_release);
+    return ESP_OK;
+}
+
+void async_log_write(esp_log_level_t level, const char *tag, const char *format, ...) {
+    if (level > esp_log_level_get(tag))
+    {
+        return;  // nivelul per tag din `log_level`, ca la ESP_LOGx()
+    }
+
+    va_list ap;
+    va_start(ap, format);
+    if (!atomic_load_explicit(&s_running, memory_order_acquire))
+    {
+        uint8_t args[ASYNC_LOG_ARGS_MAX];
+        bool    truncated;
+        size_t  len = async_log_capture(args, sizeof(args), format, ap, &truncated);
+        emit(level, esp_log_timestamp(), tag, format, args, len);
+        va_end(ap);
+        return;
+    }
+
+    /* Daca task-ul migreaza intre timp nu e nicio problema, ringul accepta mai multi producatori */
+    ring_t  *ring = &s_rings[xPortGetCoreID()];
+    unsigned pos  = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    while (true)
+    {
+        slot_t  *slot = &ring->slots[pos & RING_MASK];
+        unsigned seq  = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int      diff = (int) (seq - pos);
+        if (diff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&ring->head, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+            {
+                bool truncated;
+                slot->ts_ms  = esp_log_timestamp();
+                slot->tag    = tag;
+                slot->format = format;
+                slot->level  = level;
+                slot->len    = (uint8_t) async_log_capture(slot->args, sizeof(slot->args), format, ap, &truncated);
+                atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+                atomic_fetch_add_explicit(&s_logged, 1, memory_order_relaxed);
+                if (truncated)
+                {
+                    atomic_fetch_add_explicit(&s_truncated, 1, memory_order_relaxed);
+                }
+                break;
+            }
+        } else if (diff < 0)
+        {
+            atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+            break;  // plin: apelantul nu asteapta niciodata dupa consola
+        } else
+        {
+            pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        }
+    }
+    va_end(ap);
+}
+
+void async_log_flush(void) {
+    if (atomic_load_explicit(&s_running, memory_order_acquire))
+    {
+        drain();
+    }
+}
+
+void async_log_get_stats(async_log_stats_t *stats) {
+    if (stats == NULL)
+    {
+        return;
+    }
+    stats->logged    = atomic_load_explicit(&s_logged, memory_order_relaxed);
+    stats->truncated = atomic_load_explicit(&s_truncated, memory_order_relaxed);
+    stats->dropped   = 0;
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        stats->dropped += atomic_load_explicit(&s_rings[core].dropped, memory_order_relaxed);
+    }
+}
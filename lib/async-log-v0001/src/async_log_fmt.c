@@ -0,0 +1,415 @@
+#include "async_log_fmt.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define SPEC_MAX_LEN 32
+
+typedef enum {
+    ARG_NONE,
+    ARG_INT,
+    ARG_LONG,
+    ARG_LLONG,
+    ARG_SIZE,
+    ARG_PTRDIFF,
+    ARG_INTMAX,
+    ARG_DOUBLE,
+    ARG_LDOUBLE,  // salvat ca double
+    ARG_PTR,
+    ARG_STR,      // salvat ca [u8 lungime][bytes]
+} arg_type_t;
+
+typedef struct {
+    size_t     len;    // de la '%' pana la conversie inclusiv
+    uint8_t    stars;  // '*' la latime si/sau precizie (argumente int in plus)
+    arg_type_t type;
+} spec_t;
+
+static const uint8_t s_arg_size[] = {
+    [ARG_NONE] = 0,
+    [ARG_INT] = sizeof(int),
+    [ARG_LONG] = sizeof(long),
+    [ARG_LLONG] = sizeof(long long),
+    [ARG_SIZE] = sizeof(size_t),
+    [ARG_PTRDIFF] = sizeof(ptrdiff_t),
+    [ARG_INTMAX] = sizeof(intmax_t),
+    [ARG_DOUBLE] = sizeof(double),
+    [ARG_LDOUBLE] = sizeof(double),
+    [ARG_PTR] = sizeof(void *),
+    [ARG_STR] = 1,
+};
+
+// -------------------------------------------------
+
+/* `p` arata spre '%'. Acelasi parser e folosit la copiere si la formatare. */
+static void parse_spec(const char *p, spec_t *spec) {
+    const char *q = p + 1;
+    spec->stars   = 0;
+
+    while (*q != '\0' && strchr("-+ #0", *q) != NULL)
+    {
+        q++;
+    }
+    if (*q == '*')
+    {
+        spec->stars++;
+        q++;
+    }
+    while (*q >= '0' && *q <= '9')
+    {
+        q++;
+    }
+    if (*q == '.')
+    {
+        q++;
+        if (*q == '*')
+        {
+            spec->stars++;
+            q++;
+        }
+        while (*q >= '0' && *q <= '9')
+        {
+            q++;
+        }
+    }
+
+    arg_type_t integer = ARG_INT;
+    bool       is_long_double = false;
+    switch (*q)
+    {
+        case 'h':
+            q += (q[1] == 'h') ? 2 : 1;
+            break;
+        case 'l':
+            integer = (q[1] == 'l') ? ARG_LLONG : ARG_LONG;
+            q += (q[1] == 'l') ? 2 : 1;
+            break;
+        case 'z':
+            integer = ARG_SIZE;
+            q++;
+            break;
+        case 't':
+            integer = ARG_PTRDIFF;
+            q++;
+            break;
+        case 'j':
+            integer = ARG_INTMAX;
+            q++;
+            break;
+        case 'L':
+            is_long_double = true;
+            q++;
+            break;
+        default:
+            break;
+    }
+
+    switch (*q)
+    {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+            spec->type = integer;
+            break;
+        case 'c':
+            spec->type = ARG_INT;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            spec->type = is_long_double ? ARG_LDOUBLE : ARG_DOUBLE;
+            break;
+        case 'p':
+            spec->type = ARG_PTR;
+            break;
+        case 's':
+            spec->type = ARG_STR;
+            break;
+        default:  // "%%", %n si conversii necunoscute nu consuma argumente
+            spec->type  = ARG_NONE;
+            spec->stars = 0;
+            break;
+    }
+    spec->len = (size_t) (q - p) + (*q != '\0' ? 1 : 0);
+}
+
+// -------------------------------------------------
+
+size_t async_log_capture(uint8_t *dst, size_t cap, const char *format, va_list ap, bool *truncated) {
+    size_t used = 0;
+    *truncated  = false;
+
+    for (const char *p = strchr(format, '%'); p != NULL; p = strchr(p, '%'))
+    {
+        spec_t spec;
+        parse_spec(p, &spec);
+        p += spec.len;
+
+        size_t need = spec.stars * sizeof(int) + s_arg_size[spec.type];
+        if (used + need > cap)
+        {
+            *truncated = true;
+            break;
+        }
+        for (uint8_t s = 0; s < spec.stars; s++)
+        {
+            int star = va_arg(ap, int);
+            memcpy(dst + used, &star, sizeof(star));
+            used += sizeof(star);
+        }
+
+        switch (spec.type)
+        {
+            case ARG_NONE:
+                break;
+            case ARG_INT: {
+                int v = va_arg(ap, int);
+                memcpy(dst + used, &v, sizeof(v));
+                break;
+            }
+            case ARG_LONG: {
+                long v = va_arg(ap, long);
+                memcpy(dst + used, &v, sizeof(v));
+                break;
+            }
+            case ARG_LLONG: {
+                long long v = va_arg(ap, long long);
+                memcpy(dst + used, &v, sizeof(v));
+                break;
+            }
+            case ARG_SIZE: {
+                size_t v = va_arg(ap, size_t);
+                memcpy(dst + used, &v, sizeof(v));
+                break;
+            }
+            case ARG_PTRDIFF: {
+                ptrdiff_t v = va_arg(ap, ptrdiff_t);
+                memcpy(dst + used, &v, sizeof(v));
+                break;
+            }
+            case ARG_INTMAX: {
+                intmax_t v = va_arg(ap, intmax_t);
+                memcpy(dst + used, &v, sizeof(v));
+                break;
+            }
+            case ARG_DOUBLE: {
+                double v = va_arg(ap, double);
+                memcpy(dst + used, &v, sizeof(v));
+                break;
+            }
+            case ARG_LDOUBLE: {
+                double v = (double) va_arg(ap, long double);
+                memcpy(dst + used, &v, sizeof(v));
+                break;
+            }
+            case ARG_PTR: {
+                void *v = va_arg(ap, void *);
+                memcpy(dst + used, &v, sizeof(v));
+                break;
+            }
+            case ARG_STR: {
+                const char *str = va_arg(ap, const char *);
+                if (str == NULL)
+                {
+                    str = "(null)";
+                }
+                size_t room = cap - used - 1;
+                size_t len  = strnlen(str, room < 255 ? room : 255);
+                if (str[len] != '\0')
+                {
+                    *truncated = true;
+                }
+                dst[used] = (uint8_t) len;
+                memcpy(dst + used + 1, str, len);
+                used += len;  // + 1 vine din s_arg_size[ARG_STR]
+                break;
+            }
+        }
+        used += s_arg_size[spec.type];
+    }
+    return used;
+}
+
+// -------------------------------------------------
+
+/* Copiaza specificatorul inlocuind '*' cu valorile salvate. */
+static bool build_spec(char *buf, const char *p, const spec_t *spec, const int *stars) {
+    size_t  n = 0;
+    uint8_t s = 0;
+    for (size_t i = 0; i < spec->len; i++)
+    {
+        if (p[i] == '*')
+        {
+            int w = snprintf(buf + n, SPEC_MAX_LEN - n, "%d", stars[s++]);
+            if (w < 0 || n + (size_t) w >= SPEC_MAX_LEN)
+            {
+                return false;
+            }
+            n += (size_t) w;
+        } else
+        {
+            if (n + 1 >= SPEC_MAX_LEN)
+            {
+                return false;
+            }
+            buf[n++] = p[i];
+        }
+    }
+    buf[n] = '\0';
+    return true;
+}
+
+static void append(size_t cap, size_t *pos, int written) {
+    if (written > 0)
+    {
+        *pos += (size_t) written;
+        if (*pos > cap - 1)
+        {
+            *pos = cap - 1;
+        }
+    }
+}
+
+size_t async_log_format(char *out, size_t cap, const char *format, const uint8_t *args, size_t len) {
+    size_t      pos  = 0;
+    size_t      used = 0;
+    const char *p    = format;
+
+    if (cap == 0)
+    {
+        return 0;
+    }
+    out[0] = '\0';
+
+    while (*p != '\0' && pos < cap - 1)
+    {
+        const char *next    = strchr(p, '%');
+        size_t      literal = next != NULL ? (size_t) (next - p) : strlen(p);
+        if (literal > cap - 1 - pos)
+        {
+            literal = cap - 1 - pos;
+        }
+        memcpy(out + pos, p, literal);
+        pos += literal;
+        out[pos] = '\0';
+        if (next == NULL || pos == cap - 1)
+        {
+            break;
+        }
+
+        spec_t spec;
+        parse_spec(next, &spec);
+        p = next + spec.len;
+
+        if (spec.type == ARG_NONE)
+        {
+            if (spec.len == 2 && next[1] == '%')
+            {
+                out[pos++] = '%';
+                out[pos]   = '\0';
+            }
+            continue;
+        }
+
+        size_t need = spec.stars * sizeof(int) + s_arg_size[spec.type];
+        if (used + need > len)
+        {
+            append(cap, &pos, snprintf(out + pos, cap - pos, "..."));  // argumente taiate la copiere
+            break;
+        }
+        int stars[2] = {0, 0};
+        memcpy(stars, args + used, spec.stars * sizeof(int));
+        used += spec.stars * sizeof(int);
+
+        char spec_buf[SPEC_MAX_LEN];
+        if (!build_spec(spec_buf, next, &spec, stars))
+        {
+            break;
+        }
+
+        char  *dst  = out + pos;
+        size_t room = cap - pos;
+        int    w    = 0;
+        switch (spec.type)
+        {
+            case ARG_INT: {
+                int v;
+                memcpy(&v, args + used, sizeof(v));
+                w = snprintf(dst, room, spec_buf, v);
+                break;
+            }
+            case ARG_LONG: {
+                long v;
+                memcpy(&v, args + used, sizeof(v));
+                w = snprintf(dst, room, spec_buf, v);
+                break;
+            }
+            case ARG_LLONG: {
+                long long v;
+                memcpy(&v, args + used, sizeof(v));
+                w = snprintf(dst, room, spec_buf, v);
+                break;
+            }
+            case ARG_SIZE: {
+                size_t v;
+                memcpy(&v, args + used, sizeof(v));
+                w = snprintf(dst, room, spec_buf, v);
+                break;
+            }
+            case ARG_PTRDIFF: {
+                ptrdiff_t v;
+                memcpy(&v, args + used, sizeof(v));
+                w = snprintf(dst, room, spec_buf, v);
+                break;
+            }
+            case ARG_INTMAX: {
+                intmax_t v;
+                memcpy(&v, args + used, sizeof(v));
+                w = snprintf(dst, room, spec_buf, v);
+                break;
+            }
+            case ARG_DOUBLE: {
+                double v;
+                memcpy(&v, args + used, sizeof(v));
+                w = snprintf(dst, room, spec_buf, v);
+                break;
+            }
+            case ARG_LDOUBLE: {
+                double v;
+                memcpy(&v, args + used, sizeof(v));
+                w = snprintf(dst, room, spec_buf, (long double) v);
+                break;
+            }
+            case ARG_PTR: {
+                void *v;
+                memcpy(&v, args + used, sizeof(v));
+                w = snprintf(dst, room, spec_buf, v);
+                break;
+            }
+            case ARG_STR: {
+                char   str[256];
+                size_t str_len = args[used];
+                memcpy(str, args + used + 1, str_len);
+                str[str_len] = '\0';
+                w            = snprintf(dst, room, spec_buf, str);
+                used += str_len;
+                break;
+            }
+            case ARG_NONE:
+                break;
+        }
+        used += s_arg_size[spec.type];
+        append(cap, &pos, w);
+    }
+    return pos;
+}
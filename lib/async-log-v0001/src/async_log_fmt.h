@@ -0,0 +1,17 @@
+#pragma once
+#ifndef ASYNC_LOG_FMT_H_
+#define ASYNC_LOG_FMT_H_
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Copiaza argumentele cerute de `format` in `dst` (tipul fiecaruia vine din format).
+ * Intoarce bytes folositi; *truncated devine true daca nu au incaput toate. */
+size_t async_log_capture(uint8_t *dst, size_t cap, const char *format, va_list ap, bool *truncated);
+
+/* Reface textul din format + argumentele copiate. Intoarce lungimea scrisa in `out`. */
+size_t async_log_format(char *out, size_t cap, const char *format, const uint8_t *args, size_t len);
+
+#endif /* #ifndef ASYNC_LOG_FMT_H_ */
@@ -10,7 +10,7 @@ extern "C" {
 #endif /* __cplusplus */
 
 // PROTOTYPES
-esp_err_t initialize_filesystem_spiffs();
+esp_err_t initialize_filesystem_littlefs();  // monteaza partitia "littlefs" in /littlefs
 
 #ifdef __cplusplus
 }
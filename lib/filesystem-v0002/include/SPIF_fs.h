@@ -10,7 +10,7 @@ extern "C" {
 #endif /* __cplusplus */
 
 //PROTOTYPES
-esp_err_t initialize_filesystem_littlefs() ;
+esp_err_t initialize_filesystem_spiffs();
 
 #ifdef __cplusplus
 }
@@ -70,57 +70,6 @@ esp_err_t initialize_filesystem_littlefs() {
         ESP_LOGI(LITTLEFS_TAG, "Partition size: total: %d, used: %d", total, used);
     }
 
-    // Use POSIX and C standard library functions to work with files.
-    // First create a file.
-    ESP_LOGI(LITTLEFS_TAG, "Opening file");
-    FILE *f = fopen("/littlefs/hello.txt", "w");
-    if (f == NULL) {
-        ESP_LOGE(LITTLEFS_TAG, "Failed to open file for writing");
-        return ESP_FAIL;
-    }
-    fprintf(f, "Hello World!\n");
-    fclose(f);
-    ESP_LOGI(LITTLEFS_TAG, "File written");
-
-    // Rename original file
-    // ESP_LOGI(TAG, "Renaming file");
-    // if (rename("/littlefs/hello.txt", "/littlefs/foo.txt") != 0) {
-    //     ESP_LOGE(TAG, "Rename failed");
-    //     return;
-    // }
-
-    // Open renamed file for reading
-    ESP_LOGI(LITTLEFS_TAG, "Reading file");
-    f = fopen("/littlefs/hello.txt", "r");
-    if (f == NULL) {
-        ESP_LOGE(LITTLEFS_TAG, "Failed to open file for reading");
-        return ESP_FAIL;
-    }
-
-    char line[128] = {0};
-    fgets(line, sizeof(line), f);
-    fclose(f);
-    // strip newline
-    char* pos = strpbrk(line, "\r\n");
-    if (pos) {
-        *pos = '\0';
-    }
-    ESP_LOGI(LITTLEFS_TAG, "Read from file: '%s'", line);
-
-    ESP_LOGI(LITTLEFS_TAG, "Reading from flashed filesystem example.txt");
-    f = fopen("/littlefs/example.txt", "r");
-    if (f == NULL) {
-        ESP_LOGE(LITTLEFS_TAG, "Failed to open file for reading");
-        return ESP_FAIL;
-    }
-    fgets(line, sizeof(line), f);
-    fclose(f);
-    // strip newline
-    pos = strpbrk(line, "\r\n");
-    if (pos) {
-        *pos = '\0';
-    }
-    ESP_LOGI(LITTLEFS_TAG, "Read from file: '%s'", line);
     return ESP_OK;
 }
 
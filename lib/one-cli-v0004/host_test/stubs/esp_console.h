@@ -0,0 +1,5 @@
+#pragma once
+#include "esp_err.h"
+
+// implementat de test_batch.c
+esp_err_t esp_console_run(const char *cmdline, int *cmd_ret);
@@ -0,0 +1,10 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef unsigned UBaseType_t;
+
+#define portMAX_DELAY 0xffffffffu
+#define pdTRUE 1
+#define pdPASS 1
+#define tskIDLE_PRIORITY 0
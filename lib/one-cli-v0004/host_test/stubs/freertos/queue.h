@@ -0,0 +1,57 @@
+#pragma once
+// coada FreeRTOS minimala peste pthread, suficienta pentru batch.c
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t  changed;
+    size_t          item_size, capacity, head, count;
+    char           *buf;
+} host_queue_t;
+typedef host_queue_t *QueueHandle_t;
+
+static inline QueueHandle_t xQueueCreate(size_t capacity, size_t item_size) {
+    host_queue_t *q = calloc(1, sizeof(*q));
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->changed, NULL);
+    q->item_size = item_size;
+    q->capacity = capacity;
+    q->buf = malloc(capacity * item_size);
+    return q;
+}
+
+static inline void vQueueDelete(QueueHandle_t q) {
+    pthread_cond_destroy(&q->changed);
+    pthread_mutex_destroy(&q->lock);
+    free(q->buf);
+    free(q);
+}
+
+// timeout-ul e ignorat: in batch.c cozile nu se umplu niciodata cand timeout-ul e 0
+static inline int xQueueSend(QueueHandle_t q, const void *item, uint32_t ticks) {
+    (void)ticks;
+    pthread_mutex_lock(&q->lock);
+    while (q->count == q->capacity)
+        pthread_cond_wait(&q->changed, &q->lock);
+    memcpy(q->buf + ((q->head + q->count) % q->capacity) * q->item_size, item, q->item_size);
+    q->count++;
+    pthread_cond_broadcast(&q->changed);
+    pthread_mutex_unlock(&q->lock);
+    return pdTRUE;
+}
+
+static inline int xQueueReceive(QueueHandle_t q, void *item, uint32_t ticks) {
+    (void)ticks;
+    pthread_mutex_lock(&q->lock);
+    while (q->count == 0)
+        pthread_cond_wait(&q->changed, &q->lock);
+    memcpy(item, q->buf + q->head * q->item_size, q->item_size);
+    q->head = (q->head + 1) % q->capacity;
+    q->count--;
+    pthread_cond_broadcast(&q->changed);
+    pthread_mutex_unlock(&q->lock);
+    return pdTRUE;
+}
@@ -0,0 +1,74 @@
+#pragma once
+// task-urile FreeRTOS devin thread-uri detasate, cu notificari pe un contor
+#include <pthread.h>
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+
+typedef struct {
+    void (*fn)(void *);
+    void *arg;
+    pthread_mutex_t lock;
+    pthread_cond_t  notified;
+    uint32_t        notify_cnt;
+} host_task_t;
+typedef host_task_t *TaskHandle_t;
+
+static __thread host_task_t *host_task_current;
+
+static inline void *host_task_entry(void *p) {
+    host_task_t *t = p;
+    host_task_current = t;
+    t->fn(t->arg);
+    return NULL;
+}
+
+// structura ramane alocata: handle-ul poate fi notificat si dupa ce task-ul s-a terminat
+static inline int xTaskCreate(void (*fn)(void *), const char *name, uint32_t stack, void *arg,
+                              UBaseType_t prio, TaskHandle_t *handle) {
+    (void)name, (void)stack, (void)prio;
+    pthread_t th;
+    host_task_t *t = calloc(1, sizeof(*t));
+    t->fn = fn;
+    t->arg = arg;
+    pthread_mutex_init(&t->lock, NULL);
+    pthread_cond_init(&t->notified, NULL);
+    if (pthread_create(&th, NULL, host_task_entry, t) != 0)
+    {
+        free(t);
+        return 0;
+    }
+    pthread_detach(th);
+    if (handle != NULL)
+        *handle = t;
+    return pdPASS;
+}
+
+static inline UBaseType_t uxTaskPriorityGet(TaskHandle_t task) {
+    (void)task;
+    return 1;
+}
+
+static inline void vTaskDelete(TaskHandle_t task) {
+    (void)task;
+    pthread_exit(NULL);
+}
+
+static inline void xTaskNotifyGive(TaskHandle_t task) {
+    pthread_mutex_lock(&task->lock);
+    task->notify_cnt++;
+    pthread_cond_signal(&task->notified);
+    pthread_mutex_unlock(&task->lock);
+}
+
+// timeout-ul e ignorat: se asteapta mereu o notificare
+static inline uint32_t ulTaskNotifyTake(int clear, uint32_t ticks) {
+    (void)ticks;
+    host_task_t *t = host_task_current;
+    pthread_mutex_lock(&t->lock);
+    while (t->notify_cnt == 0)
+        pthread_cond_wait(&t->notified, &t->lock);
+    uint32_t cnt = t->notify_cnt;
+    t->notify_cnt = clear ? 0 : cnt - 1;
+    pthread_mutex_unlock(&t->lock);
+    return cnt;
+}
@@ -0,0 +1,3 @@
+#pragma once
+// doar ce foloseste history.c; testul pastreaza liniile adaugate
+int linenoiseHistoryAdd(const char *line);
@@ -0,0 +1,3 @@
+#pragma once
+// test pe host: batch.c foloseste clock_gettime() in loc de esp_timer
+#define CONFIG_IDF_TARGET_LINUX 1
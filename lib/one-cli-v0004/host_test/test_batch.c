@@ -0,0 +1,174 @@
+/*
+ * Test pe host pentru modul batch (src/batch.c): scriptul vine pe un pseudo-terminal,
+ * ca la un script lipit in consola, iar esp_console_run() e simulat.
+ *
+ *   cmake -S lib/one-cli-v0004/host_test -B build_host && cmake --build build_host && ctest --test-dir build_host
+ */
+#include <pty.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "batch.h"
+#include "config.h"
+#include "esp_console.h"
+
+static int s_failures;
+
+#define CHECK(cond)                                                    \
+    do                                                                 \
+    {                                                                  \
+        if (!(cond))                                                   \
+        {                                                              \
+            fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #cond); \
+            s_failures++;                                              \
+        }                                                              \
+    } while (0)
+
+static char s_script_path[64];
+
+/* "bad..." nu exista, "fail..." intoarce 1, "batch" porneste un script din script; restul dureaza 200 us */
+esp_err_t esp_console_run(const char *cmdline, int *cmd_ret) {
+    *cmd_ret = 0;
+    if (strncmp(cmdline, "bad", 3) == 0)
+    {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (strncmp(cmdline, "fail", 4) == 0)
+    {
+        *cmd_ret = 1;
+        return ESP_OK;
+    }
+    if (strncmp(cmdline, "batch", 5) == 0)
+    {
+        *cmd_ret = cli_batch_run_file(s_script_path, NULL, NULL) == ESP_ERR_INVALID_STATE ? 2 : 0;
+        return ESP_OK;
+    }
+    struct timespec ts = {0, 200000};
+    nanosleep(&ts, NULL);
+    return ESP_OK;
+}
+
+static void write_all(int fd, const char *buf, size_t len) {
+    while (len > 0)
+    {
+        ssize_t n = write(fd, buf, len);
+        if (n <= 0)
+        {
+            _exit(1);
+        }
+        buf += n;
+        len -= (size_t) n;
+    }
+}
+
+/* Scriptul de test, scris de un proces copil pe partea master a pty-ului */
+static void write_script(int master) {
+    char buf[CONSOLE_MAX_CMDLINE_LENGTH + 64];
+    for (int i = 0; i < 50; i++)
+    {
+        int n = snprintf(buf, sizeof(buf), "cmd %d\r\n", i);
+        write_all(master, buf, (size_t) n);
+    }
+    const char *mixed = "# comment\n\n  \nbad one\nfail two\n";
+    write_all(master, mixed, strlen(mixed));
+    memset(buf, 'x', CONSOLE_MAX_CMDLINE_LENGTH + 32);  // mai lunga decat bufferul unei linii
+    buf[CONSOLE_MAX_CMDLINE_LENGTH + 32] = '\n';
+    write_all(master, buf, CONSOLE_MAX_CMDLINE_LENGTH + 33);
+    const char *tail = "cmd after\n" CLI_BATCH_END_LINE "\nnot executed\n";
+    write_all(master, tail, strlen(tail));
+}
+
+static esp_err_t run_on_pty(bool keep_going, cli_batch_stats_t *stats) {
+    int            master, slave;
+    struct termios tio;
+    if (openpty(&master, &slave, NULL, NULL, NULL) != 0)
+    {
+        perror("openpty");
+        exit(1);
+    }
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+
+    pid_t writer = fork();
+    if (writer == 0)
+    {
+        close(slave);
+        write_script(master);
+        sleep(1);  // master-ul ramane deschis pana citeste batch-ul
+        _exit(0);
+    }
+    FILE            *in   = fdopen(slave, "r");
+    cli_batch_opts_t opts = {.keep_going = keep_going, .quiet = true};
+    esp_err_t        err  = cli_batch_run_stream(in, &opts, stats);
+    fclose(in);
+    close(master);
+    waitpid(writer, NULL, 0);
+    return err;
+}
+
+int main(void) {
+    cli_batch_stats_t stats;
+
+    // 50 comenzi + bad + fail + linia prea lunga + "cmd after"; ce e dupa "." nu se citeste
+    CHECK(run_on_pty(true, &stats) == ESP_FAIL);
+    CHECK(stats.commands == 54);
+    CHECK(stats.errors == 3);
+    CHECK(stats.skipped == 0);
+    CHECK(stats.min_us <= stats.max_us && stats.max_us >= 200);
+    CHECK(stats.wall_us >= stats.total_us / 2);
+
+    // fara keep_going: oprire la "bad one", restul pana la "." se consuma fara executie
+    CHECK(run_on_pty(false, &stats) == ESP_FAIL);
+    CHECK(stats.commands == 51);
+    CHECK(stats.errors == 1);
+    CHECK(stats.skipped == 3);
+
+    // script din fisier; `batch` din script e refuzat
+    snprintf(s_script_path, sizeof(s_script_path), "/tmp/test_batch_%d.cli", (int) getpid());
+    FILE *f = fopen(s_script_path, "w");
+    fprintf(f, "cmd a\n# comment\ncmd b\n");
+    fclose(f);
+    CHECK(cli_batch_run_file(s_script_path, NULL, &stats) == ESP_OK);
+    CHECK(stats.commands == 2 && stats.errors == 0);
+
+    f = fopen(s_script_path, "a");
+    fprintf(f, "batch nested\ncmd c\n");
+    fclose(f);
+    CHECK(cli_batch_run_file(s_script_path, NULL, &stats) == ESP_FAIL);
+    CHECK(stats.commands == 3 && stats.errors == 1 && stats.skipped == 1);
+
+    // linii care umplu exact bufferul: ultima fara '\n', una cu "\r\n"; doar cea cu un caracter in plus e prea lunga
+    char full[CONSOLE_MAX_CMDLINE_LENGTH + 1];
+    memset(full, 'x', sizeof(full));
+    f = fopen(s_script_path, "w");
+    fprintf(f, "%.*s\r\n", CONSOLE_MAX_CMDLINE_LENGTH - 1, full);
+    fprintf(f, "%.*s\n", CONSOLE_MAX_CMDLINE_LENGTH, full);
+    fprintf(f, "%.*s", CONSOLE_MAX_CMDLINE_LENGTH - 1, full);
+    fclose(f);
+    CHECK(cli_batch_run_file(s_script_path, NULL, &stats) == ESP_FAIL);
+    CHECK(stats.commands == 2 && stats.errors == 1 && stats.skipped == 1);
+
+    f = fopen(s_script_path, "w");
+    fprintf(f, "cmd a\n%.*s", CONSOLE_MAX_CMDLINE_LENGTH - 1, full);
+    fclose(f);
+    CHECK(cli_batch_run_file(s_script_path, NULL, &stats) == ESP_OK);
+    CHECK(stats.commands == 2 && stats.errors == 0);
+    remove(s_script_path);
+
+    CHECK(cli_batch_run_file("/nonexistent/script.cli", NULL, NULL) == ESP_ERR_NOT_FOUND);
+    CHECK(cli_batch_run_stream(NULL, NULL, NULL) == ESP_ERR_INVALID_ARG);
+
+    if (s_failures > 0)
+    {
+        fprintf(stderr, "%d check(s) failed\n", s_failures);
+        return 1;
+    }
+    printf("batch host test: OK\n");
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * Test pe host pentru registrul de benchmark-uri din `perfmon run` (modules/perfmon_cmd/bench_registry.c):
+ * inregistrarea kernel-urilor si masurarea pe Linux, cu clock_gettime() si perf_event_open()
+ * acolo unde contoarele exista (in VM sau container de obicei nu exista si raman nevalide).
+ *
+ *   cmake -S lib/one-cli-v0004/host_test -B build_host && cmake --build build_host && ctest --test-dir build_host
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench_registry.h"
+
+#define SPIN_NS 20000
+#define REPEAT  50
+
+static int s_failures;
+
+#define CHECK(cond)                                                    \
+    do                                                                 \
+    {                                                                  \
+        if (!(cond))                                                   \
+        {                                                              \
+            fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #cond); \
+            s_failures++;                                              \
+        }                                                              \
+    } while (0)
+
+static unsigned s_runs, s_setups, s_teardowns;
+static size_t   s_setup_size;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+static void *spin_setup(size_t size) {
+    static int ctx;
+    s_setups++;
+    s_setup_size = size;
+    return &ctx;
+}
+
+/* Timp cunoscut per apel: asteptare activa de SPIN_NS */
+static void spin_run(void *ctx) {
+    (void) ctx;
+    s_runs++;
+    uint64_t end = now_ns() + SPIN_NS;
+    while (now_ns() < end)
+    {
+    }
+}
+
+static void spin_teardown(void *ctx) {
+    (void) ctx;
+    s_teardowns++;
+}
+
+static void *failing_setup(size_t size) {
+    (void) size;
+    return NULL;
+}
+
+static const bench_kernel_t s_spin = {
+    .name        = "spin",
+    .description = "busy wait",
+    .setup       = spin_setup,
+    .run         = spin_run,
+    .teardown    = spin_teardown,
+    .sizes       = {64, 256},
+};
+
+static const bench_kernel_t s_failing = {
+    .name     = "failing",
+    .setup    = failing_setup,
+    .run      = spin_run,
+    .teardown = spin_teardown,
+};
+
+static const bench_kernel_t s_no_run = {
+    .name = "no_run",
+};
+
+int main(void) {
+    CHECK(bench_register(NULL) == ESP_ERR_INVALID_ARG);
+    CHECK(bench_register(&s_no_run) == ESP_ERR_INVALID_ARG);
+    CHECK(bench_register(&s_spin) == ESP_OK);
+    CHECK(bench_register(&s_spin) == ESP_ERR_INVALID_STATE);
+    CHECK(bench_register(&s_failing) == ESP_OK);
+    CHECK(bench_count() == 2);
+    CHECK(bench_get(0) == &s_spin && bench_get(2) == NULL);
+    CHECK(bench_find("failing") == &s_failing && bench_find("missing") == NULL);
+
+    // registrul plin
+    static bench_kernel_t fillers[BENCH_MAX_KERNELS];
+    static char           names[BENCH_MAX_KERNELS][16];
+    for (size_t i = 0; i < BENCH_MAX_KERNELS; i++)
+    {
+        snprintf(names[i], sizeof(names[i]), "filler_%u", (unsigned) i);
+        fillers[i] = (bench_kernel_t) {.name = names[i], .run = spin_run};
+    }
+    for (size_t i = 0; i < BENCH_MAX_KERNELS - 2; i++)
+    {
+        CHECK(bench_register(&fillers[i]) == ESP_OK);
+    }
+    CHECK(bench_register(&fillers[BENCH_MAX_KERNELS - 2]) == ESP_ERR_NO_MEM);
+    CHECK(bench_count() == BENCH_MAX_KERNELS);
+
+    bench_result_t r;
+    CHECK(bench_run(NULL, 0, REPEAT, &r) == ESP_ERR_INVALID_ARG);
+    CHECK(bench_run(&s_spin, 0, 0, &r) == ESP_ERR_INVALID_ARG);
+    CHECK(bench_run(&s_failing, 0, REPEAT, &r) == ESP_ERR_NO_MEM);
+    CHECK(s_teardowns == 0);
+
+    // timpul vine din clock_gettime(); contoarele doar daca perf_event_open() merge
+    CHECK(bench_run(&s_spin, 256, REPEAT, &r) == ESP_OK);
+    printf("spin %d ns: %u ns/call | valid 0x%02x cycles %u insn %u loads %u stores %u bubbles %u\n", SPIN_NS,
+           (unsigned) r.ns, (unsigned) r.valid, (unsigned) r.cycles, (unsigned) r.insn, (unsigned) r.loads,
+           (unsigned) r.stores, (unsigned) r.bubbles);
+    CHECK(r.ns >= SPIN_NS && r.ns < SPIN_NS * 10);
+    CHECK(s_setups == 1 && s_setup_size == 256 && s_teardowns == 1);
+    CHECK(s_runs >= 1 + REPEAT);  // incalzire + masurare, plus o trecere pentru fiecare contor deschis
+    CHECK((r.valid & BENCH_HAS_BUBBLES_DEP) == 0);  // fara echivalent pe Linux
+    CHECK(!(r.valid & BENCH_HAS_CYCLES) || r.cycles > 0);
+    CHECK(!(r.valid & BENCH_HAS_INSN) || r.insn > 0);
+    CHECK(r.bubbles_dep == 0);
+
+    if (s_failures > 0)
+    {
+        fprintf(stderr, "%d check(s) failed\n", s_failures);
+        return 1;
+    }
+    printf("bench registry host test: OK\n");
+    return 0;
+}
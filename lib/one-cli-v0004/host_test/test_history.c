@@ -0,0 +1,169 @@
+/*
+ * Test pe host pentru istoricul comenzilor (src/history.c): numara bytes scrisi pe flash per comanda
+ * cu jurnalul append-only fata de rescrierea completa de dinainte (linenoiseHistorySave()),
+ * apoi reincarcarea, o linie scrisa pe jumatate, un fisier gol si un octet 0 in fisier.
+ *
+ *   cmake -S lib/one-cli-v0004/host_test -B build_host && cmake --build build_host && ctest --test-dir build_host
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "config.h"
+#include "history.h"
+#include "linenoise/linenoise.h"
+
+#define COMMANDS 1000
+
+static int s_failures;
+
+#define CHECK(cond)                                                    \
+    do                                                                 \
+    {                                                                  \
+        if (!(cond))                                                   \
+        {                                                              \
+            fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #cond); \
+            s_failures++;                                              \
+        }                                                              \
+    } while (0)
+
+static char   s_path[64];
+static size_t s_added;
+static char   s_last_added[CONSOLE_MAX_CMDLINE_LENGTH];
+
+int linenoiseHistoryAdd(const char *line) {
+    s_added++;
+    strncpy(s_last_added, line, sizeof(s_last_added) - 1);
+    return 1;
+}
+
+/* Compactarea ruleaza pe task-ul ei; asteapta sa ajunga la `compactions` */
+static void wait_compactions(size_t compactions) {
+    cli_history_stats_t st;
+    for (int i = 0; i < 2000; i++)
+    {
+        cli_history_get_stats(&st);
+        if (st.compactions >= compactions)
+        {
+            return;
+        }
+        struct timespec ts = {0, 1000000};
+        nanosleep(&ts, NULL);
+    }
+}
+
+static size_t count_lines(const char *path, char *last, size_t last_size) {
+    FILE  *f     = fopen(path, "r");
+    char   line[CONSOLE_MAX_CMDLINE_LENGTH + 2];
+    size_t lines = 0;
+    if (f == NULL)
+    {
+        return 0;
+    }
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        lines++;
+        snprintf(last, last_size, "%s", line);
+    }
+    fclose(f);
+    return lines;
+}
+
+/* Vechiul mod: dupa fiecare comanda tot istoricul (ultimele CONSOLE_HISTORY_MAX_LEN) se rescrie */
+static size_t old_rewrite_bytes(const char *old_path) {
+    static char hist[CONSOLE_HISTORY_MAX_LEN][64];
+    size_t      count = 0, bytes = 0;
+    for (int i = 0; i < COMMANDS; i++)
+    {
+        if (count == CONSOLE_HISTORY_MAX_LEN)
+        {
+            memmove(hist, hist + 1, sizeof(hist[0]) * (CONSOLE_HISTORY_MAX_LEN - 1));
+            count--;
+        }
+        snprintf(hist[count++], sizeof(hist[0]), "perfmon run bench_%d --iter %d", i % 17, i);
+        FILE *f = fopen(old_path, "w");
+        for (size_t k = 0; k < count; k++)
+        {
+            fprintf(f, "%s\n", hist[k]);
+        }
+        bytes += (size_t) ftell(f);
+        fclose(f);
+    }
+    remove(old_path);
+    return bytes;
+}
+
+int main(void) {
+    snprintf(s_path, sizeof(s_path), "/tmp/test_history_%d.txt", (int) getpid());
+    remove(s_path);
+
+    // fisier gol: nimic de incarcat
+    fclose(fopen(s_path, "w"));
+    CHECK(cli_history_load(s_path) == ESP_OK);
+    CHECK(s_added == 0);
+
+    char last_cmd[64];
+    for (int i = 0; i < COMMANDS; i++)
+    {
+        snprintf(last_cmd, sizeof(last_cmd), "perfmon run bench_%d --iter %d", i % 17, i);
+        CHECK(cli_history_append(last_cmd) == ESP_OK);
+    }
+    cli_history_stats_t st;
+    cli_history_get_stats(&st);
+    wait_compactions(st.compactions);
+    cli_history_get_stats(&st);
+
+    char   old_path[80];
+    snprintf(old_path, sizeof(old_path), "%s.old", s_path);
+    size_t old_bytes = old_rewrite_bytes(old_path);
+    printf("%d commands: full rewrite %zu B (%.0f B/command), journal %zu B (%.1f B/command), %zu compactions\n",
+           COMMANDS, old_bytes, (double) old_bytes / COMMANDS, st.bytes_written, (double) st.bytes_written / COMMANDS,
+           st.compactions);
+    CHECK(st.appends == COMMANDS && st.failures == 0);
+    CHECK(st.compactions > 0);
+    CHECK(st.bytes_written * 10 < old_bytes);
+
+    // reincarcare: doar ultimele CONSOLE_HISTORY_MAX_LEN ajung in linenoise
+    s_added = 0;
+    CHECK(cli_history_load(s_path) == ESP_OK);
+    CHECK(s_added == CONSOLE_HISTORY_MAX_LEN);
+    CHECK(strcmp(s_last_added, last_cmd) == 0);
+
+    // linie scrisa pe jumatate (pana de curent): load-ul cere compactarea, care o inchide cu '\n'
+    FILE *f = fopen(s_path, "a");
+    fputs("perfmon ru", f);
+    fclose(f);
+    cli_history_get_stats(&st);
+    CHECK(cli_history_load(s_path) == ESP_OK);
+    wait_compactions(st.compactions + 1);
+    CHECK(cli_history_append("help") == ESP_OK);
+    char last_line[CONSOLE_MAX_CMDLINE_LENGTH + 2];
+    count_lines(s_path, last_line, sizeof(last_line));
+    CHECK(strcmp(last_line, "help\n") == 0);
+
+    // octet 0 la inceput si mai multe linii decat se pastreaza: cautarea liniilor nu se opreste la el
+    f = fopen(s_path, "wb");
+    fputc('\0', f);
+    fputs("corrupt\n", f);
+    for (int i = 0; i < CONSOLE_HISTORY_MAX_LEN + 10; i++)
+    {
+        fprintf(f, "cmd %d\n", i);
+    }
+    fclose(f);
+    s_added = 0;
+    CHECK(cli_history_load(s_path) == ESP_OK);
+    CHECK(s_added == CONSOLE_HISTORY_MAX_LEN);
+    CHECK(cli_history_compact() == ESP_OK);
+    CHECK(count_lines(s_path, last_line, sizeof(last_line)) == CONSOLE_HISTORY_MAX_LEN);
+
+    remove(s_path);
+    if (s_failures > 0)
+    {
+        fprintf(stderr, "%d check(s) failed\n", s_failures);
+        return 1;
+    }
+    printf("history host test: OK\n");
+    return 0;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#ifndef CLI_BATCH_H_
+#define CLI_BATCH_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "esp_err.h"
+
+/**
+ * Mod batch: comenzi citite dintr-un fisier sau dintr-un stream brut (stdin, pty),
+ * fara linenoise si fara ecou, trimise direct la esp_console_run().
+ * Un task separat citeste liniile inainte, in CLI_BATCH_DEPTH buffere, cat timp
+ * task-ul apelant executa comanda curenta. Pentru fiecare comanda se raporteaza latenta.
+ * Liniile goale si cele care incep cu '#' sunt ignorate; un stream se termina la EOF,
+ * la Ctrl-D sau la o linie "." (CLI_BATCH_END_LINE).
+ */
+
+typedef struct {
+    bool keep_going;  // continua dupa o comanda esuata
+    bool quiet;       // doar sumarul, fara linie per comanda
+} cli_batch_opts_t;
+
+typedef struct {
+    uint32_t commands;  // comenzi executate
+    uint32_t errors;    // necunoscute, cod != 0 sau linii prea lungi
+    uint32_t skipped;   // linii citite dupa oprirea pe eroare
+    uint64_t total_us;  // suma latentelor
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t wall_us;   // de la prima citire pana la ultima comanda
+} cli_batch_stats_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* #ifdef __cplusplus */
+
+    // executa comenzile din `in` pana la sfarsit; `opts`/`stats` pot fi NULL
+    esp_err_t cli_batch_run_stream(FILE *in, const cli_batch_opts_t *opts, cli_batch_stats_t *stats);
+    // deschide `path` (de ex. MOUNT_PATH "/setup.cli") si apeleaza cli_batch_run_stream()
+    esp_err_t cli_batch_run_file(const char *path, const cli_batch_opts_t *opts, cli_batch_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif /* #ifdef __cplusplus */
+#endif /* #ifndef CLI_BATCH_H_ */
@@ -7,9 +7,15 @@
 #define CONSOLE_PROMPT_MAX_LEN (32)
 
 #define CONFIG_CONSOLE_STORE_HISTORY (1)
+#define CONSOLE_HISTORY_MAX_LEN (100)                          // comenzi pastrate in linenoise
+#define CONSOLE_HISTORY_COMPACT_AT (2 * CONSOLE_HISTORY_MAX_LEN) // linii in jurnal dupa care se rescrie
 #define CONFIG_CONSOLE_IGNORE_EMPTY_LINES (1)
 #define PROMPT_STR CONFIG_IDF_TARGET
 
+#define CLI_BATCH_DEPTH (4)          // linii citite in avans in modul batch
+#define CLI_BATCH_READER_STACK (3072)
+#define CLI_BATCH_END_LINE "."       // sfarsitul unui script trimis pe stdin
+
 /**
  * SETTINGS
  */
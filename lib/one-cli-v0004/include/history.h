@@ -0,0 +1,39 @@
+#pragma once
+#ifndef CLI_HISTORY_H_
+#define CLI_HISTORY_H_
+
+#include <stddef.h>
+#include "esp_err.h"
+
+/**
+ * Istoricul comenzilor e un jurnal append-only: o linie per comanda.
+ * Formatul e acelasi ca la linenoiseHistorySave(), deci fisierele vechi se incarca direct.
+ * Cand jurnalul trece de CONSOLE_HISTORY_COMPACT_AT linii, un task de prioritate mica
+ * il rescrie cu ultimele CONSOLE_HISTORY_MAX_LEN comenzi.
+ */
+
+typedef struct {
+    size_t records;      // linii in jurnal acum
+    size_t appends;      // comenzi adaugate de la boot
+    size_t bytes_written;// bytes scrisi in fisier de la boot (append + compactare)
+    size_t compactions;  // rescrieri complete ale jurnalului
+    size_t failures;     // adaugari care n-au ajuns pe flash (fisier inaccesibil sau scriere esuata)
+} cli_history_stats_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* #ifdef __cplusplus */
+
+    // incarca jurnalul in linenoise cu o singura citire secventiala si porneste task-ul de compactare
+    esp_err_t cli_history_load(const char *path);
+    // adauga o comanda la sfarsitul jurnalului
+    esp_err_t cli_history_append(const char *line);
+    // rescrie jurnalul cu ultimele CONSOLE_HISTORY_MAX_LEN comenzi (blocant)
+    esp_err_t cli_history_compact(void);
+    void cli_history_get_stats(cli_history_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif /* #ifdef __cplusplus */
+#endif /* #ifndef CLI_HISTORY_H_ */
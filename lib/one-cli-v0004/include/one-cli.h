@@ -17,6 +17,8 @@
 
 #include "init.h"
 #include "config.h"
+#include "history.h"
+#include "batch.h"
 
 
 #define MY_ESP_CONSOLE_CONFIG_DEFAULT() \
@@ -32,6 +34,8 @@ extern "C"
     // register all commands
     void cli_register_all_commands(void);
     void cli_set_history_path(const char *path);
+    // chemat din task-ul CLI dupa fiecare linie citita de la consola (ex. activitate pentru managerul de consum)
+    void cli_set_input_cb(void (*cb)(void));
     void StartCLI();
 
 #ifdef __cplusplus
@@ -0,0 +1,73 @@
+#include "batch_cmd.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "argtable3/argtable3.h"
+#include "esp_console.h"
+#include "esp_log.h"
+
+#include "batch.h"
+#include "config.h"
+
+static const char *TAG = "CLI";
+
+static struct {
+    struct arg_lit* keep_going;
+    struct arg_lit* quiet;
+    struct arg_str* file;
+    struct arg_end* end;
+} batch_args;
+
+static int batch_command(int argc, char** argv) {
+    int nerrors = arg_parse(argc, argv, (void**) &batch_args);
+    if (nerrors != 0)
+    {
+        arg_print_errors(stderr, batch_args.end, argv[0]);
+        return 1;
+    }
+
+    cli_batch_opts_t opts = {
+        .keep_going = batch_args.keep_going->count > 0,
+        .quiet      = batch_args.quiet->count > 0,
+    };
+    const char* file = batch_args.file->count > 0 ? batch_args.file->sval[0] : "-";
+
+    esp_err_t err;
+    if (strcmp(file, "-") == 0)
+    {
+        printf("Reading commands from the console, end with '" CLI_BATCH_END_LINE "' or Ctrl-D.\n");
+        err = cli_batch_run_stream(stdin, &opts, NULL);
+    } else
+    {
+        char path[96];
+        /* Caile relative sunt fata de sistemul de fisiere al consolei */
+        snprintf(path, sizeof(path), "%s%s", file[0] == '/' ? "" : MOUNT_PATH "/", file);
+        err = cli_batch_run_file(path, &opts, NULL);
+        if (err == ESP_ERR_NOT_FOUND)
+        {
+            printf("No such script: %s\n", path);
+        }
+    }
+    if (err == ESP_ERR_INVALID_STATE)
+    {
+        printf("A batch is already running\n");
+    }
+    return err == ESP_OK ? 0 : 1;
+}
+
+void cli_register_batch_command(void) {
+    batch_args.keep_going = arg_lit0("k", "keep-going", "Continue after a failing command");
+    batch_args.quiet      = arg_lit0("q", "quiet", "Only report failures and the summary");
+    batch_args.file       = arg_str0(NULL, NULL, "<file|->", "Script on " MOUNT_PATH " (default '-': the console stream)");
+    batch_args.end        = arg_end(2);
+
+    const esp_console_cmd_t cmd = {
+        .command  = "batch",
+        .help     = "Run commands from a script without line editing and report per-command latency",
+        .hint     = NULL,
+        .func     = &batch_command,
+        .argtable = &batch_args,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&cmd));
+    ESP_LOGI(TAG, "'%s' command registered.", cmd.command);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+
+#ifndef BATCH_CMD_H_
+#define BATCH_CMD_H_
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* #ifdef __cplusplus */
+
+void cli_register_batch_command(void);
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif  /* BATCH_CMD_H_ */
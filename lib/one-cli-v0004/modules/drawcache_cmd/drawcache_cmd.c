@@ -0,0 +1,82 @@
+
+#include "drawcache_cmd.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_console.h"
+#include "esp_log.h"
+
+#include "lvgl.h"
+
+static const char* TAG = "CLI";
+
+static uint32_t hit_pct(uint32_t hits, uint32_t misses) {
+    return hits + misses ? (uint32_t) ((uint64_t) hits * 100 / (hits + misses)) : 0;
+}
+
+static void print_stats(void) {
+    /* Contoarele sunt scrise de thread-urile de desenare fara lock: pot fi decalate cu un cadru */
+    lv_draw_sw_cache_stats_t stats;
+    lv_draw_sw_cache_get_stats(&stats);
+
+    printf("Draw cache: %" PRIu32 " / %" PRIu32 " B used\n", stats.size, stats.max_size);
+    printf("Gradients: %" PRIu32 " hits, %" PRIu32 " misses (%" PRIu32 "%% hit)\n", stats.grad_hits,
+        stats.grad_misses, hit_pct(stats.grad_hits, stats.grad_misses));
+    printf("Shadows:   %" PRIu32 " hits, %" PRIu32 " misses (%" PRIu32 "%% hit)\n", stats.shadow_hits,
+        stats.shadow_misses, hit_pct(stats.shadow_hits, stats.shadow_misses));
+    printf("%" PRIu32 " evicted, %" PRIu32 " not cached (too large)\n", stats.evictions, stats.bypassed);
+    printf("File %s: %" PRIu32 " items loaded at boot, %" PRIu32 " saved last time, %" PRIu32 " new since\n",
+        DRAW_CACHE_FILE, stats.loaded, stats.saved, stats.unsaved);
+}
+
+static int drawcache_command(int argc, char** argv) {
+    if (argc == 1)
+    {
+        print_stats();
+        return 0;
+    }
+    if (strcmp(argv[1], "reset") == 0)
+    {
+        lv_draw_sw_cache_reset_stats();
+        printf("Draw cache statistics cleared\n");
+        return 0;
+    }
+    if (strcmp(argv[1], "save") == 0)
+    {
+        if (lv_draw_sw_cache_save(DRAW_CACHE_FILE) != LV_RESULT_OK)
+        {
+            printf("Couldn't write %s\n", DRAW_CACHE_FILE);
+            return 1;
+        }
+        lv_draw_sw_cache_stats_t stats;
+        lv_draw_sw_cache_get_stats(&stats);
+        printf("%" PRIu32 " items saved to %s\n", stats.saved, DRAW_CACHE_FILE);
+        return 0;
+    }
+    if (strcmp(argv[1], "load") == 0)
+    {
+        if (lv_draw_sw_cache_load(DRAW_CACHE_FILE) != LV_RESULT_OK)
+        {
+            printf("No usable %s\n", DRAW_CACHE_FILE);
+            return 1;
+        }
+        lv_draw_sw_cache_stats_t stats;
+        lv_draw_sw_cache_get_stats(&stats);
+        printf("%" PRIu32 " items loaded from %s\n", stats.loaded, DRAW_CACHE_FILE);
+        return 0;
+    }
+    printf("Usage: drawcache | drawcache reset | drawcache save | drawcache load\n");
+    return 1;
+}
+
+void cli_register_drawcache_command(void) {
+    const esp_console_cmd_t cmd = {
+        .command = "drawcache",
+        .help    = "LVGL gradient and shadow cache: hit rates and usage ('drawcache reset' clears the counters, 'save' / 'load' the LittleFS copy)",
+        .hint    = NULL,
+        .func    = &drawcache_command,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&cmd));
+    ESP_LOGI(TAG, "'%s' command registered.", cmd.command);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+
+#ifndef DRAWCACHE_CMD_H_
+#define DRAWCACHE_CMD_H_
+
+
+// Fisierul cache-ului de desenare (main.cpp il incarca la pornire, `drawcache` il salveaza);
+// LV_FS_POSIX_LETTER 'L' -> /littlefs
+#define DRAW_CACHE_FILE "L:/draw_cache.bin"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* #ifdef __cplusplus */
+
+void cli_register_drawcache_command(void);
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif  /* DRAWCACHE_CMD_H_ */
@@ -0,0 +1,60 @@
+
+#include "imgcache_cmd.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_console.h"
+#include "esp_log.h"
+
+#include "lvgl.h"
+
+static const char* TAG = "CLI";
+
+static uint32_t percent(uint32_t part, uint32_t total) {
+    return total ? (uint32_t) ((uint64_t) part * 100 / total) : 0;
+}
+
+static void print_stats(void) {
+    /* Doar se citesc contoarele (fara lock-ul LVGL): valorile pot fi decalate cu un cadru */
+    lv_image_cache_stats_t stats;
+    lv_image_cache_get_stats(&stats);
+
+    printf("Image cache (%s): %" PRIu32 " / %" PRIu32 " B used, peak %" PRIu32 " B\n",
+        LV_IMAGE_CACHE_USE_GDSF ? "GDSF" : "LRU", stats.size, stats.max_size, stats.peak_size);
+    printf("%-8s %10s %10s %6s %10s\n", "cache", "hits", "misses", "hit%", "evictions");
+    printf("%-8s %10" PRIu32 " %10" PRIu32 " %5" PRIu32 "%% %10" PRIu32 "\n", "image", stats.hits, stats.misses,
+        percent(stats.hits, stats.hits + stats.misses), stats.evictions);
+    printf("%-8s %10" PRIu32 " %10" PRIu32 " %5" PRIu32 "%%\n", "header", stats.header_hits, stats.header_misses,
+        percent(stats.header_hits, stats.header_hits + stats.header_misses));
+    printf("Opened without caching (e.g. larger than the cache): %" PRIu32 "\n", stats.uncached);
+    printf("Decoding: %" PRIu64 " ms spent, %" PRIu64 " ms saved by the hits\n", stats.decode_time / 1000,
+        stats.saved_time / 1000);
+}
+
+static int imgcache_command(int argc, char** argv) {
+    if (argc == 1)
+    {
+        print_stats();
+        return 0;
+    }
+    if (strcmp(argv[1], "reset") == 0)
+    {
+        lv_image_cache_reset_stats();
+        printf("Image cache statistics cleared\n");
+        return 0;
+    }
+    printf("Usage: imgcache | imgcache reset\n");
+    return 1;
+}
+
+void cli_register_imgcache_command(void) {
+    const esp_console_cmd_t cmd = {
+        .command = "imgcache",
+        .help    = "LVGL image cache: hit rate, evictions and decoding time ('imgcache reset' clears the counters)",
+        .hint    = NULL,
+        .func    = &imgcache_command,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&cmd));
+    ESP_LOGI(TAG, "'%s' command registered.", cmd.command);
+}
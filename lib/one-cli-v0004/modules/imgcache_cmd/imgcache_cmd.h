@@ -0,0 +1,19 @@
+#pragma once
+
+
+#ifndef IMGCACHE_CMD_H_
+#define IMGCACHE_CMD_H_
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* #ifdef __cplusplus */
+
+void cli_register_imgcache_command(void);
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif  /* IMGCACHE_CMD_H_ */
@@ -0,0 +1,60 @@
+
+#include "layermem_cmd.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_console.h"
+#include "esp_log.h"
+
+#include "lvgl.h"
+
+static const char* TAG = "CLI";
+
+static void print_stats(void) {
+    /* Doar se citesc contoarele (fara lock-ul LVGL): valorile pot fi decalate cu un cadru */
+    lv_draw_layer_mem_info_t info;
+    lv_draw_layer_get_mem_info(&info);
+
+    if (info.limit)
+    {
+        printf("Layer memory: %" PRIu32 " B used, %" PRIu32 " B pooled, peak %" PRIu32 " / %" PRIu32 " B\n", info.used,
+            info.pooled, info.peak, info.limit);
+    } else
+    {
+        printf("Layer memory: %" PRIu32 " B used, %" PRIu32 " B pooled, peak %" PRIu32 " B (no limit)\n", info.used,
+            info.pooled, info.peak);
+    }
+    printf("Chunks: simple %d B, transformed %d B\n", LV_DRAW_LAYER_SIMPLE_BUF_SIZE, LV_DRAW_LAYER_TRANSFORM_BUF_SIZE);
+    printf("Buffers: %" PRIu32 " allocated, %" PRIu32 " reused from the pool (%d)\n", info.alloc_cnt, info.reuse_cnt,
+        LV_DRAW_LAYER_BUF_POOL_CNT);
+    printf("Limit: %" PRIu32 " allocation attempts postponed, %" PRIu32 " let over it (nested layers)\n", info.wait_cnt,
+        info.over_limit_cnt);
+}
+
+static int layermem_command(int argc, char** argv) {
+    if (argc == 1)
+    {
+        print_stats();
+        return 0;
+    }
+    if (strcmp(argv[1], "reset") == 0)
+    {
+        lv_draw_layer_reset_mem_info();
+        printf("Layer memory statistics cleared\n");
+        return 0;
+    }
+    printf("Usage: layermem | layermem reset\n");
+    return 1;
+}
+
+void cli_register_layermem_command(void) {
+    const esp_console_cmd_t cmd = {
+        .command = "layermem",
+        .help    = "LVGL layer buffers: memory used, peak and reuse ('layermem reset' clears the peak and the counters)",
+        .hint    = NULL,
+        .func    = &layermem_command,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&cmd));
+    ESP_LOGI(TAG, "'%s' command registered.", cmd.command);
+}
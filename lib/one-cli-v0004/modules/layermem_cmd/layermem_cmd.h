@@ -0,0 +1,19 @@
+#pragma once
+
+
+#ifndef LAYERMEM_CMD_H_
+#define LAYERMEM_CMD_H_
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* #ifdef __cplusplus */
+
+void cli_register_layermem_command(void);
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif  /* LAYERMEM_CMD_H_ */
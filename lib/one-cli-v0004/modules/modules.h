@@ -15,5 +15,11 @@
 #include "modules/uptime_cmd/uptime_cmd.h"
 #include "modules/wifi_cmd/wifi_cmd.h"
 #include "modules/perfmon_cmd/perfmon_cmd.h"
+#include "modules/batch_cmd/batch_cmd.h"
+#include "modules/sysmon_cmd/sysmon_cmd.h"
+#include "modules/imgcache_cmd/imgcache_cmd.h"
+#include "modules/uiqueue_cmd/uiqueue_cmd.h"
+#include "modules/layermem_cmd/layermem_cmd.h"
+#include "modules/drawcache_cmd/drawcache_cmd.h"
 
 #endif /* MODULES_H_ */
\ No newline at end of file
@@ -0,0 +1,631 @@
+#include "nvs_bulk.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+
+static const char *TAG = "CLI";
+
+static nvs_index_entry_t *s_index       = NULL;
+static size_t             s_index_cnt   = 0;
+static size_t             s_index_cap   = 0;
+static char               s_index_part[NVS_PART_NAME_MAX_SIZE];
+static bool               s_index_valid = false;
+
+// -------------------------------------------------
+
+/* U8..I64 au latimea in bitii de jos ai lui nvs_type_t; 0 pentru str/blob */
+static size_t int_size(nvs_type_t type) {
+    return type < NVS_TYPE_STR ? (size_t) (type & 0x0f) : 0;
+}
+
+static bool type_is_known(nvs_type_t type) {
+    switch (type)
+    {
+        case NVS_TYPE_U8:
+        case NVS_TYPE_I8:
+        case NVS_TYPE_U16:
+        case NVS_TYPE_I16:
+        case NVS_TYPE_U32:
+        case NVS_TYPE_I32:
+        case NVS_TYPE_U64:
+        case NVS_TYPE_I64:
+        case NVS_TYPE_STR:
+        case NVS_TYPE_BLOB:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static esp_err_t get_int(nvs_handle_t nvs, nvs_type_t type, const char *key, void *out) {
+    switch (type)
+    {
+        case NVS_TYPE_U8:
+            return nvs_get_u8(nvs, key, (uint8_t *) out);
+        case NVS_TYPE_I8:
+            return nvs_get_i8(nvs, key, (int8_t *) out);
+        case NVS_TYPE_U16:
+            return nvs_get_u16(nvs, key, (uint16_t *) out);
+        case NVS_TYPE_I16:
+            return nvs_get_i16(nvs, key, (int16_t *) out);
+        case NVS_TYPE_U32:
+            return nvs_get_u32(nvs, key, (uint32_t *) out);
+        case NVS_TYPE_I32:
+            return nvs_get_i32(nvs, key, (int32_t *) out);
+        case NVS_TYPE_U64:
+            return nvs_get_u64(nvs, key, (uint64_t *) out);
+        case NVS_TYPE_I64:
+            return nvs_get_i64(nvs, key, (int64_t *) out);
+        default:
+            return ESP_ERR_NVS_TYPE_MISMATCH;
+    }
+}
+
+static esp_err_t set_int(nvs_handle_t nvs, nvs_type_t type, const char *key, const uint8_t *in) {
+    union {
+        uint8_t  u8;
+        int8_t   i8;
+        uint16_t u16;
+        int16_t  i16;
+        uint32_t u32;
+        int32_t  i32;
+        uint64_t u64;
+        int64_t  i64;
+    } v;
+    memcpy(&v, in, int_size(type));  // fisierul e little-endian, ca ESP32
+    switch (type)
+    {
+        case NVS_TYPE_U8:
+            return nvs_set_u8(nvs, key, v.u8);
+        case NVS_TYPE_I8:
+            return nvs_set_i8(nvs, key, v.i8);
+        case NVS_TYPE_U16:
+            return nvs_set_u16(nvs, key, v.u16);
+        case NVS_TYPE_I16:
+            return nvs_set_i16(nvs, key, v.i16);
+        case NVS_TYPE_U32:
+            return nvs_set_u32(nvs, key, v.u32);
+        case NVS_TYPE_I32:
+            return nvs_set_i32(nvs, key, v.i32);
+        case NVS_TYPE_U64:
+            return nvs_set_u64(nvs, key, v.u64);
+        case NVS_TYPE_I64:
+            return nvs_set_i64(nvs, key, v.i64);
+        default:
+            return ESP_ERR_NVS_TYPE_MISMATCH;
+    }
+}
+
+// -------------------------------------------------
+
+typedef struct {
+    FILE    *f;
+    uint32_t crc;
+    bool     ok;
+} writer_t;
+
+static void put(writer_t *w, const void *data, size_t len) {
+    if (w->ok && fwrite(data, 1, len, w->f) != len)
+    {
+        w->ok = false;
+    }
+    w->crc = esp_rom_crc32_le(w->crc, (const uint8_t *) data, len);
+}
+
+static void put_str8(writer_t *w, const char *str) {
+    uint8_t len = (uint8_t) strlen(str);
+    put(w, &len, 1);
+    put(w, str, len);
+}
+
+/* Valoarea unei intrari str/blob, alocata; `len` fara '\0' */
+static esp_err_t get_var(nvs_handle_t nvs, nvs_type_t type, const char *key, uint8_t **data, size_t *len) {
+    esp_err_t err = type == NVS_TYPE_STR ? nvs_get_str(nvs, key, NULL, len) : nvs_get_blob(nvs, key, NULL, len);
+    if (err != ESP_OK)
+    {
+        return err;
+    }
+    *data = malloc(*len > 0 ? *len : 1);
+    if (*data == NULL)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    err = type == NVS_TYPE_STR ? nvs_get_str(nvs, key, (char *) *data, len) : nvs_get_blob(nvs, key, *data, len);
+    if (err != ESP_OK)
+    {
+        free(*data);
+        return err;
+    }
+    if (type == NVS_TYPE_STR && *len > 0)
+    {
+        (*len)--;
+    }
+    return ESP_OK;
+}
+
+esp_err_t nvs_bulk_export(const char *part, const char *ns, FILE *out, size_t *count) {
+    if (part == NULL || ns == NULL || out == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const nvs_index_entry_t *entries;
+    size_t                   total;
+    esp_err_t                err = nvs_index_get(part, &entries, &total);
+    if (err != ESP_OK)
+    {
+        return err;
+    }
+    size_t first = nvs_index_lower_bound(entries, total, ns);
+    size_t last  = first;
+    while (last < total && strcmp(entries[last].ns, ns) == 0)
+    {
+        last++;
+    }
+    if (last - first > UINT16_MAX)
+    {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    nvs_handle_t nvs;
+    err = nvs_open_from_partition(part, ns, NVS_READONLY, &nvs);
+    if (err != ESP_OK)
+    {
+        return err;
+    }
+
+    writer_t w       = {.f = out, .crc = 0, .ok = true};
+    uint8_t  version = NVS_BULK_VERSION;
+    uint16_t n       = (uint16_t) (last - first);
+    put(&w, NVS_BULK_MAGIC, 4);
+    put(&w, &version, 1);
+    put_str8(&w, ns);
+    put(&w, &n, sizeof(n));
+
+    for (size_t i = first; i < last && err == ESP_OK && w.ok; i++)
+    {
+        const nvs_index_entry_t *e    = &entries[i];
+        uint8_t                  type = (uint8_t) e->type;
+        if (int_size(e->type) > 0)
+        {
+            uint8_t value[8];
+            err = get_int(nvs, e->type, e->key, value);
+            if (err == ESP_OK)
+            {
+                put(&w, &type, 1);
+                put_str8(&w, e->key);
+                put(&w, value, int_size(e->type));
+            }
+        } else
+        {
+            uint8_t *data = NULL;
+            size_t   len  = 0;
+            err           = get_var(nvs, e->type, e->key, &data, &len);
+            if (err == ESP_OK)
+            {
+                uint32_t len32 = (uint32_t) len;
+                put(&w, &type, 1);
+                put_str8(&w, e->key);
+                put(&w, &len32, sizeof(len32));
+                put(&w, data, len);
+                free(data);
+            }
+        }
+        if (err != ESP_OK)
+        {
+            ESP_LOGE(TAG, "Export of '%s' failed: %s", e->key, esp_err_to_name(err));
+        }
+    }
+    nvs_close(nvs);
+
+    uint32_t crc = w.crc;
+    put(&w, &crc, sizeof(crc));
+    if (err == ESP_OK && !w.ok)
+    {
+        err = ESP_FAIL;
+    }
+    if (err == ESP_OK && count != NULL)
+    {
+        *count = n;
+    }
+    return err;
+}
+
+// -------------------------------------------------
+
+typedef struct {
+    const uint8_t *p;
+    const uint8_t *end;
+} reader_t;
+
+static const uint8_t *take(reader_t *r, size_t len) {
+    if ((size_t) (r->end - r->p) < len)
+    {
+        return NULL;
+    }
+    const uint8_t *p = r->p;
+    r->p += len;
+    return p;
+}
+
+/* Un sir len u8 + bytes, copiat cu '\0' in `out` de `cap` bytes */
+static bool take_str8(reader_t *r, char *out, size_t cap) {
+    const uint8_t *len = take(r, 1);
+    if (len == NULL || *len == 0 || *len >= cap)
+    {
+        return false;
+    }
+    const uint8_t *str = take(r, *len);
+    if (str == NULL)
+    {
+        return false;
+    }
+    memcpy(out, str, *len);
+    out[*len] = '\0';
+    return true;
+}
+
+typedef struct {
+    nvs_type_t     type;
+    char           key[NVS_KEY_NAME_MAX_SIZE];
+    const uint8_t *value;
+    uint32_t       len;
+} record_t;
+
+static bool next_record(reader_t *r, record_t *rec) {
+    const uint8_t *type = take(r, 1);
+    if (type == NULL || !type_is_known((nvs_type_t) *type) || !take_str8(r, rec->key, sizeof(rec->key)))
+    {
+        return false;
+    }
+    rec->type = (nvs_type_t) *type;
+    rec->len  = (uint32_t) int_size(rec->type);
+    if (rec->len == 0)
+    {
+        const uint8_t *len = take(r, sizeof(uint32_t));
+        if (len == NULL)
+        {
+            return false;
+        }
+        memcpy(&rec->len, len, sizeof(rec->len));
+    }
+    rec->value = take(r, rec->len);
+    return rec->value != NULL;
+}
+
+static uint8_t *read_all(FILE *in, size_t *len) {
+    size_t   cap = 1024;
+    uint8_t *buf = malloc(cap);
+    *len         = 0;
+    while (buf != NULL)
+    {
+        *len += fread(buf + *len, 1, cap - *len, in);
+        if (*len < cap)
+        {
+            break;
+        }
+        uint8_t *bigger = realloc(buf, cap * 2);
+        if (bigger == NULL)
+        {
+            free(buf);
+            return NULL;
+        }
+        buf = bigger;
+        cap *= 2;
+    }
+    return buf;
+}
+
+/* Intrari de 32 bytes ocupate de o inregistrare (estimare de sus: str/blob = antet + date, blob + index) */
+static size_t record_entries(const record_t *rec) {
+    if (rec->type == NVS_TYPE_STR)
+    {
+        return 1 + (rec->len + 1 + 31) / 32;
+    }
+    if (rec->type == NVS_TYPE_BLOB)
+    {
+        return 2 + (rec->len + 31) / 32;
+    }
+    return 1;
+}
+
+/* Ce ar refuza nvs_set_*() dupa ce alte chei au fost deja scrise */
+static bool record_fits(const record_t *rec) {
+    if (rec->type == NVS_TYPE_STR)
+    {
+        return rec->len < NVS_BULK_STR_MAX && memchr(rec->value, '\0', rec->len) == NULL;
+    }
+    return true;
+}
+
+static esp_err_t set_record(nvs_handle_t nvs, nvs_type_t type, const char *key, const uint8_t *value, size_t len) {
+    if (type == NVS_TYPE_STR)
+    {
+        char *str = malloc(len + 1);
+        if (str == NULL)
+        {
+            return ESP_ERR_NO_MEM;
+        }
+        memcpy(str, value, len);
+        str[len]      = '\0';
+        esp_err_t err = nvs_set_str(nvs, key, str);
+        free(str);
+        return err;
+    }
+    if (type == NVS_TYPE_BLOB)
+    {
+        return nvs_set_blob(nvs, key, value, len);
+    }
+    return set_int(nvs, type, key, value);
+}
+
+/* Valoarea de dinainte a unei chei scrise de import, ca sa poata fi pusa la loc */
+typedef struct {
+    char       key[NVS_KEY_NAME_MAX_SIZE];
+    nvs_type_t type;  // NVS_TYPE_ANY = cheia nu exista
+    uint8_t    value[8];
+    uint8_t   *data;  // str/blob
+    size_t     len;
+} undo_t;
+
+static esp_err_t undo_save(nvs_handle_t nvs, const char *key, undo_t *undo) {
+    strcpy(undo->key, key);
+    undo->data    = NULL;
+    undo->len     = 0;
+    esp_err_t err = nvs_find_key(nvs, key, &undo->type);
+    if (err == ESP_ERR_NVS_NOT_FOUND)
+    {
+        undo->type = NVS_TYPE_ANY;
+        return ESP_OK;
+    }
+    if (err != ESP_OK)
+    {
+        return err;
+    }
+    if (int_size(undo->type) > 0)
+    {
+        undo->len = int_size(undo->type);
+        return get_int(nvs, undo->type, key, undo->value);
+    }
+    return get_var(nvs, undo->type, key, &undo->data, &undo->len);
+}
+
+/* Pune la loc cheile scrise inainte de eroare, in ordine inversa; NVS nu are tranzactii */
+static void undo_apply(nvs_handle_t nvs, undo_t *undo, size_t n) {
+    while (n-- > 0)
+    {
+        nvs_erase_key(nvs, undo[n].key);  // si cand tipul s-a schimbat
+        if (undo[n].type != NVS_TYPE_ANY)
+        {
+            esp_err_t err = set_record(nvs, undo[n].type, undo[n].key, undo[n].data != NULL ? undo[n].data : undo[n].value, undo[n].len);
+            if (err != ESP_OK)
+            {
+                ESP_LOGE(TAG, "Rollback of '%s' failed: %s", undo[n].key, esp_err_to_name(err));
+            }
+        }
+        free(undo[n].data);
+    }
+}
+
+esp_err_t nvs_bulk_import(const char *part, const char *ns, FILE *in, size_t *count) {
+    if (part == NULL || in == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t   len = 0;
+    uint8_t *buf = read_all(in, &len);
+    if (buf == NULL)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    /* Intai tot fisierul: un fisier stricat nu scrie nimic */
+    esp_err_t err = ESP_ERR_INVALID_CRC;
+    uint32_t  crc = 0;
+    if (len >= 4 + 1 + 2 + 2 + sizeof(crc))
+    {
+        memcpy(&crc, buf + len - sizeof(crc), sizeof(crc));
+        if (esp_rom_crc32_le(0, buf, len - sizeof(crc)) == crc)
+        {
+            err = ESP_OK;
+        }
+    }
+
+    reader_t       r = {.p = buf, .end = buf + len - sizeof(crc)};
+    char           file_ns[NVS_NS_NAME_MAX_SIZE];
+    uint16_t       n = 0;
+    const uint8_t *magic;
+    const uint8_t *version;
+    const uint8_t *n_raw;
+    if (err == ESP_OK)
+    {
+        magic   = take(&r, 4);
+        version = take(&r, 1);
+        if (memcmp(magic, NVS_BULK_MAGIC, 4) != 0 || *version != NVS_BULK_VERSION || !take_str8(&r, file_ns, sizeof(file_ns))
+            || (n_raw = take(&r, sizeof(n))) == NULL)
+        {
+            err = ESP_ERR_NOT_SUPPORTED;
+        } else
+        {
+            memcpy(&n, n_raw, sizeof(n));
+        }
+    }
+    const uint8_t *records = r.p;
+    record_t       rec;
+    size_t         entries = 0;
+    for (uint16_t i = 0; err == ESP_OK && i < n; i++)
+    {
+        if (!next_record(&r, &rec))
+        {
+            err = ESP_ERR_INVALID_SIZE;
+        } else if (!record_fits(&rec))
+        {
+            ESP_LOGE(TAG, "Import of '%s' rejected: invalid string", rec.key);
+            err = ESP_ERR_NVS_VALUE_TOO_LONG;
+        } else
+        {
+            entries += record_entries(&rec);
+        }
+    }
+    if (err == ESP_OK && r.p != r.end)
+    {
+        err = ESP_ERR_INVALID_SIZE;
+    }
+
+    /* Si locul: cheile suprascrise elibereaza intrarile vechi abia dupa scriere */
+    nvs_stats_t stats;
+    if (err == ESP_OK && nvs_get_stats(part, &stats) == ESP_OK && entries > stats.free_entries)
+    {
+        ESP_LOGE(TAG, "Import needs ~%u NVS entries, %u free", (unsigned) entries, (unsigned) stats.free_entries);
+        err = ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    }
+
+    nvs_handle_t nvs;
+    undo_t      *undo = NULL;
+    if (err == ESP_OK)
+    {
+        undo = malloc((n > 0 ? n : 1) * sizeof(undo_t));
+        err  = undo != NULL ? ESP_OK : ESP_ERR_NO_MEM;
+    }
+    if (err == ESP_OK)
+    {
+        err = nvs_open_from_partition(part, ns != NULL ? ns : file_ns, NVS_READWRITE, &nvs);
+    }
+    if (err == ESP_OK)
+    {
+        size_t written = 0;
+        r.p            = records;
+        for (uint16_t i = 0; err == ESP_OK && i < n; i++)
+        {
+            next_record(&r, &rec);
+            err = undo_save(nvs, rec.key, &undo[written]);
+            if (err == ESP_OK)
+            {
+                written++;
+                err = set_record(nvs, rec.type, rec.key, rec.value, rec.len);
+            }
+            if (err != ESP_OK)
+            {
+                ESP_LOGE(TAG, "Import of '%s' failed: %s", rec.key, esp_err_to_name(err));
+            }
+        }
+        if (err != ESP_OK)
+        {
+            undo_apply(nvs, undo, written);  // importul e tot sau nimic
+        } else
+        {
+            for (size_t i = 0; i < written; i++)
+            {
+                free(undo[i].data);
+            }
+        }
+        esp_err_t commit_err = nvs_commit(nvs);  // un singur commit pentru tot lotul (sau pentru rollback)
+        if (err == ESP_OK)
+        {
+            err = commit_err;
+        }
+        nvs_close(nvs);
+        nvs_index_invalidate();
+    }
+    free(undo);
+    free(buf);
+
+    if (err == ESP_OK && count != NULL)
+    {
+        *count = n;
+    }
+    return err;
+}
+
+// -------------------------------------------------
+
+static int index_cmp(const void *a, const void *b) {
+    const nvs_index_entry_t *x = (const nvs_index_entry_t *) a;
+    const nvs_index_entry_t *y = (const nvs_index_entry_t *) b;
+    int                      c = strcmp(x->ns, y->ns);
+    return c != 0 ? c : strcmp(x->key, y->key);
+}
+
+static esp_err_t index_build(const char *part) {
+    s_index_cnt = 0;
+
+    nvs_iterator_t it  = NULL;
+    esp_err_t      err = nvs_entry_find(part, NULL, NVS_TYPE_ANY, &it);
+    while (err == ESP_OK)
+    {
+        if (s_index_cnt == s_index_cap)
+        {
+            size_t             cap    = s_index_cap ? s_index_cap * 2 : 64;
+            nvs_index_entry_t *bigger = realloc(s_index, cap * sizeof(nvs_index_entry_t));
+            if (bigger == NULL)
+            {
+                nvs_release_iterator(it);
+                return ESP_ERR_NO_MEM;
+            }
+            s_index     = bigger;
+            s_index_cap = cap;
+        }
+        nvs_entry_info_t info;
+        nvs_entry_info(it, &info);
+        nvs_index_entry_t *e = &s_index[s_index_cnt++];
+        strlcpy(e->ns, info.namespace_name, sizeof(e->ns));
+        strlcpy(e->key, info.key, sizeof(e->key));
+        e->type = info.type;
+        err     = nvs_entry_next(&it);
+    }
+    nvs_release_iterator(it);
+    if (err != ESP_ERR_NVS_NOT_FOUND)
+    {
+        return err;
+    }
+
+    qsort(s_index, s_index_cnt, sizeof(nvs_index_entry_t), index_cmp);
+    strlcpy(s_index_part, part, sizeof(s_index_part));
+    s_index_valid = true;
+    return ESP_OK;
+}
+
+esp_err_t nvs_index_get(const char *part, const nvs_index_entry_t **entries, size_t *count) {
+    if (part == NULL || entries == NULL || count == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_index_valid || strcmp(s_index_part, part) != 0)
+    {
+        esp_err_t err = index_build(part);
+        if (err != ESP_OK)
+        {
+            s_index_valid = false;
+            return err;
+        }
+    }
+    *entries = s_index;
+    *count   = s_index_cnt;
+    return ESP_OK;
+}
+
+size_t nvs_index_lower_bound(const nvs_index_entry_t *entries, size_t count, const char *ns) {
+    size_t lo = 0;
+    size_t hi = count;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (strcmp(entries[mid].ns, ns) < 0)
+        {
+            lo = mid + 1;
+        } else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+void nvs_index_invalidate(void) {
+    s_index_valid = false;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#ifndef NVS_BULK_H_
+#define NVS_BULK_H_
+
+#include <stddef.h>
+#include <stdio.h>
+#include "esp_err.h"
+#include "nvs.h"
+
+/**
+ * Export / import in bloc al unui namespace NVS si un index in RAM pentru `nvs_list`.
+ *
+ * Fisierul de export e binar, little-endian:
+ *   "NVSB" | versiune u8 | len u8 + namespace | nr. intrari u16
+ *   per intrare: tip u8 (nvs_type_t) | len u8 + cheie | [len u32 la str/blob] | valoare
+ *   CRC32 (esp_rom_crc32_le) peste tot ce e inainte
+ * Intregii au latimea tipului, sirurile sunt fara '\0'.
+ */
+
+#define NVS_BULK_MAGIC   "NVSB"
+#define NVS_BULK_VERSION (1)
+#define NVS_BULK_STR_MAX (4000)  // lungimea maxima a unui sir NVS, cu tot cu '\0'
+
+typedef struct {
+    char       ns[NVS_NS_NAME_MAX_SIZE];
+    char       key[NVS_KEY_NAME_MAX_SIZE];
+    nvs_type_t type;
+} nvs_index_entry_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* #ifdef __cplusplus */
+
+    // scrie toate cheile din `ns` in `out`; `count` poate fi NULL
+    esp_err_t nvs_bulk_export(const char *part, const char *ns, FILE *out, size_t *count);
+    // valideaza tot fisierul (format, siruri, loc liber), apoi scrie toate cheile cu un singur handle
+    // si un singur nvs_commit(); o scriere esuata pune la loc cheile deja scrise; `ns` NULL = namespace-ul din fisier
+    esp_err_t nvs_bulk_import(const char *part, const char *ns, FILE *in, size_t *count);
+
+    // index sortat (namespace, cheie) al partitiei; se reconstruieste doar dupa nvs_index_invalidate()
+    esp_err_t nvs_index_get(const char *part, const nvs_index_entry_t **entries, size_t *count);
+    // primul element din namespace-ul `ns` (cautare binara) sau `count` daca nu exista
+    size_t nvs_index_lower_bound(const nvs_index_entry_t *entries, size_t count, const char *ns);
+    void nvs_index_invalidate(void);
+
+#ifdef __cplusplus
+}
+#endif /* #ifdef __cplusplus */
+#endif /* #ifndef NVS_BULK_H_ */
@@ -20,6 +20,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include "nvs_cmd.h"
+#include "nvs_bulk.h"
+#include "config.h"
 
 static const char *TAG = "CLI";
 
@@ -78,9 +80,17 @@ static struct {
     struct arg_str* partition;
     struct arg_str* namespace;
     struct arg_str* type;
+    struct arg_str* prefix;
     struct arg_end* end;
 } list_args;
 
+static struct {
+    struct arg_str* file;
+    struct arg_str* namespace;
+    struct arg_str* partition;
+    struct arg_end* end;
+} bulk_args;
+
 static nvs_type_t str_to_type(const char* type) {
     for (int i = 0; i < TYPE_STR_PAIR_SIZE; i++) {
         const type_str_pair_t* p = &type_str_pair[i];
@@ -141,12 +151,7 @@ static esp_err_t store_blob(nvs_handle_t nvs, const char* key, const char* str_v
 
     esp_err_t err = nvs_set_blob(nvs, key, blob, blob_len);
     free(blob);
-
-    if (err == ESP_OK) {
-        err = nvs_commit(nvs);
-    }
-
-    return err;
+    return err;  // commit-ul il face set_value_in_nvs()
 }
 
 static void print_blob(const char* blob, size_t len) {
@@ -240,6 +245,7 @@ static esp_err_t set_value_in_nvs(const char* key, const char* str_type, const c
     }
 
     nvs_close(nvs);
+    nvs_index_invalidate();
     return err;
 }
 
@@ -339,6 +345,7 @@ static esp_err_t erase(const char* key) {
             }
         }
         nvs_close(nvs);
+        nvs_index_invalidate();
     }
 
     return err;
@@ -358,41 +365,52 @@ static esp_err_t erase_all(const char* name) {
     ESP_LOGI(TAG, "Namespace '%s' was %s erased", name, (err == ESP_OK) ? "" : "not");
 
     nvs_close(nvs);
+    nvs_index_invalidate();
     return ESP_OK;
 }
 
-static int list(const char* part, const char* name, const char* str_type) {
+/* Filtrele se aplica pe indexul din RAM; flash-ul se parcurge doar dupa o modificare */
+static int list(const char* part, const char* name, const char* str_type, const char* prefix) {
     nvs_type_t type = str_to_type(str_type);
 
-    nvs_iterator_t it = NULL;
-    esp_err_t result = nvs_entry_find(part, NULL, type, &it);
-    if (result == ESP_ERR_NVS_NOT_FOUND) {
-        ESP_LOGE(TAG, "No such entry was found");
-        return 1;
-    }
-
+    const nvs_index_entry_t* entries;
+    size_t count;
+    esp_err_t result = nvs_index_get(part, &entries, &count);
     if (result != ESP_OK) {
         ESP_LOGE(TAG, "NVS error: %s", esp_err_to_name(result));
         return 1;
     }
 
-    do {
-        nvs_entry_info_t info;
-        nvs_entry_info(it, &info);
-        result = nvs_entry_next(&it);
-
-        printf("namespace '%s', key '%s', type '%s' \n", info.namespace_name, info.key,
-            type_to_str(info.type));
-    } while (result == ESP_OK);
+    size_t first = name[0] != '\0' ? nvs_index_lower_bound(entries, count, name) : 0;
+    size_t prefix_len = strlen(prefix);
+    size_t shown = 0;
+    for (size_t i = first; i < count; i++) {
+        const nvs_index_entry_t* e = &entries[i];
+        if (name[0] != '\0' && strcmp(e->ns, name) != 0) {
+            break;  // indexul e sortat dupa namespace
+        }
+        if ((type != NVS_TYPE_ANY && e->type != type) || strncmp(e->key, prefix, prefix_len) != 0) {
+            continue;
+        }
+        if (shown++ == 0) {
+            printf("%-16s %-16s %s\n", "namespace", "key", "type");
+        }
+        printf("%-16s %-16s %s\n", e->ns, e->key, type_to_str(e->type));
+    }
 
-    if (result != ESP_ERR_NVS_NOT_FOUND) { // the last iteration ran into an internal error
-        ESP_LOGE(TAG, "NVS error %s at current iteration, stopping.", esp_err_to_name(result));
+    if (shown == 0) {
+        ESP_LOGE(TAG, "No such entry was found");
         return 1;
     }
-
+    printf("%u of %u entries\n", (unsigned)shown, (unsigned)count);
     return 0;
 }
 
+/* Caile relative sunt fata de sistemul de fisiere al consolei */
+static void resolve_path(char* path, size_t size, const char* file) {
+    snprintf(path, size, "%s%s", file[0] == '/' ? "" : MOUNT_PATH "/", file);
+}
+
 static int set_value(int argc, char** argv) {
     int nerrors = arg_parse(argc, argv, (void**)&set_args);
     if (nerrors != 0) {
@@ -485,9 +503,10 @@ static int set_namespace(int argc, char** argv) {
 }
 
 static int list_entries(int argc, char** argv) {
-    list_args.partition->sval[0] = "";
+    list_args.partition->sval[0] = NVS_DEFAULT_PART_NAME;
     list_args.namespace->sval[0] = "";
     list_args.type->sval[0] = "";
+    list_args.prefix->sval[0] = "";
 
     int nerrors = arg_parse(argc, argv, (void**)&list_args);
     if (nerrors != 0) {
@@ -498,8 +517,71 @@ static int list_entries(int argc, char** argv) {
     const char* part = list_args.partition->sval[0];
     const char* name = list_args.namespace->sval[0];
     const char* type = list_args.type->sval[0];
+    const char* prefix = list_args.prefix->sval[0];
+
+    return list(part, name, type, prefix);
+}
+
+static int parse_bulk_args(int argc, char** argv, char* path, size_t size) {
+    bulk_args.namespace->sval[0] = current_namespace;
+    bulk_args.partition->sval[0] = NVS_DEFAULT_PART_NAME;
+
+    int nerrors = arg_parse(argc, argv, (void**)&bulk_args);
+    if (nerrors != 0) {
+        arg_print_errors(stderr, bulk_args.end, argv[0]);
+        return 1;
+    }
+    resolve_path(path, size, bulk_args.file->sval[0]);
+    return 0;
+}
+
+static int export_namespace(int argc, char** argv) {
+    char path[96];
+    if (parse_bulk_args(argc, argv, path, sizeof(path)) != 0) {
+        return 1;
+    }
+
+    FILE* f = fopen(path, "wb");
+    if (f == NULL) {
+        ESP_LOGE(TAG, "Cannot create %s", path);
+        return 1;
+    }
+    size_t count = 0;
+    esp_err_t err = nvs_bulk_export(bulk_args.partition->sval[0], bulk_args.namespace->sval[0], f, &count);
+    fclose(f);
 
-    return list(part, name, type);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "%s", esp_err_to_name(err));
+        remove(path);
+        return 1;
+    }
+    printf("%u keys from '%s' exported to %s\n", (unsigned)count, bulk_args.namespace->sval[0], path);
+    return 0;
+}
+
+static int import_namespace(int argc, char** argv) {
+    char path[96];
+    if (parse_bulk_args(argc, argv, path, sizeof(path)) != 0) {
+        return 1;
+    }
+
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+        ESP_LOGE(TAG, "Cannot open %s", path);
+        return 1;
+    }
+    /* Fara -n se foloseste namespace-ul salvat in fisier */
+    const char* ns = bulk_args.namespace->count > 0 ? bulk_args.namespace->sval[0] : NULL;
+    size_t count = 0;
+    esp_err_t err = nvs_bulk_import(bulk_args.partition->sval[0], ns, f, &count);
+    fclose(f);
+
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "%s", esp_err_to_name(err));
+        return 1;
+    }
+    printf("%u keys imported from %s\n", (unsigned)count, path);
+    return 0;
 }
 
 void register_nvs(void) {
@@ -523,11 +605,17 @@ void register_nvs(void) {
         arg_str1(NULL, NULL, "<namespace>", "namespace of the partition to be selected");
     namespace_args.end = arg_end(2);
 
-    list_args.partition = arg_str1(NULL, NULL, "<partition>", "partition name");
+    list_args.partition = arg_str0(NULL, NULL, "<partition>", "partition name (default " NVS_DEFAULT_PART_NAME ")");
     list_args.namespace = arg_str0("n", "namespace", "<namespace>", "namespace name");
     list_args.type = arg_str0("t", "type", "<type>", ARG_TYPE_STR);
+    list_args.prefix = arg_str0("k", "key", "<prefix>", "only keys starting with <prefix>");
     list_args.end = arg_end(2);
 
+    bulk_args.file = arg_str1(NULL, NULL, "<file>", "file on " MOUNT_PATH " (or absolute path)");
+    bulk_args.namespace = arg_str0("n", "namespace", "<namespace>", "namespace (default: current / from file)");
+    bulk_args.partition = arg_str0("p", "partition", "<partition>", "partition name (default " NVS_DEFAULT_PART_NAME ")");
+    bulk_args.end = arg_end(2);
+
     const esp_console_cmd_t set_cmd = {.command = "nvs_set",
         .help = "Set key-value pair in selected namespace.\n"
                 "Examples:\n"
@@ -568,20 +656,38 @@ void register_nvs(void) {
                 "Namespace and type can be specified to print only those key-value pairs.\n"
                 "Following command list variables stored inside 'nvs' partition, under namespace "
                 "'storage' with type uint32_t"
-                "Example: nvs_list nvs -n storage -t u32 \n",
+                "Example: nvs_list nvs -n storage -t u32 \n"
+                "         nvs_list -n storage -k wifi_ \n",
         .hint = NULL,
         .func = &list_entries,
         .argtable = &list_args};
 
+    const esp_console_cmd_t export_cmd = {.command = "nvs_export",
+        .help = "Save all keys of a namespace to a binary file.\n"
+                "Example: nvs_export storage.nvs -n storage",
+        .hint = NULL,
+        .func = &export_namespace,
+        .argtable = &bulk_args};
+
+    const esp_console_cmd_t import_cmd = {.command = "nvs_import",
+        .help = "Write all keys from a file made by nvs_export, with a single commit.\n"
+                "The file is checked (CRC) before anything is written.\n"
+                "Example: nvs_import storage.nvs",
+        .hint = NULL,
+        .func = &import_namespace,
+        .argtable = &bulk_args};
+
     ESP_ERROR_CHECK(esp_console_cmd_register(&set_cmd));
     ESP_ERROR_CHECK(esp_console_cmd_register(&get_cmd));
     ESP_ERROR_CHECK(esp_console_cmd_register(&erase_cmd));
     ESP_ERROR_CHECK(esp_console_cmd_register(&namespace_cmd));
     ESP_ERROR_CHECK(esp_console_cmd_register(&list_entries_cmd));
     ESP_ERROR_CHECK(esp_console_cmd_register(&erase_namespace_cmd));
+    ESP_ERROR_CHECK(esp_console_cmd_register(&export_cmd));
+    ESP_ERROR_CHECK(esp_console_cmd_register(&import_cmd));
     ESP_LOGI(TAG, "nvs commands registered!");
 }
 
 void cli_register_nsv_command(void) {
-    register_nvs();
+    register_nvs();  // NVS e initializat o singura data in app_main()
 }
\ No newline at end of file
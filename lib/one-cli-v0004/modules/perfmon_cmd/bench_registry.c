@@ -0,0 +1,242 @@
+#include "bench_registry.h"
+
+#include <string.h>
+#include <time.h>
+
+#if defined(__XTENSA__)
+#include "esp_timer.h"
+#include "perfmon.h"
+#elif defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static const bench_kernel_t *s_kernels[BENCH_MAX_KERNELS];
+static size_t                s_kernel_cnt = 0;
+
+// -------------------------------------------------
+
+esp_err_t bench_register(const bench_kernel_t *kernel) {
+    if (kernel == NULL || kernel->name == NULL || kernel->run == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (bench_find(kernel->name) != NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (s_kernel_cnt == BENCH_MAX_KERNELS)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    s_kernels[s_kernel_cnt++] = kernel;
+    return ESP_OK;
+}
+
+size_t bench_count(void) {
+    return s_kernel_cnt;
+}
+
+const bench_kernel_t *bench_get(size_t index) {
+    return index < s_kernel_cnt ? s_kernels[index] : NULL;
+}
+
+const bench_kernel_t *bench_find(const char *name) {
+    for (size_t i = 0; i < s_kernel_cnt; i++)
+    {
+        if (strcmp(s_kernels[i]->name, name) == 0)
+        {
+            return s_kernels[i];
+        }
+    }
+    return NULL;
+}
+
+// -------------------------------------------------
+
+static uint64_t now_ns(void) {
+#if defined(__XTENSA__)
+    return (uint64_t) esp_timer_get_time() * 1000ULL;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+#endif
+}
+
+static uint32_t time_per_call(const bench_kernel_t *kernel, void *ctx, uint32_t repeat) {
+    uint64_t start = now_ns();
+    for (uint32_t i = 0; i < repeat; i++)
+    {
+        kernel->run(ctx);
+    }
+    return (uint32_t) ((now_ns() - start) / repeat);
+}
+
+#if defined(__XTENSA__)
+
+/* Aceleasi contoare ca tabelul folosit inainte de `perfmon`, in ordinea din bench_result_t */
+static const uint32_t s_select_mask[] = {
+    XTPERF_CNT_CYCLES,
+    XTPERF_MASK_CYCLES,
+    XTPERF_CNT_INSN,
+    XTPERF_MASK_INSN_ALL,
+    XTPERF_CNT_D_LOAD_U1,
+    XTPERF_MASK_D_LOAD_LOCAL_MEM,
+    XTPERF_CNT_D_STORE_U1,
+    XTPERF_MASK_D_STORE_LOCAL_MEM,
+    XTPERF_CNT_BUBBLES,
+    XTPERF_MASK_BUBBLES_ALL & (~XTPERF_MASK_BUBBLES_R_HOLD_REG_DEP),
+    XTPERF_CNT_BUBBLES,
+    XTPERF_MASK_BUBBLES_R_HOLD_REG_DEP,
+};
+
+typedef struct {
+    const bench_kernel_t *kernel;
+    void                 *ctx;
+    bench_result_t       *result;
+    size_t                counter;
+} perfmon_call_t;
+
+static void perfmon_call(void *params) {
+    perfmon_call_t *call = (perfmon_call_t *) params;
+    call->kernel->run(call->ctx);
+}
+
+/* xtensa_perfmon_exec() da valoarea medie per apel, cate un callback per contor, in ordinea tabelului */
+static void perfmon_collect(void *params, uint32_t select, uint32_t mask, uint32_t value) {
+    perfmon_call_t *call  = (perfmon_call_t *) params;
+    uint32_t       *dst[] = {
+        &call->result->cycles,
+        &call->result->insn,
+        &call->result->loads,
+        &call->result->stores,
+        &call->result->bubbles,
+        &call->result->bubbles_dep,
+    };
+    if (call->counter < sizeof(dst) / sizeof(dst[0]))
+    {
+        *dst[call->counter++] = value;
+    }
+}
+
+static void measure_counters(const bench_kernel_t *kernel, void *ctx, uint32_t repeat, bench_result_t *result) {
+    perfmon_call_t call = {
+        .kernel = kernel,
+        .ctx    = ctx,
+        .result = result,
+    };
+    xtensa_perfmon_config_t pm_config = {};
+    pm_config.counters_size           = sizeof(s_select_mask) / sizeof(uint32_t) / 2;
+    pm_config.select_mask             = s_select_mask;
+    pm_config.repeat_count            = (int) repeat;
+    pm_config.max_deviation           = 1;
+    pm_config.call_params             = &call;
+    pm_config.call_function           = perfmon_call;
+    pm_config.callback                = perfmon_collect;
+    pm_config.callback_params         = &call;
+    pm_config.tracelevel              = -1;
+    if (xtensa_perfmon_exec(&pm_config) == ESP_OK && call.counter == 6)
+    {
+        result->valid |= BENCH_HAS_CYCLES | BENCH_HAS_INSN | BENCH_HAS_LOADS | BENCH_HAS_STORES | BENCH_HAS_BUBBLES |
+                         BENCH_HAS_BUBBLES_DEP;
+    }
+}
+
+#elif defined(__linux__)
+
+/* Pe PC: contoarele hardware prin perf_event_open(); ce nu exista (VM, container) ramane nevalid.
+ * Asteptarile pe dependente de registru n-au echivalent, deci BENCH_HAS_BUBBLES_DEP lipseste mereu. */
+static int perf_open(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.type           = type;
+    attr.config         = config;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    return (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+#define PERF_L1D(op) \
+    (PERF_COUNT_HW_CACHE_L1D | ((uint64_t) (op) << 8) | ((uint64_t) PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16))
+
+static void measure_counters(const bench_kernel_t *kernel, void *ctx, uint32_t repeat, bench_result_t *result) {
+    const struct {
+        uint32_t  type;
+        uint64_t  config;
+        uint32_t  flag;
+        uint32_t *dst;
+    } events[] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, BENCH_HAS_CYCLES, &result->cycles},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, BENCH_HAS_INSN, &result->insn},
+        {PERF_TYPE_HW_CACHE, PERF_L1D(PERF_COUNT_HW_CACHE_OP_READ), BENCH_HAS_LOADS, &result->loads},
+        {PERF_TYPE_HW_CACHE, PERF_L1D(PERF_COUNT_HW_CACHE_OP_WRITE), BENCH_HAS_STORES, &result->stores},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND, BENCH_HAS_BUBBLES, &result->bubbles},
+    };
+
+    for (size_t e = 0; e < sizeof(events) / sizeof(events[0]); e++)
+    {
+        int fd = perf_open(events[e].type, events[e].config);
+        if (fd < 0)
+        {
+            continue;
+        }
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        for (uint32_t i = 0; i < repeat; i++)
+        {
+            kernel->run(ctx);
+        }
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t value = 0;
+        if (read(fd, &value, sizeof(value)) == sizeof(value))
+        {
+            *events[e].dst = (uint32_t) (value / repeat);
+            result->valid |= events[e].flag;
+        }
+        close(fd);
+    }
+}
+
+#else
+
+static void measure_counters(const bench_kernel_t *kernel, void *ctx, uint32_t repeat, bench_result_t *result) {
+    (void) kernel;
+    (void) ctx;
+    (void) repeat;
+    (void) result;  // doar timpul
+}
+
+#endif
+
+esp_err_t bench_run(const bench_kernel_t *kernel, size_t size, uint32_t repeat, bench_result_t *result) {
+    if (kernel == NULL || result == NULL || repeat == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(result, 0, sizeof(*result));
+
+    void *ctx = NULL;
+    if (kernel->setup != NULL)
+    {
+        ctx = kernel->setup(size);
+        if (ctx == NULL)
+        {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    kernel->run(ctx);  // incalzire: cache, alocari lenese
+    result->ns = time_per_call(kernel, ctx, repeat);
+    measure_counters(kernel, ctx, repeat, result);
+
+    if (kernel->teardown != NULL)
+    {
+        kernel->teardown(ctx);
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#ifndef BENCH_REGISTRY_H_
+#define BENCH_REGISTRY_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+/**
+ * Registru de micro-benchmark-uri pentru `perfmon run`.
+ * Orice modul inregistreaza un kernel cu setup/teardown si dimensiunile de intrare;
+ * masurarea se face doar pe `run`. Pe Xtensa se folosesc contoarele perfmon,
+ * pe Linux perf_event_open() (cu clock_gettime() ca rezerva).
+ */
+
+#define BENCH_MAX_KERNELS   (24)
+#define BENCH_MAX_SIZES     (4)
+#define BENCH_DEFAULT_REPEAT (200)
+
+typedef struct {
+    const char *name;
+    const char *description;
+    void *(*setup)(size_t size);  // intoarce contextul pentru run(); NULL = eroare. Poate lipsi.
+    void (*run)(void *ctx);       // un apel masurat
+    void (*teardown)(void *ctx);  // poate lipsi
+    size_t sizes[BENCH_MAX_SIZES];  // dimensiuni de intrare, 0 = sfarsit; toate 0 = un singur rand
+} bench_kernel_t;
+
+/* Bit-ii din `valid` spun ce contoare a putut citi backend-ul */
+#define BENCH_HAS_CYCLES      (1U << 0)
+#define BENCH_HAS_INSN        (1U << 1)
+#define BENCH_HAS_LOADS       (1U << 2)
+#define BENCH_HAS_STORES      (1U << 3)
+#define BENCH_HAS_BUBBLES     (1U << 4)
+#define BENCH_HAS_BUBBLES_DEP (1U << 5)
+
+typedef struct {
+    uint32_t valid;
+    uint32_t ns;            // timp per apel
+    uint32_t cycles;        // toate valorile sunt per apel
+    uint32_t insn;
+    uint32_t loads;
+    uint32_t stores;
+    uint32_t bubbles;       // asteptari, fara dependente de registru
+    uint32_t bubbles_dep;   // asteptari pe dependente de registru
+} bench_result_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* #ifdef __cplusplus */
+
+    // `kernel` trebuie sa fie static (se pastreaza pointerul)
+    esp_err_t bench_register(const bench_kernel_t *kernel);
+    size_t bench_count(void);
+    const bench_kernel_t *bench_get(size_t index);
+    const bench_kernel_t *bench_find(const char *name);
+    esp_err_t bench_run(const bench_kernel_t *kernel, size_t size, uint32_t repeat, bench_result_t *result);
+
+#ifdef __cplusplus
+}
+#endif /* #ifdef __cplusplus */
+#endif /* #ifndef BENCH_REGISTRY_H_ */
@@ -1,14 +1,17 @@
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
+#include <inttypes.h>
 #include <unistd.h>
 #include "esp_timer.h"
 #include "esp_console.h"
 #include "esp_log.h"
 #include "esp_sleep.h"
 #include "sdkconfig.h"
-#include "perfmon.h"
 
+#include "config.h"
+#include "bench_registry.h"
 #include "perfmon_cmd.h"
 
 static const char* TAG = "CLI";
@@ -27,66 +30,189 @@ static void exec_test_function(void* params) {
     }
 }
 
-// Table with dedicated performance counters
-static uint32_t pm_check_table[] = {
-    XTPERF_CNT_CYCLES,
-    XTPERF_MASK_CYCLES, // total cycles
-    XTPERF_CNT_INSN,
-    XTPERF_MASK_INSN_ALL, // total instructions
-    XTPERF_CNT_D_LOAD_U1,
-    XTPERF_MASK_D_LOAD_LOCAL_MEM, // Mem read
-    XTPERF_CNT_D_STORE_U1,
-    XTPERF_MASK_D_STORE_LOCAL_MEM, // Mem write
-    XTPERF_CNT_BUBBLES,
-    XTPERF_MASK_BUBBLES_ALL & (~XTPERF_MASK_BUBBLES_R_HOLD_REG_DEP), // wait for other reasons
-    XTPERF_CNT_BUBBLES,
-    XTPERF_MASK_BUBBLES_R_HOLD_REG_DEP, // Wait for register dependency
-    XTPERF_CNT_OVERFLOW,
-    XTPERF_MASK_OVERFLOW, // Last test cycle
+static const bench_kernel_t s_loop_kernel = {
+    .name        = "loop100",
+    .description = "100 x (sum += i * 3), volatile",
+    .run         = exec_test_function,
 };
 
-#define TOTAL_CALL_AMOUNT 200 //
-#define PERFMON_TRACELEVEL -1 // -1 - will ignore trace level
-
-bool app_main_perfmon(void) {
-    ESP_LOGI(TAG, "Start");
-    ESP_LOGI(TAG, "Start test with printing all available statistic");
-    xtensa_perfmon_config_t pm_config = {};
-    pm_config.counters_size   = sizeof(xtensa_perfmon_select_mask_all) / sizeof(uint32_t) / 2;
-    pm_config.select_mask     = xtensa_perfmon_select_mask_all;
-    pm_config.repeat_count    = TOTAL_CALL_AMOUNT;
-    pm_config.max_deviation   = 1;
-    pm_config.call_function   = exec_test_function;
-    pm_config.callback        = xtensa_perfmon_view_cb;
-    pm_config.callback_params = stdout;
-    pm_config.tracelevel      = PERFMON_TRACELEVEL;
-    xtensa_perfmon_exec(&pm_config);
-
-    ESP_LOGI(TAG, "Start test with user defined statistic");
-    pm_config.counters_size   = sizeof(pm_check_table) / sizeof(uint32_t) / 2;
-    pm_config.select_mask     = pm_check_table;
-    pm_config.repeat_count    = TOTAL_CALL_AMOUNT;
-    pm_config.max_deviation   = 1;
-    pm_config.call_function   = exec_test_function;
-    pm_config.callback        = xtensa_perfmon_view_cb;
-    pm_config.callback_params = stdout;
-    pm_config.tracelevel      = PERFMON_TRACELEVEL;
-
-    xtensa_perfmon_exec(&pm_config);
-
-    ESP_LOGI(TAG, "The End");
-    return 1;
+// -------------------------------------------------
+
+typedef struct {
+    FILE*  f;
+    char*  buf;
+    size_t size;
+} fs_read_ctx_t;
+
+#define FS_READ_PATH MOUNT_PATH "/perfmon.bin"
+
+static void* fs_read_setup(size_t size) {
+    fs_read_ctx_t* ctx = calloc(1, sizeof(fs_read_ctx_t));
+    if (ctx == NULL)
+    {
+        return NULL;
+    }
+    ctx->size = size;
+    ctx->buf  = malloc(size);
+    FILE* f   = fopen(FS_READ_PATH, "wb");
+    if (ctx->buf == NULL || f == NULL || fwrite(ctx->buf, 1, size, f) != size)
+    {
+        if (f != NULL)
+        {
+            fclose(f);
+        }
+        free(ctx->buf);
+        free(ctx);
+        return NULL;
+    }
+    fclose(f);
+    ctx->f = fopen(FS_READ_PATH, "rb");
+    if (ctx->f == NULL)
+    {
+        free(ctx->buf);
+        free(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+static void fs_read_run(void* params) {
+    fs_read_ctx_t* ctx = (fs_read_ctx_t*) params;
+    fseek(ctx->f, 0, SEEK_SET);
+    fread(ctx->buf, 1, ctx->size, ctx->f);
+}
+
+static void fs_read_teardown(void* params) {
+    fs_read_ctx_t* ctx = (fs_read_ctx_t*) params;
+    fclose(ctx->f);
+    remove(FS_READ_PATH);
+    free(ctx->buf);
+    free(ctx);
+}
+
+static const bench_kernel_t s_fs_read_kernel = {
+    .name        = "fs_read",
+    .description = "fread() of a file on " MOUNT_PATH,
+    .setup       = fs_read_setup,
+    .run         = fs_read_run,
+    .teardown    = fs_read_teardown,
+    .sizes       = {512, 4096, 32768},
+};
+
+// -------------------------------------------------
+
+static void print_value(uint32_t valid, uint32_t flag, uint32_t value) {
+    if (valid & flag)
+    {
+        printf(" %10" PRIu32, value);
+    } else
+    {
+        printf(" %10s", "-");
+    }
+}
+
+static void print_header(void) {
+    printf("%-20s %7s %10s %10s %10s %5s %10s %10s %10s %10s\n", "kernel", "size", "ns/call", "cycles", "insn", "IPC",
+        "loads", "stores", "bubbles", "reg dep");
+}
+
+static bool run_kernel(const bench_kernel_t* kernel, uint32_t repeat) {
+    size_t sizes_cnt = 0;
+    while (sizes_cnt < BENCH_MAX_SIZES && kernel->sizes[sizes_cnt] != 0)
+    {
+        sizes_cnt++;
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < (sizes_cnt > 0 ? sizes_cnt : 1); i++)
+    {
+        size_t         size = sizes_cnt > 0 ? kernel->sizes[i] : 0;
+        bench_result_t r;
+        esp_err_t      err = bench_run(kernel, size, repeat, &r);
+        if (err != ESP_OK)
+        {
+            printf("%-20s %7u setup failed: %s\n", kernel->name, (unsigned) size, esp_err_to_name(err));
+            ok = false;
+            continue;
+        }
+        printf("%-20s %7u %10" PRIu32, kernel->name, (unsigned) size, r.ns);
+        print_value(r.valid, BENCH_HAS_CYCLES, r.cycles);
+        print_value(r.valid, BENCH_HAS_INSN, r.insn);
+        if ((r.valid & (BENCH_HAS_CYCLES | BENCH_HAS_INSN)) == (BENCH_HAS_CYCLES | BENCH_HAS_INSN) && r.cycles > 0)
+        {
+            printf(" %5.2f", (double) r.insn / (double) r.cycles);
+        } else
+        {
+            printf(" %5s", "-");
+        }
+        print_value(r.valid, BENCH_HAS_LOADS, r.loads);
+        print_value(r.valid, BENCH_HAS_STORES, r.stores);
+        print_value(r.valid, BENCH_HAS_BUBBLES, r.bubbles);
+        print_value(r.valid, BENCH_HAS_BUBBLES_DEP, r.bubbles_dep);
+        printf("\n");
+    }
+    return ok;
+}
+
+static void print_kernel_list(void) {
+    printf("Usage: perfmon run <name|all> [repeat]   (repeat default %d)\n", BENCH_DEFAULT_REPEAT);
+    printf("%-20s %-24s %s\n", "kernel", "sizes", "description");
+    for (size_t i = 0; i < bench_count(); i++)
+    {
+        const bench_kernel_t* k = bench_get(i);
+        char                  sizes[32] = "-";
+        size_t                pos       = 0;
+        for (size_t j = 0; j < BENCH_MAX_SIZES && k->sizes[j] != 0; j++)
+        {
+            pos += snprintf(sizes + pos, sizeof(sizes) - pos, "%s%u", j ? "," : "", (unsigned) k->sizes[j]);
+        }
+        printf("%-20s %-24s %s\n", k->name, sizes, k->description ? k->description : "");
+    }
 }
 
 static int perfmon_command(int argc, char** argv) {
-    app_main_perfmon();
-    return 0;
+    if (argc < 3 || strcmp(argv[1], "run") != 0)
+    {
+        print_kernel_list();
+        return argc == 1 || (argc == 2 && strcmp(argv[1], "list") == 0) ? 0 : 1;
+    }
+
+    uint32_t repeat = BENCH_DEFAULT_REPEAT;
+    if (argc > 3)
+    {
+        repeat = (uint32_t) strtoul(argv[3], NULL, 10);
+        if (repeat == 0)
+        {
+            printf("Invalid repeat count '%s'\n", argv[3]);
+            return 1;
+        }
+    }
+
+    bool all = strcmp(argv[2], "all") == 0;
+    const bench_kernel_t* kernel = all ? NULL : bench_find(argv[2]);
+    if (!all && kernel == NULL)
+    {
+        printf("Unknown kernel '%s'\n", argv[2]);
+        print_kernel_list();
+        return 1;
+    }
+
+    print_header();
+    bool ok = true;
+    for (size_t i = 0; i < bench_count(); i++)
+    {
+        if (all || bench_get(i) == kernel)
+        {
+            ok &= run_kernel(bench_get(i), repeat);
+        }
+    }
+    return ok ? 0 : 1;
 }
 
 static void register_perfmon(void) {
     const esp_console_cmd_t cmd = {
         .command = "perfmon",
-        .help    = "Performance Monitor",
+        .help    = "Performance Monitor: 'perfmon list', 'perfmon run <name|all> [repeat]'",
         .hint    = NULL,
         .func    = &perfmon_command,
     };
@@ -95,5 +221,7 @@ static void register_perfmon(void) {
 }
 
 void cli_register_perfmon_command(void) {
+    bench_register(&s_loop_kernel);
+    bench_register(&s_fs_read_kernel);
     register_perfmon();
 }
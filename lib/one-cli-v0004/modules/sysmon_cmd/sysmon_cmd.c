@@ -0,0 +1,121 @@
+#include "sysmon_cmd.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_console.h"
+#include "esp_log.h"
+
+#include "sysmon.h"
+
+static const char* TAG = "CLI";
+
+static const char* const s_heap_labels[SYSMON_HEAP_COUNT] = {"internal", "dma", "psram"};
+
+static void print_summary(void) {
+    sysmon_stats_t stats;
+    sysmon_get_stats(&stats);
+    if (stats.samples == 0)
+    {
+        printf("sysmon: no samples yet\n");
+        return;
+    }
+
+    if (stats.cpu_load)
+    {
+        printf("CPU load: core0 %" PRIu32 ".%" PRIu32 "%%, core1 %" PRIu32 ".%" PRIu32 "%%\n",
+            sysmon_get_last(SYSMON_SERIES_CPU0) / 10, sysmon_get_last(SYSMON_SERIES_CPU0) % 10,
+            sysmon_get_last(SYSMON_SERIES_CPU1) / 10, sysmon_get_last(SYSMON_SERIES_CPU1) % 10);
+    } else
+    {
+        printf("CPU load: n/a (CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS is off)\n");
+    }
+    printf("%-10s %12s %12s %12s\n", "heap", "free", "largest", "min ever");
+    for (int h = 0; h < SYSMON_HEAP_COUNT; h++)
+    {
+        printf("%-10s %12" PRIu32 " %12" PRIu32 " %12" PRIu32 "\n", s_heap_labels[h],
+            sysmon_get_last((sysmon_series_t) (SYSMON_SERIES_FREE_INTERNAL + h)),
+            sysmon_get_last((sysmon_series_t) (SYSMON_SERIES_LARGEST_INTERNAL + h)), stats.min_free_ever[h]);
+    }
+    printf("Smallest stack left: %" PRIu32 " bytes\n", sysmon_get_last(SYSMON_SERIES_STACK_MIN));
+    printf("Samples %" PRIu32 ", alarms %" PRIu32 ", overhead %" PRIu32 " ppm (max sample %" PRIu32 " us, detailed scan every %" PRIu32
+           ")\n",
+        stats.samples, stats.alarms, stats.overhead_ppm, stats.sample_us_max, stats.scan_every);
+}
+
+static void print_tasks(void) {
+    static sysmon_task_t tasks[SYSMON_MAX_TASKS];
+    size_t               n = sysmon_get_tasks(tasks, SYSMON_MAX_TASKS);
+    printf("%-16s %10s %5s\n", "task", "stack left", "core");
+    for (size_t i = 0; i < n; i++)
+    {
+        char core[4] = "any";
+        if (tasks[i].core < 2)
+        {
+            snprintf(core, sizeof(core), "%u", tasks[i].core);
+        }
+        printf("%-16s %10" PRIu32 " %5s%s\n", tasks[i].name, tasks[i].stack_free, core, tasks[i].alarm ? "  <-- low" : "");
+    }
+}
+
+static int print_series(const char* name, size_t count) {
+    static uint32_t values[SYSMON_HISTORY_LEN];
+    for (int s = 0; s < SYSMON_SERIES_COUNT; s++)
+    {
+        if (strcmp(name, sysmon_series_name((sysmon_series_t) s)) != 0)
+        {
+            continue;
+        }
+        size_t n = sysmon_get_series((sysmon_series_t) s, values, count);
+        /* O singura linie, de la cea mai veche valoare: se copiaza direct in plot/CSV (fara incarcare = camp gol) */
+        for (size_t i = 0; i < n; i++)
+        {
+            printf("%s", i ? "," : "");
+            if (values[i] != SYSMON_LOAD_NONE)
+            {
+                printf("%" PRIu32, values[i]);
+            }
+        }
+        printf("\n");
+        return 0;
+    }
+    printf("Unknown series '%s'. Available:", name);
+    for (int s = 0; s < SYSMON_SERIES_COUNT; s++)
+    {
+        printf(" %s", sysmon_series_name((sysmon_series_t) s));
+    }
+    printf("\n");
+    return 1;
+}
+
+static int sysmon_command(int argc, char** argv) {
+    if (argc == 1)
+    {
+        print_summary();
+        return 0;
+    }
+    if (strcmp(argv[1], "tasks") == 0)
+    {
+        print_tasks();
+        return 0;
+    }
+    if (strcmp(argv[1], "series") == 0 && argc >= 3)
+    {
+        size_t count = argc > 3 ? (size_t) strtoul(argv[3], NULL, 10) : SYSMON_HISTORY_LEN;
+        return print_series(argv[2], count > 0 ? count : SYSMON_HISTORY_LEN);
+    }
+    printf("Usage: sysmon | sysmon tasks | sysmon series <name> [count]\n");
+    return 1;
+}
+
+void cli_register_sysmon_command(void) {
+    const esp_console_cmd_t cmd = {
+        .command = "sysmon",
+        .help    = "Background monitor: CPU load, heap and stack history ('sysmon tasks', 'sysmon series <name> [count]')",
+        .hint    = NULL,
+        .func    = &sysmon_command,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&cmd));
+    ESP_LOGI(TAG, "'%s' command registered.", cmd.command);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+
+#ifndef SYSMON_CMD_H_
+#define SYSMON_CMD_H_
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* #ifdef __cplusplus */
+
+void cli_register_sysmon_command(void);
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif  /* SYSMON_CMD_H_ */
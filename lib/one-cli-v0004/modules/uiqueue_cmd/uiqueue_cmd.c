@@ -0,0 +1,53 @@
+
+#include "uiqueue_cmd.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_console.h"
+#include "esp_log.h"
+
+#include "ui_queue.h"
+
+static const char* TAG = "CLI";
+
+static void print_stats(void) {
+    /* Contoarele consumatorului sunt scrise de task-ul LVGL: pot fi decalate cu un ciclu */
+    ui_queue_stats_t stats;
+    ui_queue_get_stats(&stats);
+
+    uint32_t wait_avg = stats.executed ? (uint32_t) (stats.wait_sum_us / stats.executed) : 0;
+    printf("UI queue: %" PRIu32 " posted, %" PRIu32 " run, %" PRIu32 " dropped (ring full)\n", stats.posted,
+        stats.executed, stats.dropped);
+    printf("Depth: %" PRIu32 " now, %" PRIu32 " max of %d\n", stats.depth, stats.max_depth, UI_QUEUE_LEN);
+    printf("Producer: post max %" PRIu32 " us\n", stats.post_max_us);
+    printf("Post -> run: avg %" PRIu32 " us, max %" PRIu32 " us, %" PRIu32 " drains cut by the %d us budget\n",
+        wait_avg, stats.wait_max_us, stats.budget_stops, UI_QUEUE_DRAIN_BUDGET_US);
+}
+
+static int uiqueue_command(int argc, char** argv) {
+    if (argc == 1)
+    {
+        print_stats();
+        return 0;
+    }
+    if (strcmp(argv[1], "reset") == 0)
+    {
+        ui_queue_reset_stats();
+        printf("UI queue statistics cleared\n");
+        return 0;
+    }
+    printf("Usage: uiqueue | uiqueue reset\n");
+    return 1;
+}
+
+void cli_register_uiqueue_command(void) {
+    const esp_console_cmd_t cmd = {
+        .command = "uiqueue",
+        .help    = "Cross-task UI command queue: depth, drops and post -> run latency ('uiqueue reset' clears the counters)",
+        .hint    = NULL,
+        .func    = &uiqueue_command,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&cmd));
+    ESP_LOGI(TAG, "'%s' command registered.", cmd.command);
+}
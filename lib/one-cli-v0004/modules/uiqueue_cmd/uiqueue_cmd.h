@@ -0,0 +1,19 @@
+#pragma once
+
+
+#ifndef UIQUEUE_CMD_H_
+#define UIQUEUE_CMD_H_
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* #ifdef __cplusplus */
+
+void cli_register_uiqueue_command(void);
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif  /* UIQUEUE_CMD_H_ */
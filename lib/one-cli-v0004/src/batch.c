@@ -0,0 +1,255 @@
+#include "batch.h"
+
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "esp_console.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+#if !CONFIG_IDF_TARGET_LINUX
+#include "esp_timer.h"
+#endif
+
+#include "config.h"
+
+static const char *TAG = "CLI";
+
+typedef struct {
+    uint32_t lineno;
+    bool     too_long;
+    char     text[CONSOLE_MAX_CMDLINE_LENGTH];
+} batch_line_t;
+
+typedef struct {
+    FILE         *in;
+    QueueHandle_t free_q;   // buffere libere: executie -> citire
+    QueueHandle_t ready_q;  // linii de executat: citire -> executie; NULL = sfarsit
+} batch_t;
+
+static atomic_bool s_active;
+
+// -------------------------------------------------
+
+static uint64_t now_us(void) {
+#if CONFIG_IDF_TARGET_LINUX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000ULL + (uint64_t) ts.tv_nsec / 1000ULL;
+#else
+    return (uint64_t) esp_timer_get_time();
+#endif
+}
+
+/* Urmatoarea linie cu o comanda. Intoarce false la EOF, Ctrl-D sau CLI_BATCH_END_LINE. */
+static bool read_line(FILE *in, batch_line_t *line, uint32_t *lineno) {
+    while (fgets(line->text, sizeof(line->text), in) != NULL)
+    {
+        (*lineno)++;
+        size_t len     = strlen(line->text);
+        line->too_long = false;
+        if (len == sizeof(line->text) - 1 && line->text[len - 1] != '\n')
+        {
+            /* Bufferul e plin: e prea lunga doar daca dupa el mai urmeaza ceva pana la '\n' sau EOF */
+            int c;
+            while ((c = fgetc(in)) != EOF && c != '\n')
+            {
+                if (c != '\r')
+                {
+                    line->too_long = true;  // restul liniei nu se executa
+                }
+            }
+        }
+        while (len > 0 && (line->text[len - 1] == '\n' || line->text[len - 1] == '\r'))
+        {
+            line->text[--len] = '\0';
+        }
+        if (strchr(line->text, '\x04') != NULL || strcmp(line->text, CLI_BATCH_END_LINE) == 0)
+        {
+            return false;
+        }
+        const char *p = line->text + strspn(line->text, " \t");
+        if (*p == '\0' || *p == '#')
+        {
+            continue;
+        }
+        line->lineno = *lineno;
+        return true;
+    }
+    return false;
+}
+
+/* Citeste in avans cat timp task-ul apelant executa; se opreste singur la sfarsitul stream-ului */
+static void batch_reader_task(void *parameter) {
+    batch_t      *batch  = (batch_t *) parameter;
+    uint32_t      lineno = 0;
+    batch_line_t *line   = NULL;
+    while (xQueueReceive(batch->free_q, &line, portMAX_DELAY) == pdTRUE)
+    {
+        if (!read_line(batch->in, line, &lineno))
+        {
+            break;
+        }
+        xQueueSend(batch->ready_q, &line, portMAX_DELAY);
+    }
+    line = NULL;
+    xQueueSend(batch->ready_q, &line, portMAX_DELAY);
+    vTaskDelete(NULL);
+}
+
+/* Executa o linie si intoarce true daca a reusit */
+static bool run_line(const batch_line_t *line, bool quiet, uint32_t *elapsed_us) {
+    const char *status = "ok";
+    int         ret    = 0;
+    esp_err_t   err    = ESP_OK;
+
+    uint64_t start = now_us();
+    if (line->too_long)
+    {
+        err = ESP_ERR_INVALID_SIZE;
+    } else
+    {
+        err = esp_console_run(line->text, &ret);
+    }
+    *elapsed_us = (uint32_t) (now_us() - start);
+
+    if (err == ESP_ERR_INVALID_SIZE)
+    {
+        status = "toolong";
+    } else if (err == ESP_ERR_NOT_FOUND)
+    {
+        status = "unknown";
+    } else if (err != ESP_OK)
+    {
+        status = esp_err_to_name(err);
+    } else if (ret != 0)
+    {
+        status = "failed";
+    }
+
+    bool ok = err == ESP_OK && ret == 0;
+    if (!quiet || !ok)
+    {
+        printf("[%4" PRIu32 "] %8" PRIu32 " us  %-7s %s\n", line->lineno, *elapsed_us, status, line->text);
+    }
+    return ok;
+}
+
+// -------------------------------------------------
+
+esp_err_t cli_batch_run_stream(FILE *in, const cli_batch_opts_t *opts, cli_batch_stats_t *stats) {
+    static const cli_batch_opts_t default_opts = {0};
+    cli_batch_stats_t             local_stats;
+    if (in == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (opts == NULL)
+    {
+        opts = &default_opts;
+    }
+    if (stats == NULL)
+    {
+        stats = &local_stats;
+    }
+    memset(stats, 0, sizeof(*stats));
+    if (atomic_exchange(&s_active, true))
+    {
+        return ESP_ERR_INVALID_STATE;  // `batch` dintr-un script
+    }
+
+    esp_err_t     err   = ESP_OK;
+    batch_t       batch = {.in = in};
+    batch_line_t *lines = malloc(CLI_BATCH_DEPTH * sizeof(batch_line_t));
+    batch.free_q        = xQueueCreate(CLI_BATCH_DEPTH, sizeof(batch_line_t *));
+    batch.ready_q       = xQueueCreate(CLI_BATCH_DEPTH + 1, sizeof(batch_line_t *));  // + sfarsitul
+    if (lines == NULL || batch.free_q == NULL || batch.ready_q == NULL)
+    {
+        err = ESP_ERR_NO_MEM;
+        goto cleanup;
+    }
+    for (int i = 0; i < CLI_BATCH_DEPTH; i++)
+    {
+        batch_line_t *line = &lines[i];
+        xQueueSend(batch.free_q, &line, 0);
+    }
+
+    /* Aceeasi prioritate: cititorul avanseaza cat timp comanda asteapta dupa flash/retea */
+    if (xTaskCreate(batch_reader_task, "CLI batch", CLI_BATCH_READER_STACK, &batch, uxTaskPriorityGet(NULL), NULL) != pdPASS)
+    {
+        err = ESP_ERR_NO_MEM;
+        goto cleanup;
+    }
+
+    uint64_t      start  = now_us();
+    bool          failed = false;
+    batch_line_t *line   = NULL;
+    stats->min_us        = UINT32_MAX;
+    while (xQueueReceive(batch.ready_q, &line, portMAX_DELAY) == pdTRUE && line != NULL)
+    {
+        if (failed)
+        {
+            stats->skipped++;  // stream-ul se consuma pana la capat ca sa nu ajunga restul in prompt
+        } else
+        {
+            uint32_t elapsed_us = 0;
+            if (!run_line(line, opts->quiet, &elapsed_us))
+            {
+                stats->errors++;
+                failed = !opts->keep_going;
+            }
+            stats->commands++;
+            stats->total_us += elapsed_us;
+            stats->min_us = elapsed_us < stats->min_us ? elapsed_us : stats->min_us;
+            stats->max_us = elapsed_us > stats->max_us ? elapsed_us : stats->max_us;
+        }
+        xQueueSend(batch.free_q, &line, 0);
+    }
+    stats->wall_us = now_us() - start;
+    if (stats->commands == 0)
+    {
+        stats->min_us = 0;
+    }
+
+    printf("batch: %" PRIu32 " commands, %" PRIu32 " errors, %" PRIu32 " skipped; latency min/avg/max %" PRIu32 "/%" PRIu32 "/%" PRIu32
+           " us; %" PRIu32 " ms total\n",
+        stats->commands, stats->errors, stats->skipped, stats->min_us,
+        stats->commands ? (uint32_t) (stats->total_us / stats->commands) : 0, stats->max_us, (uint32_t) (stats->wall_us / 1000));
+    if (stats->errors > 0)
+    {
+        err = ESP_FAIL;
+    }
+
+cleanup:
+    if (batch.ready_q != NULL)
+    {
+        vQueueDelete(batch.ready_q);
+    }
+    if (batch.free_q != NULL)
+    {
+        vQueueDelete(batch.free_q);
+    }
+    free(lines);
+    atomic_store(&s_active, false);
+    return err;
+}
+
+esp_err_t cli_batch_run_file(const char *path, const cli_batch_opts_t *opts, cli_batch_stats_t *stats) {
+    if (path == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    FILE *f = fopen(path, "r");
+    if (f == NULL)
+    {
+        ESP_LOGW(TAG, "Cannot open script %s", path);
+        return ESP_ERR_NOT_FOUND;
+    }
+    esp_err_t err = cli_batch_run_stream(f, opts, stats);
+    fclose(f);
+    return err;
+}
@@ -0,0 +1,299 @@
+#include "history.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "linenoise/linenoise.h"
+
+#include "config.h"
+
+static const char *TAG = "CLI";
+
+static char              s_path[64];
+static char              s_tmp_path[68];
+static FILE             *s_journal      = NULL;  // deschis in append intre comenzi
+static SemaphoreHandle_t s_lock         = NULL;
+static TaskHandle_t      s_compact_task = NULL;
+static cli_history_stats_t s_stats;
+
+// -------------------------------------------------
+
+/* Citeste tot fisierul dintr-o bucata. Intoarce NULL daca nu exista, e gol sau nu s-a citit nimic. */
+static char *read_whole_file(const char *path, size_t *size_out) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL)
+    {
+        return NULL;
+    }
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size <= 0)
+    {
+        fclose(f);
+        return NULL;
+    }
+
+    char *buf = malloc((size_t) size + 1);
+    if (buf == NULL)
+    {
+        ESP_LOGE(TAG, "No memory to read history (%ld bytes)", size);
+        fclose(f);
+        return NULL;
+    }
+    size_t len = fread(buf, 1, (size_t) size, f);
+    fclose(f);
+    if (len == 0)
+    {
+        free(buf);
+        return NULL;
+    }
+    buf[len]  = '\0';
+    *size_out = len;
+    return buf;
+}
+
+/* Numara liniile si intoarce inceputul ultimelor `keep` linii. */
+static char *last_lines(char *buf, size_t len, size_t keep, size_t *records_out) {
+    size_t records = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        if (buf[i] == '\n')
+        {
+            records++;
+        }
+    }
+    if (len > 0 && buf[len - 1] != '\n')
+    {
+        records++; // ultima linie fara '\n' (scriere intrerupta)
+    }
+    *records_out = records;
+
+    /* memchr si nu strchr: un octet 0 in fisier (flash corupt) nu opreste cautarea */
+    char  *start = buf;
+    char  *end   = buf + len;
+    size_t skip  = records > keep ? records - keep : 0;
+    while (skip > 0)
+    {
+        char *nl = memchr(start, '\n', (size_t) (end - start));
+        if (nl == NULL)
+        {
+            break;
+        }
+        start = nl + 1;
+        skip--;
+    }
+    return start;
+}
+
+static void history_compact_task(void *parameter) {
+    (void) parameter;
+    while (true)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        cli_history_compact();
+    }
+}
+
+// -------------------------------------------------
+
+esp_err_t cli_history_load(const char *path) {
+    if (path == NULL || path[0] == '\0')
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    strncpy(s_path, path, sizeof(s_path) - 1);
+    s_path[sizeof(s_path) - 1] = '\0';
+    snprintf(s_tmp_path, sizeof(s_tmp_path), "%s.tmp", s_path);
+
+    if (s_lock == NULL)
+    {
+        s_lock = xSemaphoreCreateMutex();
+        if (s_lock == NULL)
+        {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    /* O compactare a fost intrerupta intre remove() si rename() */
+    if (access(s_path, F_OK) != 0 && access(s_tmp_path, F_OK) == 0)
+    {
+        rename(s_tmp_path, s_path);
+    }
+
+    size_t len   = 0;
+    bool   torn  = false;
+    char  *buf   = read_whole_file(s_path, &len);
+    if (buf != NULL)
+    {
+        torn           = buf[len - 1] != '\n'; // se repara la compactare
+        size_t records = 0;
+        char  *line    = last_lines(buf, len, CONSOLE_HISTORY_MAX_LEN, &records);
+        while (line != NULL && *line != '\0')
+        {
+            char *end = strchr(line, '\n');
+            if (end != NULL)
+            {
+                *end = '\0';
+            }
+            if (line[0] != '\0')
+            {
+                linenoiseHistoryAdd(line);
+            }
+            line = end != NULL ? end + 1 : NULL;
+        }
+        free(buf);
+        s_stats.records = records;
+        ESP_LOGI(TAG, "History loaded: %u records from %s", (unsigned) records, s_path);
+    }
+
+    if (s_compact_task == NULL)
+    {
+        xTaskCreate(history_compact_task, "CLI history", 3072, NULL, tskIDLE_PRIORITY + 1, &s_compact_task);
+    }
+    if (s_compact_task != NULL && (torn || s_stats.records >= CONSOLE_HISTORY_COMPACT_AT))
+    {
+        xTaskNotifyGive(s_compact_task);
+    }
+    return ESP_OK;
+}
+
+esp_err_t cli_history_append(const char *line) {
+    if (s_lock == NULL || line == NULL || line[0] == '\0')
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t err = ESP_OK;
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    if (s_journal == NULL)
+    {
+        s_journal = fopen(s_path, "a");
+    }
+    if (s_journal == NULL)
+    {
+        err = ESP_FAIL;
+    } else
+    {
+        size_t len = strlen(line);
+        if (fwrite(line, 1, len, s_journal) != len || fputc('\n', s_journal) == EOF)
+        {
+            err = ESP_FAIL;
+        }
+        /* Doar recordul nou ajunge pe flash, nu tot fisierul */
+        if (fflush(s_journal) != 0 || fsync(fileno(s_journal)) != 0)
+        {
+            err = ESP_FAIL;
+        }
+        if (err == ESP_OK)
+        {
+            s_stats.bytes_written += len + 1;
+            s_stats.appends++;
+            s_stats.records++;
+        } else
+        {
+            /* Eroarea ramane pe FILE: urmatoarea adaugare redeschide jurnalul.
+               Un record scris pe jumatate e inchis cu '\n' de compactarea ceruta mai jos. */
+            fclose(s_journal);
+            s_journal = NULL;
+        }
+    }
+    if (err != ESP_OK)
+    {
+        s_stats.failures++;
+    }
+    bool compact = err != ESP_OK || s_stats.records >= CONSOLE_HISTORY_COMPACT_AT;
+    xSemaphoreGive(s_lock);
+
+    if (err != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Failed to append history to %s", s_path);
+    }
+    if (compact && s_compact_task != NULL)
+    {
+        xTaskNotifyGive(s_compact_task);
+    }
+    return err;
+}
+
+esp_err_t cli_history_compact(void) {
+    if (s_lock == NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t err = ESP_OK;
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    if (s_journal != NULL)
+    {
+        fclose(s_journal);
+        s_journal = NULL;
+    }
+
+    size_t len = 0;
+    char  *buf = read_whole_file(s_path, &len);
+    if (buf != NULL)
+    {
+        size_t records = 0;
+        char  *start   = last_lines(buf, len, CONSOLE_HISTORY_MAX_LEN, &records);
+        size_t keep    = len - (size_t) (start - buf);
+
+        FILE *f = fopen(s_tmp_path, "wb");
+        if (f == NULL || fwrite(start, 1, keep, f) != keep)
+        {
+            err = ESP_FAIL;
+        } else if (keep > 0 && start[keep - 1] != '\n')
+        {
+            fputc('\n', f); // nu lipi urmatoarea comanda de o linie scrisa pe jumatate
+            keep++;
+        }
+        if (f != NULL)
+        {
+            fflush(f);
+            fsync(fileno(f));
+            fclose(f);
+        }
+
+        /* FAT nu suprascrie la rename(), deci sterge intai; load() repara daca pica curentul aici */
+        if (err == ESP_OK && (remove(s_path) != 0 || rename(s_tmp_path, s_path) != 0))
+        {
+            err = ESP_FAIL;
+        }
+        if (err == ESP_OK)
+        {
+            s_stats.bytes_written += keep;
+            s_stats.records = records < CONSOLE_HISTORY_MAX_LEN ? records : CONSOLE_HISTORY_MAX_LEN;
+            s_stats.compactions++;
+        }
+        free(buf);
+    }
+    xSemaphoreGive(s_lock);
+
+    if (err != ESP_OK)
+    {
+        ESP_LOGW(TAG, "History compaction failed (%s)", s_path);
+    }
+    return err;
+}
+
+void cli_history_get_stats(cli_history_stats_t *stats) {
+    if (stats == NULL)
+    {
+        return;
+    }
+    if (s_lock != NULL)
+    {
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+    }
+    *stats = s_stats;
+    if (s_lock != NULL)
+    {
+        xSemaphoreGive(s_lock);
+    }
+}
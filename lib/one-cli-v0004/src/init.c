@@ -2,6 +2,12 @@
 #include "one-cli.h"
 #include "init.h"
 #include "config.h"
+#include "history.h"
+#if CONFIG_TINYUSB_CDC_ENABLED
+#include "tinyusb.h"
+#include "tusb_cdc_acm.h"
+#include "tusb_console.h"
+#endif  // CONFIG_TINYUSB_CDC_ENABLED
 
 static const char *TAG = "CLI";
 
@@ -14,6 +20,18 @@ void initialize_console_peripheral(void)
     fflush(stdout);
     fsync(fileno(stdout));
 
+#if CONFIG_TINYUSB_CDC_ENABLED
+    /* PHY-ul USB intern e luat de TinyUSB: consola pe CDC-ACM 0, telemetria pe CDC-ACM 1 */
+    const tinyusb_config_t tusb_config = {0};
+    ESP_ERROR_CHECK(tinyusb_driver_install(&tusb_config));
+
+    tinyusb_config_cdcacm_t acm_config = {
+        .usb_dev = TINYUSB_USBDEV_0,
+        .cdc_port = TINYUSB_CDC_ACM_0,
+    };
+    ESP_ERROR_CHECK(tusb_cdc_acm_init(&acm_config));
+    ESP_ERROR_CHECK(esp_tusb_init_console(TINYUSB_CDC_ACM_0));
+#else
     /* Minicom, screen, idf_monitor send CR when ENTER key is pressed */
     usb_serial_jtag_vfs_set_rx_line_endings(ESP_LINE_ENDINGS_CR);
     /* Move the caret to the beginning of the next line on '\n' */
@@ -33,6 +51,7 @@ void initialize_console_peripheral(void)
 
     /* Tell vfs to use usb-serial-jtag driver */
     usb_serial_jtag_vfs_use_driver();
+#endif  // CONFIG_TINYUSB_CDC_ENABLED
 
     /* Disable buffering on stdin */
     setvbuf(stdin, NULL, _IONBF, 0);
@@ -64,7 +83,7 @@ void initialize_console_library(const char *history_path) {
   linenoiseSetHintsCallback((linenoiseHintsCallback *)&esp_console_get_hint);
 
   /* Set command history size */
-  linenoiseHistorySetMaxLen(100);
+  linenoiseHistorySetMaxLen(CONSOLE_HISTORY_MAX_LEN);
 
   /* Set command maximum length */
   linenoiseSetMaxLineLen(console_config.max_cmdline_length);
@@ -73,8 +92,8 @@ void initialize_console_library(const char *history_path) {
   linenoiseAllowEmpty(false);
 
 #if CONFIG_CONSOLE_STORE_HISTORY
-  /* Load command history from filesystem */
-  linenoiseHistoryLoad(history_path);
+  /* Load command history from filesystem (append-only journal) */
+  cli_history_load(history_path);
 #endif  // CONFIG_CONSOLE_STORE_HISTORY
 
   /* Figure out if the terminal supports escape sequences */
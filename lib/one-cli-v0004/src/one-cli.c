@@ -19,10 +19,16 @@ void cli_register_all_commands(void) {
     //// cli_register_tasks_info_command();
     cli_register_uptime_command();
     cli_register_info_command();
-    //// cli_register_nsv_command(); // TODO de implementat cum trebuie
+    cli_register_nsv_command();
     cli_register_WiFi_join_command();
     cli_register_set_command();
     cli_register_perfmon_command();
+    cli_register_batch_command();
+    cli_register_sysmon_command();
+    cli_register_imgcache_command();
+    cli_register_uiqueue_command();
+    cli_register_layermem_command();
+    cli_register_drawcache_command();
     return;
 }
 
@@ -86,6 +92,12 @@ void cli_set_history_path(const char* path) {
     ESP_LOGI(TAG, "History path set to: %s", s_history_path);
 }
 
+static void (*s_input_cb)(void) = NULL;
+
+void cli_set_input_cb(void (*cb)(void)) {
+    s_input_cb = cb;
+}
+
 void rtos_init_cli() {
     /* Initialize console output periheral (UART, USB_OTG, USB_JTAG) */
     initialize_console_peripheral();
@@ -120,6 +132,10 @@ void console_app(void* parameter) {
     while (true)
     {
         char* line = linenoise(prompt);
+        if (s_input_cb != NULL)
+        {
+            s_input_cb();
+        }
 
 #if CONFIG_CONSOLE_IGNORE_EMPTY_LINES
         if (line == NULL)
@@ -139,10 +155,10 @@ void console_app(void* parameter) {
         {
             linenoiseHistoryAdd(line);
 #if CONFIG_CONSOLE_STORE_HISTORY
-            /* Save command history to filesystem */
+            /* Append only this command to the history journal on the filesystem */
             if (s_history_path[0] != '\0')
             { // avem path valid
-                linenoiseHistorySave(s_history_path);
+                cli_history_append(line);
             }
 #endif // CONFIG_CONSOLE_STORE_HISTORY
         }
@@ -0,0 +1,2 @@
+#pragma once
+// button.cpp nu logheaza nimic
@@ -0,0 +1,94 @@
+/*
+ * Test pe host pentru OneButton::advance(): fronturile butonului sunt simulate, iar
+ * butonul e "trezit" ca in ButtonManager, doar la un front sau la termenul cerut de advance().
+ *
+ *   cmake -S lib/onebutton-v0001/host_test -B build_host && cmake --build build_host && ctest --test-dir build_host
+ */
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "button.h"
+
+struct Edge {
+    uint32_t t;  // ms
+    bool     active;
+};
+
+static std::string s_events;
+static int         s_failures = 0;
+
+static void on_event(void *name) {
+    s_events += (const char *) name;
+    s_events += ' ';
+}
+
+/* Ca task-ul ButtonManager: advance() la fiecare front si la expirarea termenului intors */
+static int32_t run(OneButton &button, const std::vector<Edge> &edges, uint32_t end, int *wakeups) {
+    bool     level = false;
+    int32_t  due   = -1;
+    uint32_t now   = 0;
+    size_t   next  = 0;
+    *wakeups       = 0;
+    while (true)
+    {
+        uint32_t t_edge = next < edges.size() ? edges[next].t : UINT32_MAX;
+        uint32_t t_due  = due >= 0 ? now + (uint32_t) due : UINT32_MAX;
+        uint32_t t      = t_edge < t_due ? t_edge : t_due;
+        if (t > end)
+        {
+            break;
+        }
+        now = t;
+        if (t == t_edge)
+        {
+            level = edges[next++].active;
+        }
+        due = button.advance(level, now);
+        (*wakeups)++;
+    }
+    return due;
+}
+
+static void check(const char *name, const std::vector<Edge> &edges, const char *expected, int max_wakeups, bool during = false) {
+    OneButton button(GPIO_NUM_0);
+    button.attachClick(on_event, (void *) "click");
+    button.attachDoubleClick(on_event, (void *) "double");
+    button.attachMultiClick(on_event, (void *) "multi");
+    button.attachLongPressStart(on_event, (void *) "lpstart");
+    button.attachLongPressStop(on_event, (void *) "lpstop");
+    if (during)
+    {
+        button.attachDuringLongPress(on_event, (void *) "during");
+    }
+
+    s_events.clear();
+    int     wakeups = 0;
+    int32_t due     = run(button, edges, 10000, &wakeups);
+    // dupa ultimul eveniment butonul nu mai cere treziri
+    bool ok = s_events == expected && due == -1 && button.isIdle() && wakeups <= max_wakeups;
+    if (!ok)
+    {
+        s_failures++;
+    }
+    printf("%-4s %-22s wakeups %2d  [%s]%s%s\n", ok ? "ok" : "FAIL", name, wakeups, s_events.c_str(), ok ? "" : " expected ",
+        ok ? "" : expected);
+}
+
+int main() {
+    check("click", {{100, true}, {180, false}}, "click ", 4);
+    check("click with bounce", {{100, true}, {102, false}, {103, true}, {180, false}, {183, true}, {184, false}}, "click ", 10);
+    check("double click", {{100, true}, {180, false}, {300, true}, {380, false}}, "double ", 8);
+    check("triple click", {{100, true}, {180, false}, {300, true}, {380, false}, {500, true}, {560, false}}, "multi ", 12);
+    check("long press", {{100, true}, {2000, false}}, "lpstart lpstop ", 5);
+    check("long press + during", {{100, true}, {1101, false}}, "lpstart during during during lpstop ", 12, true);
+    check("glitch < debounce", {{100, true}, {110, false}}, "", 3);
+    check("idle", {}, "", 0);
+
+    if (s_failures > 0)
+    {
+        printf("%d case(s) failed\n", s_failures);
+        return 1;
+    }
+    return 0;
+}
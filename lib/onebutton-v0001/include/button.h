@@ -5,6 +5,9 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+// Perioada pentru attachDuringLongPress() in mod eveniment, cand setLongPressIntervalTicks() e 0
+#define ONEBUTTON_EVENT_REPEAT_TICKS (50)
+
 typedef void (*callbackFunction)(void);
 typedef void (*parameterizedCallbackFunction)(void*);
 
@@ -16,6 +19,7 @@ public:
     void setDebounceTicks(int ticks);
     void setClickTicks(int ticks);
     void setPressTicks(int ticks);
+    void setLongPressIntervalTicks(int ticks);  // 0 = la fiecare tick()
 
     void attachClick(callbackFunction newFunction);
     void attachClick(parameterizedCallbackFunction newFunction, void* parameter);
@@ -40,6 +44,17 @@ public:
 
     void tick(void);
     void tick(bool activeLevel);
+    void tick(bool activeLevel, uint32_t now);
+
+    // Pentru ButtonManager: ruleaza masina de stari pana se stabilizeaza si intoarce
+    // peste cate ms trebuie chemat din nou (-1 = inactiv, asteapta doar un front GPIO)
+    int32_t advance(bool activeLevel, uint32_t now);
+    bool isIdle(void) const;
+
+    // Inceputul fazei curente (ms, esp_timer); in long press e momentul apasarii
+    uint32_t getStartTime(void) const;
+    gpio_num_t getPin(void) const;
+    bool isActiveLevel(int level) const;
 
 private:
     typedef enum {
@@ -52,6 +67,7 @@ private:
     } stateMachine_t;
 
     void _newState(stateMachine_t nextState);
+    int32_t _nextTickIn(bool activeLevel, uint32_t now) const;
 
     gpio_num_t _pin;
     int _buttonPressed = 0;
@@ -59,6 +75,7 @@ private:
     int _debounceTicks = 50;
     int _clickTicks = 400;
     int _pressTicks = 800;
+    int _longPressIntervalTicks = 0;
     int _maxClicks = 1;
 
     stateMachine_t _state = OCS_INIT;
@@ -66,6 +83,7 @@ private:
 
     int _nClicks = 0;
     uint32_t _startTime = 0;
+    uint32_t _lastDuringLongPress = 0;
 
     callbackFunction _clickFunc = nullptr;
     parameterizedCallbackFunction _paramClickFunc = nullptr;
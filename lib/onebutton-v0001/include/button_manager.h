@@ -0,0 +1,45 @@
+#pragma once
+
+#include "button.h"
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define BUTTON_MANAGER_MAX       (8)
+#define BUTTON_MANAGER_EDGE_BIT  (1UL << 0)
+#define BUTTON_MANAGER_TIMER_BIT (1UL << 1)
+
+// Deserveste toate OneButton-urile dintr-un singur task, fara polling:
+// se trezeste doar la un front GPIO (ANYEDGE) sau la un esp_timer one-shot comun,
+// armat cat timp vreun buton e la mijlocul unui gest (debounce, click, long press).
+// Callback-urile OneButton ruleaza in task-ul managerului.
+class ButtonManager {
+public:
+    // Inainte sau dupa begin(); pointerul trebuie sa ramana valid
+    esp_err_t add(OneButton* button);
+    esp_err_t begin(UBaseType_t priority, BaseType_t core = tskNO_AFFINITY, uint32_t stackSize = 4096);
+
+    uint32_t getEdgeWakeups(void) const;
+    uint32_t getTimerWakeups(void) const;
+
+private:
+    static void _isrHandler(void* arg);
+    static void _timerCallback(void* arg);
+    static void _taskMain(void* arg);
+
+    esp_err_t _attach(OneButton* button);
+    void _service(void);
+
+    OneButton* _buttons[BUTTON_MANAGER_MAX] = {};
+    size_t _count = 0;
+
+    TaskHandle_t _task = nullptr;
+    esp_timer_handle_t _timer = nullptr;
+    bool _timerArmed = false;
+
+    uint32_t _edgeWakeups = 0;  // doar task-ul managerului scrie
+    uint32_t _timerWakeups = 0;
+};
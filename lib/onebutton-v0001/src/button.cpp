@@ -36,6 +36,9 @@ void OneButton::setClickTicks(const int ticks) {
 void OneButton::setPressTicks(const int ticks) {
     _pressTicks = ticks;
 }
+void OneButton::setLongPressIntervalTicks(const int ticks) {
+    _longPressIntervalTicks = ticks;
+}
 
 // ----- Attach callbacks -----
 
@@ -99,6 +102,22 @@ int OneButton::getNumberClicks(void) {
     return _nClicks;
 }
 
+bool OneButton::isIdle(void) const {
+    return _state == OCS_INIT;
+}
+
+uint32_t OneButton::getStartTime(void) const {
+    return _startTime;
+}
+
+gpio_num_t OneButton::getPin(void) const {
+    return _pin;
+}
+
+bool OneButton::isActiveLevel(int level) const {
+    return level == _buttonPressed;
+}
+
 void OneButton::tick(void) {
     if (_pin != GPIO_NUM_NC) {
         int level = gpio_get_level(_pin);
@@ -112,7 +131,10 @@ void OneButton::_newState(stateMachine_t nextState) {
 }
 
 void OneButton::tick(bool activeLevel) {
-    uint32_t now      = (uint32_t) (esp_timer_get_time() / 1000);
+    tick(activeLevel, (uint32_t) (esp_timer_get_time() / 1000));
+}
+
+void OneButton::tick(bool activeLevel, uint32_t now) {
     uint32_t waitTime = now - _startTime;
 
     switch (_state) {
@@ -136,6 +158,7 @@ void OneButton::tick(bool activeLevel) {
                 if (_paramLongPressStartFunc)
                     _paramLongPressStartFunc(_longPressStartFuncParam);
                 _newState(OCS_PRESS);
+                _lastDuringLongPress = now;
             }
             break;
 
@@ -177,7 +200,8 @@ void OneButton::tick(bool activeLevel) {
             if (!activeLevel) {
                 _newState(OCS_PRESSEND);
                 _startTime = now;
-            } else {
+            } else if (_longPressIntervalTicks == 0 || (now - _lastDuringLongPress) >= (uint32_t) _longPressIntervalTicks) {
+                _lastDuringLongPress = now;
                 if (_duringLongPressFunc)
                     _duringLongPressFunc();
                 if (_paramDuringLongPressFunc)
@@ -202,3 +226,51 @@ void OneButton::tick(bool activeLevel) {
             break;
     }
 }
+
+// ----- Event driven -----
+
+// Cat mai e pana la urmatorul termen din masina de stari, fara front pe pin.
+// Nivelul nu se schimba intre fronturi, deci in rest tick() n-ar face nimic.
+int32_t OneButton::_nextTickIn(bool activeLevel, uint32_t now) const {
+    int32_t waitTime = (int32_t) (now - _startTime);
+    int32_t due;
+
+    switch (_state) {
+        case OCS_INIT:
+            return activeLevel ? 0 : -1;
+        case OCS_DOWN:
+            due = activeLevel ? _pressTicks + 1 : 0;
+            break;
+        case OCS_UP:
+        case OCS_PRESSEND:
+            due = _debounceTicks;
+            break;
+        case OCS_COUNT:
+            if (activeLevel || _nClicks == _maxClicks)
+                return 0;
+            due = _clickTicks + 1;
+            break;
+        case OCS_PRESS:
+            if (!activeLevel)
+                return 0;
+            if (!_duringLongPressFunc && !_paramDuringLongPressFunc)
+                return -1;
+            waitTime = (int32_t) (now - _lastDuringLongPress);
+            due      = _longPressIntervalTicks > 0 ? _longPressIntervalTicks : ONEBUTTON_EVENT_REPEAT_TICKS;
+            break;
+        default:
+            return 0;
+    }
+    return (due > waitTime) ? due - waitTime : 0;
+}
+
+int32_t OneButton::advance(bool activeLevel, uint32_t now) {
+    // Tranzitiile fara asteptare (UP->COUNT->callback) se fac aici, nu la un timer de 0 ms
+    for (int i = 0; i < 8; i++) {
+        tick(activeLevel, now);
+        int32_t next = _nextTickIn(activeLevel, now);
+        if (next != 0)
+            return next;
+    }
+    return 1;
+}
@@ -0,0 +1,138 @@
+#include "button_manager.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+
+static const char* TAG = "BUTTON";
+
+// ----- Registration -----
+
+esp_err_t ButtonManager::add(OneButton* button) {
+    if (button == nullptr || button->getPin() == GPIO_NUM_NC) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (_count == BUTTON_MANAGER_MAX) {
+        return ESP_ERR_NO_MEM;
+    }
+    _buttons[_count++] = button;
+    return (_task != nullptr) ? _attach(button) : ESP_OK;
+}
+
+esp_err_t ButtonManager::_attach(OneButton* button) {
+    gpio_num_t pin = button->getPin();
+
+    gpio_set_intr_type(pin, GPIO_INTR_ANYEDGE);
+    esp_err_t err = gpio_isr_handler_add(pin, _isrHandler, this);
+    if (err != ESP_OK) {
+        return err;
+    }
+    gpio_intr_enable(pin);
+    xTaskNotify(_task, BUTTON_MANAGER_EDGE_BIT, eSetBits);  // poate e deja apasat
+    return ESP_OK;
+}
+
+esp_err_t ButtonManager::begin(UBaseType_t priority, BaseType_t core, uint32_t stackSize) {
+    if (_task != nullptr) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // Serviciul ISR e comun in tot proiectul; daca l-a instalat altcineva e in regula
+    esp_err_t err = gpio_install_isr_service(ESP_INTR_FLAG_LEVEL1);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        return err;
+    }
+
+    const esp_timer_create_args_t timer_args = {
+        .callback              = _timerCallback,
+        .arg                   = this,
+        .dispatch_method       = ESP_TIMER_TASK,
+        .name                  = "buttons",
+        .skip_unhandled_events = true,
+    };
+    err = esp_timer_create(&timer_args, &_timer);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    if (xTaskCreatePinnedToCore(_taskMain, "Buttons", stackSize, this, priority, &_task, core) != pdPASS) {
+        esp_timer_delete(_timer);
+        _timer = nullptr;
+        return ESP_ERR_NO_MEM;
+    }
+
+    for (size_t i = 0; i < _count; i++) {
+        err = _attach(_buttons[i]);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "GPIO%d: %s", _buttons[i]->getPin(), esp_err_to_name(err));
+        }
+    }
+    return ESP_OK;
+}
+
+uint32_t ButtonManager::getEdgeWakeups(void) const {
+    return _edgeWakeups;
+}
+
+uint32_t ButtonManager::getTimerWakeups(void) const {
+    return _timerWakeups;
+}
+
+// ----- Wakeup sources -----
+
+void IRAM_ATTR ButtonManager::_isrHandler(void* arg) {
+    ButtonManager* self = (ButtonManager*) arg;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    xTaskNotifyFromISR(self->_task, BUTTON_MANAGER_EDGE_BIT, eSetBits, &xHigherPriorityTaskWoken);
+    if (xHigherPriorityTaskWoken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+void ButtonManager::_timerCallback(void* arg) {
+    ButtonManager* self = (ButtonManager*) arg;
+    xTaskNotify(self->_task, BUTTON_MANAGER_TIMER_BIT, eSetBits);
+}
+
+// ----- Service -----
+
+// Toate butoanele se evalueaza la orice trezire; sunt putine si gpio_get_level() e ieftin.
+// Timer-ul se rearmeaza la cel mai apropiat termen sau se opreste cand toate sunt inactive.
+void ButtonManager::_service(void) {
+    uint32_t now  = (uint32_t) (esp_timer_get_time() / 1000);
+    int32_t  next = -1;
+
+    for (size_t i = 0; i < _count; i++) {
+        OneButton* button = _buttons[i];
+        bool active       = button->isActiveLevel(gpio_get_level(button->getPin()));
+        if (!active && button->isIdle()) {
+            continue;
+        }
+        int32_t due = button->advance(active, now);
+        if (due >= 0 && (next < 0 || due < next)) {
+            next = due;
+        }
+    }
+
+    if (_timerArmed) {
+        esp_timer_stop(_timer);
+        _timerArmed = false;
+    }
+    if (next >= 0) {
+        _timerArmed = (esp_timer_start_once(_timer, (uint64_t) next * 1000ULL) == ESP_OK);
+    }
+}
+
+void ButtonManager::_taskMain(void* arg) {
+    ButtonManager* self = (ButtonManager*) arg;
+    uint32_t notificationValue;
+
+    while (true) {
+        xTaskNotifyWait(0x00, 0xFFFFFFFF, &notificationValue, portMAX_DELAY);
+        if (notificationValue & BUTTON_MANAGER_EDGE_BIT) {
+            self->_edgeWakeups++;
+        }
+        if (notificationValue & BUTTON_MANAGER_TIMER_BIT) {
+            self->_timerWakeups++;
+        }
+        self->_service();
+    }
+}
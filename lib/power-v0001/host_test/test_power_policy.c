@@ -0,0 +1,157 @@
+/*
+ * Test pe host pentru power_policy_step(): ceasul e simulat, cu un pas la fiecare 100 ms
+ * (cat task-ul "Power" in ACTIVE / IDLE), iar inactivitatea LVGL se numara de la ultima atingere.
+ *
+ *   cmake -S lib/power-v0001/host_test -B build_host && cmake --build build_host && ctest --test-dir build_host
+ */
+#include <stdio.h>
+
+#include "power_policy.h"
+
+#define STEP_MS (100)
+
+static int s_failures;
+
+#define CHECK(cond)                                                    \
+    do                                                                 \
+    {                                                                  \
+        if (!(cond))                                                   \
+        {                                                              \
+            fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #cond); \
+            s_failures++;                                              \
+        }                                                              \
+    } while (0)
+
+typedef struct {
+    power_policy_t   policy;
+    power_inputs_t   in;
+    power_decision_t d;
+    uint32_t         touched_ms;  // ultima atingere vazuta de LVGL
+} sim_t;
+
+static void sim_init(sim_t *sim, const power_policy_config_t *config, uint32_t now_ms) {
+    power_policy_init(&sim->policy, config, now_ms);
+    sim->in         = (power_inputs_t) {.now_ms = now_ms, .next_deadline_ms = POWER_NO_DEADLINE};
+    sim->touched_ms = now_ms;
+    sim->d.state    = POWER_ACTIVE;
+}
+
+/* Pasi de STEP_MS pana la `until_ms`; wake_irq / sleep_request conteaza doar la primul pas */
+static void sim_run(sim_t *sim, uint32_t until_ms) {
+    while ((int32_t) (until_ms - sim->in.now_ms) > 0)
+    {
+        sim->in.now_ms += STEP_MS;
+        sim->in.inactive_ms   = sim->in.now_ms - sim->touched_ms;
+        sim->d                = power_policy_step(&sim->policy, &sim->in);
+        sim->in.wake_irq      = false;
+        sim->in.sleep_request = false;
+    }
+}
+
+int main(void) {
+    power_policy_config_t config = POWER_POLICY_CONFIG_DEFAULT();
+    sim_t                 sim;
+    sim_init(&sim, &config, 0);
+
+    sim_run(&sim, 400);
+    CHECK(sim.d.state == POWER_ACTIVE);
+    sim_run(&sim, 600);
+    CHECK(sim.d.state == POWER_IDLE);
+    sim.in.busy = true;  // animatie in curs
+    sim_run(&sim, 700);
+    CHECK(sim.d.state == POWER_ACTIVE);
+    sim.in.busy = false;
+    sim_run(&sim, 30000);
+    CHECK(sim.d.state == POWER_DIM);
+
+    // atingere in DIM: PENIRQ vine inainte ca LVGL s-o vada (citirea indev-urilor e oprita)
+    sim.in.wake_irq = true;
+    sim_run(&sim, 30100);
+    CHECK(sim.d.state == POWER_ACTIVE && sim.d.changed);
+    sim_run(&sim, 30300);
+    CHECK(sim.d.state == POWER_ACTIVE);  // IRQ-ul tine ACTIVE pana preia LVGL
+    sim.touched_ms = 30300;
+    sim_run(&sim, 30900);
+    CHECK(sim.d.state == POWER_IDLE);
+
+    // SLEEP dupa 60 s de liniste, o bucata de light sleep limitata de urmatorul timer LVGL
+    sim.in.next_deadline_ms = 1000;
+    sim_run(&sim, 90300);
+    CHECK(sim.d.state == POWER_SLEEP && sim.d.sleep_ms == 1000);
+    sim.in.next_deadline_ms = 20;  // sub min_sleep_ms: nu merita
+    sim_run(&sim, 90400);
+    CHECK(sim.d.state == POWER_SLEEP && sim.d.sleep_ms == 0);
+    sim.in.next_deadline_ms = POWER_NO_DEADLINE;
+    sim_run(&sim, 90500);
+    CHECK(sim.d.sleep_ms == config.max_sleep_ms);
+
+    // 5 s dormite intre doi pasi: timpul intra la SLEEP
+    uint32_t slept_before = sim.policy.time_in_state_ms[POWER_SLEEP];
+    sim.in.now_ms += 4900;
+    sim_run(&sim, 95500);
+    CHECK(sim.d.state == POWER_SLEEP);
+    CHECK(sim.policy.time_in_state_ms[POWER_SLEEP] - slept_before == 5000);
+    sim.in.wake_irq = true;
+    sim_run(&sim, 95600);
+    CHECK(sim.d.state == POWER_ACTIVE);
+
+    // cerere explicita dintr-un click: inactivitate ~0 si animatie in curs
+    sim.touched_ms       = 95600;
+    sim.in.busy          = true;
+    sim.in.sleep_request = true;
+    sim_run(&sim, 95700);
+    CHECK(sim.d.state == POWER_SLEEP && sim.d.sleep_ms == config.max_sleep_ms);
+    sim.in.busy = false;
+    sim_run(&sim, 96000);
+    CHECK(sim.d.state == POWER_SLEEP);  // ramane pana la trezire
+    sim.in.wake_irq = true;
+    sim_run(&sim, 96100);
+    CHECK(sim.d.state == POWER_ACTIVE);
+
+    // consola USB conectata: cel mult DIM; cererea explicita doarme totusi
+    sim_init(&sim, &config, 0);
+    sim.in.no_sleep = true;
+    sim_run(&sim, 90000);
+    CHECK(sim.d.state == POWER_DIM);
+    sim.in.sleep_request = true;
+    sim_run(&sim, 90100);
+    CHECK(sim.d.state == POWER_SLEEP);
+    sim.in.wake_irq = true;  // o linie de comanda, ca o atingere
+    sim_run(&sim, 90200);
+    CHECK(sim.d.state == POWER_ACTIVE);
+    sim.in.no_sleep = false;
+    sim.touched_ms  = 90200;
+    sim_run(&sim, 150300);
+    CHECK(sim.d.state == POWER_SLEEP);
+
+    // DIM / SLEEP dezactivate
+    power_policy_config_t no_sleep = config;
+    no_sleep.dim_after_ms          = 0;
+    no_sleep.sleep_after_ms        = 0;
+    sim_init(&sim, &no_sleep, 0);
+    sim_run(&sim, 200000);
+    CHECK(sim.d.state == POWER_IDLE);
+
+    // ceasul in ms pe 32 de biti trece prin 0
+    sim_init(&sim, &config, UINT32_MAX - 250);
+    sim_run(&sim, UINT32_MAX - 50);
+    CHECK(sim.d.state == POWER_ACTIVE);
+    sim_run(&sim, 400);
+    CHECK(sim.d.state == POWER_IDLE);
+
+    // 2 minute fara atingere: tot timpul e contabilizat, cu 3 tranzitii
+    sim_init(&sim, &config, 0);
+    sim_run(&sim, 120000);
+    const uint32_t *t = sim.policy.time_in_state_ms;
+    CHECK(t[POWER_ACTIVE] + t[POWER_IDLE] + t[POWER_DIM] + t[POWER_SLEEP] == 120000);
+    CHECK(sim.policy.transitions == 3);
+    printf("2 min idle: active %u, idle %u, dim %u, sleep %u ms\n", (unsigned) t[POWER_ACTIVE], (unsigned) t[POWER_IDLE],
+        (unsigned) t[POWER_DIM], (unsigned) t[POWER_SLEEP]);
+
+    if (s_failures > 0)
+    {
+        fprintf(stderr, "%d check(s) failed\n", s_failures);
+        return 1;
+    }
+    return 0;
+}
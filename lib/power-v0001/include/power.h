@@ -0,0 +1,71 @@
+#pragma once
+#ifndef POWER_H_
+#define POWER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "driver/gpio.h"
+#include "esp_err.h"
+
+#include "power_policy.h"
+
+/**
+ * Manager de consum: un task care aplica power_policy_t.
+ * - ACTIVE tine un lock esp_pm ESP_PM_CPU_FREQ_MAX; in rest DFS coboara la min_freq_mhz.
+ * - SLEEP intra explicit in light sleep (esp_light_sleep_start()) pana la urmatorul termen
+ *   din LVGL, cu trezire pe timer si pe pinii din wake_pins. Light sleep-ul automat din esp_pm
+ *   cere CONFIG_FREERTOS_USE_TICKLESS_IDLE, care aici e oprit.
+ * Tot ce tine de LVGL / ecran vine prin callback-uri din power_config_t.
+ */
+
+#define POWER_MAX_WAKE_PINS (4)
+
+typedef struct {
+    gpio_num_t      pin;
+    int             level;    // nivelul activ (0 = activ pe low)
+    bool            watch;    // intrerupere pe frontul spre nivelul activ (ex. PENIRQ): activitate
+    gpio_int_type_t restore;  // tipul intreruperii pus inapoi dupa trezire (daca !watch)
+} power_wake_pin_t;
+
+typedef struct {
+    power_policy_config_t policy;
+    uint32_t              max_freq_mhz;
+    uint32_t              min_freq_mhz;
+    power_wake_pin_t      wake_pins[POWER_MAX_WAKE_PINS];
+    size_t                wake_pin_cnt;
+
+    // Completeaza inactive_ms, next_deadline_ms, busy si no_sleep (restul il pune managerul);
+    // false = nimic de citit acum (ex. LVGL nu raspunde), pasul se sare si se reia in curand
+    bool (*read_inputs)(power_inputs_t *in);
+    // La schimbarea starii, din task-ul managerului (ecran, citirea indev-urilor)
+    void (*on_state)(power_state_t from, power_state_t to);
+    // In jurul fiecarei bucati de light sleep; sleep_begin() == false amana (ex. LVGL ocupat)
+    bool (*sleep_begin)(void);
+    void (*sleep_end)(void);
+} power_config_t;
+
+typedef struct {
+    power_state_t state;
+    uint32_t      time_in_state_ms[POWER_STATE_COUNT];
+    uint32_t      transitions;
+    uint32_t      sleeps;       // bucati de light sleep
+    uint32_t      gpio_wakeups;
+    uint64_t      slept_us;     // masurat in jurul esp_light_sleep_start()
+} power_stats_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* #ifdef __cplusplus */
+
+    esp_err_t power_init(const power_config_t *config);
+    void power_request_sleep(void);    // din orice task
+    void power_notify_activity(void);  // din orice task (ex. callback-urile butoanelor)
+    power_state_t power_get_state(void);
+    void power_get_stats(power_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif /* #ifdef __cplusplus */
+#endif /* #ifndef POWER_H_ */
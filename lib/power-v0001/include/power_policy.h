@@ -0,0 +1,83 @@
+#pragma once
+#ifndef POWER_POLICY_H_
+#define POWER_POLICY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Politica de consum, fara nicio dependenta de ESP-IDF (se testeaza pe PC cu un ceas simulat).
+ * Liniste = min(inactivitatea LVGL, timp de la ultima intrerupere de touch / buton).
+ *   ACTIVE: CPU la frecventa maxima (lock esp_pm tinut)
+ *   IDLE:   lock eliberat, DFS coboara frecventa
+ *   DIM:    ecran stins, citirea indev-urilor oprita (trezirea vine pe intrerupere)
+ *   SLEEP:  light sleep pana la urmatorul termen din LVGL, in bucati de cel mult max_sleep_ms
+ */
+
+#define POWER_NO_DEADLINE (UINT32_MAX)
+
+typedef enum {
+    POWER_ACTIVE,
+    POWER_IDLE,
+    POWER_DIM,
+    POWER_SLEEP,
+    POWER_STATE_COUNT,
+} power_state_t;
+
+typedef struct {
+    uint32_t idle_after_ms;   // fara activitate atat timp -> IDLE
+    uint32_t dim_after_ms;    // -> DIM; 0 = niciodata
+    uint32_t sleep_after_ms;  // -> SLEEP; 0 = doar la cerere (power_request_sleep)
+    uint32_t min_sleep_ms;    // sub atat pana la urmatorul termen nu se intra in light sleep
+    uint32_t max_sleep_ms;    // o bucata de light sleep, apoi se reevalueaza
+} power_policy_config_t;
+
+#define POWER_POLICY_CONFIG_DEFAULT()   \
+    {                                   \
+        .idle_after_ms  = 500,          \
+        .dim_after_ms   = 30000,        \
+        .sleep_after_ms = 60000,        \
+        .min_sleep_ms   = 50,           \
+        .max_sleep_ms   = 5000,         \
+    }
+
+typedef struct {
+    uint32_t now_ms;
+    uint32_t inactive_ms;       // lv_display_get_inactive_time()
+    uint32_t next_deadline_ms;  // pana la urmatorul timer LVGL, POWER_NO_DEADLINE = niciunul
+    bool     wake_irq;          // PENIRQ / buton / trezire pe GPIO de la pasul precedent
+    bool     busy;              // animatii in curs, LVGL ocupat
+    bool     sleep_request;     // cerere explicita (butonul "Light Sleep")
+    bool     no_sleep;          // cel mult DIM, afara de cererea explicita (ex. consola USB conectata)
+} power_inputs_t;
+
+typedef struct {
+    power_state_t state;
+    power_state_t previous;
+    bool          changed;
+    uint32_t      sleep_ms;  // doar in POWER_SLEEP: cat se doarme acum, 0 = inca nu
+} power_decision_t;
+
+typedef struct {
+    power_policy_config_t config;
+    power_state_t         state;
+    uint32_t              last_step_ms;
+    uint32_t              last_irq_ms;
+    bool                  forced;  // SLEEP cerut explicit, pana la prima intrerupere
+    uint32_t              time_in_state_ms[POWER_STATE_COUNT];
+    uint32_t              transitions;
+} power_policy_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* #ifdef __cplusplus */
+
+    void power_policy_init(power_policy_t *policy, const power_policy_config_t *config, uint32_t now_ms);
+    power_decision_t power_policy_step(power_policy_t *policy, const power_inputs_t *in);
+    const char *power_state_name(power_state_t state);
+
+#ifdef __cplusplus
+}
+#endif /* #ifdef __cplusplus */
+#endif /* #ifndef POWER_POLICY_H_ */
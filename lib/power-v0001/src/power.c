@@ -0,0 +1,289 @@
+#include "power.h"
+
+#include <stdatomic.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_pm.h"
+#include "esp_sleep.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+static const char *TAG = "POWER";
+
+#define NOTIFY_WAKE  (1UL << 0)
+#define NOTIFY_SLEEP (1UL << 1)
+
+/* Cat asteapta task-ul intre pasi, per stare. In SLEEP doar cat sa ruleze LVGL termenul scadent. */
+static const uint32_t s_poll_ms[POWER_STATE_COUNT] = {
+    [POWER_ACTIVE] = 100,
+    [POWER_IDLE]   = 100,
+    [POWER_DIM]    = 250,
+    [POWER_SLEEP]  = 10,
+};
+#define SKIPPED_POLL_MS (10)  // dupa un pas sarit (read_inputs() fara esantion)
+
+static power_config_t    s_config;
+static power_policy_t    s_policy;
+static SemaphoreHandle_t s_lock     = NULL;  // s_policy + s_stats pentru power_get_stats()
+static TaskHandle_t      s_task     = NULL;
+static atomic_bool       s_irq      = false;
+static atomic_bool       s_sleep_rq = false;
+static power_stats_t     s_stats;
+#if CONFIG_PM_ENABLE
+static esp_pm_lock_handle_t s_cpu_lock = NULL;
+#endif /* #if CONFIG_PM_ENABLE */
+
+// -------------------------------------------------
+
+static uint32_t now_ms(void) {
+    return (uint32_t) (esp_timer_get_time() / 1000);
+}
+
+static void IRAM_ATTR wake_pin_isr(void *arg) {
+    (void) arg;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    atomic_store_explicit(&s_irq, true, memory_order_relaxed);
+    xTaskNotifyFromISR(s_task, NOTIFY_WAKE, eSetBits, &xHigherPriorityTaskWoken);
+    if (xHigherPriorityTaskWoken)
+    {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static gpio_int_type_t watch_edge(const power_wake_pin_t *wp) {
+    return wp->level ? GPIO_INTR_POSEDGE : GPIO_INTR_NEGEDGE;
+}
+
+static void set_cpu_lock(bool hold) {
+#if CONFIG_PM_ENABLE
+    if (s_cpu_lock != NULL)
+    {
+        if (hold)
+        {
+            esp_pm_lock_acquire(s_cpu_lock);
+        } else
+        {
+            esp_pm_lock_release(s_cpu_lock);
+        }
+    }
+#else
+    (void) hold;
+#endif /* #if CONFIG_PM_ENABLE */
+}
+
+static void log_transition(const power_decision_t *d) {
+    const uint32_t *t = s_policy.time_in_state_ms;
+    ESP_LOGI(TAG, "%s -> %s | active %lu.%lus, idle %lu.%lus, dim %lu.%lus, sleep %lu.%lus (%lu sleeps)",
+        power_state_name(d->previous), power_state_name(d->state), (unsigned long) (t[POWER_ACTIVE] / 1000),
+        (unsigned long) (t[POWER_ACTIVE] % 1000 / 100), (unsigned long) (t[POWER_IDLE] / 1000),
+        (unsigned long) (t[POWER_IDLE] % 1000 / 100), (unsigned long) (t[POWER_DIM] / 1000),
+        (unsigned long) (t[POWER_DIM] % 1000 / 100), (unsigned long) (t[POWER_SLEEP] / 1000),
+        (unsigned long) (t[POWER_SLEEP] % 1000 / 100), (unsigned long) s_stats.sleeps);
+}
+
+/* O bucata de light sleep. Timer-ul si pinii se armeaza doar aici, ca sa nu ramana active
+ * pentru un esp_light_sleep_start() chemat din alta parte. */
+static void light_sleep(uint32_t sleep_ms) {
+    if (s_config.sleep_begin != NULL && !s_config.sleep_begin())
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < s_config.wake_pin_cnt; i++)
+    {
+        const power_wake_pin_t *wp = &s_config.wake_pins[i];
+        /* Tipul pe nivel ramane si pentru intreruperea pinului: cu butonul tinut sau PENIRQ activ,
+         * handler-ul ar fi chemat in bucla pana la adormire */
+        gpio_intr_disable(wp->pin);
+        gpio_wakeup_enable(wp->pin, wp->level ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_LOW_LEVEL);
+    }
+    if (s_config.wake_pin_cnt > 0)
+    {
+        esp_sleep_enable_gpio_wakeup();
+    }
+    esp_sleep_enable_timer_wakeup((uint64_t) sleep_ms * 1000ULL);
+
+    int64_t   start = esp_timer_get_time();
+    esp_err_t err   = esp_light_sleep_start();
+    int64_t   slept = esp_timer_get_time() - start;
+
+    esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_TIMER);
+    if (s_config.wake_pin_cnt > 0)
+    {
+        esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
+    }
+    for (size_t i = 0; i < s_config.wake_pin_cnt; i++)
+    {
+        const power_wake_pin_t *wp = &s_config.wake_pins[i];
+        gpio_wakeup_disable(wp->pin);  // lasa pinul fara intrerupere
+        gpio_set_intr_type(wp->pin, wp->watch ? watch_edge(wp) : wp->restore);
+        if (wp->watch || wp->restore != GPIO_INTR_DISABLE)
+        {
+            gpio_intr_enable(wp->pin);
+        }
+    }
+
+    if (s_config.sleep_end != NULL)
+    {
+        s_config.sleep_end();
+    }
+
+    if (err != ESP_OK)
+    {
+        ESP_LOGW(TAG, "esp_light_sleep_start: %s", esp_err_to_name(err));
+        return;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    s_stats.sleeps++;
+    s_stats.slept_us += (uint64_t) slept;
+    if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_GPIO)
+    {
+        s_stats.gpio_wakeups++;
+        atomic_store_explicit(&s_irq, true, memory_order_relaxed);
+    }
+    xSemaphoreGive(s_lock);
+}
+
+static void power_task(void *parameter) {
+    (void) parameter;
+    bool skipped = false;
+    while (true)
+    {
+        uint32_t notified = 0;
+        xTaskNotifyWait(0x00, 0xFFFFFFFF, &notified, pdMS_TO_TICKS(skipped ? SKIPPED_POLL_MS : s_poll_ms[s_policy.state]));
+
+        power_inputs_t in = {
+            .next_deadline_ms = POWER_NO_DEADLINE,
+        };
+        /* Fara esantion nu se decide nimic: starea ramane, iar trezirile raman pentru pasul urmator */
+        skipped = !s_config.read_inputs(&in);
+        if (skipped)
+        {
+            continue;
+        }
+        in.now_ms        = now_ms();
+        in.wake_irq      = atomic_exchange_explicit(&s_irq, false, memory_order_relaxed);
+        in.sleep_request = atomic_exchange_explicit(&s_sleep_rq, false, memory_order_relaxed);
+
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        power_decision_t d = power_policy_step(&s_policy, &in);
+        xSemaphoreGive(s_lock);
+
+        if (d.changed)
+        {
+            if (d.state == POWER_ACTIVE || d.previous == POWER_ACTIVE)
+            {
+                set_cpu_lock(d.state == POWER_ACTIVE);
+            }
+            if (s_config.on_state != NULL)
+            {
+                s_config.on_state(d.previous, d.state);
+            }
+            log_transition(&d);
+        }
+        if (d.state == POWER_SLEEP && d.sleep_ms > 0)
+        {
+            light_sleep(d.sleep_ms);
+        }
+    }
+}
+
+// -------------------------------------------------
+
+esp_err_t power_init(const power_config_t *config) {
+    if (s_task != NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (config == NULL || config->read_inputs == NULL || config->wake_pin_cnt > POWER_MAX_WAKE_PINS)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_config = *config;
+    s_lock   = xSemaphoreCreateMutex();
+    if (s_lock == NULL)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    power_policy_init(&s_policy, &s_config.policy, now_ms());
+
+#if CONFIG_PM_ENABLE
+    esp_pm_config_t pm_config = {
+        .max_freq_mhz       = (int) s_config.max_freq_mhz,
+        .min_freq_mhz       = (int) s_config.min_freq_mhz,
+        .light_sleep_enable = false,
+    };
+    esp_err_t err = esp_pm_configure(&pm_config);
+    if (err == ESP_OK)
+    {
+        err = esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "power_active", &s_cpu_lock);
+    }
+    if (err != ESP_OK)
+    {
+        ESP_LOGW(TAG, "DFS unavailable: %s", esp_err_to_name(err));
+        s_cpu_lock = NULL;
+    }
+    set_cpu_lock(true);  // se porneste in ACTIVE
+#else
+    ESP_LOGW(TAG, "CONFIG_PM_ENABLE is off, only dim / light sleep");
+#endif /* #if CONFIG_PM_ENABLE */
+
+    if (xTaskCreate(power_task, "Power", 3072, NULL, tskIDLE_PRIORITY + 2, &s_task) != pdPASS)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t isr_err = gpio_install_isr_service(ESP_INTR_FLAG_LEVEL1);  // comun in tot proiectul
+    for (size_t i = 0; i < s_config.wake_pin_cnt; i++)
+    {
+        const power_wake_pin_t *wp = &s_config.wake_pins[i];
+        if (wp->watch && (isr_err == ESP_OK || isr_err == ESP_ERR_INVALID_STATE))
+        {
+            gpio_set_intr_type(wp->pin, watch_edge(wp));
+            gpio_isr_handler_add(wp->pin, wake_pin_isr, NULL);
+            gpio_intr_enable(wp->pin);
+        }
+    }
+
+    ESP_LOGI(TAG, "DFS %lu-%lu MHz, idle %lu ms, dim %lu ms, sleep %lu ms", (unsigned long) s_config.min_freq_mhz,
+        (unsigned long) s_config.max_freq_mhz, (unsigned long) s_config.policy.idle_after_ms,
+        (unsigned long) s_config.policy.dim_after_ms, (unsigned long) s_config.policy.sleep_after_ms);
+    return ESP_OK;
+}
+
+void power_request_sleep(void) {
+    atomic_store_explicit(&s_sleep_rq, true, memory_order_relaxed);
+    if (s_task != NULL)
+    {
+        xTaskNotify(s_task, NOTIFY_SLEEP, eSetBits);
+    }
+}
+
+void power_notify_activity(void) {
+    atomic_store_explicit(&s_irq, true, memory_order_relaxed);
+    if (s_task != NULL)
+    {
+        xTaskNotify(s_task, NOTIFY_WAKE, eSetBits);
+    }
+}
+
+power_state_t power_get_state(void) {
+    return s_policy.state;
+}
+
+void power_get_stats(power_stats_t *stats) {
+    if (stats == NULL || s_lock == NULL)
+    {
+        return;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    *stats       = s_stats;
+    stats->state = s_policy.state;
+    memcpy(stats->time_in_state_ms, s_policy.time_in_state_ms, sizeof(stats->time_in_state_ms));
+    stats->transitions = s_policy.transitions;
+    xSemaphoreGive(s_lock);
+}
@@ -0,0 +1,87 @@
+#include "power_policy.h"
+
+#include <string.h>
+
+static const char *const s_state_names[POWER_STATE_COUNT] = {
+    [POWER_ACTIVE] = "active",
+    [POWER_IDLE]   = "idle",
+    [POWER_DIM]    = "dim",
+    [POWER_SLEEP]  = "sleep",
+};
+
+// -------------------------------------------------
+
+void power_policy_init(power_policy_t *policy, const power_policy_config_t *config, uint32_t now_ms) {
+    memset(policy, 0, sizeof(*policy));
+    policy->config       = *config;
+    policy->state        = POWER_ACTIVE;
+    policy->last_step_ms = now_ms;
+    policy->last_irq_ms  = now_ms;  // pornirea conteaza ca activitate
+}
+
+static power_state_t quiet_state(const power_policy_config_t *config, uint32_t quiet_ms) {
+    if (config->sleep_after_ms != 0 && quiet_ms >= config->sleep_after_ms)
+    {
+        return POWER_SLEEP;
+    }
+    if (config->dim_after_ms != 0 && quiet_ms >= config->dim_after_ms)
+    {
+        return POWER_DIM;
+    }
+    return quiet_ms >= config->idle_after_ms ? POWER_IDLE : POWER_ACTIVE;
+}
+
+power_decision_t power_policy_step(power_policy_t *policy, const power_inputs_t *in) {
+    /* Timpul de la pasul precedent apartine starii de atunci (inclusiv light sleep-ul dormit) */
+    policy->time_in_state_ms[policy->state] += in->now_ms - policy->last_step_ms;
+    policy->last_step_ms = in->now_ms;
+
+    if (in->wake_irq)
+    {
+        policy->last_irq_ms = in->now_ms;
+        policy->forced      = false;
+    } else if (in->sleep_request)
+    {
+        policy->forced = true;
+    }
+
+    uint32_t since_irq = in->now_ms - policy->last_irq_ms;
+    uint32_t quiet_ms  = in->inactive_ms < since_irq ? in->inactive_ms : since_irq;
+
+    power_state_t next;
+    if (policy->forced)
+    {
+        next = POWER_SLEEP;  // cererea vine chiar dintr-un click, deci inactivitatea e ~0
+    } else if (in->busy)
+    {
+        next = POWER_ACTIVE;
+    } else
+    {
+        next = quiet_state(&policy->config, quiet_ms);
+        if (next == POWER_SLEEP && in->no_sleep)
+        {
+            next = POWER_DIM;
+        }
+    }
+
+    power_decision_t d = {
+        .state    = next,
+        .previous = policy->state,
+        .changed  = next != policy->state,
+        .sleep_ms = 0,
+    };
+    if (next == POWER_SLEEP && in->next_deadline_ms >= policy->config.min_sleep_ms)
+    {
+        d.sleep_ms = in->next_deadline_ms < policy->config.max_sleep_ms ? in->next_deadline_ms : policy->config.max_sleep_ms;
+    }
+    if (d.changed)
+    {
+        policy->transitions++;
+        policy->state = next;
+    }
+    return d;
+}
+
+const char *power_state_name(power_state_t state) {
+    return state < POWER_STATE_COUNT ? s_state_names[state] : "?";
+}
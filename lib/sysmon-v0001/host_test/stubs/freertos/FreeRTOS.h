@@ -0,0 +1,33 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef unsigned UBaseType_t;
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+typedef uint8_t StackType_t;
+
+#define configMAX_TASK_NAME_LEN 16
+#define configRUN_TIME_COUNTER_TYPE uint32_t
+#define portNUM_PROCESSORS 2
+#define portMAX_DELAY 0xffffffffu
+#define pdTRUE 1
+#define pdPASS 1
+#define tskIDLE_PRIORITY 0
+#define pdMS_TO_TICKS(ms) (ms)
+
+// newlib din ESP-IDF are strlcpy(); glibc abia de la 2.38
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+static inline size_t strlcpy(char *dst, const char *src, size_t size) {
+    size_t len = strlen(src);
+    if (size > 0)
+    {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#endif
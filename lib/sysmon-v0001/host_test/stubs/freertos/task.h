@@ -0,0 +1,67 @@
+#pragma once
+// task-urile FreeRTOS devin thread-uri detasate; un tick = 1 ms de CLOCK_MONOTONIC
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+
+typedef struct {
+    TaskHandle_t xHandle;
+    const char  *pcTaskName;
+    uint32_t     usStackHighWaterMark;
+    BaseType_t   xCoreID;
+} TaskStatus_t;
+
+typedef struct {
+    void (*fn)(void *);
+    void *arg;
+} host_task_t;
+
+static inline void *host_task_entry(void *p) {
+    host_task_t t = *(host_task_t *)p;
+    free(p);
+    t.fn(t.arg);
+    return NULL;
+}
+
+static inline int xTaskCreate(void (*fn)(void *), const char *name, uint32_t stack, void *arg,
+                              UBaseType_t prio, TaskHandle_t *handle) {
+    (void)name, (void)stack, (void)prio;
+    pthread_t th;
+    host_task_t *t = malloc(sizeof(*t));
+    t->fn = fn;
+    t->arg = arg;
+    if (pthread_create(&th, NULL, host_task_entry, t) != 0)
+    {
+        free(t);
+        return 0;
+    }
+    pthread_detach(th);
+    if (handle != NULL)
+        *handle = (TaskHandle_t)th;
+    return pdPASS;
+}
+
+static inline TickType_t xTaskGetTickCount(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (TickType_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+// ca in FreeRTOS: trezirea e la *last + period, nu la acum + period
+static inline void vTaskDelayUntil(TickType_t *last, TickType_t period) {
+    *last += period;
+    int32_t left = (int32_t)(*last - xTaskGetTickCount());
+    if (left > 0)
+    {
+        struct timespec ts = {left / 1000, (left % 1000) * 1000000L};
+        nanosleep(&ts, NULL);
+    }
+}
+
+// implementate de test
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *status, UBaseType_t max, uint32_t *total_run_time);
+configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounter(TaskHandle_t task);
+TaskHandle_t xTaskGetIdleTaskHandleForCore(BaseType_t core);
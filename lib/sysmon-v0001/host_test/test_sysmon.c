@@ -0,0 +1,196 @@
+/*
+ * Test pe host pentru sysmon (src/sysmon.c), cu task-ul real pe un thread si perioada scurta:
+ *  - incarcarea CPU din timpul task-ului IDLE si alarma CPU; compilat fara
+ *    CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS, incarcarea lipseste si alarma CPU nu porneste niciodata;
+ *  - overhead-ul: cel mai mare bloc costa 1 ms per heap (parcurge tot heap-ul, ca pe ESP32), deci
+ *    scanarea detaliata la fiecare esantion depaseste bugetul; task-ul trebuie sa o rareasca pana
+ *    timpul petrecut in ea, masurat separat de test, ramane sub SYSMON_BUDGET_PPM.
+ *
+ *   cmake -S lib/sysmon-v0001/host_test -B build_host && cmake --build build_host && ctest --test-dir build_host
+ */
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sysmon.h"
+
+#define PERIOD_MS      10
+#define SCAN_US        1000  // heap_caps_get_largest_free_block()
+#define LOAD_CORE0     950   // promile
+#define MEASURE_PERIOD (2 * SYSMON_SCAN_EVERY_MAX)  // esantioane masurate dupa ce scanarea s-a rarit
+
+static int s_failures;
+
+#define CHECK(cond)                                                    \
+    do                                                                 \
+    {                                                                  \
+        if (!(cond))                                                   \
+        {                                                              \
+            fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #cond); \
+            s_failures++;                                              \
+        }                                                              \
+    } while (0)
+
+static int64_t        s_t0;
+static atomic_uint    s_scan_us;  // timpul petrecut in heap_caps_get_largest_free_block()
+static atomic_uint    s_cpu_alarms[2];
+static atomic_bool    s_cpu_alarm_active[2];
+static TaskStatus_t   s_fake_tasks[] = {
+    {(TaskHandle_t) 1, "main", 900, 0},
+    {(TaskHandle_t) 2, "IDLE0", 300, 0},
+    {(TaskHandle_t) 3, "Sysmon", 1200, 2},
+};
+
+static void sleep_ms(int ms) {
+    struct timespec ts = {ms / 1000, (ms % 1000) * 1000000L};
+    nanosleep(&ts, NULL);
+}
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *status, UBaseType_t max, uint32_t *total_run_time) {
+    (void) total_run_time;
+    UBaseType_t n = sizeof(s_fake_tasks) / sizeof(s_fake_tasks[0]);
+    if (n > max)
+    {
+        return 0;
+    }
+    memcpy(status, s_fake_tasks, sizeof(s_fake_tasks));
+    return n;
+}
+
+/* Core 0 sta in IDLE 5% din timp, core 1 tot timpul */
+TaskHandle_t xTaskGetIdleTaskHandleForCore(BaseType_t core) {
+    return (TaskHandle_t) (intptr_t) (100 + core);
+}
+
+configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounter(TaskHandle_t task) {
+    int64_t us = esp_timer_get_time() - s_t0;
+    return (configRUN_TIME_COUNTER_TYPE) (task == xTaskGetIdleTaskHandleForCore(0) ? us * (1000 - LOAD_CORE0) / 1000 : us);
+}
+
+size_t heap_caps_get_total_size(uint32_t caps) {
+    return caps == MALLOC_CAP_SPIRAM ? 0 : 300 * 1024;
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    (void) caps;
+    return 200 * 1024;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    (void) caps;
+    int64_t t0 = esp_timer_get_time();
+    while (esp_timer_get_time() - t0 < SCAN_US)
+    {
+    }
+    atomic_fetch_add(&s_scan_us, (unsigned) (esp_timer_get_time() - t0));
+    return 100 * 1024;
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    (void) caps;
+    return 150 * 1024;
+}
+
+static void on_alarm(const sysmon_alarm_t *alarm, void *ctx) {
+    (void) ctx;
+    if (alarm->kind != SYSMON_ALARM_CPU)
+    {
+        return;
+    }
+    int core = strcmp(alarm->name, "core1") == 0;
+    atomic_store(&s_cpu_alarm_active[core], alarm->active);
+    if (alarm->active)
+    {
+        atomic_fetch_add(&s_cpu_alarms[core], 1);
+    }
+}
+
+static void check_cpu(void) {
+    sysmon_stats_t st;
+    sysmon_get_stats(&st);
+    uint32_t cpu0[8], cpu1[8];
+    size_t   n = sysmon_get_series(SYSMON_SERIES_CPU0, cpu0, 8);
+    CHECK(sysmon_get_series(SYSMON_SERIES_CPU1, cpu1, 8) == n && n == 8);
+    printf("cpu load %s: core0 %u, core1 %u | CPU alarms core0 %u core1 %u\n", st.cpu_load ? "available" : "n/a",
+           (unsigned) cpu0[n - 1], (unsigned) cpu1[n - 1], atomic_load(&s_cpu_alarms[0]), atomic_load(&s_cpu_alarms[1]));
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    CHECK(st.cpu_load);
+    for (size_t i = 1; i < n; i++)  // primul poate include timpul dinainte de prima trezire
+    {
+        CHECK(cpu0[i] >= LOAD_CORE0 - 20 && cpu0[i] <= LOAD_CORE0 + 20);
+        CHECK(cpu1[i] <= 20);
+    }
+    CHECK(atomic_load(&s_cpu_alarms[0]) == 1 && atomic_load(&s_cpu_alarm_active[0]));
+    CHECK(atomic_load(&s_cpu_alarms[1]) == 0);
+#else
+    CHECK(!st.cpu_load);
+    for (size_t i = 0; i < n; i++)
+    {
+        CHECK(cpu0[i] == SYSMON_LOAD_NONE && cpu1[i] == SYSMON_LOAD_NONE);
+    }
+    CHECK(atomic_load(&s_cpu_alarms[0]) == 0 && atomic_load(&s_cpu_alarms[1]) == 0);
+#endif
+}
+
+int main(void) {
+    s_t0 = esp_timer_get_time();
+
+    sysmon_config_t config   = SYSMON_CONFIG_DEFAULT();
+    config.period_ms         = PERIOD_MS;
+    config.scan_every        = 1;
+    config.cpu_alarm_samples = 3;
+    config.on_alarm          = on_alarm;
+    CHECK(sysmon_init(&config) == ESP_OK);
+    CHECK(sysmon_init(&config) == ESP_ERR_INVALID_STATE);
+
+    // 20 de esantioane: seriile CPU si alarma
+    sleep_ms(20 * PERIOD_MS);
+    check_cpu();
+
+    sysmon_task_t tasks[SYSMON_MAX_TASKS];
+    CHECK(sysmon_get_tasks(tasks, SYSMON_MAX_TASKS) == 3);
+    CHECK(strcmp(tasks[0].name, "IDLE0") == 0 && tasks[0].stack_free == 300);
+    CHECK(sysmon_get_last(SYSMON_SERIES_STACK_MIN) == 300);
+    CHECK(sysmon_get_last(SYSMON_SERIES_LARGEST_DMA) == 100 * 1024);
+
+    // scanarea la fiecare esantion costa 2 x SCAN_US din PERIOD_MS (20%): se rareste pana la SYSMON_SCAN_EVERY_MAX
+    sysmon_stats_t st;
+    for (int i = 0; i < 500; i++)
+    {
+        sysmon_get_stats(&st);
+        if (st.scan_every >= SYSMON_SCAN_EVERY_MAX)
+        {
+            break;
+        }
+        sleep_ms(PERIOD_MS);
+    }
+    CHECK(st.scan_every == SYSMON_SCAN_EVERY_MAX);
+
+    // masurat de test, independent de sysmon: timpul din scanari raportat la timpul scurs
+    unsigned scan_us0 = atomic_load(&s_scan_us);
+    int64_t  t0       = esp_timer_get_time();
+    sleep_ms(MEASURE_PERIOD * PERIOD_MS);
+    unsigned ppm = (unsigned) ((atomic_load(&s_scan_us) - scan_us0) * 1000000ULL / (uint64_t) (esp_timer_get_time() - t0));
+    sysmon_get_stats(&st);
+    printf("overhead: measured %u ppm, sysmon %u ppm (budget %d) | scan every %u samples, max sample %u us, "
+           "%u samples\n",
+           ppm, (unsigned) st.overhead_ppm, SYSMON_BUDGET_PPM, (unsigned) st.scan_every, (unsigned) st.sample_us_max,
+           (unsigned) st.samples);
+    CHECK(ppm > 0 && ppm < SYSMON_BUDGET_PPM);
+    CHECK(st.overhead_ppm > 0 && st.overhead_ppm < SYSMON_BUDGET_PPM);
+    CHECK(st.scan_every == SYSMON_SCAN_EVERY_MAX);  // ferestrele fara scanare nu il mai injumatatesc
+    CHECK(st.sample_us_max >= 2 * SCAN_US);
+
+    if (s_failures > 0)
+    {
+        fprintf(stderr, "%d check(s) failed\n", s_failures);
+        return 1;
+    }
+    printf("sysmon host test: OK\n");
+    return 0;
+}
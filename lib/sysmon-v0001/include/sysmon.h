@@ -0,0 +1,124 @@
+#pragma once
+#ifndef SYSMON_H_
+#define SYSMON_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+/**
+ * Monitor de sistem in fundal: incarcarea per core, heap liber / cel mai mare bloc
+ * per capabilitate si stiva minima ramasa per task, pastrate ca serii de lungime fixa.
+ * Depasirea pragurilor din sysmon_config_t da alarme (o data la intrare, o data la iesire).
+ * Task-ul isi masoara propriul timp de lucru; daca trece de SYSMON_BUDGET_PPM din CPU,
+ * rareste scanarea detaliata (stive + cel mai mare bloc, partea scumpa) pana revine sub buget.
+ */
+
+#define SYSMON_HISTORY_LEN   (120)   // esantioane per serie (2 minute la 1 s)
+#define SYSMON_MAX_TASKS     (40)
+#define SYSMON_BUDGET_PPM    (5000)  // 0.5% dintr-un core
+#define SYSMON_SCAN_EVERY_MAX (64)
+#define SYSMON_LOAD_NONE     (UINT32_MAX)  // in seriile CPU cand incarcarea nu se poate masura
+
+typedef enum {
+    SYSMON_HEAP_INTERNAL,
+    SYSMON_HEAP_DMA,
+    SYSMON_HEAP_PSRAM,
+    SYSMON_HEAP_COUNT,
+} sysmon_heap_t;
+
+typedef enum {
+    SYSMON_SERIES_CPU0,            // incarcare core 0, in promile; SYSMON_LOAD_NONE fara run-time stats
+    SYSMON_SERIES_CPU1,
+    SYSMON_SERIES_FREE_INTERNAL,   // bytes
+    SYSMON_SERIES_FREE_DMA,
+    SYSMON_SERIES_FREE_PSRAM,
+    SYSMON_SERIES_LARGEST_INTERNAL,
+    SYSMON_SERIES_LARGEST_DMA,
+    SYSMON_SERIES_LARGEST_PSRAM,
+    SYSMON_SERIES_STACK_MIN,       // cea mai mica stiva ramasa dintre toate task-urile, bytes
+    SYSMON_SERIES_COUNT,
+} sysmon_series_t;
+
+typedef enum {
+    SYSMON_ALARM_STACK,    // `name` = task-ul
+    SYSMON_ALARM_HEAP,     // `name` = capabilitatea; liber sub prag
+    SYSMON_ALARM_LARGEST,  // cel mai mare bloc sub prag (fragmentare)
+    SYSMON_ALARM_CPU,      // `name` = "core0"/"core1"; valoare in promile
+} sysmon_alarm_kind_t;
+
+typedef struct {
+    sysmon_alarm_kind_t kind;
+    bool                active;     // false = a revenit sub prag
+    const char         *name;
+    uint32_t            value;
+    uint32_t            threshold;
+} sysmon_alarm_t;
+
+/* Se apeleaza din task-ul sysmon; nu trebuie sa blocheze */
+typedef void (*sysmon_alarm_cb_t)(const sysmon_alarm_t *alarm, void *ctx);
+
+typedef struct {
+    uint32_t          period_ms;                           // intre esantioane
+    uint32_t          scan_every;                          // stive + cel mai mare bloc la fiecare N esantioane
+    uint32_t          stack_alarm_bytes;                   // 0 = fara alarma
+    uint32_t          heap_alarm_bytes[SYSMON_HEAP_COUNT];
+    uint32_t          largest_alarm_bytes[SYSMON_HEAP_COUNT];
+    uint16_t          cpu_alarm_permille;                  // 0 = fara alarma
+    uint8_t           cpu_alarm_samples;                   // esantioane consecutive peste prag
+    sysmon_alarm_cb_t on_alarm;                            // NULL = doar ESP_LOGW
+    void             *ctx;
+} sysmon_config_t;
+
+#define SYSMON_CONFIG_DEFAULT()                                          \
+    {                                                                    \
+        .period_ms           = 1000,                                     \
+        .scan_every          = 5,                                        \
+        .stack_alarm_bytes   = 512,                                      \
+        .heap_alarm_bytes    = {16 * 1024, 8 * 1024, 256 * 1024},        \
+        .largest_alarm_bytes = {4 * 1024, 4 * 1024, 64 * 1024},          \
+        .cpu_alarm_permille  = 900,                                      \
+        .cpu_alarm_samples   = 5,                                        \
+        .on_alarm            = NULL,                                     \
+        .ctx                 = NULL,                                     \
+    }
+
+typedef struct {
+    char     name[configMAX_TASK_NAME_LEN];
+    uint32_t stack_free;   // high-water mark, bytes
+    uint8_t  core;         // 0, 1 sau 2 = oricare
+    bool     alarm;
+} sysmon_task_t;
+
+typedef struct {
+    uint32_t samples;
+    bool     cpu_load;       // false = fara CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS: fara incarcare si alarma CPU
+    uint32_t overhead_ppm;   // timpul task-ului sysmon / timpul scurs, pe ultimele esantioane
+    uint32_t sample_us_max;  // cel mai lung esantion
+    uint32_t scan_every;     // intervalul curent al scanarii detaliate (dupa ajustarea la buget)
+    uint32_t alarms;         // alarme declansate de la pornire
+    uint32_t min_free_ever[SYSMON_HEAP_COUNT];  // heap_caps_get_minimum_free_size()
+} sysmon_stats_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* #ifdef __cplusplus */
+
+    // `config` NULL = SYSMON_CONFIG_DEFAULT()
+    esp_err_t sysmon_init(const sysmon_config_t *config);
+    // copiaza ultimele `max` valori ale seriei, de la cea mai veche la cea mai noua; intoarce cate
+    size_t sysmon_get_series(sysmon_series_t series, uint32_t *out, size_t max);
+    // ultima valoare a seriei (0 daca inca nu exista esantioane)
+    uint32_t sysmon_get_last(sysmon_series_t series);
+    // task-urile de la ultima scanare, sortate crescator dupa stiva ramasa
+    size_t sysmon_get_tasks(sysmon_task_t *out, size_t max);
+    void sysmon_get_stats(sysmon_stats_t *stats);
+    const char *sysmon_series_name(sysmon_series_t series);
+
+#ifdef __cplusplus
+}
+#endif /* #ifdef __cplusplus */
+#endif /* #ifndef SYSMON_H_ */
@@ -0,0 +1,397 @@
+#include "sysmon.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char *TAG = "SYSMON";
+
+#define OVERHEAD_WINDOW (16)  // minimul de esantioane peste care se calculeaza overhead_ppm
+
+static const uint32_t    s_heap_caps[SYSMON_HEAP_COUNT]  = {MALLOC_CAP_INTERNAL, MALLOC_CAP_DMA, MALLOC_CAP_SPIRAM};
+static const char *const s_heap_names[SYSMON_HEAP_COUNT] = {"internal", "dma", "psram"};
+static const char *const s_series_names[SYSMON_SERIES_COUNT] = {
+    [SYSMON_SERIES_CPU0]             = "cpu0",
+    [SYSMON_SERIES_CPU1]             = "cpu1",
+    [SYSMON_SERIES_FREE_INTERNAL]    = "free_internal",
+    [SYSMON_SERIES_FREE_DMA]         = "free_dma",
+    [SYSMON_SERIES_FREE_PSRAM]       = "free_psram",
+    [SYSMON_SERIES_LARGEST_INTERNAL] = "largest_internal",
+    [SYSMON_SERIES_LARGEST_DMA]      = "largest_dma",
+    [SYSMON_SERIES_LARGEST_PSRAM]    = "largest_psram",
+    [SYSMON_SERIES_STACK_MIN]        = "stack_min",
+};
+
+static sysmon_config_t   s_config;
+static SemaphoreHandle_t s_lock = NULL;
+static TaskHandle_t      s_task = NULL;
+
+/* Scrise doar de task-ul sysmon si doar sub s_lock (task-ul le poate citi si fara) */
+static uint32_t       s_series[SYSMON_SERIES_COUNT][SYSMON_HISTORY_LEN];
+static uint32_t       s_head  = 0;  // urmatorul index scris
+static uint32_t       s_count = 0;
+static sysmon_task_t  s_tasks[SYSMON_MAX_TASKS];
+static size_t         s_task_cnt = 0;
+static sysmon_stats_t s_stats;
+
+/* Doar task-ul sysmon */
+static TaskStatus_t s_status[SYSMON_MAX_TASKS];
+static TaskHandle_t s_stack_alarmed[SYSMON_MAX_TASKS];  // high-water mark nu mai creste: o alarma per task
+static size_t       s_stack_alarmed_cnt = 0;
+static bool         s_heap_alarm[SYSMON_HEAP_COUNT];
+static bool         s_largest_alarm[SYSMON_HEAP_COUNT];
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+static const char *const s_core_names[] = {"core0", "core1"};
+static bool              s_cpu_alarm[portNUM_PROCESSORS];
+static uint8_t           s_cpu_over[portNUM_PROCESSORS];
+static uint64_t          s_idle_prev[portNUM_PROCESSORS];
+static int64_t           s_time_prev = 0;
+#endif
+
+// -------------------------------------------------
+
+static void raise_alarm(sysmon_alarm_kind_t kind, bool active, const char *name, uint32_t value, uint32_t threshold) {
+    sysmon_alarm_t alarm = {
+        .kind      = kind,
+        .active    = active,
+        .name      = name,
+        .value     = value,
+        .threshold = threshold,
+    };
+    if (active)
+    {
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        s_stats.alarms++;
+        xSemaphoreGive(s_lock);
+        ESP_LOGW(TAG, "%s: %lu (limit %lu)", name, (unsigned long) value, (unsigned long) threshold);
+    } else
+    {
+        ESP_LOGI(TAG, "%s back to %lu", name, (unsigned long) value);
+    }
+    if (s_config.on_alarm != NULL)
+    {
+        s_config.on_alarm(&alarm, s_config.ctx);
+    }
+}
+
+/* Sub prag = alarma; iese abia la prag + 1/8, ca sa nu oscileze */
+static void check_low(sysmon_alarm_kind_t kind, bool *state, const char *name, uint32_t value, uint32_t threshold) {
+    if (threshold == 0)
+    {
+        return;
+    }
+    if (!*state && value < threshold)
+    {
+        *state = true;
+        raise_alarm(kind, true, name, value, threshold);
+    } else if (*state && value > threshold + threshold / 8)
+    {
+        *state = false;
+        raise_alarm(kind, false, name, value, threshold);
+    }
+}
+
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+static uint64_t idle_time(int core) {
+    return ulTaskGetRunTimeCounter(xTaskGetIdleTaskHandleForCore(core));
+}
+#endif
+
+/* Incarcarea in promile = 1 - timpul task-ului IDLE / timpul scurs (contorul e in us, de la esp_timer) */
+static void sample_cpu(uint32_t *row) {
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    int64_t now     = esp_timer_get_time();
+    int64_t elapsed = now - s_time_prev;
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        uint64_t idle  = idle_time(core);
+        uint64_t delta = (uint64_t) (configRUN_TIME_COUNTER_TYPE) (idle - s_idle_prev[core]);
+        uint32_t load  = 0;
+        if (elapsed > 0 && delta < (uint64_t) elapsed)
+        {
+            load = (uint32_t) (1000 - delta * 1000 / (uint64_t) elapsed);
+        }
+        s_idle_prev[core]             = idle;
+        row[SYSMON_SERIES_CPU0 + core] = load;
+
+        if (s_config.cpu_alarm_permille == 0)
+        {
+            continue;
+        }
+        s_cpu_over[core] = load > s_config.cpu_alarm_permille ? s_cpu_over[core] + (s_cpu_over[core] < UINT8_MAX) : 0;
+        if (!s_cpu_alarm[core] && s_cpu_over[core] >= s_config.cpu_alarm_samples)
+        {
+            s_cpu_alarm[core] = true;
+            raise_alarm(SYSMON_ALARM_CPU, true, s_core_names[core], load, s_config.cpu_alarm_permille);
+        } else if (s_cpu_alarm[core] && load < (uint32_t) (s_config.cpu_alarm_permille - s_config.cpu_alarm_permille / 8))
+        {
+            s_cpu_alarm[core] = false;
+            raise_alarm(SYSMON_ALARM_CPU, false, s_core_names[core], load, s_config.cpu_alarm_permille);
+        }
+    }
+    s_time_prev = now;
+#else
+    /* Fara timpul task-ului IDLE incarcarea ar parea 100%: nu se raporteaza si nu da alarme */
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        row[SYSMON_SERIES_CPU0 + core] = SYSMON_LOAD_NONE;
+    }
+#endif
+}
+
+static void sample_heap(uint32_t *row, bool scan) {
+    for (int h = 0; h < SYSMON_HEAP_COUNT; h++)
+    {
+        uint32_t total = (uint32_t) heap_caps_get_total_size(s_heap_caps[h]);
+        if (total == 0)
+        {
+            continue;  // fara PSRAM
+        }
+        uint32_t free_bytes              = (uint32_t) heap_caps_get_free_size(s_heap_caps[h]);
+        row[SYSMON_SERIES_FREE_INTERNAL + h] = free_bytes;
+        check_low(SYSMON_ALARM_HEAP, &s_heap_alarm[h], s_heap_names[h], free_bytes, s_config.heap_alarm_bytes[h]);
+
+        /* Cel mai mare bloc parcurge tot heap-ul: doar la scanarea detaliata */
+        if (scan)
+        {
+            uint32_t largest                        = (uint32_t) heap_caps_get_largest_free_block(s_heap_caps[h]);
+            row[SYSMON_SERIES_LARGEST_INTERNAL + h] = largest;
+            uint32_t min_free_ever                  = (uint32_t) heap_caps_get_minimum_free_size(s_heap_caps[h]);
+            xSemaphoreTake(s_lock, portMAX_DELAY);
+            s_stats.min_free_ever[h] = min_free_ever;
+            xSemaphoreGive(s_lock);
+            check_low(SYSMON_ALARM_LARGEST, &s_largest_alarm[h], s_heap_names[h], largest, s_config.largest_alarm_bytes[h]);
+        }
+    }
+}
+
+static bool stack_alarmed(TaskHandle_t handle) {
+    for (size_t i = 0; i < s_stack_alarmed_cnt; i++)
+    {
+        if (s_stack_alarmed[i] == handle)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int task_cmp(const void *a, const void *b) {
+    const sysmon_task_t *x = (const sysmon_task_t *) a;
+    const sysmon_task_t *y = (const sysmon_task_t *) b;
+    return (x->stack_free > y->stack_free) - (x->stack_free < y->stack_free);
+}
+
+/* uxTaskGetSystemState() calculeaza si high-water mark-ul fiecarei stive */
+static void sample_stacks(uint32_t *row) {
+    UBaseType_t n = uxTaskGetSystemState(s_status, SYSMON_MAX_TASKS, NULL);
+    if (n == 0)
+    {
+        return;  // mai multe task-uri decat SYSMON_MAX_TASKS
+    }
+
+    static sysmon_task_t tasks[SYSMON_MAX_TASKS];
+    uint32_t             stack_min = UINT32_MAX;
+    for (UBaseType_t i = 0; i < n; i++)
+    {
+        const TaskStatus_t *st   = &s_status[i];
+        uint32_t            left = (uint32_t) st->usStackHighWaterMark * sizeof(StackType_t);
+        bool                hit  = s_config.stack_alarm_bytes > 0 && left < s_config.stack_alarm_bytes;
+        if (hit && !stack_alarmed(st->xHandle) && s_stack_alarmed_cnt < SYSMON_MAX_TASKS)
+        {
+            s_stack_alarmed[s_stack_alarmed_cnt++] = st->xHandle;
+            raise_alarm(SYSMON_ALARM_STACK, true, st->pcTaskName, left, s_config.stack_alarm_bytes);
+        }
+        strlcpy(tasks[i].name, st->pcTaskName, sizeof(tasks[i].name));
+        tasks[i].stack_free = left;
+        tasks[i].core       = st->xCoreID < portNUM_PROCESSORS ? (uint8_t) st->xCoreID : portNUM_PROCESSORS;
+        tasks[i].alarm      = hit;
+        stack_min           = left < stack_min ? left : stack_min;
+    }
+    qsort(tasks, n, sizeof(sysmon_task_t), task_cmp);
+    row[SYSMON_SERIES_STACK_MIN] = stack_min;
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    memcpy(s_tasks, tasks, n * sizeof(sysmon_task_t));
+    s_task_cnt = n;
+    xSemaphoreGive(s_lock);
+}
+
+static void sample(bool scan) {
+    uint32_t row[SYSMON_SERIES_COUNT];
+
+    /* Ce nu se masoara la esantionul curent pastreaza valoarea precedenta */
+    uint32_t prev = (s_head + SYSMON_HISTORY_LEN - 1) % SYSMON_HISTORY_LEN;
+    for (int s = 0; s < SYSMON_SERIES_COUNT; s++)
+    {
+        row[s] = s_series[s][prev];
+    }
+
+    sample_cpu(row);
+    sample_heap(row, scan);
+    if (scan)
+    {
+        sample_stacks(row);
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    for (int s = 0; s < SYSMON_SERIES_COUNT; s++)
+    {
+        s_series[s][s_head] = row[s];
+    }
+    s_head = (s_head + 1) % SYSMON_HISTORY_LEN;
+    if (s_count < SYSMON_HISTORY_LEN)
+    {
+        s_count++;
+    }
+    s_stats.samples++;
+    xSemaphoreGive(s_lock);
+}
+
+static void sysmon_task(void *parameter) {
+    (void) parameter;
+    TickType_t last       = xTaskGetTickCount();
+    uint32_t   n          = 0;
+    uint32_t   window_n   = 0;
+    uint64_t   window_us  = 0;
+    int64_t    window_t0  = esp_timer_get_time();
+
+    while (true)
+    {
+        vTaskDelayUntil(&last, pdMS_TO_TICKS(s_config.period_ms));
+
+        int64_t t0 = esp_timer_get_time();
+        sample(n++ % s_stats.scan_every == 0);
+        uint32_t us = (uint32_t) (esp_timer_get_time() - t0);
+        window_us += us;
+        if (us > s_stats.sample_us_max)
+        {
+            xSemaphoreTake(s_lock, portMAX_DELAY);
+            s_stats.sample_us_max = us;
+            xSemaphoreGive(s_lock);
+        }
+
+        /* Fereastra are un multiplu de scan_every esantioane, deci acelasi numar de scanari: altfel
+         * o fereastra fara scanare pare ieftina si intervalul oscileaza cand scan_every > OVERHEAD_WINDOW */
+        if (++window_n < OVERHEAD_WINDOW || window_n % s_stats.scan_every != 0)
+        {
+            continue;
+        }
+        int64_t  elapsed    = esp_timer_get_time() - window_t0;
+        uint32_t ppm        = elapsed > 0 ? (uint32_t) (window_us * 1000000ULL / (uint64_t) elapsed) : 0;
+        uint32_t scan_every = s_stats.scan_every;
+        /* Peste buget: scanarea detaliata de doua ori mai rar; mult sub buget: revine spre config */
+        if (ppm > SYSMON_BUDGET_PPM && scan_every < SYSMON_SCAN_EVERY_MAX)
+        {
+            scan_every *= 2;
+            ESP_LOGW(TAG, "Overhead %lu ppm, detailed scan every %lu samples", (unsigned long) ppm, (unsigned long) scan_every);
+        } else if (ppm < SYSMON_BUDGET_PPM / 4 && scan_every / 2 >= s_config.scan_every)
+        {
+            scan_every /= 2;
+        }
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        s_stats.overhead_ppm = ppm;
+        s_stats.scan_every   = scan_every;
+        xSemaphoreGive(s_lock);
+        window_n  = 0;
+        window_us = 0;
+        window_t0 = esp_timer_get_time();
+    }
+}
+
+// -------------------------------------------------
+
+esp_err_t sysmon_init(const sysmon_config_t *config) {
+    static const sysmon_config_t default_config = SYSMON_CONFIG_DEFAULT();
+    if (s_task != NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_config = config != NULL ? *config : default_config;
+    if (s_config.period_ms == 0 || s_config.scan_every == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_stats.scan_every = s_config.scan_every;
+
+    s_lock = xSemaphoreCreateMutex();
+    if (s_lock == NULL)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    s_stats.cpu_load = true;
+    s_time_prev      = esp_timer_get_time();
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        s_idle_prev[core] = idle_time(core);
+    }
+#else
+    ESP_LOGW(TAG, "CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS is off: no CPU load");
+#endif
+    /* Stiva: qsort + copia locala a tabelului de task-uri */
+    if (xTaskCreate(sysmon_task, "Sysmon", 3072, NULL, tskIDLE_PRIORITY + 1, &s_task) != pdPASS)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    ESP_LOGI(TAG, "Sampling every %lu ms", (unsigned long) s_config.period_ms);
+    return ESP_OK;
+}
+
+size_t sysmon_get_series(sysmon_series_t series, uint32_t *out, size_t max) {
+    if (s_lock == NULL || series >= SYSMON_SERIES_COUNT || out == NULL)
+    {
+        return 0;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    size_t n     = s_count < max ? s_count : max;
+    size_t start = (s_head + SYSMON_HISTORY_LEN - n) % SYSMON_HISTORY_LEN;
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = s_series[series][(start + i) % SYSMON_HISTORY_LEN];
+    }
+    xSemaphoreGive(s_lock);
+    return n;
+}
+
+uint32_t sysmon_get_last(sysmon_series_t series) {
+    uint32_t value = 0;
+    sysmon_get_series(series, &value, 1);
+    return value;
+}
+
+size_t sysmon_get_tasks(sysmon_task_t *out, size_t max) {
+    if (s_lock == NULL || out == NULL)
+    {
+        return 0;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    size_t n = s_task_cnt < max ? s_task_cnt : max;
+    memcpy(out, s_tasks, n * sizeof(sysmon_task_t));
+    xSemaphoreGive(s_lock);
+    return n;
+}
+
+void sysmon_get_stats(sysmon_stats_t *stats) {
+    if (stats == NULL)
+    {
+        return;
+    }
+    if (s_lock != NULL)
+    {
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+    }
+    *stats = s_stats;
+    if (s_lock != NULL)
+    {
+        xSemaphoreGive(s_lock);
+    }
+}
+
+const char *sysmon_series_name(sysmon_series_t series) {
+    return series < SYSMON_SERIES_COUNT ? s_series_names[series] : "?";
+}
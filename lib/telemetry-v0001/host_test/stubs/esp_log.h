@@ -0,0 +1,6 @@
+#pragma once
+#include <stdio.h>
+
+#define ESP_LOGI(tag, fmt, ...) ((void) (tag))
+#define ESP_LOGW(tag, fmt, ...) fprintf(stderr, "W %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGE(tag, fmt, ...) fprintf(stderr, "E %s: " fmt "\n", tag, ##__VA_ARGS__)
@@ -0,0 +1,19 @@
+#pragma once
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef unsigned UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define portMAX_DELAY 0xffffffffu
+#define pdTRUE 1
+#define pdPASS 1
+#define tskIDLE_PRIORITY 0
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+// sectiunea critica devine un mutex; pe host nu exista ISR-uri
+typedef pthread_mutex_t portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED PTHREAD_MUTEX_INITIALIZER
+#define taskENTER_CRITICAL(mux) pthread_mutex_lock(mux)
+#define taskEXIT_CRITICAL(mux) pthread_mutex_unlock(mux)
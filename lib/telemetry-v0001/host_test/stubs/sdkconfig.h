@@ -0,0 +1,3 @@
+#pragma once
+// test pe host: fara TinyUSB, transportul vine din telemetry_config_t.write
+#define CONFIG_IDF_TARGET_LINUX 1
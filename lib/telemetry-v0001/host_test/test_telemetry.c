@@ -0,0 +1,237 @@
+/*
+ * Test pe host pentru telemetrie: doi producatori scriu prin API-ul public (contoare, histograma,
+ * trace begin/end), transportul scrie pe partea master a unui pseudo-terminal, iar
+ * tools/telemetry_decode.py citeste de pe /dev/pts/N ca de pe CDC-ACM 1.
+ * Se verifica ce a decodat scriptul fata de ce au acceptat producatorii.
+ *
+ *   cmake -S lib/telemetry-v0001/host_test -B build_host && cmake --build build_host && ctest --test-dir build_host
+ */
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "telemetry.h"
+#include "telemetry_cobs.h"
+
+#define ID_PROD_A  1
+#define ID_PROD_B  2
+#define ID_VALUE   100
+#define ID_WORK    200
+#define PER_THREAD 2000
+
+static int s_failures;
+
+#define CHECK(cond)                                                    \
+    do                                                                 \
+    {                                                                  \
+        if (!(cond))                                                   \
+        {                                                              \
+            fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #cond); \
+            s_failures++;                                              \
+        }                                                              \
+    } while (0)
+
+static int s_master;
+
+typedef struct {
+    uint16_t id;
+    int      accepted;  // contoare acceptate in ring
+    int      spans;     // perechi begin/end acceptate
+} producer_t;
+
+static size_t pty_write(const uint8_t *data, size_t len, void *ctx) {
+    (void) ctx;
+    return write(s_master, data, len) == (ssize_t) len ? len : 0;
+}
+
+/* ~4000 recorduri/s per producator: incap in ring intre doua trimiteri (20 ms) */
+static void *producer(void *arg) {
+    producer_t *p = arg;
+    for (int i = 0; i < PER_THREAD; i++)
+    {
+        if (telemetry_counter(p->id, p->accepted))
+        {
+            p->accepted++;
+        }
+        telemetry_hist(ID_VALUE, (uint32_t) i & 1023);
+        if (p->id == ID_PROD_A && i % 100 == 0)
+        {
+            bool begin = telemetry_trace_begin(ID_WORK);
+            usleep(50);
+            if (telemetry_trace_end(ID_WORK) && begin)
+            {
+                p->spans++;
+            }
+        }
+        if (i % 4 == 0)
+        {
+            usleep(1000);
+        }
+    }
+    return NULL;
+}
+
+static int check_cobs(void) {
+    static uint8_t src[600], enc[TELEMETRY_COBS_MAX_LEN(600)], dec[600];
+    srand(1);
+    for (int t = 0; t < 2000; t++)
+    {
+        size_t len = (size_t) rand() % sizeof(src);
+        for (size_t i = 0; i < len; i++)
+        {
+            src[i] = rand() % 4 == 0 ? 0 : (uint8_t) rand();
+        }
+        size_t enc_len = telemetry_cobs_encode(src, len, enc);
+        if (memchr(enc, 0, enc_len) != NULL || enc_len > TELEMETRY_COBS_MAX_LEN(len) ||
+            telemetry_cobs_decode(enc, enc_len, dec) != len || memcmp(src, dec, len) != 0)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Porneste decodorul pe partea slave; stdout si stderr merg in fisiere */
+static pid_t start_decoder(const char *slave_path, int slave, const char *out_path, const char *err_path) {
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        // altfel master-ul ramane deschis in decodor si acesta nu mai vede EOF
+        close(s_master);
+        close(slave);
+        freopen(out_path, "w", stdout);
+        freopen(err_path, "w", stderr);
+        execl(PYTHON_EXECUTABLE, PYTHON_EXECUTABLE, DECODER_PATH, slave_path, (char *) NULL);
+        _exit(127);
+    }
+    return pid;
+}
+
+int main(void) {
+    CHECK(check_cobs() == 0);
+
+    s_master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (s_master < 0 || grantpt(s_master) != 0 || unlockpt(s_master) != 0)
+    {
+        perror("posix_openpt");
+        return 1;
+    }
+    const char *slave_path = ptsname(s_master);
+    // slave-ul ramane deschis si raw: frame-urile scrise inainte ca decodorul sa porneasca nu se pierd
+    int            slave = open(slave_path, O_RDWR | O_NOCTTY);
+    struct termios tio;
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+
+    char out_path[64], err_path[64];
+    snprintf(out_path, sizeof(out_path), "/tmp/test_telemetry_%d.out", (int) getpid());
+    snprintf(err_path, sizeof(err_path), "/tmp/test_telemetry_%d.err", (int) getpid());
+    pid_t decoder = start_decoder(slave_path, slave, out_path, err_path);
+
+    telemetry_config_t config = {.write = pty_write};
+    CHECK(telemetry_declare(ID_PROD_A, TELEMETRY_COUNTER, "prod_a") == ESP_OK);
+    CHECK(telemetry_declare(ID_PROD_B, TELEMETRY_COUNTER, "prod_b") == ESP_OK);
+    CHECK(telemetry_declare(ID_VALUE, TELEMETRY_HIST, "value") == ESP_OK);
+    CHECK(telemetry_declare(ID_WORK, TELEMETRY_TRACE_BEGIN, "work") == ESP_OK);
+    CHECK(telemetry_init(&config) == ESP_OK);
+
+    producer_t prod[2] = {{.id = ID_PROD_A}, {.id = ID_PROD_B}};
+    pthread_t  th[2];
+    for (int i = 0; i < 2; i++)
+    {
+        pthread_create(&th[i], NULL, producer, &prod[i]);
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        pthread_join(th[i], NULL);
+    }
+    // ultimele recorduri, histograma si statisticile (perioada de 1 s)
+    usleep((TELEMETRY_HIST_PERIOD_MS + 200) * 1000);
+    telemetry_stats_t st;
+    telemetry_get_stats(&st);
+
+    // master inchis: decodorul primeste EIO si iese
+    close(s_master);
+    int status = 0;
+    waitpid(decoder, &status, 0);
+    close(slave);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    int   counters[2] = {0, 0}, expected[2] = {0, 0}, out_of_order = 0, spans = 0, hists = 0, stats = 0;
+    char  line[256], kind[16], name[32], text[128];
+    FILE *f = fopen(out_path, "r");
+    while (f != NULL && fgets(line, sizeof(line), f) != NULL)
+    {
+        double ts;
+        text[0] = '\0';
+        if (sscanf(line, "%lf %15s %31s %127[^\n]", &ts, kind, name, text) < 3)
+        {
+            continue;
+        }
+        if (strcmp(kind, "counter") == 0 && strncmp(name, "prod_", 5) == 0)
+        {
+            int p = name[5] == 'a' ? 0 : 1;
+            // fiecare producator numara 0, 1, 2... doar recordurile acceptate, deci in ordine si fara goluri
+            if (atoi(text) != expected[p])
+            {
+                out_of_order++;
+            }
+            expected[p] = atoi(text) + 1;
+            counters[p]++;
+        } else if (strcmp(kind, "span") == 0 && strcmp(name, "work") == 0)
+        {
+            spans++;
+        } else if (strcmp(kind, "hist") == 0 && strcmp(name, "value") == 0)
+        {
+            hists++;
+        } else if (strcmp(kind, "stats") == 0)
+        {
+            stats++;
+        }
+    }
+    if (f != NULL)
+    {
+        fclose(f);
+    }
+
+    unsigned frames = 0, bad = 0, lost = 0;
+    f = fopen(err_path, "r");
+    while (f != NULL && fgets(line, sizeof(line), f) != NULL)
+    {
+        sscanf(line, "frames=%u bad=%u lost=%u", &frames, &bad, &lost);
+    }
+    if (f != NULL)
+    {
+        fclose(f);
+    }
+
+    printf("device: records %u dropped %u frames %u frame drops %u bytes %u (%.1f B/record)\n", st.records,
+           st.dropped, st.frames, st.frame_drops, st.bytes, st.records ? (double) st.bytes / st.records : 0.0);
+    printf("decoder: frames %u bad %u lost %u | prod_a %d/%d prod_b %d/%d spans %d/%d hist %d stats %d\n", frames,
+           bad, lost, counters[0], prod[0].accepted, counters[1], prod[1].accepted, spans, prod[0].spans, hists,
+           stats);
+    CHECK(counters[0] == prod[0].accepted && counters[1] == prod[1].accepted);
+    CHECK(out_of_order == 0);
+    CHECK(prod[0].accepted > 0 && prod[1].accepted > 0);
+    CHECK(spans == prod[0].spans);
+    CHECK(hists > 0 && stats > 0);
+    // statisticile sunt citite inainte de inchidere: task-ul mai poate trimite un frame periodic
+    CHECK(frames >= st.frames && bad == 0 && lost == 0);
+
+    remove(out_path);
+    remove(err_path);
+    if (s_failures > 0)
+    {
+        fprintf(stderr, "%d check(s) failed\n", s_failures);
+        return 1;
+    }
+    printf("telemetry host test: OK\n");
+    return 0;
+}
@@ -0,0 +1,85 @@
+#pragma once
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+/**
+ * Canal binar de telemetrie, separat de consola text.
+ * Producatorii (task-uri sau ISR) pun recorduri de 12 bytes intr-un ring lock-free;
+ * un task de prioritate mica le grupeaza in frame-uri COBS si le trimite pe transport
+ * (implicit CDC-ACM 1 de la TinyUSB). Formatul frame-urilor e descris in README.md,
+ * decodorul de pe PC e tools/telemetry_decode.py.
+ */
+
+#define TELEMETRY_RING_LEN          (256)   // recorduri in asteptare, putere a lui 2
+#define TELEMETRY_FRAME_MAX_RECORDS (32)    // recorduri per frame (32 * 12 = 384 bytes)
+#define TELEMETRY_HIST_MAX          (8)     // histograme declarate simultan
+#define TELEMETRY_HIST_BUCKETS      (16)    // bucket k = [2^(k-1), 2^k), ultimul ia restul
+#define TELEMETRY_NAME_MAX_LEN      (23)
+#define TELEMETRY_DECLARE_MAX       (32)    // id-uri cu nume
+#define TELEMETRY_SEND_PERIOD_MS    (20)
+#define TELEMETRY_HIST_PERIOD_MS    (1000)  // histogramele si statisticile se trimit la 1 s
+
+#if CONFIG_TINYUSB_CDC_ENABLED && (CONFIG_TINYUSB_CDC_COUNT > 1)
+#define TELEMETRY_HAS_CDC 1
+#else
+#define TELEMETRY_HAS_CDC 0
+#endif
+
+typedef enum {
+    TELEMETRY_COUNTER     = 1,  // valoare absoluta (int32)
+    TELEMETRY_HIST        = 2,  // distributie log2, agregata pe device
+    TELEMETRY_TRACE       = 3,  // eveniment punctual cu argument
+    TELEMETRY_TRACE_BEGIN = 4,
+    TELEMETRY_TRACE_END   = 5,
+} telemetry_type_t;
+
+/* Scrie un frame complet. Intoarce cati bytes au fost acceptati (mai putin = frame pierdut). */
+typedef size_t (*telemetry_write_t)(const uint8_t *data, size_t len, void *ctx);
+
+typedef struct {
+    telemetry_write_t write;  // NULL: CDC-ACM 1 (daca TinyUSB CDC e activ cu 2 porturi)
+    void *ctx;
+} telemetry_config_t;
+
+typedef struct {
+    uint32_t records;       // recorduri acceptate in ring
+    uint32_t dropped;       // recorduri pierdute (ring plin)
+    uint32_t frames;        // frame-uri trimise
+    uint32_t frame_drops;   // frame-uri refuzate de transport (host deconectat / buffer plin)
+    uint32_t bytes;         // bytes trimisi pe transport, cu tot cu COBS
+} telemetry_stats_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* #ifdef __cplusplus */
+
+    esp_err_t telemetry_init(const telemetry_config_t *config);
+    // da un nume unui id; pentru TELEMETRY_HIST rezerva si histograma
+    esp_err_t telemetry_declare(uint16_t id, telemetry_type_t type, const char *name);
+
+    // producatori: lock-free, ISR-safe, intorc false daca recordul s-a pierdut
+    bool telemetry_counter(uint16_t id, int32_t value);
+    bool telemetry_hist(uint16_t id, uint32_t value);
+    bool telemetry_trace(uint16_t id, int32_t arg);
+    bool telemetry_trace_begin(uint16_t id);
+    bool telemetry_trace_end(uint16_t id);
+
+    void telemetry_get_stats(telemetry_stats_t *stats);
+
+#if TELEMETRY_HAS_CDC
+    // porneste CDC-ACM 1 (driver-ul TinyUSB e instalat de consola pe CDC-ACM 0)
+    esp_err_t telemetry_cdc_start(void);
+    size_t telemetry_cdc_write(const uint8_t *data, size_t len, void *ctx);
+#endif /* #if TELEMETRY_HAS_CDC */
+
+#ifdef __cplusplus
+}
+#endif /* #ifdef __cplusplus */
+#endif /* #ifndef TELEMETRY_H_ */
@@ -0,0 +1,26 @@
+#pragma once
+#ifndef TELEMETRY_COBS_H_
+#define TELEMETRY_COBS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Lungimea maxima codata: un byte de overhead la fiecare 254 bytes + primul cod */
+#define TELEMETRY_COBS_MAX_LEN(n) ((n) + ((n) / 254) + 1)
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* #ifdef __cplusplus */
+
+    // codeaza `len` bytes fara niciun 0x00 in iesire; NU adauga delimitatorul
+    size_t telemetry_cobs_encode(const uint8_t *src, size_t len, uint8_t *dst);
+    // intoarce lungimea decodata sau 0 daca frame-ul e corupt
+    size_t telemetry_cobs_decode(const uint8_t *src, size_t len, uint8_t *dst);
+    // CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+    uint16_t telemetry_crc16(const uint8_t *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif /* #ifdef __cplusplus */
+#endif /* #ifndef TELEMETRY_COBS_H_ */
@@ -0,0 +1,374 @@
+#include "telemetry.h"
+
+#include <stdatomic.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "telemetry_cobs.h"
+
+static const char *TAG = "TLM";
+
+#define RING_MASK (TELEMETRY_RING_LEN - 1)
+_Static_assert((TELEMETRY_RING_LEN & RING_MASK) == 0, "TELEMETRY_RING_LEN trebuie sa fie putere a lui 2");
+
+/* Tipuri de frame (primul byte din payload) */
+#define FRAME_RECORDS 1
+#define FRAME_HIST    2
+#define FRAME_NAME    3
+#define FRAME_STATS   4
+
+#define RECORD_SIZE   12
+#define NAMES_EVERY   5  // numele se retrimit la fiecare 5 perioade, pentru host-uri conectate tarziu
+
+#define PAYLOAD_MAX   (2 + TELEMETRY_FRAME_MAX_RECORDS * RECORD_SIZE + 2)
+_Static_assert(PAYLOAD_MAX >= 2 + 8 + TELEMETRY_HIST_BUCKETS * 4 + 2, "frame-ul de histograma nu incape");
+
+typedef struct {
+    uint32_t ts_us;
+    uint16_t id;
+    uint8_t  type;
+    int32_t  value;
+} record_t;
+
+/* Ring MPSC marginit: fiecare slot are un numar de secventa (Vyukov). Producatorii
+ * rezerva o pozitie cu CAS pe s_head; consumatorul e doar task-ul de trimitere. */
+typedef struct {
+    atomic_uint seq;
+    record_t    rec;
+} slot_t;
+
+typedef struct {
+    uint16_t id;
+    uint8_t  type;
+    char     name[TELEMETRY_NAME_MAX_LEN + 1];
+} name_t;
+
+static slot_t      s_ring[TELEMETRY_RING_LEN];
+static atomic_bool s_running;  // producatorii ies imediat pana la telemetry_init()
+static atomic_uint s_head;
+static uint32_t    s_tail;
+
+static uint16_t    s_hist_id[TELEMETRY_HIST_MAX];
+static atomic_uint s_hist[TELEMETRY_HIST_MAX][TELEMETRY_HIST_BUCKETS];
+static atomic_uint s_hist_cnt;
+
+static name_t      s_names[TELEMETRY_DECLARE_MAX];
+static size_t      s_name_cnt;
+static portMUX_TYPE s_declare_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static atomic_uint s_records;
+static atomic_uint s_dropped;
+static telemetry_stats_t s_tx;  // scris doar de task-ul de trimitere
+
+static telemetry_write_t s_write       = NULL;
+static void             *s_write_ctx   = NULL;
+static TaskHandle_t      s_sender_task = NULL;
+static uint8_t           s_seq;
+
+// -------------------------------------------------
+
+static bool ring_push(uint16_t id, uint8_t type, int32_t value) {
+    if (!atomic_load_explicit(&s_running, memory_order_acquire))
+    {
+        return false;
+    }
+    unsigned pos = atomic_load_explicit(&s_head, memory_order_relaxed);
+    while (true)
+    {
+        slot_t  *slot = &s_ring[pos & RING_MASK];
+        unsigned seq  = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int      diff = (int) (seq - pos);
+        if (diff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&s_head, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+            {
+                slot->rec.ts_us = (uint32_t) esp_timer_get_time();
+                slot->rec.id    = id;
+                slot->rec.type  = type;
+                slot->rec.value = value;
+                atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+                atomic_fetch_add_explicit(&s_records, 1, memory_order_relaxed);
+                return true;
+            }
+        } else if (diff < 0)
+        {
+            atomic_fetch_add_explicit(&s_dropped, 1, memory_order_relaxed);
+            return false;  // plin: nu blocam niciodata producatorul
+        } else
+        {
+            pos = atomic_load_explicit(&s_head, memory_order_relaxed);
+        }
+    }
+}
+
+static bool ring_pop(record_t *rec) {
+    slot_t  *slot = &s_ring[s_tail & RING_MASK];
+    unsigned seq  = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    if (seq != s_tail + 1)
+    {
+        return false;
+    }
+    *rec = slot->rec;
+    atomic_store_explicit(&slot->seq, s_tail + TELEMETRY_RING_LEN, memory_order_release);
+    s_tail++;
+    return true;
+}
+
+static uint8_t *put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t) v;
+    p[1] = (uint8_t) (v >> 8);
+    return p + 2;
+}
+
+static uint8_t *put_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t) v;
+    p[1] = (uint8_t) (v >> 8);
+    p[2] = (uint8_t) (v >> 16);
+    p[3] = (uint8_t) (v >> 24);
+    return p + 4;
+}
+
+/* payload = [tip][secventa][corp][crc16] -> COBS -> 0x00 */
+static void send_frame(uint8_t *payload, size_t len) {
+    static uint8_t encoded[TELEMETRY_COBS_MAX_LEN(PAYLOAD_MAX) + 1];
+
+    payload[1] = s_seq++;
+    put_u16(payload + len, telemetry_crc16(payload, len));
+    size_t n     = telemetry_cobs_encode(payload, len + 2, encoded);
+    encoded[n++] = 0x00;
+
+    if (s_write(encoded, n, s_write_ctx) == n)
+    {
+        s_tx.frames++;
+        s_tx.bytes += n;
+    } else
+    {
+        s_tx.frame_drops++;
+    }
+}
+
+static void send_records(uint8_t *payload) {
+    record_t rec;
+    size_t   count = 0;
+    uint8_t *p     = payload + 2;
+
+    payload[0] = FRAME_RECORDS;
+    while (ring_pop(&rec))
+    {
+        p    = put_u32(p, rec.ts_us);
+        p    = put_u16(p, rec.id);
+        *p++ = rec.type;
+        *p++ = 0;
+        p    = put_u32(p, (uint32_t) rec.value);
+        if (++count == TELEMETRY_FRAME_MAX_RECORDS)
+        {
+            send_frame(payload, (size_t) (p - payload));
+            count = 0;
+            p     = payload + 2;
+        }
+    }
+    if (count > 0)
+    {
+        send_frame(payload, (size_t) (p - payload));
+    }
+}
+
+static void send_periodic(uint8_t *payload) {
+    uint32_t now = (uint32_t) esp_timer_get_time();
+    unsigned hist_cnt = atomic_load_explicit(&s_hist_cnt, memory_order_acquire);
+
+    for (unsigned h = 0; h < hist_cnt; h++)
+    {
+        uint8_t *p = payload;
+        *p++       = FRAME_HIST;
+        p++;  // secventa
+        p    = put_u32(p, now);
+        p    = put_u16(p, s_hist_id[h]);
+        *p++ = TELEMETRY_HIST_BUCKETS;
+        *p++ = 0;
+        for (int b = 0; b < TELEMETRY_HIST_BUCKETS; b++)
+        {
+            p = put_u32(p, atomic_exchange_explicit(&s_hist[h][b], 0, memory_order_relaxed));
+        }
+        send_frame(payload, (size_t) (p - payload));
+    }
+
+    uint8_t *p = payload;
+    *p++       = FRAME_STATS;
+    p++;
+    p = put_u32(p, now);
+    p = put_u32(p, atomic_load_explicit(&s_dropped, memory_order_relaxed));
+    p = put_u32(p, s_tx.frame_drops);
+    send_frame(payload, (size_t) (p - payload));
+}
+
+static void send_names(uint8_t *payload) {
+    taskENTER_CRITICAL(&s_declare_lock);
+    size_t name_cnt = s_name_cnt;
+    taskEXIT_CRITICAL(&s_declare_lock);
+
+    for (size_t i = 0; i < name_cnt; i++)
+    {
+        size_t   len = strlen(s_names[i].name);
+        uint8_t *p   = payload;
+        *p++         = FRAME_NAME;
+        p++;
+        p    = put_u16(p, s_names[i].id);
+        *p++ = s_names[i].type;
+        *p++ = (uint8_t) len;
+        memcpy(p, s_names[i].name, len);
+        send_frame(payload, (size_t) (p - payload) + len);
+    }
+}
+
+static void telemetry_sender_task(void *parameter) {
+    static uint8_t payload[PAYLOAD_MAX];
+    (void) parameter;
+
+    TickType_t tick    = xTaskGetTickCount();
+    uint32_t   elapsed = 0;
+    uint32_t   periods = 0;
+    send_names(payload);
+    while (true)
+    {
+        vTaskDelayUntil(&tick, pdMS_TO_TICKS(TELEMETRY_SEND_PERIOD_MS));
+        send_records(payload);
+
+        elapsed += TELEMETRY_SEND_PERIOD_MS;
+        if (elapsed >= TELEMETRY_HIST_PERIOD_MS)
+        {
+            send_periodic(payload);
+            if (++periods % NAMES_EVERY == 0)
+            {
+                send_names(payload);
+            }
+            elapsed = 0;
+        }
+    }
+}
+
+// -------------------------------------------------
+
+esp_err_t telemetry_init(const telemetry_config_t *config) {
+    if (s_sender_task != NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    s_write     = config != NULL ? config->write : NULL;
+    s_write_ctx = config != NULL ? config->ctx : NULL;
+#if TELEMETRY_HAS_CDC
+    if (s_write == NULL)
+    {
+        esp_err_t err = telemetry_cdc_start();
+        if (err != ESP_OK)
+        {
+            return err;
+        }
+        s_write = telemetry_cdc_write;
+    }
+#endif /* #if TELEMETRY_HAS_CDC */
+    if (s_write == NULL)
+    {
+        ESP_LOGW(TAG, "No telemetry transport (enable TinyUSB CDC with 2 ports)");
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    for (unsigned i = 0; i < TELEMETRY_RING_LEN; i++)
+    {
+        atomic_init(&s_ring[i].seq, i);
+    }
+    atomic_init(&s_head, 0);
+    s_tail = 0;
+    atomic_store_explicit(&s_running, true, memory_order_release);
+
+    if (xTaskCreate(telemetry_sender_task, "Telemetry", 3072, NULL, tskIDLE_PRIORITY + 2, &s_sender_task) != pdPASS)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    ESP_LOGI(TAG, "Telemetry started (%d records ring)", TELEMETRY_RING_LEN);
+    return ESP_OK;
+}
+
+esp_err_t telemetry_declare(uint16_t id, telemetry_type_t type, const char *name) {
+    if (name == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t err = ESP_OK;
+    taskENTER_CRITICAL(&s_declare_lock);
+    if (s_name_cnt == TELEMETRY_DECLARE_MAX)
+    {
+        err = ESP_ERR_NO_MEM;
+    } else if (type == TELEMETRY_HIST)
+    {
+        unsigned h = atomic_load_explicit(&s_hist_cnt, memory_order_relaxed);
+        if (h == TELEMETRY_HIST_MAX)
+        {
+            err = ESP_ERR_NO_MEM;
+        } else
+        {
+            s_hist_id[h] = id;
+            atomic_store_explicit(&s_hist_cnt, h + 1, memory_order_release);
+        }
+    }
+    if (err == ESP_OK)
+    {
+        name_t *n = &s_names[s_name_cnt++];
+        n->id     = id;
+        n->type   = (uint8_t) type;
+        strncpy(n->name, name, TELEMETRY_NAME_MAX_LEN);
+        n->name[TELEMETRY_NAME_MAX_LEN] = '\0';
+    }
+    taskEXIT_CRITICAL(&s_declare_lock);
+    return err;
+}
+
+bool telemetry_counter(uint16_t id, int32_t value) {
+    return ring_push(id, TELEMETRY_COUNTER, value);
+}
+
+bool telemetry_hist(uint16_t id, uint32_t value) {
+    unsigned hist_cnt = atomic_load_explicit(&s_hist_cnt, memory_order_acquire);
+    for (unsigned h = 0; h < hist_cnt; h++)
+    {
+        if (s_hist_id[h] == id)
+        {
+            int bucket = value == 0 ? 0 : 32 - __builtin_clz(value);
+            if (bucket >= TELEMETRY_HIST_BUCKETS)
+            {
+                bucket = TELEMETRY_HIST_BUCKETS - 1;
+            }
+            atomic_fetch_add_explicit(&s_hist[h][bucket], 1, memory_order_relaxed);
+            return true;
+        }
+    }
+    atomic_fetch_add_explicit(&s_dropped, 1, memory_order_relaxed);
+    return false;  // histograma nedeclarata
+}
+
+bool telemetry_trace(uint16_t id, int32_t arg) {
+    return ring_push(id, TELEMETRY_TRACE, arg);
+}
+
+bool telemetry_trace_begin(uint16_t id) {
+    return ring_push(id, TELEMETRY_TRACE_BEGIN, 0);
+}
+
+bool telemetry_trace_end(uint16_t id) {
+    return ring_push(id, TELEMETRY_TRACE_END, 0);
+}
+
+void telemetry_get_stats(telemetry_stats_t *stats) {
+    if (stats == NULL)
+    {
+        return;
+    }
+    *stats         = s_tx;
+    stats->records = atomic_load_explicit(&s_records, memory_order_relaxed);
+    stats->dropped = atomic_load_explicit(&s_dropped, memory_order_relaxed);
+}
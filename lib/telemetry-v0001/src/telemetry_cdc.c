@@ -0,0 +1,41 @@
+#include "telemetry.h"
+
+#if TELEMETRY_HAS_CDC
+
+#include "esp_log.h"
+#include "tinyusb.h"
+#include "tusb_cdc_acm.h"
+
+static const char *TAG = "TLM";
+
+esp_err_t telemetry_cdc_start(void) {
+    if (tusb_cdc_acm_initialized(TINYUSB_CDC_ACM_1))
+    {
+        return ESP_OK;
+    }
+
+    tinyusb_config_cdcacm_t acm_cfg = {
+        .usb_dev  = TINYUSB_USBDEV_0,
+        .cdc_port = TINYUSB_CDC_ACM_1,
+    };
+    esp_err_t err = tusb_cdc_acm_init(&acm_cfg);
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "CDC-ACM 1 init failed: %s", esp_err_to_name(err));
+    }
+    return err;
+}
+
+size_t telemetry_cdc_write(const uint8_t *data, size_t len, void *ctx) {
+    (void) ctx;
+    /* Fara host (DTR jos) sau cu FIFO-ul plin frame-ul se arunca intreg, nu pe bucati */
+    if (!tud_cdc_n_connected(TINYUSB_CDC_ACM_1) || tud_cdc_n_write_available(TINYUSB_CDC_ACM_1) < len)
+    {
+        return 0;
+    }
+    size_t queued = tinyusb_cdcacm_write_queue(TINYUSB_CDC_ACM_1, data, len);
+    tinyusb_cdcacm_write_flush(TINYUSB_CDC_ACM_1, 0);
+    return queued;
+}
+
+#endif /* #if TELEMETRY_HAS_CDC */
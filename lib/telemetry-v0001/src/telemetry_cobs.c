@@ -0,0 +1,65 @@
+#include "telemetry_cobs.h"
+
+size_t telemetry_cobs_encode(const uint8_t *src, size_t len, uint8_t *dst) {
+    size_t  out      = 1;
+    size_t  code_pos = 0;
+    uint8_t code     = 1;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        if (src[i] == 0)
+        {
+            dst[code_pos] = code;
+            code_pos      = out++;
+            code          = 1;
+        } else
+        {
+            dst[out++] = src[i];
+            code++;
+            if (code == 0xFF)
+            {
+                dst[code_pos] = code;
+                code_pos      = out++;
+                code          = 1;
+            }
+        }
+    }
+    dst[code_pos] = code;
+    return out;
+}
+
+size_t telemetry_cobs_decode(const uint8_t *src, size_t len, uint8_t *dst) {
+    size_t in  = 0;
+    size_t out = 0;
+
+    while (in < len)
+    {
+        uint8_t code = src[in++];
+        if (code == 0 || in + code - 1 > len)
+        {
+            return 0;
+        }
+        for (uint8_t i = 1; i < code; i++)
+        {
+            dst[out++] = src[in++];
+        }
+        if (code != 0xFF && in < len)
+        {
+            dst[out++] = 0;
+        }
+    }
+    return out;
+}
+
+uint16_t telemetry_crc16(const uint8_t *data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= (uint16_t) data[i] << 8;
+        for (int b = 0; b < 8; b++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t) ((crc << 1) ^ 0x1021) : (uint16_t) (crc << 1);
+        }
+    }
+    return crc;
+}
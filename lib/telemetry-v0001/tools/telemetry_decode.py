@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""Decodeaza frame-urile de telemetrie (COBS + CRC-16) de pe CDC-ACM 1.
+
+Exemple:
+    telemetry_decode.py /dev/ttyACM1
+    telemetry_decode.py /dev/pts/7          # pseudo-TTY pentru test pe Linux
+    telemetry_decode.py capture.bin         # captura salvata
+"""
+
+import argparse
+import os
+import struct
+import sys
+import termios
+import tty
+
+FRAME_RECORDS = 1
+FRAME_HIST = 2
+FRAME_NAME = 3
+FRAME_STATS = 4
+
+TYPES = {1: "counter", 2: "hist", 3: "trace", 4: "begin", 5: "end"}
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            raise ValueError("cod COBS invalid")
+        out += data[i:i + code - 1]
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+class Decoder:
+    def __init__(self, out):
+        self.out = out
+        self.names = {}
+        self.seq = None
+        self.frames = 0
+        self.bad = 0
+        self.lost = 0
+        self.open_traces = {}
+
+    def name(self, ident):
+        return self.names.get(ident, "#%d" % ident)
+
+    def feed_frame(self, raw):
+        try:
+            payload = cobs_decode(raw)
+        except ValueError:
+            self.bad += 1
+            return
+        if len(payload) < 4 or crc16(payload[:-2]) != struct.unpack_from("<H", payload, len(payload) - 2)[0]:
+            self.bad += 1
+            return
+        kind, seq = payload[0], payload[1]
+        body = payload[2:-2]
+        if self.seq is not None:
+            self.lost += (seq - self.seq - 1) & 0xFF
+        self.seq = seq
+        self.frames += 1
+
+        if kind == FRAME_RECORDS:
+            for off in range(0, len(body) - 11, 12):
+                ts, ident, typ, value = struct.unpack_from("<IHBxi", body, off)
+                self.record(ts, ident, typ, value)
+        elif kind == FRAME_HIST:
+            ts, ident, nb = struct.unpack_from("<IHBx", body)
+            buckets = struct.unpack_from("<%dI" % nb, body, 8)
+            used = ["<%d:%d" % (1 << k, n) for k, n in enumerate(buckets) if n]
+            self.emit(ts, "hist", self.name(ident), " ".join(used) or "-")
+        elif kind == FRAME_NAME:
+            ident, typ, length = struct.unpack_from("<HBB", body)
+            self.names[ident] = body[4:4 + length].decode(errors="replace")
+        elif kind == FRAME_STATS:
+            ts, dropped, frame_drops = struct.unpack_from("<III", body)
+            self.emit(ts, "stats", "device", "dropped=%d frame_drops=%d | host frames=%d bad=%d lost=%d"
+                      % (dropped, frame_drops, self.frames, self.bad, self.lost))
+
+    def record(self, ts, ident, typ, value):
+        if typ == 4:
+            self.open_traces[ident] = ts
+            return
+        if typ == 5 and ident in self.open_traces:
+            dur = (ts - self.open_traces.pop(ident)) & 0xFFFFFFFF
+            self.emit(ts, "span", self.name(ident), "%d us" % dur)
+            return
+        self.emit(ts, TYPES.get(typ, str(typ)), self.name(ident), str(value))
+
+    def emit(self, ts, kind, name, text):
+        self.out.write("%10.6f %-7s %-20s %s\n" % (ts / 1e6, kind, name, text))
+        self.out.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="tty (/dev/ttyACM1, /dev/pts/N) sau fisier cu captura")
+    args = parser.parse_args()
+
+    fd = os.open(args.port, os.O_RDONLY | os.O_NOCTTY)
+    if os.isatty(fd):
+        # fara ecou si fara conversii CR/LF, altfel 0x0D/0x0A se strica;
+        # TCSANOW: frame-urile deja primite (numele trimise la pornire) nu se arunca
+        tty.setraw(fd, termios.TCSANOW)
+
+    dec = Decoder(sys.stdout)
+    pending = bytearray()
+    try:
+        while True:
+            try:
+                chunk = os.read(fd, 4096)
+            except OSError:  # pty inchis de partea cealalta
+                break
+            if not chunk:
+                break
+            pending += chunk
+            while True:
+                end = pending.find(b"\x00")
+                if end < 0:
+                    break
+                if end > 0:
+                    dec.feed_frame(bytes(pending[:end]))
+                del pending[:end + 1]
+    except KeyboardInterrupt:
+        pass
+    finally:
+        os.close(fd)
+    sys.stderr.write("frames=%d bad=%d lost=%d\n" % (dec.frames, dec.bad, dec.lost))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,235 @@
+/*
+ * Test pe host pentru ui-queue (src/ui_queue.c): 4 producatori pe thread-uri posteaza comenzi
+ * numerotate, consumatorul face ce face task-ul LVGL (ia lock-ul "LVGL", goleste ringul, tine
+ * lock-ul cat un cadru, il elibereaza). Se verifica:
+ *  - fiecare comanda acceptata ruleaza o data, in ordinea postarii per producator, cu datele intacte;
+ *  - ringul plin pierde comanda si o numara; producatorul nu asteapta niciodata un cadru;
+ *  - bugetul de golire opreste o golire cu comenzi lente, restul ruleaza la ciclul urmator.
+ * Ruleaza si compilat cu -fsanitize=thread (ui_queue_tsan).
+ *
+ *   cmake -S lib/ui-queue-v0001/host_test -B build_host && cmake --build build_host && ctest --test-dir build_host
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp_timer.h"
+#include "ui_queue.h"
+
+#define PRODUCERS  4
+#define PER_THREAD 2000
+#define FRAME_US   8000  // cat tine task-ul LVGL lock-ul pe ciclu
+#define IDLE_US    2000  // intre cicluri
+
+static int s_failures;
+
+#define CHECK(cond)                                                    \
+    do                                                                 \
+    {                                                                  \
+        if (!(cond))                                                   \
+        {                                                              \
+            fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #cond); \
+            s_failures++;                                              \
+        }                                                              \
+    } while (0)
+
+typedef struct {
+    uint32_t producer;
+    uint32_t n;
+    uint8_t  payload[UI_QUEUE_DATA_MAX - 8];
+} cmd_t;
+
+static pthread_mutex_t s_lvgl_lock = PTHREAD_MUTEX_INITIALIZER;
+static atomic_bool     s_lvgl_locked;  // comenzile trebuie sa ruleze cu lock-ul "LVGL" luat
+
+// scrise doar din comenzi, deci doar de consumator
+static uint32_t s_last[PRODUCERS];
+static uint32_t s_ran;
+static uint32_t s_order_errors;
+static uint32_t s_data_errors;
+static uint32_t s_unlocked;
+
+static atomic_uint s_rejected;      // ui_queue_post() == false vazut de producatori
+static atomic_uint s_post_max_us;   // masurat de producatori, independent de ui_queue
+static atomic_int  s_producers_done;
+
+static void sleep_us(long us) {
+    struct timespec ts = {us / 1000000, (us % 1000000) * 1000L};
+    nanosleep(&ts, NULL);
+}
+
+static void spin_us(int64_t us) {
+    int64_t t0 = esp_timer_get_time();
+    while (esp_timer_get_time() - t0 < us)
+    {
+    }
+}
+
+static void fill_payload(cmd_t *cmd) {
+    for (size_t i = 0; i < sizeof(cmd->payload); i++)
+    {
+        cmd->payload[i] = (uint8_t) (cmd->producer * 31 + cmd->n + i);
+    }
+}
+
+static void run_cmd(void *data) {
+    const cmd_t *cmd = data;
+    cmd_t        expected;
+    expected.producer = cmd->producer;
+    expected.n        = cmd->n;
+    fill_payload(&expected);
+
+    if (!atomic_load(&s_lvgl_locked))
+    {
+        s_unlocked++;
+    }
+    if (cmd->producer >= PRODUCERS || cmd->n <= s_last[cmd->producer])
+    {
+        s_order_errors++;
+        return;
+    }
+    if (memcmp(cmd->payload, expected.payload, sizeof(cmd->payload)) != 0)
+    {
+        s_data_errors++;
+    }
+    s_last[cmd->producer] = cmd->n;
+    s_ran++;
+}
+
+// Reincearca o comanda respinsa (ring plin) pana intra; fiecare respingere e numarata
+static void *producer(void *arg) {
+    cmd_t cmd;
+    cmd.producer = (uint32_t) (intptr_t) arg;
+    for (uint32_t n = 1; n <= PER_THREAD; n++)
+    {
+        cmd.n = n;
+        fill_payload(&cmd);
+        while (true)
+        {
+            int64_t t0 = esp_timer_get_time();
+            bool    ok = ui_queue_post(run_cmd, &cmd, sizeof(cmd));
+            unsigned us  = (unsigned) (esp_timer_get_time() - t0);
+            unsigned cur = atomic_load(&s_post_max_us);
+            while (us > cur && !atomic_compare_exchange_weak(&s_post_max_us, &cur, us))
+            {
+            }
+            if (ok)
+            {
+                break;
+            }
+            atomic_fetch_add(&s_rejected, 1);
+            sleep_us(100);
+        }
+        memset(&cmd.payload, 0xEE, sizeof(cmd.payload));  // copiat la post, refolosit imediat
+        sleep_us(500 + (n % 4) * 250);
+    }
+    atomic_fetch_add(&s_producers_done, 1);
+    return NULL;
+}
+
+static void lvgl_cycle(uint32_t frame_us) {
+    pthread_mutex_lock(&s_lvgl_lock);
+    atomic_store(&s_lvgl_locked, true);
+    ui_queue_drain(UI_QUEUE_DRAIN_BUDGET_US);
+    spin_us(frame_us);
+    atomic_store(&s_lvgl_locked, false);
+    pthread_mutex_unlock(&s_lvgl_lock);
+}
+
+static void slow_cmd(void *data) {
+    (void) data;
+    spin_us(UI_QUEUE_DRAIN_BUDGET_US / 4);
+}
+
+static void check_args(void) {
+    uint8_t big[UI_QUEUE_DATA_MAX + 1] = {0};
+    CHECK(!ui_queue_post(run_cmd, big, sizeof(big)));
+    CHECK(!ui_queue_post(NULL, NULL, 0));
+    CHECK(!ui_queue_post(run_cmd, NULL, 4));
+}
+
+// Ring plin: comenzile in plus se pierd si se numara, golirea se opreste la buget
+static void check_full_and_budget(void) {
+    ui_queue_reset_stats();
+    uint32_t accepted = 0;
+    for (int i = 0; i < UI_QUEUE_LEN + 10; i++)
+    {
+        accepted += ui_queue_post(slow_cmd, NULL, 0);
+    }
+    CHECK(accepted == UI_QUEUE_LEN);
+
+    uint32_t first  = ui_queue_drain(UI_QUEUE_DRAIN_BUDGET_US);
+    uint32_t cycles = 1;
+    uint32_t total  = first;
+    while (total < accepted && cycles < 100)
+    {
+        total += ui_queue_drain(UI_QUEUE_DRAIN_BUDGET_US);
+        cycles++;
+    }
+
+    ui_queue_stats_t st;
+    ui_queue_get_stats(&st);
+    printf("full ring: %u accepted, %u dropped | budget: %u commands in the first drain, %u drains, %u budget stops\n",
+        (unsigned) accepted, (unsigned) st.dropped, (unsigned) first, (unsigned) cycles, (unsigned) st.budget_stops);
+    CHECK(st.dropped == 10 && st.posted == UI_QUEUE_LEN);
+    CHECK(first >= 1 && first <= 5);
+    CHECK(total == accepted && st.depth == 0);
+    CHECK(st.budget_stops == cycles - 1);
+}
+
+int main(void) {
+    CHECK(!ui_queue_post(run_cmd, NULL, 0));  // inainte de ui_queue_init()
+    ui_queue_init();
+    check_args();
+
+    pthread_t threads[PRODUCERS];
+    for (intptr_t i = 0; i < PRODUCERS; i++)
+    {
+        pthread_create(&threads[i], NULL, producer, (void *) i);
+    }
+    int64_t t0 = esp_timer_get_time();
+    while (atomic_load(&s_producers_done) < PRODUCERS)
+    {
+        lvgl_cycle(FRAME_US);
+        sleep_us(IDLE_US);
+    }
+    for (int i = 0; i < PRODUCERS; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    lvgl_cycle(0);  // ce s-a postat dupa ultima golire
+
+    ui_queue_stats_t st;
+    ui_queue_get_stats(&st);
+    printf("%d producers x %d: ran %u, order errors %u, data errors %u, unlocked %u | posted %u, dropped %u, "
+           "rejected %u | post max %u us (ui_queue %u us) | depth max %u, wait avg %u us max %u us | %.1f s\n",
+        PRODUCERS, PER_THREAD, (unsigned) s_ran, (unsigned) s_order_errors, (unsigned) s_data_errors,
+        (unsigned) s_unlocked, (unsigned) st.posted, (unsigned) st.dropped, atomic_load(&s_rejected),
+        atomic_load(&s_post_max_us), (unsigned) st.post_max_us, (unsigned) st.max_depth,
+        (unsigned) (st.executed ? st.wait_sum_us / st.executed : 0), (unsigned) st.wait_max_us,
+        (esp_timer_get_time() - t0) / 1e6);
+
+    CHECK(s_ran == PRODUCERS * PER_THREAD);
+    CHECK(st.posted == PRODUCERS * PER_THREAD && st.executed == st.posted && st.depth == 0);
+    CHECK(s_order_errors == 0 && s_data_errors == 0 && s_unlocked == 0);
+    for (int i = 0; i < PRODUCERS; i++)
+    {
+        CHECK(s_last[i] == PER_THREAD);
+    }
+    CHECK(st.dropped == atomic_load(&s_rejected));
+    CHECK(st.max_depth <= UI_QUEUE_LEN);
+    // cu un mutex comun producatorul ar sta pana la un cadru intreg
+    CHECK(atomic_load(&s_post_max_us) < FRAME_US);
+
+    check_full_and_budget();
+
+    if (s_failures > 0)
+    {
+        fprintf(stderr, "%d check(s) failed\n", s_failures);
+        return 1;
+    }
+    printf("ui-queue host test: OK\n");
+    return 0;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#ifndef UI_QUEUE_H_
+#define UI_QUEUE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Comenzi catre task-ul LVGL din orice task, fara lock-ul LVGL. ui_queue_post() copiaza
+ * functia si datele ei intr-un ring MPSC lock-free si revine imediat (plin = comanda pierduta,
+ * apelantul nu asteapta niciodata un cadru). Task-ul LVGL apeleaza ui_queue_drain() la
+ * inceputul fiecarui ciclu, cu lock-ul LVGL luat, deci comenzile pot folosi orice API LVGL.
+ *
+ * Comenzile ruleaza in ordinea postarii. Doar din task-uri, nu din ISR.
+ */
+
+#define UI_QUEUE_LEN             (64)    // comenzi in asteptare, putere a lui 2
+#define UI_QUEUE_DATA_MAX        (32)    // bytes de date copiate per comanda
+#define UI_QUEUE_DRAIN_BUDGET_US (2000)  // cat poate lua golirea dintr-un ciclu LVGL
+
+typedef void (*ui_queue_fn_t)(void *data);
+
+typedef struct {
+    uint32_t posted;        // comenzi puse in ring
+    uint32_t dropped;       // comenzi pierdute (ring plin)
+    uint32_t executed;      // comenzi rulate de ui_queue_drain()
+    uint32_t depth;         // comenzi in asteptare acum
+    uint32_t max_depth;     // cel mai plin ring vazut de ui_queue_drain()
+    uint32_t budget_stops;  // goliri oprite de buget (restul ramane pentru ciclul urmator)
+    uint32_t post_max_us;   // cel mai lung ui_queue_post(), adica cat a stat producatorul
+    uint32_t wait_max_us;   // postare -> rulare
+    uint64_t wait_sum_us;   // pentru media: wait_sum_us / executed
+} ui_queue_stats_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* #ifdef __cplusplus */
+
+    // Inainte de primul post si de pornirea task-ului LVGL
+    void ui_queue_init(void);
+    // data poate fi NULL (size 0); se copiaza, apelantul il poate refolosi imediat
+    // false: ring plin sau ui_queue_init() neapelat
+    bool ui_queue_post(ui_queue_fn_t fn, const void *data, size_t size);
+    // Doar din task-ul LVGL. Ruleaza comenzi pana se goleste ringul sau trece budget_us
+    // (cel putin una), intoarce cate a rulat.
+    uint32_t ui_queue_drain(uint32_t budget_us);
+    void ui_queue_get_stats(ui_queue_stats_t *stats);
+    void ui_queue_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif /* #ifdef __cplusplus */
+
+#endif /* #ifndef UI_QUEUE_H_ */
@@ -0,0 +1,172 @@
+#include "ui_queue.h"
+
+#include <stdatomic.h>
+#include <string.h>
+#include "esp_timer.h"
+
+#define RING_MASK (UI_QUEUE_LEN - 1)
+_Static_assert((UI_QUEUE_LEN & RING_MASK) == 0, "UI_QUEUE_LEN trebuie sa fie putere a lui 2");
+
+/* Ring MPSC marginit cu numar de secventa per slot, ca in async_log: producatorii rezerva
+ * slotul cu CAS pe head, il completeaza si il publica prin seq; consumatorul e doar task-ul LVGL. */
+typedef struct {
+    atomic_uint   seq;
+    ui_queue_fn_t fn;
+    int64_t       posted_us;
+    uint8_t       data[UI_QUEUE_DATA_MAX];
+} slot_t;
+
+static slot_t      s_slots[UI_QUEUE_LEN];
+static atomic_uint s_head;
+static uint32_t    s_tail;  // doar consumatorul
+static atomic_bool s_ready;
+
+static atomic_uint s_posted;
+static atomic_uint s_dropped;
+static atomic_uint s_post_max_us;
+
+/* Scrise doar de consumator; citite din alte task-uri pot fi decalate cu o golire */
+static uint32_t s_executed;
+static uint32_t s_max_depth;
+static uint32_t s_budget_stops;
+static uint32_t s_wait_max_us;
+static uint64_t s_wait_sum_us;
+
+// -------------------------------------------------
+
+static void update_max(atomic_uint *max, uint32_t value) {
+    unsigned cur = atomic_load_explicit(max, memory_order_relaxed);
+    while (value > cur && !atomic_compare_exchange_weak_explicit(max, &cur, value, memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+}
+
+// -------------------------------------------------
+
+void ui_queue_init(void) {
+    for (unsigned i = 0; i < UI_QUEUE_LEN; i++)
+    {
+        atomic_init(&s_slots[i].seq, i);
+    }
+    atomic_init(&s_head, 0);
+    s_tail = 0;
+    atomic_store_explicit(&s_ready, true, memory_order_release);
+}
+
+bool ui_queue_post(ui_queue_fn_t fn, const void *data, size_t size) {
+    if (fn == NULL || size > UI_QUEUE_DATA_MAX || (size > 0 && data == NULL) ||
+        !atomic_load_explicit(&s_ready, memory_order_acquire))
+    {
+        return false;
+    }
+
+    int64_t  start = esp_timer_get_time();
+    unsigned pos   = atomic_load_explicit(&s_head, memory_order_relaxed);
+    while (true)
+    {
+        slot_t  *slot = &s_slots[pos & RING_MASK];
+        unsigned seq  = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int      diff = (int) (seq - pos);
+        if (diff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&s_head, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+            {
+                slot->fn        = fn;
+                slot->posted_us = start;
+                if (size > 0)
+                {
+                    memcpy(slot->data, data, size);
+                }
+                atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+                break;
+            }
+        } else if (diff < 0)
+        {
+            atomic_fetch_add_explicit(&s_dropped, 1, memory_order_relaxed);
+            return false;  // plin: producatorul nu asteapta dupa task-ul LVGL
+        } else
+        {
+            pos = atomic_load_explicit(&s_head, memory_order_relaxed);
+        }
+    }
+
+    atomic_fetch_add_explicit(&s_posted, 1, memory_order_relaxed);
+    update_max(&s_post_max_us, (uint32_t) (esp_timer_get_time() - start));
+    return true;
+}
+
+uint32_t ui_queue_drain(uint32_t budget_us) {
+    if (!atomic_load_explicit(&s_ready, memory_order_acquire))
+    {
+        return 0;
+    }
+
+    uint32_t depth = atomic_load_explicit(&s_head, memory_order_relaxed) - s_tail;
+    if (depth > s_max_depth)
+    {
+        s_max_depth = depth;
+    }
+
+    int64_t  start = esp_timer_get_time();
+    uint32_t count = 0;
+    while (true)
+    {
+        slot_t *slot = &s_slots[s_tail & RING_MASK];
+        if (atomic_load_explicit(&slot->seq, memory_order_acquire) != s_tail + 1)
+        {
+            break;  // gol, sau producatorul inca scrie slotul
+        }
+
+        uint32_t wait = (uint32_t) (esp_timer_get_time() - slot->posted_us);
+        s_wait_sum_us += wait;
+        if (wait > s_wait_max_us)
+        {
+            s_wait_max_us = wait;
+        }
+
+        /* Slotul e eliberat abia dupa rulare: datele sunt folosite pe loc, fara copie */
+        slot->fn(slot->data);
+        atomic_store_explicit(&slot->seq, s_tail + UI_QUEUE_LEN, memory_order_release);
+        s_tail++;
+        s_executed++;
+        count++;
+
+        if (esp_timer_get_time() - start >= (int64_t) budget_us)
+        {
+            if (atomic_load_explicit(&s_slots[s_tail & RING_MASK].seq, memory_order_acquire) == s_tail + 1)
+            {
+                s_budget_stops++;
+            }
+            break;
+        }
+    }
+    return count;
+}
+
+void ui_queue_get_stats(ui_queue_stats_t *stats) {
+    if (stats == NULL)
+    {
+        return;
+    }
+    stats->posted       = atomic_load_explicit(&s_posted, memory_order_relaxed);
+    stats->dropped      = atomic_load_explicit(&s_dropped, memory_order_relaxed);
+    stats->post_max_us  = atomic_load_explicit(&s_post_max_us, memory_order_relaxed);
+    stats->executed     = s_executed;
+    stats->depth        = atomic_load_explicit(&s_head, memory_order_relaxed) - s_tail;
+    stats->max_depth    = s_max_depth;
+    stats->budget_stops = s_budget_stops;
+    stats->wait_max_us  = s_wait_max_us;
+    stats->wait_sum_us  = s_wait_sum_us;
+}
+
+/* Din alt task decat LVGL se poate pierde o actualizare concurenta a contoarelor consumatorului */
+void ui_queue_reset_stats(void) {
+    atomic_store_explicit(&s_posted, 0, memory_order_relaxed);
+    atomic_store_explicit(&s_dropped, 0, memory_order_relaxed);
+    atomic_store_explicit(&s_post_max_us, 0, memory_order_relaxed);
+    s_executed     = 0;
+    s_max_depth    = 0;
+    s_budget_stops = 0;
+    s_wait_max_us  = 0;
+    s_wait_sum_us  = 0;
+}
@@ -0,0 +1,144 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "lvgl.h"
+#include "src/draw/lv_draw_private.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_private.h"
+#include "src/draw/sw/lv_draw_sw_utils.h"
+
+#include "bench_registry.h"
+#include "bench_kernels.h"
+
+// din main.cpp
+void touch_get_calibrated_point(int16_t xraw, int16_t yraw, int16_t* x_out, int16_t* y_out);
+
+#define BENCH_LINE_W (320)
+
+/**********************
+ *  BLEND / SWAP
+ **********************/
+
+// Un layer RGB565 de latime 320 si `size` pixeli, ca in flush-ul real
+typedef struct {
+    lv_draw_buf_t*          buf;
+    lv_layer_t              layer;
+    lv_draw_task_t          task;
+    lv_area_t               area;
+    lv_draw_sw_blend_dsc_t  dsc;
+} blend_ctx_t;
+
+static void* blend_setup(size_t size) {
+    blend_ctx_t* ctx = (blend_ctx_t*) calloc(1, sizeof(blend_ctx_t));
+    if (ctx == NULL) {
+        return NULL;
+    }
+    lv_lock();  // task-ul LVGL sta cat ruleaza kernel-ul
+    int32_t rows = (int32_t) (size / BENCH_LINE_W);
+    ctx->buf     = lv_draw_buf_create(BENCH_LINE_W, rows, LV_COLOR_FORMAT_RGB565, LV_STRIDE_AUTO);
+    if (ctx->buf == NULL) {
+        lv_unlock();
+        free(ctx);
+        return NULL;
+    }
+    lv_area_set(&ctx->area, 0, 0, BENCH_LINE_W - 1, rows - 1);
+    ctx->layer.draw_buf     = ctx->buf;
+    ctx->layer.buf_area     = ctx->area;
+    ctx->layer.color_format = LV_COLOR_FORMAT_RGB565;
+    ctx->task.target_layer  = &ctx->layer;
+    ctx->task.clip_area     = ctx->area;
+    ctx->dsc.blend_area     = &ctx->area;
+    ctx->dsc.color          = lv_color_hex(0x3080FF);
+    ctx->dsc.opa            = LV_OPA_50;
+    ctx->dsc.mask_res       = LV_DRAW_SW_MASK_RES_FULL_COVER;
+    ctx->dsc.blend_mode     = LV_BLEND_MODE_NORMAL;
+    return ctx;
+}
+
+static void blend_run(void* params) {
+    blend_ctx_t* ctx = (blend_ctx_t*) params;
+    lv_draw_sw_blend(&ctx->task, &ctx->dsc);
+}
+
+static void swap_run(void* params) {
+    blend_ctx_t* ctx = (blend_ctx_t*) params;
+    lv_draw_sw_rgb565_swap(ctx->buf->data, (uint32_t) lv_area_get_size(&ctx->area));
+}
+
+static void blend_teardown(void* params) {
+    blend_ctx_t* ctx = (blend_ctx_t*) params;
+    lv_draw_buf_destroy(ctx->buf);
+    lv_unlock();
+    free(ctx);
+}
+
+/**********************
+ *  LABEL
+ **********************/
+
+typedef struct {
+    lv_obj_t* label;
+    char      text[2][128];
+    uint32_t  n;
+} label_ctx_t;
+
+static void* label_setup(size_t size) {
+    label_ctx_t* ctx = (label_ctx_t*) calloc(1, sizeof(label_ctx_t));
+    if (ctx == NULL || size >= sizeof(ctx->text[0])) {
+        free(ctx);
+        return NULL;
+    }
+    lv_lock();
+    for (size_t i = 0; i < size; i++) {
+        ctx->text[0][i] = (char) ('a' + i % 26);
+        ctx->text[1][i] = (char) ('A' + i % 26);
+    }
+    ctx->label = lv_label_create(lv_layer_top());
+    return ctx;
+}
+
+// textul alterneaza, altfel LVGL poate scurtcircuita setarea aceluiasi text
+static void label_run(void* params) {
+    label_ctx_t* ctx = (label_ctx_t*) params;
+    lv_label_set_text(ctx->label, ctx->text[ctx->n++ & 1]);
+}
+
+static void label_teardown(void* params) {
+    label_ctx_t* ctx = (label_ctx_t*) params;
+    lv_obj_delete(ctx->label);
+    lv_unlock();
+    free(ctx);
+}
+
+/**********************
+ *  TOUCH
+ **********************/
+
+// calibrarea XPT2046 -> ecran pentru un rand de citiri brute
+static void touch_calib_run(void* params) {
+    volatile int16_t x, y;
+    for (int16_t raw = 0; raw < 4096; raw += 64) {
+        int16_t xo, yo;
+        touch_get_calibrated_point(raw, (int16_t) (4095 - raw), &xo, &yo);
+        x = xo;
+        y = yo;
+    }
+    (void) x;
+    (void) y;
+}
+
+static const bench_kernel_t s_kernels[] = {
+    {"lv_blend_fill_50", "lv_draw_sw_blend() fill, RGB565, opa 50%", blend_setup, blend_run, blend_teardown,
+        {BENCH_LINE_W, BENCH_LINE_W * 20, BENCH_LINE_W * 240}},
+    {"lv_rgb565_swap", "lv_draw_sw_rgb565_swap() over the buffer", blend_setup, swap_run, blend_teardown,
+        {BENCH_LINE_W, BENCH_LINE_W * 20, BENCH_LINE_W * 240}},
+    {"lv_label_set_text", "lv_label_set_text() on a label on the top layer", label_setup, label_run, label_teardown,
+        {8, 64}},
+    {"touch_calib", "touch_get_calibrated_point() x 64 raw samples", NULL, touch_calib_run, NULL, {0}},
+};
+
+void bench_kernels_register() {
+    for (size_t i = 0; i < sizeof(s_kernels) / sizeof(s_kernels[0]); i++) {
+        bench_register(&s_kernels[i]);
+    }
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+// kernel-uri LVGL / touch pentru `perfmon run` (dupa initializarea LVGL)
+void bench_kernels_register();
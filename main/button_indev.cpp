@@ -0,0 +1,148 @@
+#include <atomic>
+
+#include "esp_timer.h"
+#include "lvgl.h"
+
+#include "async_log.h"
+#include "button_indev.h"
+
+#define QUEUE_MASK (BUTTON_INDEV_QUEUE_LEN - 1)
+static_assert((BUTTON_INDEV_QUEUE_LEN & QUEUE_MASK) == 0, "BUTTON_INDEV_QUEUE_LEN trebuie sa fie putere a lui 2");
+
+/**********************
+ *  COADA SPSC
+ **********************/
+
+// head: doar producatorul scrie; tail: doar read_cb. Indecsii cresc liber, slotul e index & mask.
+static button_indev_event_t  s_slots[BUTTON_INDEV_QUEUE_LEN];
+static std::atomic<uint32_t> s_head{0};
+static std::atomic<uint32_t> s_tail{0};
+static std::atomic<uint32_t> s_dropped{0};
+
+button_indev_event_t* button_indev_reserve(void) {
+    uint32_t head = s_head.load(std::memory_order_relaxed);
+    if (head - s_tail.load(std::memory_order_acquire) == BUTTON_INDEV_QUEUE_LEN) {
+        s_dropped.fetch_add(1, std::memory_order_relaxed);
+        return NULL;
+    }
+    return &s_slots[head & QUEUE_MASK];
+}
+
+void button_indev_commit(void) {
+    uint32_t head = s_head.load(std::memory_order_relaxed);
+    s_slots[head & QUEUE_MASK].queued_us = esp_timer_get_time();
+    s_head.store(head + 1, std::memory_order_release);
+}
+
+bool button_indev_push_key(uint32_t key, lv_indev_state_t state, int64_t time_us) {
+    button_indev_event_t* ev = button_indev_reserve();
+    if (ev == NULL) {
+        return false;
+    }
+    ev->time_us  = time_us;
+    ev->key      = key;
+    ev->enc_diff = 0;
+    ev->state    = state;
+    button_indev_commit();
+    return true;
+}
+
+bool button_indev_push_step(int16_t enc_diff, int64_t time_us) {
+    button_indev_event_t* ev = button_indev_reserve();
+    if (ev == NULL) {
+        return false;
+    }
+    ev->time_us  = time_us;
+    ev->key      = LV_KEY_ENTER;
+    ev->enc_diff = enc_diff;
+    ev->state    = LV_INDEV_STATE_RELEASED;  // LVGL ia pasii doar cu butonul eliberat
+    button_indev_commit();
+    return true;
+}
+
+/**********************
+ *  LATENTA
+ **********************/
+
+// Restul de aici e doar in task-ul LVGL
+static button_indev_stats_t s_stats = {.min_us = UINT32_MAX};
+static int64_t              s_pending_us = 0;  // commit() al primului eveniment livrat si inca nerandat
+
+// Primul render dupa ce read_cb a livrat evenimente; daca ciclul de refresh nu randeaza nimic,
+// intrarea n-a schimbat ecranul si nu se masoara (altfel ar lua un render ulterior, fara legatura)
+static void display_event_cb(lv_event_t* e) {
+    if (s_pending_us == 0) {
+        return;
+    }
+    if (lv_event_get_code(e) == LV_EVENT_RENDER_READY) {
+        uint32_t latency_us = (uint32_t) (esp_timer_get_time() - s_pending_us);
+        s_stats.samples++;
+        s_stats.last_us = latency_us;
+        s_stats.sum_us += latency_us;
+        s_stats.min_us = latency_us < s_stats.min_us ? latency_us : s_stats.min_us;
+        s_stats.max_us = latency_us > s_stats.max_us ? latency_us : s_stats.max_us;
+        ALOGI("INPUT", "input -> render %lu us (min %lu, avg %lu, max %lu, n=%lu)", (unsigned long) latency_us,
+            (unsigned long) s_stats.min_us, (unsigned long) (s_stats.sum_us / s_stats.samples),
+            (unsigned long) s_stats.max_us, (unsigned long) s_stats.samples);
+    }
+    s_pending_us = 0;  // LV_EVENT_REFR_READY fara render inainte
+}
+
+/**********************
+ *  INDEV
+ **********************/
+
+static void button_indev_read(lv_indev_t* indev, lv_indev_data_t* data) {
+    static lv_indev_state_t last_state = LV_INDEV_STATE_RELEASED;
+    static uint32_t         last_key   = LV_KEY_ENTER;
+    (void) indev;
+
+    uint32_t tail = s_tail.load(std::memory_order_relaxed);
+    if (tail == s_head.load(std::memory_order_acquire)) {
+        data->state = last_state;
+        data->key   = last_key;
+        return;
+    }
+
+    const button_indev_event_t* ev = &s_slots[tail & QUEUE_MASK];
+    uint32_t age_ms = (uint32_t) ((esp_timer_get_time() - ev->time_us) / 1000);
+
+    data->key       = ev->key;
+    data->state     = ev->state;
+    data->enc_diff  = ev->enc_diff;
+    data->timestamp = lv_tick_get() - age_ms;  // long press/click se masoara de la apasarea reala
+    if (data->timestamp == 0) {
+        data->timestamp = 1;  // 0 inseamna "acum"
+    }
+    if (s_pending_us == 0) {
+        s_pending_us = ev->queued_us;
+    }
+    last_state = ev->state;
+    last_key   = ev->key;
+
+    s_tail.store(tail + 1, std::memory_order_release);
+    s_stats.events++;
+
+    // Tot ce s-a adunat de la citirea precedenta intra in acelasi ciclu lv_indev_read()
+    data->continue_reading = (tail + 1) != s_head.load(std::memory_order_acquire);
+}
+
+lv_indev_t* button_indev_create(lv_indev_type_t type, lv_display_t* disp) {
+    lv_group_t* group = lv_group_create();
+    lv_group_set_default(group);  // widget-urile create dupa asta intra automat in focus
+
+    lv_indev_t* indev = lv_indev_create();
+    lv_indev_set_type(indev, type);
+    lv_indev_set_display(indev, disp);
+    lv_indev_set_read_cb(indev, button_indev_read);
+    lv_indev_set_group(indev, group);
+
+    lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_RENDER_READY, NULL);
+    lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_REFR_READY, NULL);
+    return indev;
+}
+
+void button_indev_get_stats(button_indev_stats_t* stats) {
+    *stats         = s_stats;
+    stats->dropped = s_dropped.load(std::memory_order_relaxed);
+}
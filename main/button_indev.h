@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+// Butoanele fizice ca indev LVGL (keypad sau encoder).
+// Producatorul (task-ul ButtonManager) scrie evenimentul direct in slotul din coada,
+// consumatorul (read_cb, in task-ul LVGL) il citeste pe loc: fara copii, fara lock-uri.
+#define BUTTON_INDEV_QUEUE_LEN (16)  // putere a lui 2
+
+typedef struct {
+    int64_t          time_us;    // esp_timer, momentul fizic (ex. inceputul apasarii la long press)
+    int64_t          queued_us;  // pus de commit(); de aici se masoara latenta pana la render
+    uint32_t         key;        // LV_KEY_*
+    int16_t          enc_diff;   // pasi de encoder, doar cu LV_INDEV_STATE_RELEASED
+    lv_indev_state_t state;
+} button_indev_event_t;
+
+typedef struct {
+    uint32_t events;   // evenimente livrate catre LVGL
+    uint32_t dropped;  // coada plina
+    uint32_t samples;  // latente masurate (commit() -> LV_EVENT_RENDER_READY)
+    uint32_t last_us;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+} button_indev_stats_t;
+
+// In task-ul LVGL, cu lock-ul luat. Creeaza si grupul implicit pentru focus.
+lv_indev_t* button_indev_create(lv_indev_type_t type, lv_display_t* disp);
+
+// Un singur producator: reserve() -> completeaza slotul -> commit()
+button_indev_event_t* button_indev_reserve(void);  // NULL = coada plina
+void button_indev_commit(void);
+
+bool button_indev_push_key(uint32_t key, lv_indev_state_t state, int64_t time_us);
+bool button_indev_push_step(int16_t enc_diff, int64_t time_us);
+
+// Din task-ul LVGL sau cu lock-ul LVGL luat
+void button_indev_get_stats(button_indev_stats_t* stats);
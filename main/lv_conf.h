@@ -148,16 +148,29 @@
 /* If a widget has `style_opa < 255` (not `bg_opa`, `text_opa` etc) or not NORMAL blend mode
  * it is buffered into a "simple" layer before rendering. The widget can be buffered in smaller chunks.
  * "Transformed layers" (if `transform_angle/zoom` are set) use larger buffers
- * and can't be drawn in chunks. */
+ * and are drawn in chunks only if `LV_DRAW_LAYER_TRANSFORM_BUF_SIZE` is set. */
 
 /*The target buffer size for simple layer chunks.*/
 #define LV_DRAW_LAYER_SIMPLE_BUF_SIZE    (64 * 1024)   /*[bytes]*/ //24 old
 
+/*The target buffer size for transformed layer chunks.
+ *The transformed widget is drawn in tiles of the screen whose (not transformed) source area fits into this size.
+ *Set it to 0 to draw the whole widget on one layer.*/
+#define LV_DRAW_LAYER_TRANSFORM_BUF_SIZE (32 * 1024)   /*[bytes]*/ // un ecran intreg rotit ar cere ~300 KB ARGB8888
+
 /* Limit the max allocated memory for simple and transformed layers.
  * It should be at least `LV_DRAW_LAYER_SIMPLE_BUF_SIZE` sized but if transformed layers are also used
- * it should be enough to store the largest widget too (width x height x 4 area).
+ * it should be enough to store the largest widget too (width x height x 4 area) or the largest
+ * `LV_DRAW_LAYER_TRANSFORM_BUF_SIZE` chunk.
+ * A layer which doesn't fit is drawn when an other one is freed. The limit is exceeded only if
+ * the layers using the memory might wait for this one (e.g. nested layers).
  * Set it to 0 to have no limit. */
-#define LV_DRAW_LAYER_MAX_MEMORY 0  /**< No limit by default [bytes]*/
+#define LV_DRAW_LAYER_MAX_MEMORY (128 * 1024)   /*[bytes]*/ // 2 bucati simple in lucru, cate una per thread de desenare
+
+/*Keep this many freed layer buffers to reuse them for the next layers
+ *instead of freeing and allocating them again. They are counted in `LV_DRAW_LAYER_MAX_MEMORY`.
+ *Set it to 0 to free the layer buffers immediately.*/
+#define LV_DRAW_LAYER_BUF_POOL_CNT 4   // fara alocari repetate in PSRAM => fara fragmentare
 
 /* The stack size of the drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
@@ -216,7 +229,7 @@
         /*Allow buffering some shadow calculation.
         *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
         *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
-        #define LV_DRAW_SW_SHADOW_CACHE_SIZE 16 // 0
+        #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0 // 16: inlocuit de LV_DRAW_SW_CACHE_SIZE
 
         /* Set number of maximally cached circle data.
         * The circumference of 1/4 circle are saved for anti-aliasing
@@ -225,6 +238,13 @@
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 16 // 4
     #endif
 
+    /*Size of the cache of the calculated gradient color maps and blurred shadow corners [bytes].
+     *Unlike `LV_DRAW_SW_SHADOW_CACHE_SIZE` it keeps many items, shared by the draw units,
+     *and can be saved to a file and preloaded at boot (see `lv_draw_sw_cache_save()`).
+     *Items larger than half of the cache are not cached.
+     *0: to disable caching */
+    #define LV_DRAW_SW_CACHE_SIZE (32 * 1024)   // salvat pe LittleFS (L:/draw_cache.bin), vezi `drawcache`
+
     #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
 
     #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
@@ -449,11 +469,17 @@
  *Used by image decoders such as `lv_lodepng` to keep the decoded image in the memory.
  *If size is not set to 0, the decoder will fail to decode when the cache is full.
  *If size is 0, the cache function is not enabled and the decoded mem will be released immediately after use.*/
-#define LV_CACHE_DEF_SIZE       4
+#define LV_CACHE_DEF_SIZE       (256 * 1024U)   // imaginile decodate stau in heap-ul LVGL (1 MB, PSRAM)
+
+/*Evict the decoded images by cost instead of LRU order (Greedy-Dual-Size-Frequency).
+ *Small images, images used often and images which took long to decode are kept longer,
+ *large images which were quick to decode are evicted first.
+ *Set a microsecond clock with `lv_image_cache_set_clock_cb()` to measure the decoding time.*/
+#define LV_IMAGE_CACHE_USE_GDSF 1
 
 /*Default number of image header cache entries. The cache is used to store the headers of images
  *The main logic is like `LV_CACHE_DEF_SIZE` but for image headers.*/
-#define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
+#define LV_IMAGE_HEADER_CACHE_DEF_CNT 32    // ~40 B/intrare, evita deschiderea fisierului la fiecare lv_image_set_src
 
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
@@ -472,6 +498,15 @@
 /**  Enable support widget names*/
 #define LV_USE_OBJ_NAME         0
 
+/* Keep a rendered copy of widgets with `LV_OBJ_FLAG_CACHE_AS_BITMAP` and its children
+ * and blend it instead of redrawing them until something in them is invalidated. */
+#define LV_USE_OBJ_BITMAP_CACHE 1
+#if LV_USE_OBJ_BITMAP_CACHE
+    /* Memory budget shared by all the cached widget bitmaps.
+     * The least recently used bitmaps are freed when it's exceeded. */
+    #define LV_OBJ_BITMAP_CACHE_SIZE (64 * 1024U)    /*[bytes]*/ // bara de taburi + butoanele din ui.h: ~56 KB (in PSRAM)
+#endif
+
 /* Automatically assign an ID when obj is created */
 #define LV_OBJ_ID_AUTO_ASSIGN   LV_USE_OBJ_ID
 
@@ -627,6 +662,11 @@
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
 
+/*Size of the decoded glyph bitmap cache of the built-in fonts in bytes.
+ *Glyphs are decoded to A8 once and reused until evicted in LRU order.
+ *0: disable the cache and decode the glyphs on every draw.*/
+#define LV_FONT_GLYPH_CACHE_SIZE (16 * 1024U)   // ~60 glyph-uri Montserrat 10..16, tinute in SRAM intern
+
 /*Enable drawing placeholders when glyph dsc is not found*/
 #define LV_USE_FONT_PLACEHOLDER 1
 
@@ -837,10 +877,10 @@
 #endif
 
 /*API for open, read, etc*/
-#define LV_USE_FS_POSIX 0
+#define LV_USE_FS_POSIX 1 // 0
 #if LV_USE_FS_POSIX
-    #define LV_FS_POSIX_LETTER '\0'     /*Set an upper cased letter on which the drive will accessible (e.g. 'A')*/
-    #define LV_FS_POSIX_PATH ""         /*Set the working directory. File/directory paths will be appended to it.*/
+    #define LV_FS_POSIX_LETTER 'L'     /*Set an upper cased letter on which the drive will accessible (e.g. 'A')*/
+    #define LV_FS_POSIX_PATH "/littlefs"         /*Set the working directory. File/directory paths will be appended to it.*/
     #define LV_FS_POSIX_CACHE_SIZE 0    /*>0 to cache this number of bytes in lv_fs_read()*/
 #endif
 
@@ -900,7 +940,11 @@
 
 /* JPG + split JPG decoder library.
  * Split JPG is a custom format optimized for embedded systems. */
-#define LV_USE_TJPGD 0
+#define LV_USE_TJPGD 1
+#if LV_USE_TJPGD
+    /*Bytes of decoded MCU rows kept between draws (RGB888, 320x240 = 230400 bytes). 0: no cache*/
+    #define LV_TJPGD_CACHE_SIZE (256 * 1024U)
+#endif
 
 /* libjpeg-turbo decoder library.
  * Supports complete JPEG specifications and high-performance JPEG decoding. */
@@ -33,7 +33,7 @@
  *    LVGL DEFINES
  *********************/
 /* LVGL TASK NOTIFICATION */
-#define USE_MUTEX 0
+#define USE_MUTEX 0                 // bucla cu delay fix (nume istoric: ramane doar lock-ul intern LVGL)
 #define USE_FREERTOS_TASK_NOTIF 1   // cica e mai rapid cu 20 %
 #define LV_TASK_NOTIFY_SIGNAL 0x01  // Semnalul pentru notificarea LVGL
 ////#define LV_TIMER_TASK_METHOD USE_MUTEX
@@ -93,6 +93,11 @@ extern "C" {
 
 #include "lvgl.h"
 #include <lv_conf.h>
+#include "src/draw/lv_draw_buf_private.h"  // pentru handler-ele de alocare ale glyph-urilor
+#include "esp_heap_caps.h"
+#include "nvs_flash.h"
+#include "esp_system.h"
+#include "esp_timer.h"
 
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
@@ -101,9 +106,20 @@ extern "C" {
 #include "esp_lcd_touch_xpt2046.h"
 
 // my include
+#include "LITTLE_fs.h"
+#include "async_log.h"
 #include "one-cli.h"
+#include "modules/drawcache_cmd/drawcache_cmd.h"  // DRAW_CACHE_FILE
+#include "power.h"
+#include "sysmon.h"
+#include "telemetry.h"
 #include "ui.h"
+#include "ui_queue.h"
 }
+#include <atomic>
+#include "bench_kernels.h"    // C++
+#include "button_indev.h"    // C++
+#include "button_manager.h"  // C++ (OneButton)
 /**********************
  *   GLOBAL VARIABLES
  **********************/
@@ -232,6 +248,15 @@ static volatile uint32_t g_flush_count     = 0;
 // pentru log la 1s (din task, nu din ISR)
 static uint32_t g_log_last_tick = 0;
 
+// id-uri pe canalul binar de telemetrie (CDC-ACM 1)
+enum {
+    TLM_FLUSH_US = 1,  // histograma duratei transferului SPI, din ISR
+    TLM_FLUSH_BYTES,
+    TLM_FLUSH_COUNT,
+    TLM_INV_ADDED,
+    TLM_INV_MERGED,
+};
+
 #endif /* #if LVGL_BENCH_TEST */
 
 /**********************
@@ -241,6 +266,7 @@ uint32_t      bufSize;           // Dimensiunea buffer-ului
 lv_color_t*   disp_draw_buf;     // Buffer LVGL
 lv_color_t*   disp_draw_buf_II;  // Buffer LVGL secundar
 lv_display_t* disp;              // Display LVGL
+lv_indev_t*   touch_indev = NULL; // Touch XPT2046
 
 /**********************
  *   LVGL FUNCTIONS
@@ -250,7 +276,7 @@ lv_display_t* disp;              // Display LVGL
 void lv_disp_flush(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map) {
 #ifdef LVGL_BENCH_TEST
     // dimensiune reală a zonei în bytes
-    g_flush_bytes     = (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1) * sizeof(lv_color_t);
+    g_flush_bytes     = (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1) * lv_color_format_get_size(lv_display_get_color_format(disp));
     g_flush_tstart_us = esp_timer_get_time();  // ISR-safe
 #endif                                         /* #if LVGL_BENCH_TEST */
     esp_lcd_panel_draw_bitmap(
@@ -327,6 +353,7 @@ bool panel_io_trans_done_callback(esp_lcd_panel_io_handle_t panel_io, esp_lcd_pa
     g_flush_last_us     = elapsed_us;
     g_flush_total_us += elapsed_us;
     g_flush_count++;
+    telemetry_hist(TLM_FLUSH_US, elapsed_us);  // lock-free, nu formateaza nimic in ISR
 #endif /* #ifdef LVGL_BENCH_TEST */
 #ifdef flush_ready_in_io_trans_done
     lv_display_t* d = (lv_display_t*) user_ctx;
@@ -341,23 +368,103 @@ uint32_t lv_get_rtos_tick_count_callback(void) {
     return xTaskGetTickCount();
 }  // Callback pentru a obține numărul de tick-uri RTOS
 #endif /* #if LV_TICK_SOURCE == LV_TICK_SOURCE_CALLBACK */
-//--------------------------------------
-static SemaphoreHandle_t s_lvgl_mutex;
+//---------
+#if LV_FONT_GLYPH_CACHE_SIZE > 0
+// Glyph-urile decodate (cache-ul de glyph-uri + buffer-ul temporar) merg in SRAM intern,
+// iar cand nu mai e loc se trece pe PSRAM (heap-ul LVGL e tot in PSRAM)
+static void* lv_font_buf_malloc_cb(size_t size, lv_color_format_t cf) {
+    (void) cf;
+    return heap_caps_malloc_prefer(size + LV_DRAW_BUF_ALIGN - 1, 2,  // +align, ca la buf_malloc din LVGL
+        MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT,
+        MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+}
+static void lv_font_buf_free_cb(void* buf) {
+    heap_caps_free(buf);
+}
+static void lv_font_buf_use_internal_ram(void) {
+    lv_draw_buf_handlers_t* handlers = lv_draw_buf_get_font_handlers();
+    handlers->buf_malloc_cb          = lv_font_buf_malloc_cb;
+    handlers->buf_free_cb            = lv_font_buf_free_cb;
+}
+#endif /* #if LV_FONT_GLYPH_CACHE_SIZE > 0 */
+//---------
+#if LV_CACHE_DEF_SIZE > 0
+static uint32_t lv_image_cache_clock_us(void) {
+    return (uint32_t) esp_timer_get_time();
+}
+#endif /* #if LV_CACHE_DEF_SIZE > 0 */
+//---------
+#if LV_DRAW_SW_CACHE_SIZE > 0
+// Gradientii si colturile de umbra calculate raman pe LittleFS intre porniri, ca primul cadru
+// al ecranelor cu umbre sa nu fie mai lent decat urmatoarele. Nu exista o oprire propriu-zisa
+// (se taie alimentarea), deci se salveaza la stingerea ecranului, la esp_restart() si din `drawcache save`.
+static int64_t s_first_frame_start_us = 0;
+static bool    s_first_frame_logged   = false;
 
-bool s_lvgl_port_init_locking(void) {
-    s_lvgl_mutex = xSemaphoreCreateRecursiveMutex();
-    return (s_lvgl_mutex != NULL);
+// Doar daca s-a calculat ceva nou de la ultima salvare / incarcare (scrierea in flash nu e gratis)
+static void draw_cache_save_if_changed(void) {
+    lv_draw_sw_cache_stats_t stats;
+    lv_draw_sw_cache_get_stats(&stats);
+    if (stats.unsaved == 0) {
+        return;
+    }
+    int64_t t0 = esp_timer_get_time();
+    if (lv_draw_sw_cache_save(DRAW_CACHE_FILE) == LV_RESULT_OK) {
+        lv_draw_sw_cache_get_stats(&stats);
+        ESP_LOGI("LVGL", "Draw cache: %" PRIu32 " items saved in %" PRIu32 " ms", stats.saved,
+            (uint32_t) ((esp_timer_get_time() - t0) / 1000));
+    }
 }
 
-bool s_lvgl_lock(uint32_t timeout_ms) {
-    if (!s_lvgl_mutex)
-        return false;
-    return xSemaphoreTakeRecursive(s_lvgl_mutex, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+static void draw_cache_on_shutdown(void) {
+    draw_cache_save_if_changed();
 }
 
-void s_lvgl_unlock(void) {
-    if (s_lvgl_mutex)
-        xSemaphoreGiveRecursive(s_lvgl_mutex);
+// Primul cadru desenat, ca sa se vada castigul preincarcarii (comparat cu un boot fara fisier)
+static void first_frame_event_cb(lv_event_t* e) {
+    if (s_first_frame_logged) {
+        return;
+    }
+    if (lv_event_get_code(e) == LV_EVENT_RENDER_START) {
+        s_first_frame_start_us = esp_timer_get_time();
+        return;
+    }
+    s_first_frame_logged = true;
+    lv_draw_sw_cache_stats_t stats;
+    lv_draw_sw_cache_get_stats(&stats);
+    ESP_LOGI("LVGL", "First frame %" PRIu32 " us | draw cache preloaded=%" PRIu32 " | grad hit=%" PRIu32 " miss=%" PRIu32 " | shadow hit=%" PRIu32 " miss=%" PRIu32,
+        (uint32_t) (esp_timer_get_time() - s_first_frame_start_us), stats.loaded, stats.grad_hits, stats.grad_misses,
+        stats.shadow_hits, stats.shadow_misses);
+}
+#endif /* #if LV_DRAW_SW_CACHE_SIZE > 0 */
+//--------------------------------------
+// Celelalte task-uri nu mai iau lock-ul LVGL: posteaza comenzi cu ui_queue_post() si citesc
+// starea publicata aici de task-ul LVGL la sfarsitul fiecarui ciclu.
+// Doar cod care chiar trebuie sa opreasca LVGL (ex. `perfmon run`) ia lv_lock().
+static std::atomic<bool>     s_lv_in_cycle{false};   // task-ul LVGL e in lv_main_cycle()
+static std::atomic<bool>     s_lv_sleep_hold{false};  // light sleep: task-ul LVGL sare peste cicluri
+static std::atomic<uint32_t> s_lv_snap_tick{0};       // lv_tick_get() la snapshot
+static std::atomic<uint32_t> s_lv_inactive_ms{0};
+static std::atomic<uint32_t> s_lv_next_ms{LV_NO_TIMER_READY};
+static std::atomic<bool>     s_lv_anim_running{false};
+
+// Comenzile postate, apoi timer-ele si refresh-ul, sub un singur lv_lock()
+// (lv_timer_handler() il ia oricum, e recursiv)
+static void lv_main_cycle(void) {
+    s_lv_in_cycle.store(true);
+    if (s_lv_sleep_hold.load()) {  // power_sleep_begin() a castigat
+        s_lv_in_cycle.store(false);
+        return;
+    }
+    lv_lock();
+    ui_queue_drain(UI_QUEUE_DRAIN_BUDGET_US);
+    lv_timer_handler();
+    s_lv_inactive_ms.store(lv_display_get_inactive_time(NULL));
+    s_lv_next_ms.store(lv_timer_get_time_until_next());
+    s_lv_anim_running.store(lv_anim_count_running() > 0);
+    s_lv_snap_tick.store(lv_tick_get());
+    lv_unlock();
+    s_lv_in_cycle.store(false);
 }
 
 /*
@@ -373,19 +480,6 @@ void s_lvgl_unlock(void) {
  *********************/
 TaskHandle_t xHandle_lv_main_task;
 TaskHandle_t xHandle_lv_main_tick_task;
-TaskHandle_t xHandle_chechButton0State;
-//---------
-#if (LV_TIMER_TASK_METHOD == USE_MUTEX)
-SemaphoreHandle_t lvgl_timer_mutex;
-
-bool lv_timer_sem_take(void) {
-    return (xSemaphoreTake(lvgl_timer_mutex, portMAX_DELAY) == pdTRUE);
-}
-bool lv_timer_sem_give(void) {
-    return (xSemaphoreGive(lvgl_timer_mutex) == pdTRUE);
-}
-
-#endif  // (LV_TIMER_TASK_METHOD == USE_MUTEX)
 
 #ifdef LVGL_BENCH_TEST
 /********************************************** */
@@ -408,7 +502,46 @@ void lv_bench_task(void* parameter) {
                 ? ((double) g_flush_bytes / (1024.0 * 1024.0)) / ((double) g_flush_last_us / 1e6)
                 : 0.0;
 
-            ESP_LOGI("STATS", "flush last=%.2f ms | avg=%.2f ms | FPS(inst)=%.1f | FPS(avg)=%.1f | MB/s(inst)=%.2f", g_flush_last_us / 1000.0, avg_us / 1000.0, fps_inst, fps_avg, mbps_inst);
+            ALOGI("STATS", "flush last=%.2f ms | avg=%.2f ms | FPS(inst)=%.1f | FPS(avg)=%.1f | MB/s(inst)=%.2f", g_flush_last_us / 1000.0, avg_us / 1000.0, fps_inst, fps_avg, mbps_inst);
+#if LV_FONT_GLYPH_CACHE_SIZE > 0
+            lv_font_glyph_cache_stats_t glyph_stats;
+            lv_font_glyph_cache_get_stats(&glyph_stats);
+            ALOGI("STATS", "glyph cache hit=%" PRIu32 " | miss=%" PRIu32 " | evict=%" PRIu32 " | bypass=%" PRIu32, glyph_stats.hits, glyph_stats.misses, glyph_stats.evictions, glyph_stats.bypassed);
+#endif /* #if LV_FONT_GLYPH_CACHE_SIZE > 0 */
+#if LV_USE_OBJ_BITMAP_CACHE
+            lv_obj_bitmap_cache_stats_t bmp_stats;
+            lv_obj_bitmap_cache_get_stats(&bmp_stats);
+            ALOGI("STATS", "bitmap cache hit=%" PRIu32 " | render=%" PRIu32 " | fallback=%" PRIu32 " | evict=%" PRIu32 " | used=%" PRIu32 "/%" PRIu32 " B", bmp_stats.hits, bmp_stats.renders, bmp_stats.fallbacks, bmp_stats.evictions, bmp_stats.used, bmp_stats.budget);
+#endif /* #if LV_USE_OBJ_BITMAP_CACHE */
+#if LV_CACHE_DEF_SIZE > 0
+            lv_image_cache_stats_t img_stats;
+            lv_image_cache_get_stats(&img_stats);
+            ALOGI("STATS", "image cache hit=%" PRIu32 " | miss=%" PRIu32 " | evict=%" PRIu32 " | used=%" PRIu32 "/%" PRIu32 " B", img_stats.hits, img_stats.misses, img_stats.evictions, img_stats.size, img_stats.max_size);
+#endif /* #if LV_CACHE_DEF_SIZE > 0 */
+#if LV_DRAW_SW_CACHE_SIZE > 0
+            lv_draw_sw_cache_stats_t draw_stats;
+            lv_draw_sw_cache_get_stats(&draw_stats);
+            ALOGI("STATS", "draw cache grad hit=%" PRIu32 " miss=%" PRIu32 " | shadow hit=%" PRIu32 " miss=%" PRIu32 " | evict=%" PRIu32 " | used=%" PRIu32 "/%" PRIu32 " B", draw_stats.grad_hits, draw_stats.grad_misses, draw_stats.shadow_hits, draw_stats.shadow_misses, draw_stats.evictions, draw_stats.size, draw_stats.max_size);
+#endif /* #if LV_DRAW_SW_CACHE_SIZE > 0 */
+            lv_draw_layer_mem_info_t layer_mem;
+            lv_draw_layer_get_mem_info(&layer_mem);
+            ALOGI("STATS", "layers used=%" PRIu32 " | pooled=%" PRIu32 " | peak=%" PRIu32 "/%" PRIu32 " B | alloc=%" PRIu32 " | reuse=%" PRIu32 " | wait=%" PRIu32, layer_mem.used, layer_mem.pooled, layer_mem.peak, layer_mem.limit, layer_mem.alloc_cnt, layer_mem.reuse_cnt, layer_mem.wait_cnt);
+            ui_queue_stats_t q_stats;
+            ui_queue_get_stats(&q_stats);
+            ALOGI("STATS", "ui queue posted=%" PRIu32 " | dropped=%" PRIu32 " | depth=%" PRIu32 "/%" PRIu32 " | post max=%" PRIu32 " us | wait avg=%" PRIu32 " max=%" PRIu32 " us", q_stats.posted, q_stats.dropped, q_stats.depth, q_stats.max_depth, q_stats.post_max_us, q_stats.executed ? (uint32_t) (q_stats.wait_sum_us / q_stats.executed) : 0, q_stats.wait_max_us);
+            lv_display_inv_stats_t inv_stats;
+            lv_display_get_inv_stats(NULL, &inv_stats);
+            ALOGI("STATS", "inv areas added=%" PRIu32 " | merged=%" PRIu32 " | overflow=%" PRIu32, inv_stats.added, inv_stats.merged, inv_stats.overflows);
+            button_indev_stats_t in_stats;
+            lv_lock();  // latentele se scriu in task-ul LVGL
+            button_indev_get_stats(&in_stats);
+            lv_unlock();
+            ALOGI("STATS", "input events=%" PRIu32 " | dropped=%" PRIu32 " | to render last=%" PRIu32 " min=%" PRIu32 " avg=%" PRIu32 " max=%" PRIu32 " us | n=%" PRIu32, in_stats.events, in_stats.dropped, in_stats.last_us, in_stats.samples ? in_stats.min_us : 0, in_stats.samples ? (uint32_t) (in_stats.sum_us / in_stats.samples) : 0, in_stats.max_us, in_stats.samples);
+
+            telemetry_counter(TLM_FLUSH_BYTES, (int32_t) g_flush_bytes);
+            telemetry_counter(TLM_FLUSH_COUNT, (int32_t) g_flush_count);
+            telemetry_counter(TLM_INV_ADDED, (int32_t) inv_stats.added);
+            telemetry_counter(TLM_INV_MERGED, (int32_t) inv_stats.merged);
 
             g_log_last_tick = now;
         }
@@ -470,14 +603,7 @@ void lv_main_task(void* parameter) {
     static TickType_t tick = 0;
     tick                   = xTaskGetTickCount();  // Inițializare corectă
     while (true) {
-        if (s_lvgl_lock(portMAX_DELAY)) {
-            if (lv_timer_sem_take())  // Protejeaza accesul la LVGL
-            {
-                lv_timer_handler();   /* let the GUI do its work */
-                lv_timer_sem_give();  // Eliberam mutex-ul
-            }
-            s_lvgl_unlock();
-        }
+        lv_main_cycle();                           /* let the GUI do its work */
         vTaskDelayUntil(&tick, pdMS_TO_TICKS(5));  // Delay precis mult mai rapid asa
     }
 }
@@ -488,25 +614,21 @@ void lv_main_task(void* parameter) {
     static TickType_t tick = 0;
     tick                   = xTaskGetTickCount();  // Inițializare corectă
     while (true) {
-        if (s_lvgl_lock(portMAX_DELAY)) {
 #if LV_TICK_SOURCE == LV_TICK_SOURCE_TASK
-            uint32_t   notificationValue;
-            BaseType_t notified = xTaskNotifyWait(
-                0x00,       // nu ignoră nimic
-                ULONG_MAX,  // curăță toate biturile
-                &notificationValue,
-                portMAX_DELAY  // așteaptă cât trebuie
-            );
-            if (notified == pdTRUE && (notificationValue & LV_TASK_NOTIFY_SIGNAL)) {
-                lv_timer_handler();
-            }
-            s_lvgl_unlock();  // mereu eliberezi, indiferent dacă ai notificare sau nu
+        uint32_t   notificationValue;
+        BaseType_t notified = xTaskNotifyWait(
+            0x00,       // nu ignoră nimic
+            ULONG_MAX,  // curăță toate biturile
+            &notificationValue,
+            portMAX_DELAY  // așteaptă cât trebuie, fara lock-ul LVGL luat
+        );
+        if (notified == pdTRUE && (notificationValue & LV_TASK_NOTIFY_SIGNAL)) {
+            lv_main_cycle();
+        }
 #elif LV_TICK_SOURCE == LV_TICK_SOURCE_TIMER
-            lv_timer_handler();
-            s_lvgl_unlock();
-            vTaskDelayUntil(&tick, pdMS_TO_TICKS(5));  // delay doar aici
+        lv_main_cycle();
+        vTaskDelayUntil(&tick, pdMS_TO_TICKS(5));  // delay doar aici
 #endif
-        }
     }
 }
 #endif  // (LV_TIMER_TASK_METHOD == USE_FREERTOS_TASK_NOTIF)
@@ -514,40 +636,150 @@ void lv_main_task(void* parameter) {
 /********************************************** */
 /*                   TASK                       */
 /********************************************** */
-static void IRAM_ATTR chechButton0State_isr_handler(void* arg) {
-    // NOTĂ: NU face log sau delay aici
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    xTaskNotifyFromISR((TaskHandle_t) arg, 0x01, eSetBits, &xHigherPriorityTaskWoken);
-    if (xHigherPriorityTaskWoken) {
-        portYIELD_FROM_ISR();
-    }
+// Butoanele fizice: fara polling, ButtonManager se trezeste doar la fronturi si in timpul unui gest.
+// GPIO0 e un encoder LVGL cu un singur buton: click = urmatorul widget, dublu click = ENTER,
+// long press = ENTER tinut apasat, cu momentul real al apasarii (LVGL vede direct LONG_PRESSED).
+static ButtonManager s_buttons;
+
+static void button0_click(void* parameter) {
+    (void) parameter;
+    power_notify_activity();  // aprinde ecranul daca era stins
+    button_indev_push_step(1, esp_timer_get_time());
 }
-//---------
-void chechButton0State(void* parameter) {
+
+static void button0_double_click(void* parameter) {
     (void) parameter;
-    xHandle_chechButton0State = xTaskGetCurrentTaskHandle();  // Încoronarea oficială
-    uint32_t      notificationValue;
-    gpio_config_t io_conf = {
-        .pin_bit_mask = 1ULL << 0,
-        .mode         = GPIO_MODE_INPUT,
-        .pull_up_en   = GPIO_PULLUP_ENABLE,  // activăm pull-up intern
-        .pull_down_en = GPIO_PULLDOWN_DISABLE,
-        .intr_type    = GPIO_INTR_ANYEDGE,  // întrerupere pe orice schimbare de stare
-    };
-    gpio_config(&io_conf);
-    gpio_install_isr_service(ESP_INTR_FLAG_LEVEL1);  // doar o dată în tot proiectul
-    gpio_isr_handler_add((gpio_num_t) 0, chechButton0State_isr_handler, (void*) xHandle_chechButton0State);
-    while (true) {
-        xTaskNotifyWait(0x00, 0xFFFFFFFF, &notificationValue, portMAX_DELAY);
-        if (notificationValue & 0x01) {
-            ESP_LOGW("BUTTON", "Button ACTIVAT pe GPIO0");
-            //// Acțiune custom (PUNE COD AICI)
+    int64_t now = esp_timer_get_time();
+    power_notify_activity();
+    button_indev_push_key(LV_KEY_ENTER, LV_INDEV_STATE_PRESSED, now);
+    button_indev_push_key(LV_KEY_ENTER, LV_INDEV_STATE_RELEASED, now);
+}
+
+static void button0_long_press_start(void* parameter) {
+    OneButton* button  = (OneButton*) parameter;
+    int64_t    now     = esp_timer_get_time();
+    uint32_t   held_ms = (uint32_t) (now / 1000) - button->getStartTime();  // ms pe 32 biti, poate trece prin 0
+    power_notify_activity();
+    button_indev_push_key(LV_KEY_ENTER, LV_INDEV_STATE_PRESSED, now - (int64_t) held_ms * 1000);
+}
+
+static void button0_long_press_stop(void* parameter) {
+    (void) parameter;
+    button_indev_push_key(LV_KEY_ENTER, LV_INDEV_STATE_RELEASED, esp_timer_get_time());
+}
+//---------
+static void buttons_init(void) {
+    static OneButton button0(GPIO_NUM_0, true, true);
+    button0.attachClick(button0_click, &button0);
+    button0.attachDoubleClick(button0_double_click, &button0);
+    button0.attachLongPressStart(button0_long_press_start, &button0);
+    button0.attachLongPressStop(button0_long_press_stop, &button0);
+    s_buttons.add(&button0);
+    ESP_ERROR_CHECK(s_buttons.begin((UBaseType_t) configMAX_PRIORITIES - 7, 1));
+}
+//---------
+// Managerul de consum vede LVGL doar prin functiile astea (task-ul "Power")
+// Din snapshot-ul ultimului ciclu, fara lock; campurile pot fi din cicluri diferite, nu conteaza aici
+static bool power_read_inputs(power_inputs_t* in) {
+    if (s_lv_in_cycle.load()) {
+        return false;  // LVGL randeaza chiar acum: pasul se sare, raman intrarile de data trecuta
+    }
+    uint32_t elapsed = lv_tick_elaps(s_lv_snap_tick.load());
+    uint32_t next    = s_lv_next_ms.load();
+    in->inactive_ms  = s_lv_inactive_ms.load() + elapsed;
+    if (next != LV_NO_TIMER_READY) {  // LV_NO_TIMER_READY == POWER_NO_DEADLINE
+        next = next > elapsed ? next - elapsed : 0;
+    }
+    in->next_deadline_ms = next;
+    in->busy             = s_lv_anim_running.load();
+    // Light sleep-ul opreste USB-ul: consola s-ar deconecta cat timp un host e atasat
+    in->no_sleep = usb_serial_jtag_is_connected();
+    return true;
+}
+
+// In task-ul LVGL, din ui_queue
+static void power_apply_dark(void* data) {
+    bool dark = *(bool*) data;
+    for (lv_indev_t* i = lv_indev_get_next(NULL); i != NULL; i = lv_indev_get_next(i)) {
+        if (dark) {
+            lv_timer_pause(lv_indev_get_read_timer(i));
+        } else {
+            lv_timer_resume(lv_indev_get_read_timer(i));
         }
-        vTaskDelay(200);
+    }
+    if (!dark) {
+        lv_indev_wait_release(touch_indev);  // atingerea care a aprins ecranul nu e si click
+    }
+#if LV_DRAW_SW_CACHE_SIZE > 0
+    if (dark) {
+        draw_cache_save_if_changed();  // ecranul e stins, nu se vede pauza; poate urma taierea alimentarii
+    }
+#endif /* #if LV_DRAW_SW_CACHE_SIZE > 0 */
+}
+
+// Stins: backlight oprit si citirea indev-urilor oprita (touch-ul trezeste prin PENIRQ).
+// Panoul isi pastreaza GRAM-ul, deci la aprindere nu se invalideaza / redeseneaza nimic.
+static void power_on_state(power_state_t from, power_state_t to) {
+    bool was_dark = from >= POWER_DIM;
+    bool dark     = to >= POWER_DIM;
+    if (was_dark == dark) {
+        return;
+    }
+    // Backlight-ul direct de aici: se stinge inainte de un eventual light sleep, chiar daca
+    // task-ul LVGL n-a golit inca coada
+    gfx_set_backlight(dark ? 0 : 1);
+    if (!ui_queue_post(power_apply_dark, &dark, sizeof(dark))) {
+        lv_lock();  // coada plina: tranzitia nu se poate pierde
+        power_apply_dark(&dark);
+        lv_unlock();
     }
 }
+
+// In afara lui lv_main_cycle() nu e niciun flush in curs (refresh-ul asteapta ultimul flush).
+// Ca la Dekker: fiecare parte isi pune flag-ul si apoi il verifica pe al celeilalte.
+static bool power_sleep_begin(void) {
+    s_lv_sleep_hold.store(true);
+    if (s_lv_in_cycle.load()) {
+        s_lv_sleep_hold.store(false);
+        return false;  // amanat pana la urmatoarea verificare a managerului
+    }
+    return true;
+}
+
+static void power_sleep_end(void) {
+    s_lv_sleep_hold.store(false);
+}
+
+static void power_manager_init(void) {
+    power_config_t config = {
+        .policy       = POWER_POLICY_CONFIG_DEFAULT(),
+        .max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+        .min_freq_mhz = 80,
+        .wake_pins    = {
+            {.pin = (gpio_num_t) PIN_NUM_IRQ, .level = 0, .watch = true, .restore = GPIO_INTR_DISABLE},
+            {.pin = GPIO_NUM_0, .level = 0, .watch = false, .restore = GPIO_INTR_ANYEDGE},  // ButtonManager
+        },
+        .wake_pin_cnt = 2,
+        .read_inputs  = power_read_inputs,
+        .on_state     = power_on_state,
+        .sleep_begin  = power_sleep_begin,
+        .sleep_end    = power_sleep_end,
+    };
+    ESP_ERROR_CHECK(power_init(&config));
+}
 /****************************/
 
+// O singura data, inainte de CLI (`nvs_*`) si de orice alt utilizator al NVS
+static void nvs_init(void) {
+    esp_err_t err = nvs_flash_init();
+    if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        ESP_LOGW("NVS", "NVS partition was truncated and needs to be erased");
+        ESP_ERROR_CHECK(nvs_flash_erase());
+        err = nvs_flash_init();
+    }
+    ESP_ERROR_CHECK(err);
+}
+
 //--------------------------------------
 
 /*
@@ -564,10 +796,12 @@ extern "C" void app_main(void) {
     power_latch_init();  // Inițializare latch pentru alimentare
     gfx_set_backlight(1);
     esp_log_level_set("*", ESP_LOG_INFO);
+    async_log_init();  // ALOGx(): formatarea se face in task-ul "Async log", nu in apelant
+    sysmon_init(NULL);  // CPU / heap / stive in fundal, alarme in log (vezi `sysmon`)
+    nvs_init();
 
     boot_count++;
     ESP_LOGI("RTC", "Boot count (from RTC RAM): %lu", boot_count);
-    esp_sleep_enable_timer_wakeup(5000000);  // 5 secunde în microsecunde
 
     esp_bootloader_desc_t bootloader_desc;
 
@@ -581,14 +815,30 @@ extern "C" void app_main(void) {
 
     lv_init();
 
+#if LV_DRAW_SW_CACHE_SIZE > 0
+    if (initialize_filesystem_littlefs() == ESP_OK) {  // altfel cache-ul nu se pastreaza intre porniri
+        lv_draw_sw_cache_load(DRAW_CACHE_FILE);  // inainte de primul cadru
+        esp_register_shutdown_handler(draw_cache_on_shutdown);
+    }
+#endif /* #if LV_DRAW_SW_CACHE_SIZE > 0 */
+
+#if LV_FONT_GLYPH_CACHE_SIZE > 0
+    lv_font_buf_use_internal_ram();  // inainte de primul text desenat
+#endif /* #if LV_FONT_GLYPH_CACHE_SIZE > 0 */
+
 #if LV_TICK_SOURCE == LV_TICK_SOURCE_CALLBACK
     // Next function comment because create problems with lvgl timers and esp32 timers
     lv_tick_set_cb(lv_get_rtos_tick_count_callback);
 #endif /* #if LV_TICK_SOURCE == LV_TICK_SOURCE_CALLBACK */
+#if LV_CACHE_DEF_SIZE > 0
+    lv_image_cache_set_clock_cb(lv_image_cache_clock_us);  // costul de decodare, in us (iconitele au < 1 ms)
+#endif /* #if LV_CACHE_DEF_SIZE > 0 */
 
     disp = lv_display_create(
         (int32_t) LCD_WIDTH,
         (int32_t) LCD_HEIGHT);
+    // ST7789 asteapta MSB primul: LVGL randeaza direct in ordinea asta, bufferul pleaca neatins pe i80
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565_SWAPPED);
 
     esp_lcd_i80_bus_config_t lcd_bus_config = {.dc_gpio_num = BOARD_TFT_DC,
         .wr_gpio_num                                        = BOARD_TFT_WR,
@@ -631,7 +881,7 @@ extern "C" void app_main(void) {
         .flags = {
             .cs_active_high     = 0,
             .reverse_color_bits = 0,
-            .swap_color_bytes   = 1,
+            .swap_color_bytes   = 0,  // LVGL randeaza deja RGB565_SWAPPED
             .pclk_active_neg    = 0,
             .pclk_idle_low      = 0,
         },
@@ -787,29 +1037,27 @@ extern "C" void app_main(void) {
     lv_display_set_flush_cb(disp, lv_disp_flush);  // Set the flush callback which will be called to
                                                    // copy the rendered image to the display.
     ESP_LOGI("LVGL", "LVGL display flush callback set");
+#if LV_DRAW_SW_CACHE_SIZE > 0
+    lv_display_add_event_cb(disp, first_frame_event_cb, LV_EVENT_RENDER_START, NULL);
+    lv_display_add_event_cb(disp, first_frame_event_cb, LV_EVENT_RENDER_READY, NULL);
+#endif /* #if LV_DRAW_SW_CACHE_SIZE > 0 */
 
-    lv_indev_t* indev = lv_indev_create();           /*Initialize the (dummy) input device driver*/
-    lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER); /*Touchpad should have POINTER type*/
-    ////lv_indev_set_read_cb(indev, lv_touchpad_read);    // old version
-    lv_indev_set_read_cb(indev, lv_touchpad_read_v2);
+    touch_indev = lv_indev_create();                       /*Initialize the (dummy) input device driver*/
+    lv_indev_set_type(touch_indev, LV_INDEV_TYPE_POINTER); /*Touchpad should have POINTER type*/
+    ////lv_indev_set_read_cb(touch_indev, lv_touchpad_read);    // old version
+    lv_indev_set_read_cb(touch_indev, lv_touchpad_read_v2);
+    button_indev_create(LV_INDEV_TYPE_ENCODER, disp);  // GPIO0, inainte de create_tabs_ui() (grupul implicit)
     ESP_LOGI("LVGL", "LVGL Setup done");
 
-#if LV_TIMER_TASK_METHOD == USE_MUTEX
-    ESP_LOGI("LVGL", "Se creaza LVGL mutex!");
-    lvgl_timer_mutex = xSemaphoreCreateMutex();
-    if (lvgl_timer_mutex == NULL) {
-        ESP_LOGE("LVGL", "Eroare: Mutex-ul LVGL nu a fost creat!");
-        while (1)
-            ;  // Blocheaza executia daca mutex-ul nu poate fi creat
-    }
-#endif  // (LV_TIMER_TASK_METHOD == USE_MUTEX)
-
-    s_lvgl_port_init_locking();
+    ui_queue_init();  // inainte de task-ul LVGL si de orice producator
 
-    s_lvgl_lock(0);
+    lv_lock();
     create_tabs_ui();  // Creeaza interfata grafica
-    s_lvgl_unlock();
+    lv_unlock();
+
+    bench_kernels_register();  // kernel-uri pentru `perfmon run`
 
+    cli_set_input_cb(power_notify_activity);  // o linie tastata la consola e activitate, ca o atingere
     StartCLI();
 
     xTaskCreatePinnedToCore(lv_main_task,        // Functia task-ului
@@ -835,16 +1083,16 @@ extern "C" void app_main(void) {
 #endif /* #if LV_TICK_SOURCE == LV_TICK_SOURCE_TIMER */
 
 #ifdef LVGL_BENCH_TEST
+    telemetry_declare(TLM_FLUSH_US, TELEMETRY_HIST, "flush_us");
+    telemetry_declare(TLM_FLUSH_BYTES, TELEMETRY_COUNTER, "flush_bytes");
+    telemetry_declare(TLM_FLUSH_COUNT, TELEMETRY_COUNTER, "flush_count");
+    telemetry_declare(TLM_INV_ADDED, TELEMETRY_COUNTER, "inv_added");
+    telemetry_declare(TLM_INV_MERGED, TELEMETRY_COUNTER, "inv_merged");
+    telemetry_init(NULL);  // fara TinyUSB CDC cu 2 porturi ramane doar log-ul text
     esp_rom_delay_us(1000);
     xTaskCreatePinnedToCore(lv_bench_task, "lvBench", 4096, NULL, tskIDLE_PRIORITY + 1, NULL, 1);
 #endif /* #ifdef LVGL_BENCH_TEST */
 
-    xTaskCreatePinnedToCore(chechButton0State,   // Functia care ruleaza task-ul
-        (const char*) "v_check_0_pin_state",     // Numele task-ului
-        (uint32_t) (4096),                       // Dimensiunea stack-ului
-        (NULL),                                  // Parametri
-        (UBaseType_t) configMAX_PRIORITIES - 7,  // Prioritatea task-ului // 6
-        &xHandle_chechButton0State,              // Handle-ul task-ului
-        ((1))                                    // Nucleul pe care ruleaza (ESP32 e dual-core)
-    );
+    buttons_init();
+    power_manager_init();  // dupa buttons_init(): pune la loc intreruperea ANYEDGE pe GPIO0 dupa light sleep
 }
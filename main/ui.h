@@ -7,6 +7,9 @@
 #include "esp_sleep.h"
 #include "lvgl.h"
 #include "esp_timer.h"
+#include "power.h"
+#include "sysmon.h"
+#include "virtual_list.h"
 
 // --- Variabile pentru drift monitor ---
 static lv_obj_t * label_drift = NULL;
@@ -39,6 +42,62 @@ static void lv_drift_timer_cb(lv_timer_t * timer) {
     }
 }
 
+// --- Tab-ul Sys: istoricul din sysmon ---
+#define SYS_CHART_POINTS (60)  // ultimele 60 de esantioane (1 min la perioada implicita)
+
+static lv_obj_t*          sys_chart      = NULL;
+static lv_obj_t*          sys_label      = NULL;
+static lv_chart_series_t* sys_ser_cpu[2] = {NULL, NULL};
+static int32_t            sys_cpu_y[2][SYS_CHART_POINTS];
+
+/* Chart-ul citeste direct din sys_cpu_y (ext array): seria sysmon se copiaza, aliniata la dreapta */
+static void lv_sys_timer_cb(lv_timer_t* timer) {
+    static uint32_t raw[SYS_CHART_POINTS];
+    for (int core = 0; core < 2; core++)
+    {
+        size_t n   = sysmon_get_series((sysmon_series_t) (SYSMON_SERIES_CPU0 + core), raw, SYS_CHART_POINTS);
+        size_t pad = SYS_CHART_POINTS - n;
+        for (size_t i = 0; i < SYS_CHART_POINTS; i++)
+        {
+            bool none          = i < pad || raw[i - pad] == SYSMON_LOAD_NONE;
+            sys_cpu_y[core][i] = none ? LV_CHART_POINT_NONE : (int32_t) (raw[i - pad] / 10);
+        }
+    }
+    lv_chart_refresh(sys_chart);
+
+    sysmon_stats_t stats;
+    sysmon_get_stats(&stats);
+    char cpu[24] = "n/a";
+    if (stats.cpu_load)
+    {
+        snprintf(cpu, sizeof(cpu), "%" LV_PRIu32 "%% / %" LV_PRIu32 "%%", sysmon_get_last(SYSMON_SERIES_CPU0) / 10,
+            sysmon_get_last(SYSMON_SERIES_CPU1) / 10);
+    }
+    lv_label_set_text_fmt(sys_label, "CPU %s   RAM %" LV_PRIu32 " KB   stack min %" LV_PRIu32 " B", cpu,
+        sysmon_get_last(SYSMON_SERIES_FREE_INTERNAL) / 1024, sysmon_get_last(SYSMON_SERIES_STACK_MIN));
+}
+
+// --- Tab-ul List: 100000 de randuri, pe ecran doar ~11 obiecte LVGL ---
+#define LIST_ROWS (100000)
+
+static void list_bind_row(lv_obj_t* row, uint32_t index, void* user_data) {
+    (void) user_data;
+    lv_label_set_text_fmt(lv_obj_get_child(row, 0), "file_%05" LV_PRIu32 ".bin", index);
+    lv_label_set_text_fmt(lv_obj_get_child(row, 1), "%" LV_PRIu32 " B", index * 37 % 100000);
+}
+
+static void list_event_cb(lv_event_t* e) {
+    lv_obj_t* list  = lv_event_get_current_target_obj(e);
+    uint32_t  index = virtual_list_get_row_index(list, lv_event_get_target_obj(e));
+    if (index != VIRTUAL_LIST_NO_ROW)
+    {
+        virtual_list_stats_t stats;
+        virtual_list_get_stats(list, &stats);
+        ESP_LOGI("UI", "rand %" LV_PRIu32 " | %" LV_PRIu32 " obiecte, %" LV_PRIu32 " bind-uri, layout max %" LV_PRIu32 " us",
+            index, stats.row_objs, stats.binds, stats.layout_us_max);
+    }
+}
+
 lv_obj_t* btn1              = NULL; // Declarație globală pentru primul buton
 lv_obj_t* btn1_label        = NULL; // Declarație globală pentru eticheta primului buton
 lv_obj_t* btn3              = NULL; // Declarație globală pentru al treilea buton
@@ -57,7 +116,7 @@ static void btn1_event_cb(lv_event_t* e) {
 
 void btn2_event_cb(lv_event_t* e) {
     ESP_LOGI("UI", "Butonul Light Sleep apăsat");
-    esp_light_sleep_start();
+    power_request_sleep();  // ecran stins + light sleep pana la prima atingere / GPIO0
 }
 
 // Callback pentru al treilea buton
@@ -92,17 +151,22 @@ void create_tabs_ui(void) {
     lv_obj_t* tab2 = lv_tabview_add_tab(tabview, "Tab 2");
     lv_obj_t* tab3 = lv_tabview_add_tab(tabview, "Tab 3");
     lv_obj_t* tab4 = lv_tabview_add_tab(tabview, "Tab 4");
-    // lv_obj_t *tab5 = lv_tabview_add_tab(tabview, "Tab 5");
+    lv_obj_t* tab5 = lv_tabview_add_tab(tabview, "Sys");
+    lv_obj_t* tab6 = lv_tabview_add_tab(tabview, "List");
+    // Bara de taburi se schimba doar la comutarea tab-ului: se deseneaza din bitmap-ul pastrat
+    lv_obj_add_flag(lv_tabview_get_tab_bar(tabview), LV_OBJ_FLAG_CACHE_AS_BITMAP);
 
     // TAB 1
     btn1 = lv_button_create(tab1); // Buton în primul tab
     lv_obj_center(btn1);
+    lv_obj_add_flag(btn1, LV_OBJ_FLAG_CACHE_AS_BITMAP); // static, redesenat doar la apasare
     lv_obj_add_event_cb(btn1, btn1_event_cb, LV_EVENT_CLICKED, NULL);
     btn1_label = lv_label_create(btn1);
     lv_label_set_text(btn1_label, "Hello World");
     lv_obj_center(btn1_label);
 
     lv_obj_t* btn2 = lv_button_create(tab1); // Al doilea buton - Light Sleep
+    lv_obj_add_flag(btn2, LV_OBJ_FLAG_CACHE_AS_BITMAP);
     lv_obj_add_event_cb(btn2, btn2_event_cb, LV_EVENT_CLICKED, NULL);
     lv_obj_t* btn2_label = lv_label_create(btn2);
     lv_label_set_text(btn2_label, "Light Sleep");
@@ -112,6 +176,7 @@ void create_tabs_ui(void) {
     // TAB 2
     btn3 = lv_button_create(tab2); // Buton în al doilea tab
     lv_obj_center(btn3);
+    lv_obj_add_flag(btn3, LV_OBJ_FLAG_CACHE_AS_BITMAP);
     lv_obj_add_event_cb(btn3, btn3_event_cb, LV_EVENT_CLICKED, NULL);
     btn3_label = lv_label_create(btn3);
     lv_label_set_text(btn3_label, "Hello Pople");
@@ -138,4 +203,41 @@ void create_tabs_ui(void) {
     lv_label_set_text(slider_tab4_label, "0");
     lv_obj_align_to(
         slider_tab4_label, slider_tab4, LV_ALIGN_OUT_TOP_MID, 0, -15); /*Align top of the slider*/
+
+    // TAB 5 - incarcarea per core din sysmon
+    sys_label = lv_label_create(tab5);
+    lv_obj_align(sys_label, LV_ALIGN_TOP_LEFT, 0, 0);
+    lv_label_set_text(sys_label, "sysmon: waiting for samples");
+
+    sys_chart = lv_chart_create(tab5);
+    lv_obj_set_size(sys_chart, LV_PCT(100), 120);
+    lv_obj_align(sys_chart, LV_ALIGN_BOTTOM_MID, 0, 0);
+    lv_chart_set_type(sys_chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_point_count(sys_chart, SYS_CHART_POINTS);
+    lv_chart_set_axis_range(sys_chart, LV_CHART_AXIS_PRIMARY_Y, 0, 100);
+    lv_obj_set_style_size(sys_chart, 0, 0, LV_PART_INDICATOR); // fara puncte, doar linia
+    sys_ser_cpu[0] = lv_chart_add_series(sys_chart, lv_palette_main(LV_PALETTE_BLUE), LV_CHART_AXIS_PRIMARY_Y);
+    sys_ser_cpu[1] = lv_chart_add_series(sys_chart, lv_palette_main(LV_PALETTE_ORANGE), LV_CHART_AXIS_PRIMARY_Y);
+    for (int core = 0; core < 2; core++)
+    {
+        lv_chart_set_series_ext_y_array(sys_chart, sys_ser_cpu[core], sys_cpu_y[core]);
+        for (int i = 0; i < SYS_CHART_POINTS; i++)
+        {
+            sys_cpu_y[core][i] = LV_CHART_POINT_NONE;
+        }
+    }
+
+    lv_timer_create(lv_sys_timer_cb, 1000, NULL); // aceeasi perioada ca sysmon
+
+    // TAB 6 - tabel virtual, doua coloane
+    virtual_list_config_t list_config = {};
+    list_config.row_cnt      = LIST_ROWS;
+    list_config.row_height   = 24;
+    list_config.col_cnt      = 2;
+    list_config.col_width[0] = 180;
+    list_config.col_width[1] = 90;
+    list_config.bind_row     = list_bind_row;
+    lv_obj_t* list           = virtual_list_create(tab6, &list_config);
+    lv_obj_set_size(list, LV_PCT(100), LV_PCT(100));
+    lv_obj_add_event_cb(list, list_event_cb, LV_EVENT_CLICKED, NULL);
 }
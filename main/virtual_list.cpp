@@ -0,0 +1,532 @@
+#include <string.h>
+
+#include "esp_timer.h"
+#include "lvgl.h"
+
+#include "virtual_list.h"
+
+#define BLOCK_ROWS VIRTUAL_LIST_BLOCK_ROWS
+#define SLOT_GROW  (4)
+
+typedef struct {
+    lv_obj_t* obj;
+    uint32_t  index;     // VIRTUAL_LIST_NO_ROW = liber (ascuns)
+    bool      measured;  // cu variable_height: inaltimea randului legat e in index
+} row_slot_t;
+
+typedef struct {
+    virtual_list_config_t config;
+    uint32_t              row_cnt;
+    int32_t               total_h;
+    // Indexul de inaltimi: Fenwick pe sumele blocurilor de BLOCK_ROWS randuri (1-based) si, doar pentru
+    // blocurile cu macar un rand diferit de estimare, inaltimea fiecarui rand
+    uint32_t              block_cnt;
+    int32_t*              tree;
+    uint16_t**            block_h;  // NULL = toate randurile blocului au config.row_height
+    uint32_t              block_h_cnt;
+    row_slot_t*           slots;
+    uint32_t              slot_cnt;
+    bool                  in_layout;
+    virtual_list_stats_t  stats;
+} vlist_t;
+
+/**********************
+ *  INDEXUL DE INALTIMI
+ **********************/
+
+static uint32_t lowbit(uint32_t i) {
+    return i & (0u - i);
+}
+
+static uint32_t block_rows(const vlist_t* vl, uint32_t block) {
+    uint32_t start = block * BLOCK_ROWS;
+    return vl->row_cnt - start < BLOCK_ROWS ? vl->row_cnt - start : BLOCK_ROWS;
+}
+
+static int32_t block_sum(const vlist_t* vl, uint32_t block) {
+    const uint16_t* h = vl->block_h[block];
+    uint32_t        n = block_rows(vl, block);
+    if (h == NULL) {
+        return (int32_t) n * vl->config.row_height;
+    }
+    int32_t sum = 0;
+    for (uint32_t k = 0; k < n; k++) {
+        sum += h[k];
+    }
+    return sum;
+}
+
+static void tree_add(vlist_t* vl, uint32_t block, int32_t delta) {
+    for (uint32_t i = block + 1; i <= vl->block_cnt; i += lowbit(i)) {
+        vl->tree[i] += delta;
+    }
+    vl->total_h += delta;
+}
+
+// Suma blocurilor [0, block)
+static int32_t tree_prefix(const vlist_t* vl, uint32_t block) {
+    int32_t sum = 0;
+    for (uint32_t i = block; i > 0; i -= lowbit(i)) {
+        sum += vl->tree[i];
+    }
+    return sum;
+}
+
+// Blocul care contine y; *y devine offset-ul in bloc. block_cnt daca y e dupa ultimul rand.
+static uint32_t tree_find(const vlist_t* vl, int32_t* y) {
+    uint32_t pos  = 0;
+    uint32_t step = 1;
+    while (step * 2 <= vl->block_cnt) {
+        step *= 2;
+    }
+    for (; step > 0; step /= 2) {
+        if (pos + step <= vl->block_cnt && vl->tree[pos + step] <= *y) {
+            pos += step;
+            *y -= vl->tree[pos];
+        }
+    }
+    return pos;
+}
+
+static void tree_build(vlist_t* vl) {
+    vl->total_h = 0;
+    for (uint32_t b = 0; b < vl->block_cnt; b++) {
+        vl->tree[b + 1] = block_sum(vl, b);
+        vl->total_h += vl->tree[b + 1];
+    }
+    for (uint32_t i = 1; i <= vl->block_cnt; i++) {
+        uint32_t parent = i + lowbit(i);
+        if (parent <= vl->block_cnt) {
+            vl->tree[parent] += vl->tree[i];
+        }
+    }
+}
+
+static bool index_resize(vlist_t* vl, uint32_t row_cnt) {
+    uint32_t block_cnt = (row_cnt + BLOCK_ROWS - 1) / BLOCK_ROWS;
+    for (uint32_t b = block_cnt; b < vl->block_cnt; b++) {
+        if (vl->block_h[b] != NULL) {
+            lv_free(vl->block_h[b]);
+            vl->block_h_cnt--;
+        }
+    }
+
+    uint16_t** block_h = (uint16_t**) lv_realloc(vl->block_h, sizeof(uint16_t*) * (block_cnt + 1));
+    int32_t*   tree    = (int32_t*) lv_realloc(vl->tree, sizeof(int32_t) * (block_cnt + 1));
+    if (block_h != NULL) {
+        vl->block_h = block_h;
+    }
+    if (tree != NULL) {
+        vl->tree = tree;
+    }
+    if (block_h == NULL || tree == NULL) {
+        return false;
+    }
+    for (uint32_t b = vl->block_cnt; b < block_cnt; b++) {
+        vl->block_h[b] = NULL;
+    }
+
+    // Randurile noi din ultimul bloc vechi pot avea inaltimi ramase de la o micsorare anterioara
+    for (uint32_t i = vl->row_cnt; i < row_cnt && i / BLOCK_ROWS < vl->block_cnt; i++) {
+        uint16_t* h = vl->block_h[i / BLOCK_ROWS];
+        if (h != NULL) {
+            h[i % BLOCK_ROWS] = (uint16_t) vl->config.row_height;
+        }
+    }
+
+    vl->row_cnt   = row_cnt;
+    vl->block_cnt = block_cnt;
+    tree_build(vl);
+    return true;
+}
+
+static void index_reset(vlist_t* vl) {
+    for (uint32_t b = 0; b < vl->block_cnt; b++) {
+        lv_free(vl->block_h[b]);
+        vl->block_h[b] = NULL;
+    }
+    vl->block_h_cnt    = 0;
+    vl->stats.measured = 0;
+    tree_build(vl);
+}
+
+static int32_t row_height(const vlist_t* vl, uint32_t index) {
+    const uint16_t* h = vl->block_h[index / BLOCK_ROWS];
+    return h != NULL ? h[index % BLOCK_ROWS] : vl->config.row_height;
+}
+
+static int32_t row_y(const vlist_t* vl, uint32_t index) {
+    uint32_t        block = index / BLOCK_ROWS;
+    int32_t         y     = tree_prefix(vl, block);
+    const uint16_t* h     = vl->block_h[block];
+    if (h == NULL) {
+        return y + (int32_t) (index % BLOCK_ROWS) * vl->config.row_height;
+    }
+    for (uint32_t k = 0; k < index % BLOCK_ROWS; k++) {
+        y += h[k];
+    }
+    return y;
+}
+
+static uint32_t row_at(const vlist_t* vl, int32_t y) {
+    if (y < 0) {
+        y = 0;
+    }
+    uint32_t block = tree_find(vl, &y);
+    if (block >= vl->block_cnt) {
+        return vl->row_cnt - 1;
+    }
+    uint32_t        n = block_rows(vl, block);
+    uint32_t        k = 0;
+    const uint16_t* h = vl->block_h[block];
+    if (h == NULL) {
+        k = (uint32_t) (y / vl->config.row_height);
+    } else {
+        while (k < n - 1 && y >= h[k]) {
+            y -= h[k];
+            k++;
+        }
+    }
+    return block * BLOCK_ROWS + (k < n ? k : n - 1);
+}
+
+// Intoarce cu cat s-a schimbat inaltimea randului
+static int32_t set_row_height(vlist_t* vl, uint32_t index, int32_t height) {
+    height = LV_CLAMP(1, height, UINT16_MAX);
+    int32_t old = row_height(vl, index);
+    if (old == height) {
+        return 0;
+    }
+    uint32_t block = index / BLOCK_ROWS;
+    if (vl->block_h[block] == NULL) {
+        uint16_t* h = (uint16_t*) lv_malloc(sizeof(uint16_t) * BLOCK_ROWS);
+        if (h == NULL) {
+            return 0;  // ramane estimarea
+        }
+        for (uint32_t k = 0; k < BLOCK_ROWS; k++) {
+            h[k] = (uint16_t) vl->config.row_height;
+        }
+        vl->block_h[block] = h;
+        vl->block_h_cnt++;
+    }
+    vl->block_h[block][index % BLOCK_ROWS] = (uint16_t) height;
+    tree_add(vl, block, height - old);
+    vl->stats.measured++;
+    return height - old;
+}
+
+/**********************
+ *  RANDURI
+ **********************/
+
+static lv_obj_t* default_row_create(lv_obj_t* list, const virtual_list_config_t* config) {
+    lv_label_long_mode_t long_mode = config->variable_height ? LV_LABEL_LONG_MODE_WRAP : LV_LABEL_LONG_MODE_DOTS;
+    int32_t              height    = config->variable_height ? LV_SIZE_CONTENT : config->row_height;
+    lv_obj_t*            row;
+
+    if (config->col_cnt == 0) {
+        row = lv_label_create(list);
+        lv_label_set_long_mode(row, long_mode);
+    } else {
+        row = lv_obj_create(list);
+        lv_obj_remove_style_all(row);
+        lv_obj_remove_flag(row, LV_OBJ_FLAG_SCROLLABLE);
+        int32_t x = 0;
+        for (uint32_t c = 0; c < config->col_cnt && c < VIRTUAL_LIST_MAX_COLS; c++) {
+            lv_obj_t* cell = lv_label_create(row);
+            lv_label_set_long_mode(cell, long_mode);
+            lv_obj_set_pos(cell, x, 0);
+            lv_obj_set_size(cell, config->col_width[c], height);
+            x += config->col_width[c];
+        }
+    }
+    // Click-ul ajunge si la lista: virtual_list_get_row_index(list, lv_event_get_target(e))
+    lv_obj_add_flag(row, (lv_obj_flag_t) (LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_EVENT_BUBBLE));
+    lv_obj_set_size(row, LV_PCT(100), height);
+    return row;
+}
+
+// Randul legat la index; altfel un slot liber sau un obiect nou
+static row_slot_t* slot_get(lv_obj_t* list, vlist_t* vl, uint32_t index, bool* fresh) {
+    row_slot_t* free_slot = NULL;
+    for (uint32_t s = 0; s < vl->slot_cnt; s++) {
+        if (vl->slots[s].index == index) {
+            *fresh = false;
+            return &vl->slots[s];
+        }
+        if (free_slot == NULL && vl->slots[s].index == VIRTUAL_LIST_NO_ROW) {
+            free_slot = &vl->slots[s];
+        }
+    }
+
+    *fresh = true;
+    if (free_slot == NULL) {
+        if (vl->slot_cnt % SLOT_GROW == 0) {
+            row_slot_t* slots = (row_slot_t*) lv_realloc(vl->slots, sizeof(row_slot_t) * (vl->slot_cnt + SLOT_GROW));
+            if (slots == NULL) {
+                return NULL;
+            }
+            vl->slots = slots;
+        }
+        lv_obj_t* obj = vl->config.create_row != NULL ? vl->config.create_row(list, vl->config.user_data)
+                                                      : default_row_create(list, &vl->config);
+        if (obj == NULL) {
+            return NULL;
+        }
+        free_slot        = &vl->slots[vl->slot_cnt++];
+        free_slot->obj   = obj;
+        vl->stats.row_objs = vl->slot_cnt;
+    }
+    free_slot->index    = index;
+    free_slot->measured = false;
+    lv_obj_remove_flag(free_slot->obj, LV_OBJ_FLAG_HIDDEN);
+    return free_slot;
+}
+
+static void slot_release(row_slot_t* slot) {
+    slot->index = VIRTUAL_LIST_NO_ROW;
+    lv_obj_add_flag(slot->obj, LV_OBJ_FLAG_HIDDEN);
+}
+
+// Inaltimea fara lv_obj_update_layout() (care nu ruleaza daca suntem deja in layout, ex. la SIZE_CHANGED)
+static int32_t measure_row(lv_obj_t* row) {
+    lv_obj_refr_size(row);  // latimea, pentru wrap
+    uint32_t child_cnt = lv_obj_get_child_count(row);
+    for (uint32_t c = 0; c < child_cnt; c++) {
+        lv_obj_refr_size(lv_obj_get_child(row, (int32_t) c));
+    }
+    lv_obj_refr_size(row);
+    return lv_obj_get_height(row);
+}
+
+/**********************
+ *  LAYOUT
+ **********************/
+
+static void layout(lv_obj_t* list, vlist_t* vl, bool rebind) {
+    if (vl->in_layout) {
+        return;
+    }
+    vl->in_layout = true;
+    int64_t t0    = esp_timer_get_time();
+
+    int32_t view_h = lv_obj_get_content_height(list);
+    int32_t top    = lv_obj_get_scroll_y(list);
+    int32_t bottom = top + view_h;
+    if (vl->row_cnt == 0 || view_h <= 0) {
+        for (uint32_t s = 0; s < vl->slot_cnt; s++) {
+            if (vl->slots[s].index != VIRTUAL_LIST_NO_ROW) {
+                slot_release(&vl->slots[s]);
+            }
+        }
+        vl->stats.first = VIRTUAL_LIST_NO_ROW;
+        vl->stats.last  = VIRTUAL_LIST_NO_ROW;
+        vl->in_layout   = false;
+        return;
+    }
+
+    // Un rand in plus deasupra si dedesubt, ca la scroll sa nu apara goluri pana la urmatorul layout
+    uint32_t first = row_at(vl, top);
+    first          = first > 0 ? first - 1 : 0;
+    uint32_t last  = row_at(vl, bottom - 1) + 1;
+
+    for (uint32_t s = 0; s < vl->slot_cnt; s++) {
+        uint32_t index = vl->slots[s].index;
+        if (index != VIRTUAL_LIST_NO_ROW && (index < first || index > last || index >= vl->row_cnt)) {
+            slot_release(&vl->slots[s]);
+        }
+    }
+
+    // Randurile masurate deasupra lui top muta continutul; scroll-ul compenseaza, ca ce e pe ecran sa stea pe loc
+    int32_t  shift = 0;
+    int32_t  y     = row_y(vl, first);
+    uint32_t i;
+    for (i = first; i < vl->row_cnt; i++) {
+        bool        fresh;
+        row_slot_t* slot = slot_get(list, vl, i, &fresh);
+        if (slot == NULL) {
+            break;
+        }
+        if (fresh || rebind) {
+            vl->config.bind_row(slot->obj, i, vl->config.user_data);
+            vl->stats.binds++;
+        }
+        if (vl->config.variable_height && (fresh || rebind || !slot->measured)) {
+            int32_t delta  = set_row_height(vl, i, measure_row(slot->obj));
+            slot->measured = true;
+            if (y < top) {
+                shift += delta;
+            }
+        }
+        lv_obj_set_y(slot->obj, y);
+        y += row_height(vl, i);
+        if (y - row_height(vl, i) >= bottom + shift) {
+            break;  // randul in plus de dedesubt
+        }
+    }
+    last = i < vl->row_cnt ? i : vl->row_cnt - 1;
+
+    // Inaltimile masurate acum au scurtat fereastra
+    for (uint32_t s = 0; s < vl->slot_cnt; s++) {
+        if (vl->slots[s].index != VIRTUAL_LIST_NO_ROW && vl->slots[s].index > last) {
+            slot_release(&vl->slots[s]);
+        }
+    }
+
+    vl->stats.first = first;
+    vl->stats.last  = last;
+    vl->stats.layouts++;
+    vl->stats.layout_us_last = (uint32_t) (esp_timer_get_time() - t0);
+    if (vl->stats.layout_us_last > vl->stats.layout_us_max) {
+        vl->stats.layout_us_max = vl->stats.layout_us_last;
+    }
+
+    if (shift != 0) {
+        lv_obj_scroll_to_y(list, top + shift, LV_ANIM_OFF);  // SCROLL nu reintra, in_layout e true
+    }
+    vl->in_layout = false;
+    if (shift != 0) {
+        layout(list, vl, false);  // fereastra pentru noul top; masoara doar randurile noi
+    }
+}
+
+/**********************
+ *  EVENIMENTE
+ **********************/
+
+static void list_event_cb(lv_event_t* e) {
+    lv_obj_t* list = (lv_obj_t*) lv_event_get_current_target(e);
+    vlist_t*  vl   = (vlist_t*) lv_event_get_user_data(e);
+
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_SCROLL:
+        layout(list, vl, false);
+        break;
+    case LV_EVENT_SIZE_CHANGED:
+        if (vl->config.variable_height) {
+            index_reset(vl);  // alta latime, alt wrap
+            for (uint32_t s = 0; s < vl->slot_cnt; s++) {
+                vl->slots[s].measured = false;
+            }
+        }
+        layout(list, vl, false);
+        break;
+    case LV_EVENT_GET_SELF_SIZE: {
+        // Inaltimea tuturor randurilor; de aici LVGL ia limita de scroll
+        lv_point_t* p = (lv_point_t*) lv_event_get_param(e);
+        p->y          = LV_MAX(p->y, vl->total_h);
+        break;
+    }
+    case LV_EVENT_DELETE:
+        for (uint32_t b = 0; b < vl->block_cnt; b++) {
+            lv_free(vl->block_h[b]);
+        }
+        lv_free(vl->block_h);
+        lv_free(vl->tree);
+        lv_free(vl->slots);  // obiectele randurilor sunt copii ai listei si se sterg cu ea
+        lv_free(vl);
+        break;
+    default:
+        break;
+    }
+}
+
+// Starea listei e user_data-ul lui list_event_cb; user_data-ul obiectului ramane al aplicatiei
+static vlist_t* get_vlist(lv_obj_t* list) {
+    uint32_t cnt = lv_obj_get_event_count(list);
+    for (uint32_t i = 0; i < cnt; i++) {
+        lv_event_dsc_t* dsc = lv_obj_get_event_dsc(list, i);
+        if (lv_event_dsc_get_cb(dsc) == list_event_cb) {
+            return (vlist_t*) lv_event_dsc_get_user_data(dsc);
+        }
+    }
+    LV_ASSERT_MSG(false, "not a virtual list");
+    return NULL;
+}
+
+/**********************
+ *  API
+ **********************/
+
+lv_obj_t* virtual_list_create(lv_obj_t* parent, const virtual_list_config_t* config) {
+    if (config == NULL || config->bind_row == NULL || config->row_height < 1) {
+        return NULL;
+    }
+    vlist_t* vl = (vlist_t*) lv_malloc_zeroed(sizeof(vlist_t));
+    if (vl == NULL) {
+        return NULL;
+    }
+    vl->config      = *config;
+    vl->stats.first = VIRTUAL_LIST_NO_ROW;
+    vl->stats.last  = VIRTUAL_LIST_NO_ROW;
+    if (!index_resize(vl, config->row_cnt)) {
+        lv_free(vl->block_h);
+        lv_free(vl->tree);
+        lv_free(vl);
+        return NULL;
+    }
+
+    lv_obj_t* list = lv_obj_create(parent);
+    lv_obj_set_scroll_dir(list, LV_DIR_VER);
+    lv_obj_add_event_cb(list, list_event_cb, LV_EVENT_ALL, vl);
+    return list;
+}
+
+void virtual_list_set_row_count(lv_obj_t* list, uint32_t row_cnt) {
+    vlist_t* vl = get_vlist(list);
+    if (!index_resize(vl, row_cnt)) {
+        return;
+    }
+    lv_obj_readjust_scroll(list, LV_ANIM_OFF);  // poate am scurtat lista sub pozitia curenta
+    lv_obj_invalidate(list);                    // scrollbar-ul
+    layout(list, vl, false);
+}
+
+void virtual_list_refresh(lv_obj_t* list) {
+    layout(list, get_vlist(list), true);
+}
+
+void virtual_list_refresh_row(lv_obj_t* list, uint32_t index) {
+    vlist_t* vl = get_vlist(list);
+    for (uint32_t s = 0; s < vl->slot_cnt; s++) {
+        if (vl->slots[s].index == index) {
+            vl->config.bind_row(vl->slots[s].obj, index, vl->config.user_data);
+            vl->stats.binds++;
+            vl->slots[s].measured = false;
+            layout(list, vl, false);  // cu variable_height randurile de dedesubt se pot muta
+            return;
+        }
+    }
+}
+
+void virtual_list_scroll_to(lv_obj_t* list, uint32_t index, lv_anim_enable_t anim) {
+    vlist_t* vl = get_vlist(list);
+    if (index >= vl->row_cnt) {
+        return;
+    }
+    lv_obj_scroll_to_y(list, row_y(vl, index), anim);
+}
+
+uint32_t virtual_list_get_row_index(lv_obj_t* list, lv_obj_t* row) {
+    vlist_t* vl = get_vlist(list);
+    // Obiectul apasat poate fi o celula din rand
+    while (row != NULL && lv_obj_get_parent(row) != list) {
+        row = lv_obj_get_parent(row);
+    }
+    for (uint32_t s = 0; s < vl->slot_cnt; s++) {
+        if (vl->slots[s].obj == row) {
+            return vl->slots[s].index;
+        }
+    }
+    return VIRTUAL_LIST_NO_ROW;
+}
+
+void virtual_list_get_stats(lv_obj_t* list, virtual_list_stats_t* stats) {
+    vlist_t* vl         = get_vlist(list);
+    *stats              = vl->stats;
+    stats->rows         = vl->row_cnt;
+    stats->row_objs     = vl->slot_cnt;
+    stats->index_bytes  = sizeof(vlist_t) + (vl->block_cnt + 1) * (sizeof(int32_t) + sizeof(uint16_t*))
+                       + vl->block_h_cnt * BLOCK_ROWS * sizeof(uint16_t)
+                       + ((vl->slot_cnt + SLOT_GROW - 1) / SLOT_GROW) * SLOT_GROW * sizeof(row_slot_t);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+// Lista / tabel virtual: doar randurile vizibile (+1 sus si jos) exista ca obiecte LVGL.
+// Obiectele se refolosesc la scroll, continutul vine din bind_row(). Inaltimea totala pentru
+// scroll vine din inaltimile randurilor: estimata pana cand randul e masurat (variable_height).
+// Cost la scroll: O(randuri vizibile + log(randuri)), memorie: O(randuri / 64) + pool-ul de obiecte.
+#define VIRTUAL_LIST_BLOCK_ROWS (64)  // randuri pe bloc in indexul de inaltimi
+#define VIRTUAL_LIST_MAX_COLS   (8)
+#define VIRTUAL_LIST_NO_ROW     (UINT32_MAX)
+
+typedef struct {
+    uint32_t row_cnt;
+    int32_t  row_height;       // inaltimea unui rand; cu variable_height doar estimarea
+    bool     variable_height;  // masoara fiecare rand dupa bind_row() (ex. text pe mai multe linii)
+
+    // Randul implicit (create_row == NULL): un label, sau col_cnt label-uri de latimi col_width[] (tabel).
+    // bind_row() le ia cu lv_obj_get_child(row, col); fara coloane randul e chiar label-ul.
+    uint32_t col_cnt;
+    int32_t  col_width[VIRTUAL_LIST_MAX_COLS];
+
+    lv_obj_t* (*create_row)(lv_obj_t* list, void* user_data);  // copil al lui list, fara pozitie
+    void (*bind_row)(lv_obj_t* row, uint32_t index, void* user_data);
+    void* user_data;
+} virtual_list_config_t;
+
+typedef struct {
+    uint32_t rows;           // randuri in sursa de date
+    uint32_t row_objs;       // obiecte LVGL create (pool-ul)
+    uint32_t first;          // fereastra legata acum
+    uint32_t last;
+    uint32_t binds;          // apeluri bind_row()
+    uint32_t measured;       // randuri masurate cu alta inaltime decat estimarea
+    uint32_t layouts;
+    uint32_t layout_us_last;
+    uint32_t layout_us_max;
+    size_t   index_bytes;    // indexul de inaltimi + pool-ul de sloturi (fara obiectele LVGL)
+} virtual_list_stats_t;
+
+// Toate functiile: din task-ul LVGL sau cu lock-ul LVGL luat
+lv_obj_t* virtual_list_create(lv_obj_t* parent, const virtual_list_config_t* config);
+
+// Randurile existente isi pastreaza inaltimea masurata (ex. un log care creste)
+void virtual_list_set_row_count(lv_obj_t* list, uint32_t row_cnt);
+// Datele s-au schimbat: bind_row() din nou pentru randurile vizibile / pentru un rand
+void virtual_list_refresh(lv_obj_t* list);
+void virtual_list_refresh_row(lv_obj_t* list, uint32_t index);
+
+void virtual_list_scroll_to(lv_obj_t* list, uint32_t index, lv_anim_enable_t anim);
+uint32_t virtual_list_get_row_index(lv_obj_t* list, lv_obj_t* row);  // VIRTUAL_LIST_NO_ROW = nelegat
+void virtual_list_get_stats(lv_obj_t* list, virtual_list_stats_t* stats);